@@ -0,0 +1,322 @@
+#include "Benchmark.h"
+
+#include <algorithm>   // sort, min, count
+#include <chrono>      // steady_clock
+#include <cstdint>     // uint8_t
+#include <cstdio>      // printf, snprintf
+#include <random>      // mt19937
+#include <thread>      // hardware_concurrency
+#include <vector>      // vector
+
+#include "JobSystem.h"
+#include "OcclusionCulling.h"
+#include "Primitives.h"
+#include "ShaderUniforms.h"
+#include "Transform.h"
+#include "TransformBatch.h"
+
+using namespace std;
+using namespace glm;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	const int BENCHMARK_ITERATIONS = 30;
+	const int VERTEX_BENCHMARK_INSTANCES = 64;    // Copies of the Grid per Timed Draw
+	const int VERTEX_BENCHMARK_GRID = 256;        // Grid Vertices per Side, 65,536 in Total
+	const double OCCLUSION_BUDGET_MS = 1.0;       // Whole-Cull Budget per Frame at 1080p
+	const size_t OCCLUSION_TEST_JOB_GRAIN = 256;  // Occludees per Job
+
+	// Occluder Boxes are Subdivided so the Rasterizer Sees a Realistic Triangle Count
+	// -------------------------------------------------------------------------------
+	constexpr auto OCCLUDER_BOX = makeBox<PositionOnly, 2>(1.0f, 1.0f, 1.0f);
+
+
+	// Random Transforms Spread Over a Large Volume
+	// --------------------------------------------
+	vector<Transform> createRandomTransforms(size_t count)
+	{
+		mt19937 random(1234);
+		uniform_real_distribution<float> position(-100.0f, 100.0f);
+		uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+		uniform_real_distribution<float> size(0.5f, 2.0f);
+
+		vector<Transform> transforms(count);
+		for (Transform& transform : transforms)
+		{
+			transform.scale = vec3(size(random), size(random), size(random));
+			transform.rotation = vec3(angle(random), angle(random), angle(random));
+			transform.translation = vec3(position(random), position(random), position(random));
+		}
+
+		return transforms;
+	}
+
+	// Median Wall-Clock Time of a Function, in Milliseconds
+	// -----------------------------------------------------
+	template <typename Function>
+	double medianMilliseconds(int iterations, Function function)
+	{
+		vector<double> samples;
+		for (int i = 0; i < iterations; ++i)
+		{
+			auto start = chrono::steady_clock::now();
+			function();
+			auto end = chrono::steady_clock::now();
+			samples.push_back(chrono::duration<double, milli>(end - start).count());
+		}
+
+		sort(samples.begin(), samples.end());
+		return samples[samples.size() / 2];
+	}
+}
+
+void benchmarkJobSystem(size_t objectCount)
+{
+	vector<Transform> transforms = createRandomTransforms(objectCount);
+	vector<mat4> models(objectCount);
+
+	unsigned maxThreads = max(1u, thread::hardware_concurrency());
+
+	printf("Job System: Composing %zu Model Matrices (median of %d runs)\n", objectCount, BENCHMARK_ITERATIONS);
+	printf("%8s %12s %10s %12s\n", "threads", "ms", "speedup", "efficiency");
+
+	double baseline = 0.0;
+	for (unsigned threads = 1; threads <= maxThreads; threads = (threads == maxThreads) ? threads + 1 : min(threads * 2, maxThreads))
+	{
+		JobSystem jobs(threads);
+
+		double ms = medianMilliseconds(BENCHMARK_ITERATIONS, [&]()
+		{
+			jobs.parallelFor(objectCount, 1024, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+					models[i] = composeModelMatrix(transforms[i]);
+			});
+		});
+
+		if (threads == 1)
+			baseline = ms;
+
+		double speedup = baseline / ms;
+		printf("%8u %12.3f %9.2fx %11.0f%%\n", threads, ms, speedup, 100.0 * speedup / threads);
+	}
+}
+
+void benchmarkTransforms(size_t objectCount)
+{
+	vector<Transform> transforms = createRandomTransforms(objectCount);
+	vector<mat4> models(objectCount);
+	vector<mat3> normals(objectCount);
+
+	TransformBatch batch;
+	batch.resize(objectCount);
+	for (size_t i = 0; i < objectCount; ++i)
+		batch.set(i, transforms[i]);
+
+	printf("Transforms: %zu Model and Normal Matrices, One Thread (median of %d runs)\n", objectCount, BENCHMARK_ITERATIONS);
+	printf("%-34s %10s %14s\n", "kernel", "ms", "Mtransforms/s");
+
+	// Before: glm Compose, then the General 4x4 Inverse the Vertex Shader Used to Do
+	// ------------------------------------------------------------------------------
+	double scalar = medianMilliseconds(BENCHMARK_ITERATIONS, [&]()
+	{
+		for (size_t i = 0; i < objectCount; ++i)
+		{
+			models[i] = composeModelMatrix(transforms[i]);
+			normals[i] = mat3(transpose(inverse(models[i])));
+		}
+	});
+	printf("%-34s %10.3f %14.2f\n", "glm compose + inverse-transpose", scalar, objectCount / scalar / 1000.0);
+
+	// After: Structure-of-Arrays SIMD Kernel
+	// --------------------------------------
+	double simd = medianMilliseconds(BENCHMARK_ITERATIONS, [&]()
+	{
+		batch.compose(0, objectCount, models.data(), normals.data());
+	});
+
+	char name[64];
+	snprintf(name, sizeof(name), "SoA batch (%s, %zu lanes)", TransformBatch::instructionSet(), TransformBatch::LANE_COUNT);
+	printf("%-34s %10.3f %14.2f\n", name, simd, objectCount / simd / 1000.0);
+	printf("Speedup: %.2fx\n", scalar / simd);
+}
+
+void benchmarkOcclusion(size_t occluderCount, size_t occludeeCount)
+{
+	// Camera at the Origin Looking Down -Z with a 1080p Aspect Ratio
+	// --------------------------------------------------------------
+	const mat4 viewProjection = perspective(radians(45.0f), 1920.0f / 1080.0f, 0.1f, 100.0f);
+
+	vector<vec3> positions;
+	for (const PositionOnly& vertex : OCCLUDER_BOX.vertices)
+		positions.push_back(vec3(vertex.position[0], vertex.position[1], vertex.position[2]));
+
+	// Wall-Sized Occluders Near the Camera, Small Occludees Scattered Behind and Among Them
+	// -------------------------------------------------------------------------------------
+	mt19937 random(1234);
+	uniform_real_distribution<float> spread(-1.0f, 1.0f);
+	uniform_real_distribution<float> occluderDepth(-30.0f, -5.0f);
+	uniform_real_distribution<float> occludeeDepth(-60.0f, -5.0f);
+	uniform_real_distribution<float> occluderSize(1.0f, 4.0f);
+
+	vector<mat4> occluders(occluderCount);
+	for (mat4& model : occluders)
+	{
+		float z = occluderDepth(random);
+		model = translate(mat4(1.0f), vec3(spread(random) * -z * 0.8f, spread(random) * -z * 0.45f, z));
+		model = scale(model, vec3(occluderSize(random), occluderSize(random), 0.5f));
+	}
+
+	// Front to Back, so Tiles Covered by Near Occluders Reject the Far Ones Early
+	// -------------------------------------------------------------------------
+	sort(occluders.begin(), occluders.end(), [](const mat4& a, const mat4& b) { return a[3].z > b[3].z; });
+
+	vector<mat4> occludees(occludeeCount);
+	for (mat4& model : occludees)
+	{
+		float z = occludeeDepth(random);
+		model = translate(mat4(1.0f), vec3(spread(random) * -z * 0.8f, spread(random) * -z * 0.45f, z));
+		model = scale(model, vec3(0.5f));
+	}
+
+	printf("Occlusion Culling: %zu Occluders (%zu Triangles Each), %zu Occludee AABBs, %dx%d Depth (median of %d runs)\n",
+		occluderCount, OCCLUDER_BOX.indices.size() / 3, occludeeCount, OcclusionCulling::BUFFER_WIDTH, OcclusionCulling::BUFFER_HEIGHT, BENCHMARK_ITERATIONS);
+	printf("Binning Runs on the Calling Thread; Rasterization and the Occludee Tests Run on the Pool. Budget %.1f ms per Frame\n", OCCLUSION_BUDGET_MS);
+	printf("%8s %12s %12s %12s %10s %10s %10s\n", "threads", "bin ms", "raster ms", "test ms", "total ms", "budget", "visible");
+
+	vector<uint8_t> visible(occludeeCount);
+	unsigned maxThreads = max(1u, thread::hardware_concurrency());
+	for (unsigned threads = 1; threads <= maxThreads; threads = (threads == maxThreads) ? threads + 1 : min(threads * 2, maxThreads))
+	{
+		JobSystem jobs(threads);
+		OcclusionCulling culling;
+
+		double bin = medianMilliseconds(BENCHMARK_ITERATIONS, [&]()
+		{
+			culling.beginFrame(viewProjection);
+			for (const mat4& model : occluders)
+				culling.addOccluder(positions.data(), positions.size(), OCCLUDER_BOX.indices.data(), OCCLUDER_BOX.indices.size(), model);
+		});
+
+		double raster = medianMilliseconds(BENCHMARK_ITERATIONS, [&]()
+		{
+			culling.rasterize(jobs);
+		});
+
+		double test = medianMilliseconds(BENCHMARK_ITERATIONS, [&]()
+		{
+			jobs.parallelFor(occludeeCount, OCCLUSION_TEST_JOB_GRAIN, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+					visible[i] = culling.isVisible(vec3(-0.5f), vec3(0.5f), occludees[i]);
+			});
+		});
+
+		const double total = bin + raster + test;
+		const size_t visibleCount = count(visible.begin(), visible.end(), 1);
+		printf("%8u %12.3f %12.3f %12.3f %10.3f %9.0f%% %10zu\n", threads, bin, raster, test, total, 100.0 * total / OCCLUSION_BUDGET_MS, visibleCount);
+	}
+}
+
+void benchmarkVertexShader(RenderBackend& backend, ProgramId inverseProgram, ProgramId normalMatrixProgram)
+{
+	// Dense Grid Mesh: Position and Normal per Vertex
+	// -----------------------------------------------
+	vector<float> vertices;
+	for (int y = 0; y < VERTEX_BENCHMARK_GRID; ++y)
+	{
+		for (int x = 0; x < VERTEX_BENCHMARK_GRID; ++x)
+		{
+			float u = static_cast<float>(x) / (VERTEX_BENCHMARK_GRID - 1);
+			float v = static_cast<float>(y) / (VERTEX_BENCHMARK_GRID - 1);
+			vertices.insert(vertices.end(), { u - 0.5f, 0.0f, v - 0.5f, 0.0f, 1.0f, 0.0f });
+		}
+	}
+
+	vector<uint16_t> indices;
+	for (int y = 0; y + 1 < VERTEX_BENCHMARK_GRID; ++y)
+	{
+		for (int x = 0; x + 1 < VERTEX_BENCHMARK_GRID; ++x)
+		{
+			uint16_t corner = static_cast<uint16_t>(y * VERTEX_BENCHMARK_GRID + x);
+			uint16_t row = static_cast<uint16_t>(VERTEX_BENCHMARK_GRID);
+			indices.insert(indices.end(), { corner, uint16_t(corner + 1), uint16_t(corner + row), uint16_t(corner + 1), uint16_t(corner + row + 1), uint16_t(corner + row) });
+		}
+	}
+
+	VertexLayout layout;
+	layout.attributes[0] = { 0, 3, 0 };
+	layout.attributes[1] = { 1, 3, 3 * sizeof(float) };
+	layout.attributeCount = 2;
+	layout.stride = 6 * sizeof(float);
+
+	const BufferId buffers[2] = { backend.createBuffer(BufferType::Vertex, vertices.size() * sizeof(float), vertices.data()),
+		backend.createBuffer(BufferType::Index, indices.size() * sizeof(uint16_t), indices.data()) };
+	const VertexInputId vertexInput = backend.createVertexInput(layout, buffers[0], buffers[1]);
+	const uint32_t indexCount = static_cast<uint32_t>(indices.size());
+
+	const char* names[2] = { "per-vertex inverse(model)", "per-object normalMatrix" };
+	PipelineId pipelines[2] = {};
+	double milliseconds[2] = {};
+
+	mat4 model = composeModelMatrix(createRandomTransforms(1)[0]);
+	mat3 normalMatrix = mat3(transpose(inverse(model)));
+	mat4 viewProjection(1.0f);
+
+	// A 1x1 Viewport Leaves at Most One Fragment per Triangle, so the Vertex Stage Dominates;
+	// Rasterizer Discard is Avoided Because Some Drivers Then Skip Vertex Shading Entirely
+	// ----------------------------------------------------------------------------------------
+	PassDesc pass;
+	pass.width = 1;
+	pass.height = 1;
+
+	CommandList commands;
+	for (int p = 0; p < 2; ++p)
+	{
+		PipelineDesc desc;
+		desc.program = (p == 0) ? inverseProgram : normalMatrixProgram;
+		desc.uniforms = Uniform::NAMES;
+		desc.uniformCount = Uniform::Count;
+		desc.depthTest = false;
+		pipelines[p] = backend.createPipeline(desc);
+
+		commands.reset();
+		commands.bindPipeline(pipelines[p]);
+		commands.setUniform(Uniform::Model, model);
+		commands.setUniform(Uniform::NormalMatrix, normalMatrix);
+		commands.setUniform(Uniform::ViewProjection, viewProjection);
+		commands.bindVertexInput(vertexInput, IndexType::UInt16);
+		commands.drawIndexed(indexCount, 0, VERTEX_BENCHMARK_INSTANCES);
+
+		// Warm Up, then Time Draw to Completion; Timestamps Miss Work on Software Drivers
+		// -------------------------------------------------------------------------------
+		auto drawToCompletion = [&]()
+		{
+			backend.beginPass(pass);
+			backend.submit(&commands, 1);
+			backend.endPass();
+
+			const FenceId fence = backend.insertFence();
+			backend.waitFence(fence, UINT64_MAX);
+			backend.destroyFence(fence);
+		};
+
+		drawToCompletion();
+		milliseconds[p] = medianMilliseconds(BENCHMARK_ITERATIONS, drawToCompletion);
+	}
+
+	for (PipelineId pipeline : pipelines)
+		backend.destroyPipeline(pipeline);
+	backend.destroyVertexInput(vertexInput);
+	for (BufferId buffer : buffers)
+		backend.destroyBuffer(buffer);
+
+	double vertexCount = static_cast<double>(vertices.size() / 6) * VERTEX_BENCHMARK_INSTANCES;
+	printf("Vertex Shader: %d Instances of a %zu-Vertex Grid, 1x1 Viewport (median of %d runs)\n", VERTEX_BENCHMARK_INSTANCES, vertices.size() / 6, BENCHMARK_ITERATIONS);
+	printf("%-28s %10s %14s\n", "vertex shader", "ms", "Mvertices/s");
+	for (int p = 0; p < 2; ++p)
+		printf("%-28s %10.3f %14.1f\n", names[p], milliseconds[p], vertexCount / milliseconds[p] / 1000.0);
+	printf("Speedup: %.2fx\n", milliseconds[0] / milliseconds[1]);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>   // size_t
+
+#include "RenderBackend.h"
+
+// Benchmarks, Selected from the Command Line in main(); --bench-vertex Needs the Backend
+// ---------------------------------------------------------------------------------------
+
+// --bench-jobs: Model Matrix Composition Scaling from 1 to N Threads
+// ------------------------------------------------------------------
+void benchmarkJobSystem(size_t objectCount);
+
+// --bench-transforms: Scalar glm Model and Normal Matrices Against the SIMD Batch Kernel
+// -------------------------------------------------------------------------------------
+void benchmarkTransforms(size_t objectCount);
+
+// --bench-vertex: Vertex Shader Cost of a Per-Vertex Inverse Against a Per-Object Normal Matrix
+// ---------------------------------------------------------------------------------------------
+void benchmarkVertexShader(RenderBackend& backend, ProgramId inverseProgram, ProgramId normalMatrixProgram);
+
+// --bench-occlusion: Headless Software Occlusion Culling: Occluder Rasterization and AABB Tests
+// ---------------------------------------------------------------------------------------------
+void benchmarkOcclusion(size_t occluderCount, size_t occludeeCount);
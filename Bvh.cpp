@@ -0,0 +1,305 @@
+#include "Bvh.h"
+
+#include <algorithm>   // nth_element, min, max
+#include <cfloat>      // FLT_MAX
+#include <cmath>       // fabs, copysign
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BVH_SSE2
+#endif
+
+using namespace std;
+using namespace glm;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	const int STACK_SIZE = 256;               // Far Deeper than a Median-Split Tree of Any Scene Here
+	const float MIN_DIRECTION = 1e-20f;       // Keeps Slab Tests Clear of 0 * Infinity
+	const float PARALLEL_EPSILON = 1e-12f;    // Determinant Below which a Ray Grazes the Triangle
+
+	// Slab Test of One Ray Against a Node's Four Children; Bit i Set if Child i is Entered
+	// Before maxDistance, with its Entry Distance in entry[i]
+	// ------------------------------------------------------------------------------------
+	template <typename Node>
+	int intersectChildren(const Node& node, const vec3& origin, const vec3& inverseDirection, float maxDistance, float entry[4])
+	{
+#if defined(BVH_SSE2)
+		const __m128 originX = _mm_set1_ps(origin.x);
+		const __m128 originY = _mm_set1_ps(origin.y);
+		const __m128 originZ = _mm_set1_ps(origin.z);
+		const __m128 inverseX = _mm_set1_ps(inverseDirection.x);
+		const __m128 inverseY = _mm_set1_ps(inverseDirection.y);
+		const __m128 inverseZ = _mm_set1_ps(inverseDirection.z);
+
+		const __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.minX), originX), inverseX);
+		const __m128 x2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.maxX), originX), inverseX);
+		const __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.minY), originY), inverseY);
+		const __m128 y2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.maxY), originY), inverseY);
+		const __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.minZ), originZ), inverseZ);
+		const __m128 z2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.maxZ), originZ), inverseZ);
+
+		const __m128 nearest = _mm_max_ps(_mm_max_ps(_mm_min_ps(x1, x2), _mm_min_ps(y1, y2)), _mm_max_ps(_mm_min_ps(z1, z2), _mm_setzero_ps()));
+		const __m128 farthest = _mm_min_ps(_mm_min_ps(_mm_max_ps(x1, x2), _mm_max_ps(y1, y2)), _mm_min_ps(_mm_max_ps(z1, z2), _mm_set1_ps(maxDistance)));
+
+		_mm_storeu_ps(entry, nearest);
+		return _mm_movemask_ps(_mm_cmple_ps(nearest, farthest));
+#else
+		int mask = 0;
+		for (int i = 0; i < 4; ++i)
+		{
+			const float x1 = (node.minX[i] - origin.x) * inverseDirection.x;
+			const float x2 = (node.maxX[i] - origin.x) * inverseDirection.x;
+			const float y1 = (node.minY[i] - origin.y) * inverseDirection.y;
+			const float y2 = (node.maxY[i] - origin.y) * inverseDirection.y;
+			const float z1 = (node.minZ[i] - origin.z) * inverseDirection.z;
+			const float z2 = (node.maxZ[i] - origin.z) * inverseDirection.z;
+
+			entry[i] = max(max(min(x1, x2), min(y1, y2)), max(min(z1, z2), 0.0f));
+			const float farthest = min(min(max(x1, x2), max(y1, y2)), min(max(z1, z2), maxDistance));
+			if (entry[i] <= farthest)
+				mask |= 1 << i;
+		}
+		return mask;
+#endif
+	}
+}
+
+void Bvh::build(const vector<vec3>& vertices)
+{
+	mNodes.clear();
+	mTriangles.clear();
+
+	const size_t count = vertices.size() / 3;
+	vector<BuildItem> items(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const vec3& a = vertices[i * 3];
+		const vec3& b = vertices[i * 3 + 1];
+		const vec3& c = vertices[i * 3 + 2];
+
+		items[i].boundsMin = min(a, min(b, c));
+		items[i].boundsMax = max(a, max(b, c));
+		items[i].centroid = (a + b + c) / 3.0f;
+		items[i].id = static_cast<uint32_t>(i);
+	}
+
+	mTriangles.reserve(count);
+	buildNode(items, 0, count);
+
+	for (Triangle& triangle : mTriangles)
+	{
+		const vec3& a = vertices[triangle.id * 3];
+		triangle.origin = a;
+		triangle.edge1 = vertices[triangle.id * 3 + 1] - a;
+		triangle.edge2 = vertices[triangle.id * 3 + 2] - a;
+	}
+}
+
+int32_t Bvh::buildNode(vector<BuildItem>& items, size_t begin, size_t end)
+{
+	// Empty Slots are a Point at FLT_MAX, which No Ray Reaches Within its maxDistance
+	// -------------------------------------------------------------------------------
+	Node node;
+	for (int i = 0; i < WIDTH; ++i)
+	{
+		node.minX[i] = node.minY[i] = node.minZ[i] = FLT_MAX;
+		node.maxX[i] = node.maxY[i] = node.maxZ[i] = FLT_MAX;
+		node.child[i] = -1;
+		node.count[i] = 0;
+	}
+
+	const int32_t index = static_cast<int32_t>(mNodes.size());
+	mNodes.push_back(node);
+
+	// Halve the Range at the Centroid Median of its Longest Axis, then Halve Both Halves
+	// ---------------------------------------------------------------------------------
+	size_t ranges[WIDTH][2] = { { begin, end } };
+	int rangeCount = 1;
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		const int previousCount = rangeCount;
+		for (int r = 0; r < previousCount; ++r)
+		{
+			const size_t rangeBegin = ranges[r][0];
+			const size_t rangeEnd = ranges[r][1];
+			if (rangeEnd - rangeBegin <= LEAF_SIZE)
+				continue;
+
+			vec3 centroidMin(FLT_MAX), centroidMax(-FLT_MAX);
+			for (size_t i = rangeBegin; i < rangeEnd; ++i)
+			{
+				centroidMin = min(centroidMin, items[i].centroid);
+				centroidMax = max(centroidMax, items[i].centroid);
+			}
+
+			const vec3 extent = centroidMax - centroidMin;
+			const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+			const size_t middle = rangeBegin + (rangeEnd - rangeBegin) / 2;
+			nth_element(items.begin() + rangeBegin, items.begin() + middle, items.begin() + rangeEnd,
+				[axis](const BuildItem& a, const BuildItem& b) { return a.centroid[axis] < b.centroid[axis]; });
+
+			ranges[r][1] = middle;
+			ranges[rangeCount][0] = middle;
+			ranges[rangeCount][1] = rangeEnd;
+			++rangeCount;
+		}
+	}
+
+	// Small Ranges Become Leaves, the Rest Child Nodes; mNodes Grows, so Write by Index
+	// --------------------------------------------------------------------------------
+	for (int slot = 0; slot < rangeCount; ++slot)
+	{
+		const size_t rangeBegin = ranges[slot][0];
+		const size_t rangeEnd = ranges[slot][1];
+		if (rangeBegin == rangeEnd)
+			continue;
+
+		vec3 boundsMin(FLT_MAX), boundsMax(-FLT_MAX);
+		for (size_t i = rangeBegin; i < rangeEnd; ++i)
+		{
+			boundsMin = min(boundsMin, items[i].boundsMin);
+			boundsMax = max(boundsMax, items[i].boundsMax);
+		}
+
+		int32_t child;
+		uint32_t count = 0;
+		if (rangeEnd - rangeBegin <= LEAF_SIZE)
+		{
+			child = static_cast<int32_t>(mTriangles.size());
+			count = static_cast<uint32_t>(rangeEnd - rangeBegin);
+			for (size_t i = rangeBegin; i < rangeEnd; ++i)
+				mTriangles.push_back({ vec3(0.0f), vec3(0.0f), vec3(0.0f), items[i].id });
+		}
+		else
+			child = buildNode(items, rangeBegin, rangeEnd);
+
+		Node& target = mNodes[index];
+		target.minX[slot] = boundsMin.x;
+		target.minY[slot] = boundsMin.y;
+		target.minZ[slot] = boundsMin.z;
+		target.maxX[slot] = boundsMax.x;
+		target.maxY[slot] = boundsMax.y;
+		target.maxZ[slot] = boundsMax.z;
+		target.child[slot] = child;
+		target.count[slot] = count;
+	}
+
+	return index;
+}
+
+bool Bvh::intersect(const vec3& origin, const vec3& direction, float maxDistance, Hit& hit) const
+{
+	return trace<false>(origin, direction, maxDistance, hit);
+}
+
+bool Bvh::occluded(const vec3& origin, const vec3& direction, float maxDistance) const
+{
+	Hit hit;
+	return trace<true>(origin, direction, maxDistance, hit);
+}
+
+template <bool AnyHit>
+bool Bvh::trace(const vec3& origin, const vec3& direction, float maxDistance, Hit& hit) const
+{
+	if (mNodes.empty())
+		return false;
+
+	vec3 inverseDirection;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		const float component = fabs(direction[axis]) < MIN_DIRECTION ? copysign(MIN_DIRECTION, direction[axis]) : direction[axis];
+		inverseDirection[axis] = 1.0f / component;
+	}
+
+	float closest = maxDistance;
+	bool found = false;
+
+	int32_t stack[STACK_SIZE];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		const Node& node = mNodes[stack[--stackSize]];
+
+		float entry[WIDTH];
+		const int mask = intersectChildren(node, origin, inverseDirection, closest, entry);
+		if (!mask)
+			continue;
+
+		// Entered Children, Nearest First
+		// -------------------------------
+		int order[WIDTH];
+		int orderCount = 0;
+		for (int i = 0; i < WIDTH; ++i)
+		{
+			if (!(mask & (1 << i)))
+				continue;
+
+			int position = orderCount++;
+			for (; position > 0 && entry[order[position - 1]] > entry[i]; --position)
+				order[position] = order[position - 1];
+			order[position] = i;
+		}
+
+		// Leaves Now, Nearest First, so the Hit Distance Shrinks Before Inner Nodes are Queued
+		// -----------------------------------------------------------------------------------
+		for (int k = 0; k < orderCount; ++k)
+		{
+			const int slot = order[k];
+			if (node.count[slot] == 0 || entry[slot] > closest)
+				continue;
+
+			const uint32_t first = static_cast<uint32_t>(node.child[slot]);
+			for (uint32_t t = first; t < first + node.count[slot]; ++t)
+			{
+				// Moller-Trumbore, Two-Sided
+				// --------------------------
+				const Triangle& triangle = mTriangles[t];
+				const vec3 p = cross(direction, triangle.edge2);
+				const float determinant = dot(triangle.edge1, p);
+				if (fabs(determinant) < PARALLEL_EPSILON)
+					continue;
+
+				const float inverseDeterminant = 1.0f / determinant;
+				const vec3 s = origin - triangle.origin;
+				const float u = dot(s, p) * inverseDeterminant;
+				if (u < 0.0f || u > 1.0f)
+					continue;
+
+				const vec3 q = cross(s, triangle.edge1);
+				const float v = dot(direction, q) * inverseDeterminant;
+				if (v < 0.0f || u + v > 1.0f)
+					continue;
+
+				const float distance = dot(triangle.edge2, q) * inverseDeterminant;
+				if (distance <= 0.0f || distance >= closest)
+					continue;
+
+				if (AnyHit)
+					return true;
+
+				closest = distance;
+				found = true;
+				hit.distance = distance;
+				hit.triangle = triangle.id;
+				hit.u = u;
+				hit.v = v;
+			}
+		}
+
+		// Inner Nodes Pushed Farthest First, so the Nearest is Popped Next
+		// ----------------------------------------------------------------
+		for (int k = orderCount - 1; k >= 0; --k)
+		{
+			const int slot = order[k];
+			if (node.count[slot] == 0 && node.child[slot] >= 0 && entry[slot] <= closest && stackSize < STACK_SIZE)
+				stack[stackSize++] = node.child[slot];
+		}
+	}
+
+	return found;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <cstdint>        // uint32_t
+#include <vector>         // vector
+#include <glm/glm.hpp>
+
+// Four-Wide Bounding Volume Hierarchy for Ray Queries Against Static Triangles
+// ----------------------------------------------------------------------------
+// Every node holds the bounds of up to four children in structure-of-arrays form, so one
+// SSE slab test clips a ray against all four boxes at once; leaves hold up to LEAF_SIZE
+// triangles, tested one by one. The tree is built by splitting each range at the centroid
+// median of its longest axis twice, giving four children per level. Queries only read the
+// tree, so any number of threads can trace it at once.
+class Bvh
+{
+public:
+	static const int WIDTH = 4;
+	static const size_t LEAF_SIZE = 4;
+
+	struct Hit
+	{
+		float distance = 0.0f;
+		uint32_t triangle = 0;   // Index into the Triangles Given to build()
+		float u = 0.0f;          // Barycentric Weights of the Second and Third Vertex
+		float v = 0.0f;
+	};
+
+	// Three Vertices per Triangle, in World Space
+	// -------------------------------------------
+	void build(const std::vector<glm::vec3>& vertices);
+
+	// Closest Hit Along the Ray Before maxDistance
+	// --------------------------------------------
+	bool intersect(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Hit& hit) const;
+
+	// Whether Anything Lies Along the Ray Before maxDistance; Stops at the First Hit
+	// ------------------------------------------------------------------------------
+	bool occluded(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
+
+	size_t triangleCount() const { return mTriangles.size(); }
+	size_t nodeCount() const { return mNodes.size(); }
+
+private:
+	// Child Slots: count 0 is an Inner Node (child is its Index) or an Empty Slot (child -1);
+	// Otherwise a Leaf of count Triangles Starting at child
+	// --------------------------------------------------------------------------------------
+	struct Node
+	{
+		float minX[WIDTH], minY[WIDTH], minZ[WIDTH];
+		float maxX[WIDTH], maxY[WIDTH], maxZ[WIDTH];
+		int32_t child[WIDTH];
+		uint32_t count[WIDTH];
+	};
+
+	// First Vertex and Two Edges, Ready for the Moller-Trumbore Test
+	// --------------------------------------------------------------
+	struct Triangle
+	{
+		glm::vec3 origin;
+		glm::vec3 edge1;
+		glm::vec3 edge2;
+		uint32_t id;
+	};
+
+	struct BuildItem
+	{
+		glm::vec3 boundsMin;
+		glm::vec3 boundsMax;
+		glm::vec3 centroid;
+		uint32_t id;
+	};
+
+	int32_t buildNode(std::vector<BuildItem>& items, size_t begin, size_t end);
+	template <bool AnyHit>
+	bool trace(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Hit& hit) const;
+
+	std::vector<Node> mNodes;
+	std::vector<Triangle> mTriangles;   // Leaf Order
+};
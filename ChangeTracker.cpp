@@ -0,0 +1,42 @@
+#include "ChangeTracker.h"
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	// FNV-1a, 64-Bit
+	// --------------
+	const uint64_t FNV_OFFSET = 14695981039346656037ull;
+	const uint64_t FNV_PRIME = 1099511628211ull;
+}
+
+void ChangeTracker::beginState()
+{
+	mHash = FNV_OFFSET;
+}
+
+void ChangeTracker::track(const void* data, size_t size)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < size; ++i)
+		mHash = (mHash ^ bytes[i]) * FNV_PRIME;
+}
+
+bool ChangeTracker::shouldRender()
+{
+	if (mRedrawRequested || mHash != mRenderedHash)
+		mSettleFrames = SETTLE_FRAMES + 1;
+
+	mRedrawRequested = false;
+	mRenderedHash = mHash;
+
+	if (mSettleFrames > 0)
+	{
+		--mSettleFrames;
+		++mRenderedFrames;
+		return true;
+	}
+
+	++mSkippedFrames;
+	return false;
+}
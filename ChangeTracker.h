@@ -0,0 +1,46 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <cstdint>        // uint64_t
+
+// Change Tracking for On-Demand Rendering
+// ---------------------------------------
+// Each loop iteration the caller hashes everything a frame is drawn from (camera, window
+// size, render state, lights, object transforms or their version counters) between
+// beginState() and shouldRender(). A frame is only needed when the hash differs from the
+// one the last frame was rendered with, when something asked for a redraw (the window was
+// exposed, a subsystem is still converging), or for SETTLE_FRAMES after either, which lets
+// work that lags the frame it was issued in (timer queries, streaming feedback readbacks,
+// resolution scaling) catch up before the loop goes idle.
+class ChangeTracker
+{
+public:
+	static const int SETTLE_FRAMES = 8;
+
+	void beginState();
+	void track(const void* data, size_t size);
+
+	template <typename T>
+	void track(const T& value) { track(&value, sizeof(value)); }
+
+	// Render the Next Frame whatever the State
+	// ----------------------------------------
+	void requestRedraw() { mRedrawRequested = true; }
+
+	// Whether this Iteration Needs a Frame; Counts it as Rendered or Skipped
+	// ----------------------------------------------------------------------
+	bool shouldRender();
+
+	size_t renderedFrameCount() const { return mRenderedFrames; }
+	size_t skippedFrameCount() const { return mSkippedFrames; }
+
+private:
+	uint64_t mHash = 0;
+	uint64_t mRenderedHash = 0;
+	bool mRedrawRequested = true;   // The First Frame Always Renders
+	int mSettleFrames = 0;
+	size_t mRenderedFrames = 0;
+	size_t mSkippedFrames = 0;
+};
@@ -0,0 +1,214 @@
+#include "ClusteredLighting.h"
+
+#include <algorithm>   // min, max
+#include <cmath>       // pow, log
+#include <cstring>     // memcpy
+
+#include "JobSystem.h"
+#include "ShaderUniforms.h"
+
+using namespace std;
+using namespace glm;
+
+// Size the Per-Frame Work Arrays
+// ------------------------------
+void ClusteredLighting::create(const RenderBackend& backend)
+{
+	mStorageAlignment = max<size_t>(backend.storageBufferAlignment(), 16);
+
+	mClusterBounds.resize(CLUSTER_COUNT);
+	mClusters.resize(CLUSTER_COUNT);
+	mSliceCandidates.resize(GRID_Z);
+	mSliceIndices.resize(GRID_Z);
+}
+
+// View-Space Depth of the Near Side of a Slice
+// --------------------------------------------
+float ClusteredLighting::sliceDepth(unsigned slice) const
+{
+	float t = static_cast<float>(slice) / GRID_Z;
+
+	if (mPerspective)
+		return mNear * pow(mFar / mNear, t);
+
+	return mNear + (mFar - mNear) * t;
+}
+
+// Cluster AABBs in View Space from the Inverse Projection
+// -------------------------------------------------------
+void ClusteredLighting::buildClusterBounds(const mat4& projection, float nearPlane, float farPlane)
+{
+	mBoundsProjection = projection;
+	mPerspective = projection[3][3] == 0.0f;
+	mNear = nearPlane;
+	mFar = farPlane;
+
+	mat4 inverseProjection = inverse(projection);
+
+	for (unsigned y = 0; y < GRID_Y; ++y)
+	{
+		for (unsigned x = 0; x < GRID_X; ++x)
+		{
+			// Tile Corners on the Near Plane
+			// ------------------------------
+			vec3 corners[4];
+			for (int c = 0; c < 4; ++c)
+			{
+				float ndcX = -1.0f + 2.0f * (x + (c & 1)) / GRID_X;
+				float ndcY = -1.0f + 2.0f * (y + (c >> 1)) / GRID_Y;
+				vec4 point = inverseProjection * vec4(ndcX, ndcY, -1.0f, 1.0f);
+				corners[c] = vec3(point) / point.w;
+			}
+
+			for (unsigned z = 0; z < GRID_Z; ++z)
+			{
+				float depths[2] = { sliceDepth(z), sliceDepth(z + 1) };
+
+				ClusterBounds& bounds = mClusterBounds[(z * GRID_Y + y) * GRID_X + x];
+				bounds.min = vec3(1e30f);
+				bounds.max = vec3(-1e30f);
+
+				// Perspective Tiles Widen with Depth; Orthographic Tiles do Not
+				// -------------------------------------------------------------
+				for (float depth : depths)
+				{
+					for (const vec3& corner : corners)
+					{
+						vec3 point = mPerspective ? corner * (depth / -corner.z) : vec3(corner.x, corner.y, -depth);
+						bounds.min = glm::min(bounds.min, point);
+						bounds.max = glm::max(bounds.max, point);
+					}
+				}
+			}
+		}
+	}
+}
+
+void ClusteredLighting::update(JobSystem& jobs, StreamBuffer& stream, const vector<PointLight>& lights, const mat4& view,
+	const mat4& projection, float nearPlane, float farPlane, int viewportWidth, int viewportHeight)
+{
+	mViewportWidth = viewportWidth;
+	mViewportHeight = viewportHeight;
+	mLightCount = static_cast<GLuint>(lights.size());
+
+	if (projection != mBoundsProjection || nearPlane != mNear || farPlane != mFar)
+		buildClusterBounds(projection, nearPlane, farPlane);
+
+	// Lights in View Space for Culling; the GPU Copy is Written Straight to the Stream
+	// --------------------------------------------------------------------------------
+	mAllocations[0] = stream.allocate(max<size_t>(1, lights.size()) * sizeof(GpuPointLight), mStorageAlignment);
+	GpuPointLight* gpuLights = mAllocations[0].data<GpuPointLight>();
+
+	mViewSpaceLights.resize(lights.size());
+	for (size_t i = 0; i < lights.size(); ++i)
+	{
+		const PointLight& light = lights[i];
+		mViewSpaceLights[i] = vec4(vec3(view * vec4(light.position, 1.0f)), light.radius);
+		gpuLights[i].positionRadius = vec4(light.position, light.radius);
+		gpuLights[i].colorIntensity = vec4(light.color, light.intensity);
+	}
+
+	// Each Slice is Assigned Independently, so Slices Become Jobs
+	// -----------------------------------------------------------
+	jobs.parallelFor(GRID_Z, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t z = begin; z < end; ++z)
+		{
+			float sliceNear = sliceDepth(static_cast<unsigned>(z));
+			float sliceFar = sliceDepth(static_cast<unsigned>(z) + 1);
+
+			vector<uint32_t>& candidates = mSliceCandidates[z];
+			candidates.clear();
+			for (uint32_t i = 0; i < mViewSpaceLights.size(); ++i)
+			{
+				float depth = -mViewSpaceLights[i].z;
+				float radius = mViewSpaceLights[i].w;
+				if (depth + radius >= sliceNear && depth - radius <= sliceFar)
+					candidates.push_back(i);
+			}
+
+			vector<uint32_t>& indices = mSliceIndices[z];
+			indices.clear();
+			for (unsigned tile = 0; tile < GRID_X * GRID_Y; ++tile)
+			{
+				size_t cluster = z * GRID_X * GRID_Y + tile;
+				const ClusterBounds& bounds = mClusterBounds[cluster];
+				uint32_t offset = static_cast<uint32_t>(indices.size());
+
+				// Sphere Against Cluster AABB
+				// ---------------------------
+				for (uint32_t i : candidates)
+				{
+					vec3 center = vec3(mViewSpaceLights[i]);
+					vec3 closest = glm::clamp(center, bounds.min, bounds.max);
+					vec3 delta = center - closest;
+					float radius = mViewSpaceLights[i].w;
+
+					if (dot(delta, delta) <= radius * radius)
+					{
+						indices.push_back(i);
+						if (indices.size() - offset == MAX_LIGHTS_PER_CLUSTER)
+							break;
+					}
+				}
+
+				mClusters[cluster] = uvec2(offset, static_cast<uint32_t>(indices.size()) - offset);
+			}
+		}
+	});
+
+	// Concatenate the Slice Lists and Rebase the Cluster Offsets, Writing Only to Mapped Memory
+	// -----------------------------------------------------------------------------------------
+	mAssignedLightCount = 0;
+	for (const vector<uint32_t>& indices : mSliceIndices)
+		mAssignedLightCount += indices.size();
+
+	// Empty Ranges Still Need Storage to be Bound
+	// -------------------------------------------
+	mAllocations[1] = stream.allocate(CLUSTER_COUNT * sizeof(uvec2), mStorageAlignment);
+	mAllocations[2] = stream.allocate(max<size_t>(1, mAssignedLightCount) * sizeof(uint32_t), mStorageAlignment);
+	uvec2* clusters = mAllocations[1].data<uvec2>();
+	uint32_t* lightIndices = mAllocations[2].data<uint32_t>();
+
+	uint32_t base = 0;
+	for (unsigned z = 0; z < GRID_Z; ++z)
+	{
+		const vector<uint32_t>& indices = mSliceIndices[z];
+		if (!indices.empty())
+			memcpy(lightIndices + base, indices.data(), indices.size() * sizeof(uint32_t));
+
+		for (unsigned tile = 0; tile < GRID_X * GRID_Y; ++tile)
+		{
+			size_t cluster = z * GRID_X * GRID_Y + tile;
+			clusters[cluster] = uvec2(mClusters[cluster].x + base, mClusters[cluster].y);
+		}
+
+		base += static_cast<uint32_t>(indices.size());
+	}
+}
+
+void ClusteredLighting::bind(CommandList& commands) const
+{
+	const GLuint bindings[3] = { LIGHT_BINDING, CLUSTER_BINDING, LIGHT_INDEX_BINDING };
+	for (int i = 0; i < 3; ++i)
+		commands.bindStorageBuffer(bindings[i], mAllocations[i].buffer, static_cast<uint32_t>(mAllocations[i].offset), static_cast<uint32_t>(mAllocations[i].size));
+
+	// Slice = log(depth) * scale + bias (Perspective) or depth * scale + bias (Orthographic)
+	// --------------------------------------------------------------------------------------
+	float scale, bias;
+	if (mPerspective)
+	{
+		scale = GRID_Z / log(mFar / mNear);
+		bias = -scale * log(mNear);
+	}
+	else
+	{
+		scale = GRID_Z / (mFar - mNear);
+		bias = -scale * mNear;
+	}
+
+	commands.setUniform(Uniform::ClusterGrid, uvec3(GRID_X, GRID_Y, GRID_Z));
+	commands.setUniform(Uniform::ClusterScreenSize, vec2(static_cast<float>(mViewportWidth), static_cast<float>(mViewportHeight)));
+	commands.setUniform(Uniform::ClusterDepth, vec3(scale, bias, mPerspective ? 1.0f : 0.0f));
+	commands.setUniform(Uniform::LightCount, static_cast<uint32_t>(mLightCount));
+}
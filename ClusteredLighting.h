@@ -0,0 +1,103 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstdint>        // uint32_t
+#include <vector>         // vector
+#include <GL/glew.h>      // GLEW library
+#include <glm/glm.hpp>
+
+#include "RenderBackend.h"
+#include "StreamBuffer.h"
+
+class JobSystem;
+
+// Dynamic Point Light
+// -------------------
+struct PointLight
+{
+	glm::vec3 position = glm::vec3(0.0f);
+	float radius = 20.0f;                    // Light has no Effect Past this Distance
+	glm::vec3 color = glm::vec3(1.0f);
+	float intensity = 1.0f;
+};
+
+// Clustered Forward Lighting
+// --------------------------
+// The view frustum is split into GRID_X * GRID_Y screen tiles and GRID_Z depth slices
+// (exponential for perspective projections, linear for orthographic ones). Every frame
+// the lights are assigned to the clusters they touch on the worker pool, and the light
+// list, per-cluster ranges and light index list are written straight into the frame's
+// StreamBuffer and bound as three SSBO ranges that clusteredLightingSource reads, so each
+// fragment only loops over its own cluster's lights. Passes the grid was not built for read
+// the whole light list through the lightCount uniform instead.
+class ClusteredLighting
+{
+public:
+	static const unsigned GRID_X = 16;
+	static const unsigned GRID_Y = 9;
+	static const unsigned GRID_Z = 24;
+	static const unsigned CLUSTER_COUNT = GRID_X * GRID_Y * GRID_Z;
+	static const unsigned MAX_LIGHTS_PER_CLUSTER = 256;
+
+	// Shader Storage Buffer Binding Points Used by clusteredLightingSource
+	// --------------------------------------------------------------------
+	static const GLuint LIGHT_BINDING = 0;
+	static const GLuint CLUSTER_BINDING = 1;
+	static const GLuint LIGHT_INDEX_BINDING = 2;
+
+	void create(const RenderBackend& backend);
+
+	// Assign Lights to Clusters and Write the Result into this Frame's Stream Region
+	// ------------------------------------------------------------------------------
+	void update(JobSystem& jobs, StreamBuffer& stream, const std::vector<PointLight>& lights, const glm::mat4& view,
+		const glm::mat4& projection, float nearPlane, float farPlane, int viewportWidth, int viewportHeight);
+
+	// Record Binding the SSBO Ranges and Setting the Cluster Lookup Uniforms
+	// ----------------------------------------------------------------------
+	void bind(CommandList& commands) const;
+
+	size_t assignedLightCount() const { return mAssignedLightCount; }
+
+private:
+	struct ClusterBounds
+	{
+		glm::vec3 min;
+		glm::vec3 max;
+	};
+
+	// GPU Layout (std430)
+	// -------------------
+	struct GpuPointLight
+	{
+		glm::vec4 positionRadius;
+		glm::vec4 colorIntensity;
+	};
+
+	void buildClusterBounds(const glm::mat4& projection, float nearPlane, float farPlane);
+	float sliceDepth(unsigned slice) const;
+
+	// This Frame's Light, Cluster and Light Index Ranges in the Stream Buffer
+	// -----------------------------------------------------------------------
+	StreamBuffer::Allocation mAllocations[3];
+	size_t mStorageAlignment = 16;
+
+	// Cluster Geometry in View Space, Rebuilt only when the Projection Changes
+	// ------------------------------------------------------------------------
+	std::vector<ClusterBounds> mClusterBounds;
+	glm::mat4 mBoundsProjection = glm::mat4(0.0f);
+	bool mPerspective = true;
+	float mNear = 0.1f;
+	float mFar = 100.0f;
+	int mViewportWidth = 1;
+	int mViewportHeight = 1;
+	GLuint mLightCount = 0;
+
+	// Per-Frame Assignment Results
+	// ----------------------------
+	std::vector<glm::vec4> mViewSpaceLights;              // xyz = View Position, w = Radius
+	std::vector<std::vector<uint32_t>> mSliceCandidates;  // Lights Overlapping Each Depth Slice
+	std::vector<std::vector<uint32_t>> mSliceIndices;     // Light Indices Written by Each Slice
+	std::vector<glm::uvec2> mClusters;                    // Offset and Count into the Slice's Indices
+	size_t mAssignedLightCount = 0;
+};
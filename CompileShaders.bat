@@ -0,0 +1,38 @@
+@echo off
+rem Offline Shader Validation and SPIR-V Generation
+rem -----------------------------------------------
+rem Usage: CompileShaders.bat <Path to the Built Executable> [Output Directory]
+rem
+rem Exports every GLSL() source with --export-shaders, validates each stage with
+rem glslangValidator (Vulkan SDK, on the PATH) and writes <stage>.spv next to it in
+rem OpenGL SPIR-V form for ARB_gl_spirv, plus <stage>.vk.spv in Vulkan SPIR-V form
+rem for --backend vulkan, with the loose uniforms gathered into one default uniform
+rem block (-R). Uniforms and varyings without explicit locations are assigned
+rem automatically. Exits non-zero if any stage fails.
+
+setlocal enabledelayedexpansion
+
+if "%~1"=="" (
+	echo Usage: CompileShaders.bat ^<Path to the Built Executable^> [Output Directory]
+	exit /b 1
+)
+
+set OUTPUT=%~2
+if "%OUTPUT%"=="" set OUTPUT=shaders
+
+"%~1" --export-shaders "%OUTPUT%" || exit /b 1
+
+set FAILED=0
+for %%F in ("%OUTPUT%\*.vert" "%OUTPUT%\*.frag") do (
+	glslangValidator -G --auto-map-locations --auto-map-bindings -o "%%F.spv" "%%F"
+	if errorlevel 1 set FAILED=1
+	glslangValidator -V -R --auto-map-locations --auto-map-bindings -o "%%F.vk.spv" "%%F"
+	if errorlevel 1 set FAILED=1
+)
+
+if !FAILED! neq 0 (
+	echo ERROR::SHADER::OFFLINE_VALIDATION_FAILED
+	exit /b 1
+)
+
+echo Shaders Validated and Compiled to SPIR-V in %OUTPUT%
@@ -0,0 +1,398 @@
+#include "DebugDraw.h"
+
+#include <cmath>       // cos, sin
+#include <cstddef>     // offsetof
+#include <cstring>     // memcpy
+
+#include "ShaderUniforms.h"
+#include "StreamBuffer.h"
+
+using namespace std;
+using namespace glm;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	// The Atlas Holds Printable ASCII in a 16x6 Grid, One Empty Texel Around Each Glyph
+	// ---------------------------------------------------------------------------------
+	const int FIRST_GLYPH = 32;
+	const int GLYPH_COUNT = 95;
+	const int ATLAS_COLUMNS = 16;
+	const int ATLAS_ROWS = 6;
+	const int CELL_WIDTH = DebugDraw::GLYPH_WIDTH + 1;
+	const int CELL_HEIGHT = DebugDraw::GLYPH_HEIGHT + 1;
+	const int ATLAS_WIDTH = ATLAS_COLUMNS * CELL_WIDTH;
+	const int ATLAS_HEIGHT = ATLAS_ROWS * CELL_HEIGHT;
+	const GLint GLYPH_UNIT = 0;
+
+	// 5x7 Glyphs from Space to Tilde, One Byte per Row from the Top, Bit 4 the Leftmost Column
+	// ----------------------------------------------------------------------------------------
+	const unsigned char GLYPH_ROWS[GLYPH_COUNT][DebugDraw::GLYPH_HEIGHT] =
+	{
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // Space
+		{ 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 },   // !
+		{ 0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00 },   // "
+		{ 0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A },   // #
+		{ 0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04 },   // $
+		{ 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 },   // %
+		{ 0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D },   // &
+		{ 0x04, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00 },   // '
+		{ 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 },   // (
+		{ 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 },   // )
+		{ 0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00 },   // *
+		{ 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00 },   // +
+		{ 0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08 },   // ,
+		{ 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 },   // -
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C },   // .
+		{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 },   // /
+		{ 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E },   // 0
+		{ 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E },   // 1
+		{ 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F },   // 2
+		{ 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E },   // 3
+		{ 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 },   // 4
+		{ 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E },   // 5
+		{ 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E },   // 6
+		{ 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 },   // 7
+		{ 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E },   // 8
+		{ 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C },   // 9
+		{ 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 },   // :
+		{ 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08 },   // ;
+		{ 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 },   // <
+		{ 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00 },   // =
+		{ 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 },   // >
+		{ 0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 },   // ?
+		{ 0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E },   // @
+		{ 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 },   // A
+		{ 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E },   // B
+		{ 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E },   // C
+		{ 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C },   // D
+		{ 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F },   // E
+		{ 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 },   // F
+		{ 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F },   // G
+		{ 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 },   // H
+		{ 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E },   // I
+		{ 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C },   // J
+		{ 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 },   // K
+		{ 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F },   // L
+		{ 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 },   // M
+		{ 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 },   // N
+		{ 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E },   // O
+		{ 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 },   // P
+		{ 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D },   // Q
+		{ 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 },   // R
+		{ 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E },   // S
+		{ 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 },   // T
+		{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E },   // U
+		{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 },   // V
+		{ 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A },   // W
+		{ 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 },   // X
+		{ 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 },   // Y
+		{ 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F },   // Z
+		{ 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E },   // [
+		{ 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 },   // Backslash
+		{ 0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E },   // ]
+		{ 0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00 },   // ^
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F },   // _
+		{ 0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00 },   // `
+		{ 0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F },   // a
+		{ 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E },   // b
+		{ 0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E },   // c
+		{ 0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F },   // d
+		{ 0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E },   // e
+		{ 0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08 },   // f
+		{ 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E },   // g
+		{ 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11 },   // h
+		{ 0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E },   // i
+		{ 0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C },   // j
+		{ 0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12 },   // k
+		{ 0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E },   // l
+		{ 0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11 },   // m
+		{ 0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11 },   // n
+		{ 0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E },   // o
+		{ 0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10 },   // p
+		{ 0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01 },   // q
+		{ 0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10 },   // r
+		{ 0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E },   // s
+		{ 0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06 },   // t
+		{ 0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D },   // u
+		{ 0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04 },   // v
+		{ 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A },   // w
+		{ 0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11 },   // x
+		{ 0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E },   // y
+		{ 0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F },   // z
+		{ 0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02 },   // {
+		{ 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 },   // |
+		{ 0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08 },   // }
+		{ 0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00 },   // ~
+	};
+}
+
+bool DebugDraw::create(RenderBackend& backend)
+{
+	mBackend = &backend;
+	for (int i = 0; i < SPHERE_SEGMENTS; ++i)
+	{
+		const float angle = two_pi<float>() * i / SPHERE_SEGMENTS;
+		mCircle[i] = vec2(cos(angle), sin(angle));
+	}
+
+	// Expand the Glyph Bits into the Atlas, Top Row of Each Glyph at the Top of its Cell
+	// ---------------------------------------------------------------------------------
+	vector<unsigned char> texels(ATLAS_WIDTH * ATLAS_HEIGHT, 0);
+	for (int g = 0; g < GLYPH_COUNT; ++g)
+	{
+		const int cellX = (g % ATLAS_COLUMNS) * CELL_WIDTH;
+		const int cellY = (g / ATLAS_COLUMNS) * CELL_HEIGHT;
+		for (int row = 0; row < GLYPH_HEIGHT; ++row)
+		{
+			for (int column = 0; column < GLYPH_WIDTH; ++column)
+			{
+				if (GLYPH_ROWS[g][row] & (1 << (GLYPH_WIDTH - 1 - column)))
+					texels[(cellY + row) * ATLAS_WIDTH + cellX + column] = 255;
+			}
+		}
+	}
+
+	TextureDesc atlas;
+	atlas.width = ATLAS_WIDTH;
+	atlas.height = ATLAS_HEIGHT;
+	atlas.format = TextureFormat::R8;
+	atlas.filter = TextureFilter::Nearest;
+	atlas.wrap = TextureWrap::ClampToEdge;
+	atlas.levels = 1;
+	mAtlas = mBackend->createTexture(atlas, nullptr);
+	if (!mAtlas)
+		return false;
+	mBackend->updateTexture(mAtlas, 0, texels.data());
+
+	// Vertex Formats Only; the Stream Buffer Range is Bound at Each flush()
+	// ---------------------------------------------------------------------
+	VertexLayout lineLayout;
+	lineLayout.attributes[0] = { 0, 3, offsetof(LineVertex, position) };
+	lineLayout.attributes[1] = { 1, 4, offsetof(LineVertex, color), true };
+	lineLayout.attributeCount = 2;
+	lineLayout.stride = sizeof(LineVertex);
+	mLineInput = backend.createVertexInput(lineLayout, 0, 0);
+
+	VertexLayout glyphLayout;
+	glyphLayout.attributes[0] = { 0, 2, offsetof(GlyphVertex, position) };
+	glyphLayout.attributes[1] = { 1, 4, offsetof(GlyphVertex, color), true };
+	glyphLayout.attributes[2] = { 2, 2, offsetof(GlyphVertex, coordinate) };
+	glyphLayout.attributeCount = 3;
+	glyphLayout.stride = sizeof(GlyphVertex);
+	mGlyphInput = backend.createVertexInput(glyphLayout, 0, 0);
+
+	return true;
+}
+
+void DebugDraw::destroy()
+{
+	if (mBackend)
+	{
+		mBackend->destroyTexture(mAtlas);
+		mBackend->destroyVertexInput(mLineInput);
+		mBackend->destroyVertexInput(mGlyphInput);
+		mBackend->destroyPipeline(mLinePipeline);
+		mBackend->destroyPipeline(mTextPipeline);
+	}
+	mAtlas = mLineInput = mGlyphInput = mLinePipeline = mTextPipeline = 0;
+	mLines.clear();
+	mGlyphs.clear();
+}
+
+void DebugDraw::line(const vec3& from, const vec3& to, const vec4& color)
+{
+	const uint32_t packed = packColor(color);
+	mLines.push_back({ from, packed });
+	mLines.push_back({ to, packed });
+}
+
+void DebugDraw::box(const vec3& boundsMin, const vec3& boundsMax, const vec4& color)
+{
+	vec3 corners[8];
+	for (int i = 0; i < 8; ++i)
+		corners[i] = vec3((i & 1) ? boundsMax.x : boundsMin.x, (i & 2) ? boundsMax.y : boundsMin.y, (i & 4) ? boundsMax.z : boundsMin.z);
+
+	// Each Edge Joins Two Corners Differing in One Bit
+	// ------------------------------------------------
+	for (int i = 0; i < 8; ++i)
+	{
+		for (int axis = 1; axis < 8; axis <<= 1)
+		{
+			if (!(i & axis))
+				line(corners[i], corners[i | axis], color);
+		}
+	}
+}
+
+void DebugDraw::sphere(const vec3& center, float radius, const vec4& color)
+{
+	const uint32_t packed = packColor(color);
+	for (int i = 0; i < SPHERE_SEGMENTS; ++i)
+	{
+		const vec2 a = mCircle[i] * radius;
+		const vec2 b = mCircle[(i + 1) % SPHERE_SEGMENTS] * radius;
+
+		mLines.push_back({ center + vec3(a.x, a.y, 0.0f), packed });
+		mLines.push_back({ center + vec3(b.x, b.y, 0.0f), packed });
+		mLines.push_back({ center + vec3(a.x, 0.0f, a.y), packed });
+		mLines.push_back({ center + vec3(b.x, 0.0f, b.y), packed });
+		mLines.push_back({ center + vec3(0.0f, a.x, a.y), packed });
+		mLines.push_back({ center + vec3(0.0f, b.x, b.y), packed });
+	}
+}
+
+void DebugDraw::frustum(const mat4& viewProjection, const vec4& color)
+{
+	const mat4 inverseViewProjection = inverse(viewProjection);
+
+	vec3 corners[8];
+	for (int i = 0; i < 8; ++i)
+	{
+		const vec4 corner = inverseViewProjection * vec4((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+		corners[i] = vec3(corner) / corner.w;
+	}
+
+	for (int i = 0; i < 8; ++i)
+	{
+		for (int axis = 1; axis < 8; axis <<= 1)
+		{
+			if (!(i & axis))
+				line(corners[i], corners[i | axis], color);
+		}
+	}
+}
+
+void DebugDraw::text(float x, float y, const char* string, const vec4& color)
+{
+	const uint32_t packed = packColor(color);
+	const uint32_t shadow = packColor(vec4(0.0f, 0.0f, 0.0f, color.a));
+
+	float penX = x;
+	for (const char* c = string; *c; ++c)
+	{
+		if (*c == '\n')
+		{
+			penX = x;
+			y += LINE_HEIGHT;
+			continue;
+		}
+
+		if (*c != ' ')
+		{
+			glyph(penX + GLYPH_SCALE, y + GLYPH_SCALE, *c, shadow);
+			glyph(penX, y, *c, packed);
+		}
+		penX += (GLYPH_WIDTH + 1) * GLYPH_SCALE;
+	}
+}
+
+// Two Triangles Covering the Glyph's Cell, Texel for Font Pixel
+// -------------------------------------------------------------
+void DebugDraw::glyph(float x, float y, char character, uint32_t color)
+{
+	int index = static_cast<unsigned char>(character) - FIRST_GLYPH;
+	if (index < 0 || index >= GLYPH_COUNT)
+		index = '?' - FIRST_GLYPH;
+
+	const vec2 atlasMin(static_cast<float>((index % ATLAS_COLUMNS) * CELL_WIDTH) / ATLAS_WIDTH,
+		static_cast<float>((index / ATLAS_COLUMNS) * CELL_HEIGHT) / ATLAS_HEIGHT);
+	const vec2 atlasMax = atlasMin + vec2(static_cast<float>(GLYPH_WIDTH) / ATLAS_WIDTH, static_cast<float>(GLYPH_HEIGHT) / ATLAS_HEIGHT);
+	const vec2 topLeft(x, y);
+	const vec2 bottomRight = topLeft + vec2(GLYPH_WIDTH * GLYPH_SCALE, GLYPH_HEIGHT * GLYPH_SCALE);
+
+	const GlyphVertex corners[4] =
+	{
+		{ topLeft, atlasMin, color },
+		{ vec2(bottomRight.x, topLeft.y), vec2(atlasMax.x, atlasMin.y), color },
+		{ bottomRight, atlasMax, color },
+		{ vec2(topLeft.x, bottomRight.y), vec2(atlasMin.x, atlasMax.y), color }
+	};
+
+	mGlyphs.push_back(corners[0]);
+	mGlyphs.push_back(corners[1]);
+	mGlyphs.push_back(corners[2]);
+	mGlyphs.push_back(corners[0]);
+	mGlyphs.push_back(corners[2]);
+	mGlyphs.push_back(corners[3]);
+}
+
+int DebugDraw::flush(StreamBuffer& stream, GLuint lineProgramID, GLuint textProgramID, const mat4& viewProjection, int width, int height)
+{
+	mFlushedLines = mLines.size() / 2;
+	mFlushedGlyphs = mGlyphs.size() / 6;
+
+	mCommands.reset();
+
+	// Every Line in One Call
+	// ----------------------
+	if (!mLines.empty() && lineProgramID)
+	{
+		const GLsizeiptr size = static_cast<GLsizeiptr>(mLines.size() * sizeof(LineVertex));
+		StreamBuffer::Allocation allocation = stream.allocate(size, sizeof(LineVertex));
+		if (allocation.pointer)
+		{
+			memcpy(allocation.pointer, mLines.data(), size);
+
+			mCommands.bindPipeline(overlayPipeline(mLinePipeline, lineProgramID, Topology::Lines));
+			mCommands.setUniform(Uniform::ViewProjection, viewProjection);
+			mCommands.bindVertexInput(mLineInput);
+			mCommands.bindVertexBuffer(allocation.buffer, static_cast<uint32_t>(allocation.offset));
+			mCommands.draw(static_cast<uint32_t>(mLines.size()));
+		}
+	}
+
+	// Every Glyph in One Call
+	// -----------------------
+	if (!mGlyphs.empty() && textProgramID)
+	{
+		const GLsizeiptr size = static_cast<GLsizeiptr>(mGlyphs.size() * sizeof(GlyphVertex));
+		StreamBuffer::Allocation allocation = stream.allocate(size, 4 * sizeof(GlyphVertex));
+		if (allocation.pointer)
+		{
+			memcpy(allocation.pointer, mGlyphs.data(), size);
+
+			mCommands.bindPipeline(overlayPipeline(mTextPipeline, textProgramID, Topology::Triangles));
+			mCommands.setUniform(Uniform::WindowSize, vec2(static_cast<float>(width), static_cast<float>(height)));
+			mCommands.setUniform(Uniform::GlyphAtlas, GLYPH_UNIT);
+			mCommands.bindTexture(GLYPH_UNIT, mAtlas);
+			mCommands.bindVertexInput(mGlyphInput);
+			mCommands.bindVertexBuffer(allocation.buffer, static_cast<uint32_t>(allocation.offset));
+			mCommands.draw(static_cast<uint32_t>(mGlyphs.size()));
+		}
+	}
+
+	mBackend->submit(&mCommands, 1);
+
+	mLines.clear();
+	mGlyphs.clear();
+	return static_cast<int>(mCommands.drawCount());
+}
+
+// Overlay State: No Depth Test, Alpha Blended and Filled in Wireframe Mode
+// ------------------------------------------------------------------------
+PipelineId DebugDraw::overlayPipeline(PipelineId& pipeline, GLuint programID, Topology topology)
+{
+	if (!pipeline)
+	{
+		PipelineDesc desc;
+		desc.program = programID;
+		desc.uniforms = Uniform::NAMES;
+		desc.uniformCount = Uniform::Count;
+		desc.topology = topology;
+		desc.depthTest = false;
+		desc.alphaBlend = true;
+		desc.alwaysFilled = true;
+		pipeline = mBackend->createPipeline(desc);
+	}
+
+	return pipeline;
+}
+
+uint32_t DebugDraw::packColor(const vec4& color)
+{
+	const vec4 scaled = clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+	return static_cast<uint32_t>(scaled.r) | (static_cast<uint32_t>(scaled.g) << 8)
+		| (static_cast<uint32_t>(scaled.b) << 16) | (static_cast<uint32_t>(scaled.a) << 24);
+}
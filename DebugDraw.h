@@ -0,0 +1,92 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <cstdint>        // uint32_t
+#include <vector>         // vector
+#include <GL/glew.h>      // GLEW library
+#include <glm/glm.hpp>
+
+#include "RenderBackend.h"
+
+class StreamBuffer;
+
+// Immediate-Mode Debug Overlay
+// ----------------------------
+// Anything may call line(), box(), sphere(), frustum() or text() during a frame. The calls
+// only append vertices to CPU arrays that keep their capacity, so steady-state frames do not
+// allocate. flush() copies both arrays into the frame's StreamBuffer region and records every
+// world-space line as one line draw and every glyph as one triangle draw, then empties the
+// arrays for the next frame. Both pipelines blend, ignore depth so bounds behind other
+// geometry stay visible, and stay filled in wireframe mode. Glyphs come from a built-in
+// 5x7 ASCII font in a small R8 atlas, and text is placed in window pixels from the top
+// left, each glyph over a one-pixel drop shadow.
+class DebugDraw
+{
+public:
+	static const int GLYPH_WIDTH = 5;
+	static const int GLYPH_HEIGHT = 7;
+	static const int GLYPH_SCALE = 2;                                  // Window Pixels per Font Pixel
+	static const int LINE_HEIGHT = (GLYPH_HEIGHT + 3) * GLYPH_SCALE;   // Window Pixels Between Text Rows
+	static const int SPHERE_SEGMENTS = 24;                             // Lines per Great Circle
+
+	bool create(RenderBackend& backend);
+	void destroy();
+
+	void line(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color);
+	void box(const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::vec4& color);
+
+	// Three Great Circles, One Around Each Axis
+	// -----------------------------------------
+	void sphere(const glm::vec3& center, float radius, const glm::vec4& color);
+
+	// The Twelve Edges of the Volume a View-Projection Matrix Clips To
+	// ----------------------------------------------------------------
+	void frustum(const glm::mat4& viewProjection, const glm::vec4& color);
+
+	// Window Pixels from the Top Left; '\n' Starts a New Row, Characters Outside ASCII Print as '?'
+	// ---------------------------------------------------------------------------------------------
+	void text(float x, float y, const char* string, const glm::vec4& color);
+
+	// Draws Everything Queued this Frame into the Current Backend Pass; Returns the Draw Calls Made
+	// ---------------------------------------------------------------------------------------------
+	int flush(StreamBuffer& stream, GLuint lineProgramID, GLuint textProgramID, const glm::mat4& viewProjection, int width, int height);
+
+	// What the Last flush() Drew
+	// --------------------------
+	size_t lineCount() const { return mFlushedLines; }
+	size_t glyphCount() const { return mFlushedGlyphs; }
+
+private:
+	struct LineVertex
+	{
+		glm::vec3 position;
+		uint32_t color;          // RGBA8
+	};
+
+	struct GlyphVertex
+	{
+		glm::vec2 position;      // Window Pixels
+		glm::vec2 coordinate;    // Atlas Texture Coordinate
+		uint32_t color;
+	};
+
+	static uint32_t packColor(const glm::vec4& color);
+	void glyph(float x, float y, char character, uint32_t color);
+	PipelineId overlayPipeline(PipelineId& pipeline, GLuint programID, Topology topology);
+
+	std::vector<LineVertex> mLines;
+	std::vector<GlyphVertex> mGlyphs;
+	glm::vec2 mCircle[SPHERE_SEGMENTS];   // Unit Circle, Filled by create()
+
+	RenderBackend* mBackend = nullptr;
+	VertexInputId mLineInput = 0;    // Vertex Formats Only; the Stream Buffer Range is Bound at Each flush()
+	VertexInputId mGlyphInput = 0;
+	PipelineId mLinePipeline = 0;    // Created the First Time their Programs are Ready
+	PipelineId mTextPipeline = 0;
+	CommandList mCommands;
+	TextureId mAtlas = 0;
+	size_t mFlushedLines = 0;
+	size_t mFlushedGlyphs = 0;
+};
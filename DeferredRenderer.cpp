@@ -0,0 +1,105 @@
+#include "DeferredRenderer.h"
+
+#include <iostream>   // cerr
+
+#include "ShaderUniforms.h"
+
+using namespace std;
+
+bool DeferredRenderer::create(RenderBackend& backend, int width, int height)
+{
+	mBackend = &backend;
+	mFullscreenInput = backend.createVertexInput(VertexLayout(), 0, 0);
+	return createTargets(width, height);
+}
+
+void DeferredRenderer::destroy()
+{
+	destroyTargets();
+	if (mBackend)
+		mBackend->destroyVertexInput(mFullscreenInput);
+	mFullscreenInput = 0;
+}
+
+// Albedo (RGBA8), World Normal (RGBA16F) and Depth (32F) Attachments
+// ------------------------------------------------------------------
+bool DeferredRenderer::createTargets(int width, int height)
+{
+	mWidth = width;
+	mHeight = height;
+
+	TextureId* textures[] = { &mAlbedo, &mNormal, &mDepth };
+	const TextureFormat formats[] = { TextureFormat::RGBA8, TextureFormat::RGBA16F, TextureFormat::Depth32F };
+
+	for (int i = 0; i < 3; ++i)
+	{
+		TextureDesc desc;
+		desc.width = width;
+		desc.height = height;
+		desc.format = formats[i];
+		desc.filter = TextureFilter::Nearest;
+		desc.wrap = TextureWrap::ClampToEdge;
+		desc.levels = 1;
+		desc.renderTarget = true;
+		*textures[i] = mBackend->createTexture(desc, nullptr);
+	}
+
+	// Error Check: G-Buffer Completeness
+	// ----------------------------------
+	const TextureId colors[] = { mAlbedo, mNormal };
+	mTarget = (mAlbedo && mNormal && mDepth) ? mBackend->createRenderTarget(colors, 2, mDepth) : 0;
+	if (!mTarget)
+	{
+		cerr << "ERROR::DEFERRED::GBUFFER_INCOMPLETE " << width << "x" << height << endl;
+		return false;
+	}
+
+	return true;
+}
+
+void DeferredRenderer::destroyTargets()
+{
+	if (mBackend)
+	{
+		mBackend->destroyRenderTarget(mTarget);
+		mBackend->destroyTexture(mAlbedo);
+		mBackend->destroyTexture(mNormal);
+		mBackend->destroyTexture(mDepth);
+	}
+	mTarget = mAlbedo = mNormal = mDepth = 0;
+}
+
+bool DeferredRenderer::beginGeometryPass(int width, int height, int viewportWidth, int viewportHeight)
+{
+	if (width != mWidth || height != mHeight)
+	{
+		destroyTargets();
+		if (!createTargets(width, height))
+			return false;
+	}
+
+	PassDesc pass;
+	pass.target = mTarget;
+	pass.width = viewportWidth;
+	pass.height = viewportHeight;
+	pass.clearColor = pass.clearDepth = true;
+	mBackend->beginPass(pass);
+
+	return true;
+}
+
+void DeferredRenderer::lightingPass(CommandList& commands) const
+{
+	commands.bindTexture(ALBEDO_UNIT, mAlbedo);
+	commands.bindTexture(NORMAL_UNIT, mNormal);
+	commands.bindTexture(DEPTH_UNIT, mDepth);
+
+	commands.setUniform(Uniform::GAlbedo, ALBEDO_UNIT);
+	commands.setUniform(Uniform::GNormal, NORMAL_UNIT);
+	commands.setUniform(Uniform::GDepth, DEPTH_UNIT);
+
+	// Full-Screen Triangle; the Pipeline's Depth Test Always Passes but Depth is Still Written
+	// ----------------------------------------------------------------------------------------
+	commands.bindVertexInput(mFullscreenInput);
+	commands.draw(3);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+// Includes
+// -------
+#include "RenderBackend.h"
+
+// Deferred Shading Path
+// ---------------------
+// The geometry pass writes albedo, world-space normal and depth to a G-buffer, then one
+// full-screen pass reconstructs each pixel's world position and shades it with the
+// clustered light lists, so lighting is evaluated once per visible pixel regardless of
+// overdraw. The light pass also writes the G-buffer depth into the default framebuffer so
+// forward-rendered objects (the lamps) still depth test against the scene.
+class DeferredRenderer
+{
+public:
+	// G-Buffer Texture Units Read by the Lighting Pass
+	// ------------------------------------------------
+	static const int32_t ALBEDO_UNIT = 0;
+	static const int32_t NORMAL_UNIT = 1;
+	static const int32_t DEPTH_UNIT = 2;
+
+	bool create(RenderBackend& backend, int width, int height);
+	void destroy();
+
+	// Begin a Backend Pass that Clears the G-Buffer, Resizing it to Match the Framebuffer;
+	// Drawing is Limited to the Lower-Left viewportWidth x viewportHeight Region for Dynamic
+	// Resolution. The Caller Ends the Pass
+	// --------------------------------------------------------------------------------------
+	bool beginGeometryPass(int width, int height, int viewportWidth, int viewportHeight);
+
+	// Record Shading Every Covered Pixel of the Pass's Viewport; the Lighting Pipeline is Bound
+	// -----------------------------------------------------------------------------------------
+	void lightingPass(CommandList& commands) const;
+
+private:
+	bool createTargets(int width, int height);
+	void destroyTargets();
+
+	RenderTargetId mTarget = 0;
+	TextureId mAlbedo = 0;
+	TextureId mNormal = 0;
+	TextureId mDepth = 0;
+	RenderBackend* mBackend = nullptr;
+	VertexInputId mFullscreenInput = 0;   // Attribute-Less; the Vertex Shader Makes the Triangle
+	int mWidth = 0;
+	int mHeight = 0;
+};
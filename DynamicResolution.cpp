@@ -0,0 +1,138 @@
+#include "DynamicResolution.h"
+
+#include <algorithm>   // min, max
+#include <cmath>       // sqrt, fabs, round, lround
+#include <iostream>    // cerr
+
+using namespace std;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	const float SCALE_RESPONSE = 0.25f;     // Fraction of the Error Corrected per Frame
+	const float SCALE_TOLERANCE = 0.02f;    // Errors Below this Leave the Scale Alone
+}
+
+bool DynamicResolution::create(RenderBackend& backend, float budgetMilliseconds)
+{
+	mBackend = &backend;
+	mBudget = budgetMilliseconds;
+	mScale = MAX_SCALE;
+	mFrame = 0;
+
+	for (TimestampId* timestamps : mTimestamps)
+	{
+		timestamps[0] = backend.createTimestamp();
+		timestamps[1] = backend.createTimestamp();
+	}
+	for (bool& issued : mQueryIssued)
+		issued = false;
+
+	return true;
+}
+
+void DynamicResolution::destroy()
+{
+	destroyTarget();
+	for (TimestampId* timestamps : mTimestamps)
+	{
+		if (mBackend)
+		{
+			mBackend->destroyTimestamp(timestamps[0]);
+			mBackend->destroyTimestamp(timestamps[1]);
+		}
+		timestamps[0] = timestamps[1] = 0;
+	}
+}
+
+// Color (RGBA8) and Depth (24-Bit) Textures the Size of the Window
+// ----------------------------------------------------------------
+bool DynamicResolution::createTarget(int width, int height)
+{
+	mTargetWidth = width;
+	mTargetHeight = height;
+
+	TextureDesc desc;
+	desc.width = width;
+	desc.height = height;
+	desc.wrap = TextureWrap::ClampToEdge;
+	desc.levels = 1;
+	desc.renderTarget = true;
+	mColor = mBackend->createTexture(desc, nullptr);
+
+	desc.format = TextureFormat::Depth24;
+	mDepth = mBackend->createTexture(desc, nullptr);
+
+	// Error Check: Target Completeness
+	// --------------------------------
+	mTarget = (mColor && mDepth) ? mBackend->createRenderTarget(&mColor, 1, mDepth) : 0;
+	if (!mTarget)
+	{
+		cerr << "ERROR::DYNAMIC_RESOLUTION::TARGET_INCOMPLETE " << width << "x" << height << endl;
+		destroyTarget();
+		return false;
+	}
+
+	return true;
+}
+
+void DynamicResolution::destroyTarget()
+{
+	if (mBackend)
+	{
+		mBackend->destroyRenderTarget(mTarget);
+		mBackend->destroyTexture(mColor);
+		mBackend->destroyTexture(mDepth);
+	}
+	mTarget = mColor = mDepth = 0;
+	mTargetWidth = mTargetHeight = 0;
+}
+
+void DynamicResolution::beginFrame(int windowWidth, int windowHeight)
+{
+	if (windowWidth != mTargetWidth || windowHeight != mTargetHeight)
+	{
+		destroyTarget();
+		if (windowWidth > 0 && windowHeight > 0)
+			createTarget(windowWidth, windowHeight);
+	}
+
+	// The Oldest Query Finished Frames Ago; Never Wait if the Driver Lags Further
+	// ---------------------------------------------------------------------------
+	const int slot = mFrame % QUERY_COUNT;
+	uint64_t begin = 0, end = 0;
+	if (mQueryIssued[slot] && mBackend->timestampResult(mTimestamps[slot][1], false, end))
+	{
+		mBackend->timestampResult(mTimestamps[slot][0], true, begin);
+		mGpuMilliseconds = static_cast<float>((end - begin) * 1e-6);
+
+		// Area, Not Width, Tracks Cost: Aim for the Scale Whose Area Fits the Budget
+		// --------------------------------------------------------------------------
+		if (mGpuMilliseconds > 0.0f)
+		{
+			float target = mScale * sqrt(mBudget / mGpuMilliseconds);
+			target = min(MAX_SCALE, max(MIN_SCALE, target));
+			if (fabs(target - mScale) > SCALE_TOLERANCE)
+				mScale += (target - mScale) * SCALE_RESPONSE;
+		}
+	}
+
+	const float steppedScale = round(mScale / SCALE_STEP) * SCALE_STEP;
+	mWidth = max(1, static_cast<int>(lround(mTargetWidth * steppedScale)));
+	mHeight = max(1, static_cast<int>(lround(mTargetHeight * steppedScale)));
+
+	mBackend->writeTimestamp(mTimestamps[slot][0]);
+	mQueryIssued[slot] = true;
+}
+
+void DynamicResolution::endFrame()
+{
+	mBackend->writeTimestamp(mTimestamps[mFrame % QUERY_COUNT][1]);
+	++mFrame;
+
+	// Bilinear Upscale of the Rendered Region to the Whole Window
+	// -----------------------------------------------------------
+	if (mTarget)
+		mBackend->blitRenderTarget(mTarget, mWidth, mHeight, 0, mTargetWidth, mTargetHeight);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+// Includes
+// -------
+#include "RenderBackend.h"
+
+// Dynamic Resolution Scaling to a GPU Frame-Time Budget
+// -----------------------------------------------------
+// The scene is rendered into an offscreen target the size of the window, but only into its
+// lower-left scale x scale region, so changing the scale never reallocates anything. Each
+// frame's GPU time is taken from two backend timestamps read QUERY_COUNT frames later, so
+// the CPU never waits on them. Pixel cost grows with area, so the scale is steered towards
+// scale * sqrt(budget / gpuTime), moving part of the way each frame and ignoring small
+// errors to avoid oscillating. The region is sized from the scale rounded to SCALE_STEP,
+// so pooled targets that follow it (post-processing) only ever see a handful of sizes.
+// endFrame() upscales the region to the window with a bilinear blit. The scale stays
+// between MIN_SCALE and MAX_SCALE on each axis.
+class DynamicResolution
+{
+public:
+	static constexpr float MIN_SCALE = 0.5f;
+	static constexpr float MAX_SCALE = 1.0f;
+	static constexpr float SCALE_STEP = 1.0f / 32.0f;
+	static const int QUERY_COUNT = 4;
+
+	bool create(RenderBackend& backend, float budgetMilliseconds);
+	void destroy();
+
+	// Start Timing the Frame and Pick its Scale from the Oldest Finished Measurement
+	// -----------------------------------------------------------------------------
+	void beginFrame(int windowWidth, int windowHeight);
+
+	// Stop Timing and Upscale the Rendered Region into the Window
+	// -----------------------------------------------------------
+	void endFrame();
+
+	// Size of the Scaled Region this Frame
+	// ------------------------------------
+	int width() const { return mWidth; }
+	int height() const { return mHeight; }
+	float scale() const { return mScale; }
+	RenderTargetId target() const { return mTarget; }
+
+	float budgetMilliseconds() const { return mBudget; }
+	float gpuMilliseconds() const { return mGpuMilliseconds; }   // Latest Measured Frame
+
+private:
+	bool createTarget(int width, int height);
+	void destroyTarget();
+
+	RenderBackend* mBackend = nullptr;
+	RenderTargetId mTarget = 0;
+	TextureId mColor = 0;        // Only Ever Blitted, Never Sampled
+	TextureId mDepth = 0;
+	int mTargetWidth = 0;        // Allocated Size, Follows the Window
+	int mTargetHeight = 0;
+	int mWidth = 0;
+	int mHeight = 0;
+
+	TimestampId mTimestamps[QUERY_COUNT][2] = {};   // Begin and End per Frame in Flight
+	bool mQueryIssued[QUERY_COUNT] = {};
+	int mFrame = 0;
+
+	float mBudget = 16.6f;
+	float mScale = MAX_SCALE;
+	float mGpuMilliseconds = 0.0f;
+};
@@ -0,0 +1,114 @@
+#include "FrameArena.h"
+
+#include <algorithm>   // max
+#include <atomic>      // atomic allocation counter
+#include <cstdlib>     // malloc, free
+
+using namespace std;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	size_t alignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+#ifdef _DEBUG
+	atomic<size_t> gHeapAllocations{ 0 };
+#endif
+}
+
+// Debug Builds Replace the Global Allocator to Count Every Heap Allocation
+// ------------------------------------------------------------------------
+#ifdef _DEBUG
+void* operator new(size_t size)
+{
+	gHeapAllocations.fetch_add(1, memory_order_relaxed);
+
+	if (void* pointer = malloc(size ? size : 1))
+		return pointer;
+	throw bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+	free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	free(pointer);
+}
+#endif
+
+size_t FrameArena::heapAllocationCount()
+{
+#ifdef _DEBUG
+	return gHeapAllocations.load(memory_order_relaxed);
+#else
+	return 0;
+#endif
+}
+
+bool FrameArena::create(size_t bytesPerFrame)
+{
+	for (vector<char>& block : mBlocks)
+		block.resize(bytesPerFrame);
+
+	mFrame = 0;
+	mHead = 0;
+	mFrameBytes = 0;
+	mHighWater = 0;
+
+	return true;
+}
+
+void FrameArena::destroy()
+{
+	for (int frame = 0; frame < FRAME_COUNT; ++frame)
+	{
+		vector<char>().swap(mBlocks[frame]);
+		vector<vector<char>>().swap(mOverflow[frame]);
+	}
+}
+
+void FrameArena::beginFrame()
+{
+	mHighWater = max(mHighWater, mFrameBytes);
+
+	mFrame = (mFrame + 1) % FRAME_COUNT;
+	mHead = 0;
+	mFrameBytes = 0;
+
+	// This Block's Last Frame Spilled: Grow Once so it Never Spills Again
+	// -------------------------------------------------------------------
+	if (!mOverflow[mFrame].empty())
+	{
+		mOverflow[mFrame].clear();
+		mBlocks[mFrame].resize(mHighWater);
+	}
+}
+
+void* FrameArena::allocateBytes(size_t size, size_t alignment)
+{
+	// Block Storage Comes from the Heap, so its Base is Aligned for Any Fundamental Type
+	// ----------------------------------------------------------------------------------
+	size_t offset = alignUp(mHead, alignment);
+	mFrameBytes += offset - mHead + size;
+
+	if (offset + size <= mBlocks[mFrame].size())
+	{
+		mHead = offset + size;
+		return mBlocks[mFrame].data() + offset;
+	}
+
+	// Overflow: a Heap Block Just for this Allocation, Padded for Alignment
+	// ---------------------------------------------------------------------
+	mOverflow[mFrame].emplace_back(size + alignment);
+	char* base = mOverflow[mFrame].back().data();
+	size_t padding = alignUp(reinterpret_cast<size_t>(base), alignment) - reinterpret_cast<size_t>(base);
+
+	return base + padding;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <new>            // placement new
+#include <type_traits>    // is_trivially_destructible
+#include <vector>         // vector
+
+// Per-Frame Linear Arena for Transient CPU Data
+// ---------------------------------------------
+// Render queues, culling lists and other data that only live for one frame are bump-
+// allocated out of a block that is reset wholesale by beginFrame(), so they cost a pointer
+// add instead of a heap allocation. There is one block per frame in flight (FRAME_COUNT,
+// matching StreamBuffer's regions), so data handed to the GPU or to jobs that finish in a
+// later frame is not overwritten until that block comes round again. A frame that outgrows
+// its block spills into heap overflow blocks; the block is then resized to the high-water
+// mark at its next reset, so steady-state frames make no heap allocations at all.
+class FrameArena
+{
+public:
+	static const int FRAME_COUNT = 3;
+
+	bool create(size_t bytesPerFrame);
+	void destroy();
+
+	// Reset the Next Frame's Block; Everything it Handed Out Before is Invalid
+	// ------------------------------------------------------------------------
+	void beginFrame();
+
+	// Typed Allocation of count Default-Initialized Values; Never Destroyed, so Trivial Only
+	// --------------------------------------------------------------------------------------
+	template <typename T>
+	T* alloc(size_t count)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "Frame arena values are never destroyed");
+
+		T* values = static_cast<T*>(allocateBytes(sizeof(T) * count, alignof(T)));
+		for (size_t i = 0; i < count; ++i)
+			new (values + i) T;
+
+		return values;
+	}
+
+	void* allocateBytes(size_t size, size_t alignment);
+
+	// Largest Number of Bytes Any Frame has Used; Blocks Grow to Fit it
+	// -----------------------------------------------------------------
+	size_t highWaterMark() const { return mHighWater; }
+	size_t capacity() const { return mBlocks[mFrame].size(); }
+
+	// Allocations that Missed the Block this Frame
+	// --------------------------------------------
+	size_t overflowCount() const { return mOverflow[mFrame].size(); }
+
+	// Heap Allocations Made Anywhere in the Process; Counted in Debug Builds Only
+	// ---------------------------------------------------------------------------
+	static size_t heapAllocationCount();
+
+private:
+	std::vector<char> mBlocks[FRAME_COUNT];
+	std::vector<std::vector<char>> mOverflow[FRAME_COUNT];   // Spill Blocks, Freed at the Frame's Next Reset
+	int mFrame = 0;
+	size_t mHead = 0;         // Bytes Used in the Current Block
+	size_t mFrameBytes = 0;   // Bytes Requested this Frame, Including Overflow
+	size_t mHighWater = 0;
+};
@@ -0,0 +1,671 @@
+#include "FrameCapture.h"
+
+#include <algorithm>    // min, max
+#include <chrono>       // steady_clock
+#include <cstdint>      // uint8_t, uint32_t
+#include <cstdio>       // snprintf
+#include <cstdlib>      // abs
+#include <cstring>      // strcmp, memcmp, memcpy
+#include <filesystem>   // create_directories
+#include <iostream>     // cerr
+#include <iterator>     // istreambuf_iterator
+
+using namespace std;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	const uint64_t FLUSH_TIMEOUT = 1000000000;   // Nanoseconds One Flushing Wait Gives a Readback
+
+	double secondsSince(chrono::steady_clock::time_point start)
+	{
+		return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	}
+
+	void writeBigEndian(vector<unsigned char>& out, uint32_t value)
+	{
+		out.push_back(static_cast<unsigned char>(value >> 24));
+		out.push_back(static_cast<unsigned char>(value >> 16));
+		out.push_back(static_cast<unsigned char>(value >> 8));
+		out.push_back(static_cast<unsigned char>(value));
+	}
+
+	uint32_t readBigEndian(const unsigned char* in)
+	{
+		return static_cast<uint32_t>(in[0]) << 24 | static_cast<uint32_t>(in[1]) << 16 | static_cast<uint32_t>(in[2]) << 8 | in[3];
+	}
+
+	// Row y Counted from the Top of the Image; the Readback Stores the Bottom Row First
+	// --------------------------------------------------------------------------------
+	const unsigned char* topDownRow(const unsigned char* pixels, int width, int height, int y)
+	{
+		return pixels + static_cast<size_t>(height - 1 - y) * width * 4;
+	}
+
+#pragma region PNG
+
+	uint32_t crc32(const unsigned char* data, size_t size, uint32_t crc = 0)
+	{
+		static uint32_t table[256];
+		static bool tableReady = false;
+		if (!tableReady)
+		{
+			for (uint32_t n = 0; n < 256; ++n)
+			{
+				uint32_t c = n;
+				for (int k = 0; k < 8; ++k)
+					c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+				table[n] = c;
+			}
+			tableReady = true;
+		}
+
+		crc = ~crc;
+		for (size_t i = 0; i < size; ++i)
+			crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+		return ~crc;
+	}
+
+	void writePngChunk(vector<unsigned char>& out, const char* type, const unsigned char* data, size_t size)
+	{
+		writeBigEndian(out, static_cast<uint32_t>(size));
+		const size_t start = out.size();
+		out.insert(out.end(), type, type + 4);
+		out.insert(out.end(), data, data + size);
+		writeBigEndian(out, crc32(out.data() + start, size + 4));
+	}
+
+	// 8-Bit RGB PNG; the zlib Stream Uses Stored (Uncompressed) Deflate Blocks, so Encoding
+	// Costs a Copy and Two Checksums Rather than a Compressor
+	// -------------------------------------------------------------------------------------
+	void encodePng(const unsigned char* pixels, int width, int height, vector<unsigned char>& out)
+	{
+		const size_t rowSize = static_cast<size_t>(width) * 3 + 1;   // Filter Byte (None), then RGB
+		vector<unsigned char> raw(rowSize * height);
+		for (int y = 0; y < height; ++y)
+		{
+			const unsigned char* source = topDownRow(pixels, width, height, y);
+			unsigned char* row = raw.data() + y * rowSize;
+			row[0] = 0;
+			for (int x = 0; x < width; ++x)
+				memcpy(row + 1 + x * 3, source + x * 4, 3);
+		}
+
+		vector<unsigned char> zlib = { 0x78, 0x01 };
+		const size_t MAX_STORED_BLOCK = 65535;
+		for (size_t offset = 0;; offset += MAX_STORED_BLOCK)
+		{
+			const size_t size = min(MAX_STORED_BLOCK, raw.size() - offset);
+			const bool last = offset + size >= raw.size();
+			zlib.push_back(last ? 1 : 0);
+			zlib.push_back(static_cast<unsigned char>(size));
+			zlib.push_back(static_cast<unsigned char>(size >> 8));
+			zlib.push_back(static_cast<unsigned char>(~size));
+			zlib.push_back(static_cast<unsigned char>(~size >> 8));
+			zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + size);
+			if (last)
+				break;
+		}
+
+		uint32_t a = 1, b = 0;   // Adler-32
+		for (unsigned char byte : raw)
+		{
+			a = (a + byte) % 65521;
+			b = (b + a) % 65521;
+		}
+		writeBigEndian(zlib, (b << 16) | a);
+
+		vector<unsigned char> header;
+		writeBigEndian(header, static_cast<uint32_t>(width));
+		writeBigEndian(header, static_cast<uint32_t>(height));
+		header.insert(header.end(), { 8, 2, 0, 0, 0 });   // 8 Bits, RGB, Deflate, No Filter Set, No Interlace
+
+		const unsigned char signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		out.assign(signature, signature + sizeof(signature));
+		writePngChunk(out, "IHDR", header.data(), header.size());
+		writePngChunk(out, "IDAT", zlib.data(), zlib.size());
+		writePngChunk(out, "IEND", nullptr, 0);
+	}
+
+#pragma endregion
+
+#pragma region QOI
+
+	// QOI ("Quite OK Image") RGB Encoder: Runs, a 64-Entry Color Index and Small Deltas
+	// ---------------------------------------------------------------------------------
+	void encodeQoi(const unsigned char* pixels, int width, int height, vector<unsigned char>& out)
+	{
+		out.clear();
+		out.insert(out.end(), { 'q', 'o', 'i', 'f' });
+		writeBigEndian(out, static_cast<uint32_t>(width));
+		writeBigEndian(out, static_cast<uint32_t>(height));
+		out.push_back(3);   // RGB
+		out.push_back(0);   // sRGB with Linear Alpha
+
+		uint8_t index[64][3] = {};
+		bool indexUsed[64] = {};
+		uint8_t previous[3] = { 0, 0, 0 };
+		int run = 0;
+
+		for (int y = 0; y < height; ++y)
+		{
+			const unsigned char* row = topDownRow(pixels, width, height, y);
+			for (int x = 0; x < width; ++x)
+			{
+				const uint8_t* pixel = row + x * 4;
+				const bool last = (y == height - 1 && x == width - 1);
+				if (pixel[0] == previous[0] && pixel[1] == previous[1] && pixel[2] == previous[2])
+				{
+					if (++run == 62 || last)
+					{
+						out.push_back(static_cast<unsigned char>(0xC0 | (run - 1)));
+						run = 0;
+					}
+					continue;
+				}
+
+				if (run > 0)
+				{
+					out.push_back(static_cast<unsigned char>(0xC0 | (run - 1)));
+					run = 0;
+				}
+
+				const int hash = (pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + 255 * 11) % 64;
+				if (indexUsed[hash] && index[hash][0] == pixel[0] && index[hash][1] == pixel[1] && index[hash][2] == pixel[2])
+					out.push_back(static_cast<unsigned char>(hash));
+				else
+				{
+					memcpy(index[hash], pixel, 3);
+					indexUsed[hash] = true;
+
+					const int dr = static_cast<int8_t>(pixel[0] - previous[0]);
+					const int dg = static_cast<int8_t>(pixel[1] - previous[1]);
+					const int db = static_cast<int8_t>(pixel[2] - previous[2]);
+					const int drg = dr - dg;
+					const int dbg = db - dg;
+					if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+						out.push_back(static_cast<unsigned char>(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+					else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7)
+					{
+						out.push_back(static_cast<unsigned char>(0x80 | (dg + 32)));
+						out.push_back(static_cast<unsigned char>((drg + 8) << 4 | (dbg + 8)));
+					}
+					else
+						out.insert(out.end(), { 0xFE, pixel[0], pixel[1], pixel[2] });
+				}
+
+				memcpy(previous, pixel, 3);
+			}
+		}
+
+		out.insert(out.end(), { 0, 0, 0, 0, 0, 0, 0, 1 });
+	}
+
+	// Decode a QOI File to Top-Down RGB Rows; Alpha is Dropped
+	// --------------------------------------------------------
+	bool decodeQoi(const vector<unsigned char>& in, int& width, int& height, vector<unsigned char>& out)
+	{
+		const size_t headerSize = 14;
+		if (in.size() < headerSize || memcmp(in.data(), "qoif", 4) != 0)
+			return false;
+
+		width = static_cast<int>(readBigEndian(in.data() + 4));
+		height = static_cast<int>(readBigEndian(in.data() + 8));
+		if (width <= 0 || height <= 0 || width > 16384 || height > 16384)
+			return false;
+
+		const size_t pixelCount = static_cast<size_t>(width) * height;
+		out.resize(pixelCount * 3);
+
+		uint8_t index[64][4] = {};
+		uint8_t pixel[4] = { 0, 0, 0, 255 };
+		size_t cursor = headerSize;
+		int run = 0;
+
+		for (size_t i = 0; i < pixelCount; ++i)
+		{
+			if (run > 0)
+				--run;
+			else
+			{
+				if (cursor >= in.size())
+					return false;
+
+				const uint8_t op = in[cursor++];
+				if (op == 0xFE || op == 0xFF)
+				{
+					const size_t channels = (op == 0xFE) ? 3 : 4;
+					if (cursor + channels > in.size())
+						return false;
+					memcpy(pixel, &in[cursor], channels);
+					cursor += channels;
+				}
+				else if ((op & 0xC0) == 0x00)
+					memcpy(pixel, index[op], 4);
+				else if ((op & 0xC0) == 0x40)
+				{
+					pixel[0] = static_cast<uint8_t>(pixel[0] + ((op >> 4) & 3) - 2);
+					pixel[1] = static_cast<uint8_t>(pixel[1] + ((op >> 2) & 3) - 2);
+					pixel[2] = static_cast<uint8_t>(pixel[2] + (op & 3) - 2);
+				}
+				else if ((op & 0xC0) == 0x80)
+				{
+					if (cursor >= in.size())
+						return false;
+					const int dg = (op & 0x3F) - 32;
+					const uint8_t second = in[cursor++];
+					pixel[0] = static_cast<uint8_t>(pixel[0] + dg - 8 + (second >> 4));
+					pixel[1] = static_cast<uint8_t>(pixel[1] + dg);
+					pixel[2] = static_cast<uint8_t>(pixel[2] + dg - 8 + (second & 0x0F));
+				}
+				else
+					run = op & 0x3F;
+
+				memcpy(index[(pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64], pixel, 4);
+			}
+
+			memcpy(&out[i * 3], pixel, 3);
+		}
+
+		return true;
+	}
+
+	bool readQoiFile(const string& path, int& width, int& height, vector<unsigned char>& pixels)
+	{
+		ifstream file(path, ios::binary);
+		if (!file)
+			return false;
+
+		const vector<unsigned char> data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+		return decodeQoi(data, width, height, pixels);
+	}
+
+	string frameFileName(size_t frame, const char* extension)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "/frame_%06zu.%s", frame, extension);
+		return name;
+	}
+
+#pragma endregion
+
+#pragma region Y4M
+
+	// One 4:2:0 Frame with Full-Range BT.601 Coefficients (Y4M "C420jpeg")
+	// --------------------------------------------------------------------
+	void encodeY4mFrame(const unsigned char* pixels, int width, int height, vector<unsigned char>& out)
+	{
+		const int chromaWidth = (width + 1) / 2;
+		const int chromaHeight = (height + 1) / 2;
+		const size_t lumaSize = static_cast<size_t>(width) * height;
+		const size_t chromaSize = static_cast<size_t>(chromaWidth) * chromaHeight;
+
+		const char marker[] = "FRAME\n";
+		out.assign(marker, marker + 6);
+		out.resize(6 + lumaSize + chromaSize * 2);
+		unsigned char* luma = out.data() + 6;
+		unsigned char* cb = luma + lumaSize;
+		unsigned char* cr = cb + chromaSize;
+
+		for (int y = 0; y < height; ++y)
+		{
+			const unsigned char* row = topDownRow(pixels, width, height, y);
+			for (int x = 0; x < width; ++x)
+			{
+				const unsigned char* pixel = row + x * 4;
+				luma[y * width + x] = static_cast<unsigned char>((77 * pixel[0] + 150 * pixel[1] + 29 * pixel[2] + 128) >> 8);
+			}
+		}
+
+		for (int y = 0; y < chromaHeight; ++y)
+		{
+			const unsigned char* rows[2] = { topDownRow(pixels, width, height, y * 2), topDownRow(pixels, width, height, min(y * 2 + 1, height - 1)) };
+			for (int x = 0; x < chromaWidth; ++x)
+			{
+				int r = 0, g = 0, b = 0;
+				for (const unsigned char* row : rows)
+				{
+					for (int dx = 0; dx < 2; ++dx)
+					{
+						const unsigned char* pixel = row + min(x * 2 + dx, width - 1) * 4;
+						r += pixel[0];
+						g += pixel[1];
+						b += pixel[2];
+					}
+				}
+
+				// Averages of Four Texels, Scaled by 256 then Divided Back Out
+				// ------------------------------------------------------------
+				cb[y * chromaWidth + x] = static_cast<unsigned char>(128 + ((-43 * r - 85 * g + 128 * b) / 4 + 128) / 256);
+				cr[y * chromaWidth + x] = static_cast<unsigned char>(128 + ((128 * r - 107 * g - 21 * b) / 4 + 128) / 256);
+			}
+		}
+	}
+
+#pragma endregion
+}
+
+bool FrameCapture::parseFormat(const char* name, Format& format)
+{
+	if (strcmp(name, "png") == 0)
+		format = Format::Png;
+	else if (strcmp(name, "qoi") == 0)
+		format = Format::Qoi;
+	else if (strcmp(name, "y4m") == 0)
+		format = Format::Y4m;
+	else
+		return false;
+
+	return true;
+}
+
+bool FrameCapture::compare(const char* directory, const char* reference, int tolerance, double maxSharePercent)
+{
+	// Every Reference Frame, in Order, Against the Same-Numbered Frame of the Capture
+	// -------------------------------------------------------------------------------
+	size_t frame = 0;
+	size_t failedFrames = 0;
+	vector<unsigned char> expected;
+	vector<unsigned char> actual;
+	for (;; ++frame)
+	{
+		const string name = frameFileName(frame, "qoi");
+		if (!filesystem::exists(reference + name))
+			break;
+
+		// Error Check: Both Frames Decode at One Size
+		// -------------------------------------------
+		int width = 0, height = 0;
+		int actualWidth = 0, actualHeight = 0;
+		if (!readQoiFile(reference + name, width, height, expected))
+		{
+			cerr << "ERROR::FRAME_COMPARE::DECODE_FAILED " << reference << name << endl;
+			return false;
+		}
+		if (!readQoiFile(directory + name, actualWidth, actualHeight, actual))
+		{
+			cerr << "ERROR::FRAME_COMPARE::MISSING_FRAME " << directory << name << endl;
+			return false;
+		}
+		if (actualWidth != width || actualHeight != height)
+		{
+			cerr << "ERROR::FRAME_COMPARE::SIZE_MISMATCH Frame " << frame << ": " << actualWidth << "x" << actualHeight
+				<< " Against " << width << "x" << height << endl;
+			return false;
+		}
+
+		// Largest Channel Difference per Pixel; Pixels Above the Tolerance are Counted
+		// ----------------------------------------------------------------------------
+		const size_t pixelCount = static_cast<size_t>(width) * height;
+		int maxDifference = 0;
+		uint64_t differenceSum = 0;
+		size_t pixelsOver = 0;
+		for (size_t i = 0; i < pixelCount; ++i)
+		{
+			int difference = 0;
+			for (int channel = 0; channel < 3; ++channel)
+				difference = max(difference, abs(expected[i * 3 + channel] - actual[i * 3 + channel]));
+
+			maxDifference = max(maxDifference, difference);
+			differenceSum += difference;
+			if (difference > tolerance)
+				++pixelsOver;
+		}
+
+		const double sharePercent = 100.0 * pixelsOver / pixelCount;
+		const bool passed = sharePercent <= maxSharePercent;
+		if (!passed)
+			++failedFrames;
+
+		cerr << "INFO: Frame " << frame << ": Max Difference " << maxDifference << ", Mean " << (static_cast<double>(differenceSum) / pixelCount)
+			<< ", " << sharePercent << "% of Pixels Above " << tolerance << (passed ? "" : " (FAILED)") << endl;
+	}
+
+	// Error Check: Something was Compared
+	// -----------------------------------
+	if (frame == 0)
+	{
+		cerr << "ERROR::FRAME_COMPARE::NO_FRAMES " << reference << frameFileName(0, "qoi") << endl;
+		return false;
+	}
+
+	cerr << "INFO: " << (frame - failedFrames) << " of " << frame << " Frames Match Within " << maxSharePercent << "% of Pixels" << endl;
+	return failedFrames == 0;
+}
+
+bool FrameCapture::create(RenderBackend& backend, const char* directory, Format format, int framesPerSecond)
+{
+	// Error Check: Output Directory
+	// -----------------------------
+	error_code error;
+	filesystem::create_directories(directory, error);
+	if (error)
+	{
+		cerr << "ERROR::FRAME_CAPTURE::CREATE_DIRECTORY " << directory << ": " << error.message() << endl;
+		return false;
+	}
+
+	mBackend = &backend;
+	mDirectory = directory;
+	mFormat = format;
+	mFramesPerSecond = framesPerSecond;
+	mStopping = false;
+	mEncoder = thread(&FrameCapture::encoderLoop, this);
+	return true;
+}
+
+void FrameCapture::destroy()
+{
+	if (!mEncoder.joinable())
+		return;
+
+	// Hand Over the Last Readbacks, Let the Encoder Drain the Queue, then Stop it; a
+	// Readback can Outlast One FLUSH_TIMEOUT, so Flush Until No Slot is Still Reading
+	// -------------------------------------------------------------------------------
+	while (anySlotReading())
+		submitFinishedReads(true);
+	{
+		lock_guard<mutex> lock(mMutex);
+		mStopping = true;
+	}
+	mWorkReady.notify_one();
+	mEncoder.join();
+
+	destroySlots();
+	if (mVideo.is_open())
+		mVideo.close();
+}
+
+bool FrameCapture::createSlots(int width, int height)
+{
+	const size_t size = static_cast<size_t>(width) * height * 4;
+	for (Slot& slot : mSlots)
+	{
+		slot.buffer = mBackend->createBuffer(BufferType::Readback, size, nullptr);
+		slot.pixels = static_cast<const unsigned char*>(mBackend->mappedData(slot.buffer));
+
+		// Error Check: Mapped Readback
+		// ----------------------------
+		if (!slot.pixels)
+		{
+			cerr << "ERROR::FRAME_CAPTURE::MAP_FAILED" << endl;
+			destroySlots();
+			return false;
+		}
+	}
+
+	mWidth = width;
+	mHeight = height;
+	return true;
+}
+
+void FrameCapture::destroySlots()
+{
+	for (Slot& slot : mSlots)
+	{
+		if (slot.fence)
+			mBackend->destroyFence(slot.fence);
+		mBackend->destroyBuffer(slot.buffer);
+		slot.buffer = 0;
+		slot.pixels = nullptr;
+		slot.fence = 0;
+		slot.state = SlotState::Free;
+	}
+}
+
+void FrameCapture::capture(int width, int height)
+{
+	const auto start = chrono::steady_clock::now();
+
+	if (mWidth == 0 && width > 0 && height > 0 && !createSlots(width, height))
+		mWidth = -1;   // Stop Trying; Every Frame Counts as Skipped
+
+	if (width != mWidth || height != mHeight)
+	{
+		++mSkippedFrames;
+		mRenderThreadSeconds += secondsSince(start);
+		return;
+	}
+
+	submitFinishedReads(false);
+
+	// The Next Slot is Normally Free; Otherwise Wait for the Readback or the Encoder
+	// ------------------------------------------------------------------------------
+	Slot& slot = mSlots[mNextSlot];
+	if (slot.state != SlotState::Free)
+	{
+		const auto stallStart = chrono::steady_clock::now();
+
+		// A Readback can Outlast FLUSH_TIMEOUT on a Busy GPU; Waiting for the Encoder Before
+		// the Slot is Queued would Never Return, so Keep Flushing Until the Fence Resolves
+		// ---------------------------------------------------------------------------------
+		while (slot.state == SlotState::Reading)
+			submitFinishedReads(true);
+
+		unique_lock<mutex> lock(mMutex);
+		mSlotFreed.wait(lock, [&slot] { return slot.state == SlotState::Free; });
+		mStallSeconds += secondsSince(stallStart);
+	}
+
+	mBackend->readRenderTarget(0, width, height, slot.buffer);
+	slot.fence = mBackend->insertFence();
+	slot.frame = mNextFrame++;
+	{
+		lock_guard<mutex> lock(mMutex);
+		slot.state = SlotState::Reading;
+	}
+	mNextSlot = (mNextSlot + 1) % SLOT_COUNT;
+
+	mRenderThreadSeconds += secondsSince(start);
+}
+
+bool FrameCapture::anySlotReading() const
+{
+	for (const Slot& slot : mSlots)
+		if (slot.state == SlotState::Reading)
+			return true;
+	return false;
+}
+
+// Queue Finished Readbacks for the Encoder in Frame Order; Only Waits when Flushing
+// --------------------------------------------------------------------------------
+void FrameCapture::submitFinishedReads(bool wait)
+{
+	for (int i = 0; i < SLOT_COUNT; ++i)
+	{
+		Slot& slot = mSlots[(mNextSlot + i) % SLOT_COUNT];
+		if (slot.state != SlotState::Reading)
+			continue;
+
+		if (!mBackend->waitFence(slot.fence, wait ? FLUSH_TIMEOUT : 0))
+			break;
+
+		mBackend->destroyFence(slot.fence);
+		slot.fence = 0;
+		{
+			lock_guard<mutex> lock(mMutex);
+			slot.state = SlotState::Encoding;
+			mQueue.push_back(static_cast<int>(&slot - mSlots));
+		}
+		mWorkReady.notify_one();
+	}
+}
+
+void FrameCapture::encoderLoop()
+{
+	for (;;)
+	{
+		int slotIndex = 0;
+		{
+			unique_lock<mutex> lock(mMutex);
+			mWorkReady.wait(lock, [this] { return mStopping || !mQueue.empty(); });
+			if (mQueue.empty())
+				return;
+
+			slotIndex = mQueue.front();
+			mQueue.pop_front();
+		}
+
+		const auto start = chrono::steady_clock::now();
+		const bool written = encodeFrame(mSlots[slotIndex]);
+		const double seconds = secondsSince(start);
+
+		{
+			lock_guard<mutex> lock(mMutex);
+			mSlots[slotIndex].state = SlotState::Free;
+			mWrittenFrames += written;
+			mEncodeSeconds += seconds;
+		}
+		mSlotFreed.notify_one();
+	}
+}
+
+bool FrameCapture::encodeFrame(const Slot& slot)
+{
+	if (mFormat == Format::Y4m)
+	{
+		if (!mVideo.is_open())
+		{
+			mVideo.open(mDirectory + "/capture.y4m", ios::binary);
+			mVideo << "YUV4MPEG2 W" << mWidth << " H" << mHeight << " F" << mFramesPerSecond << ":1 Ip A1:1 C420jpeg\n";
+		}
+
+		encodeY4mFrame(slot.pixels, mWidth, mHeight, mScratch);
+		mVideo.write(reinterpret_cast<const char*>(mScratch.data()), mScratch.size());
+		if (!mVideo && !mReportedWriteError)
+		{
+			cerr << "ERROR::FRAME_CAPTURE::WRITE_FAILED " << mDirectory << "/capture.y4m" << endl;
+			mReportedWriteError = true;
+		}
+		return static_cast<bool>(mVideo);
+	}
+
+	const string name = frameFileName(slot.frame, mFormat == Format::Png ? "png" : "qoi");
+
+	if (mFormat == Format::Png)
+		encodePng(slot.pixels, mWidth, mHeight, mScratch);
+	else
+		encodeQoi(slot.pixels, mWidth, mHeight, mScratch);
+
+	ofstream file(mDirectory + name, ios::binary);
+	file.write(reinterpret_cast<const char*>(mScratch.data()), mScratch.size());
+	if (!file && !mReportedWriteError)
+	{
+		cerr << "ERROR::FRAME_CAPTURE::WRITE_FAILED " << mDirectory << name << endl;
+		mReportedWriteError = true;
+	}
+	return static_cast<bool>(file);
+}
+
+size_t FrameCapture::writtenFrameCount()
+{
+	lock_guard<mutex> lock(mMutex);
+	return mWrittenFrames;
+}
+
+double FrameCapture::encodeSeconds()
+{
+	lock_guard<mutex> lock(mMutex);
+	return mEncodeSeconds;
+}
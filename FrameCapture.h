@@ -0,0 +1,111 @@
+#pragma once
+
+// Includes
+// -------
+#include <atomic>                 // slot states read by both threads
+#include <condition_variable>     // encoder sleep / wake
+#include <cstddef>                // size_t
+#include <deque>                  // deque
+#include <fstream>                // ofstream
+#include <mutex>                  // mutex
+#include <string>                 // string
+#include <thread>                 // std::thread
+#include <vector>                 // vector
+
+#include "RenderBackend.h"
+
+// Stall-Free Capture of the Presented Frames
+// ------------------------------------------
+// capture() queues an asynchronous backend readback of the window into the next of
+// SLOT_COUNT readback buffers and fences it. The buffers stay mapped, so once a
+// fence has signalled the encoder thread reads the pixels straight out of the mapping:
+// the render thread neither waits for the readback nor copies a byte. The encoder writes
+// a numbered PNG or QOI file per frame, or appends the frame to one Y4M (4:2:0) video.
+// The render thread only blocks when every slot is still being read back or encoded, and
+// that time is reported as the capture stall. The first captured frame fixes the capture
+// size; frames of any other size (after a resize) are skipped and counted.
+class FrameCapture
+{
+public:
+	enum class Format { Png, Qoi, Y4m };
+
+	static const int SLOT_COUNT = 4;
+
+	// Parse "png", "qoi" or "y4m"
+	// ---------------------------
+	static bool parseFormat(const char* name, Format& format);
+
+	// Compare the QOI Frames Captured to directory with Those in reference, Frame by Frame
+	// ------------------------------------------------------------------------------------
+	// A pixel differs when any channel is more than tolerance apart; a frame fails when more
+	// than maxSharePercent of its pixels differ. Reports each frame and returns false if any
+	// frame fails, is missing or differs in size.
+	static bool compare(const char* directory, const char* reference, int tolerance, double maxSharePercent);
+
+	bool create(RenderBackend& backend, const char* directory, Format format, int framesPerSecond);
+
+	// Finish Every Frame in Flight, Stop the Encoder and Release the Buffers
+	// ----------------------------------------------------------------------
+	void destroy();
+
+	// Queue a Readback of the Window's Frame; Call Before it is Presented
+	// -------------------------------------------------------------------
+	void capture(int width, int height);
+
+	size_t capturedFrameCount() const { return mNextFrame; }
+	size_t writtenFrameCount();
+	size_t skippedFrameCount() const { return mSkippedFrames; }
+	double renderThreadSeconds() const { return mRenderThreadSeconds; }   // Time Spent in capture(), Stalls Included
+	double stallSeconds() const { return mStallSeconds; }
+	double encodeSeconds();                                                // Encoder Thread Time
+
+private:
+	enum class SlotState { Free, Reading, Encoding };
+
+	struct Slot
+	{
+		BufferId buffer = 0;
+		const unsigned char* pixels = nullptr;   // Mapped Readback: RGBA Rows, Bottom Row First
+		FenceId fence = 0;
+		std::atomic<SlotState> state{ SlotState::Free };   // Changed Under mMutex so Waits Wake Reliably
+		size_t frame = 0;
+	};
+
+	bool createSlots(int width, int height);
+	void destroySlots();
+	bool anySlotReading() const;
+	void submitFinishedReads(bool wait);
+	void encoderLoop();
+	bool encodeFrame(const Slot& slot);
+
+	RenderBackend* mBackend = nullptr;
+	std::string mDirectory;
+	Format mFormat = Format::Qoi;
+	int mFramesPerSecond = 60;
+	int mWidth = 0;
+	int mHeight = 0;
+
+	Slot mSlots[SLOT_COUNT];
+	int mNextSlot = 0;
+	size_t mNextFrame = 0;
+	size_t mSkippedFrames = 0;
+	double mRenderThreadSeconds = 0.0;
+	double mStallSeconds = 0.0;
+
+	// Shared with the Encoder Thread, Guarded by mMutex
+	// -------------------------------------------------
+	std::thread mEncoder;
+	std::mutex mMutex;
+	std::condition_variable mWorkReady;
+	std::condition_variable mSlotFreed;
+	std::deque<int> mQueue;          // Slots Ready to Encode, Oldest First
+	bool mStopping = false;
+	size_t mWrittenFrames = 0;
+	double mEncodeSeconds = 0.0;
+
+	// Encoder Thread Only
+	// -------------------
+	std::ofstream mVideo;
+	std::vector<unsigned char> mScratch;
+	bool mReportedWriteError = false;
+};
@@ -0,0 +1,716 @@
+#include "GLBackend.h"
+
+#include <GLFW/glfw3.h>   // glfwSwapBuffers, glfwSwapInterval
+#include <algorithm>   // max
+#include <cstring>     // memcpy
+#include <iostream>    // cerr
+
+#include "MemoryTracker.h"
+
+using namespace std;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	struct PixelFormat
+	{
+		GLenum internalFormat;
+		GLenum format;
+		GLenum type;
+	};
+
+	PixelFormat pixelFormat(TextureFormat format)
+	{
+		switch (format)
+		{
+			case TextureFormat::R8:       return { GL_R8, GL_RED, GL_UNSIGNED_BYTE };
+			case TextureFormat::RGB8:     return { GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE };
+			case TextureFormat::RGBA16F:  return { GL_RGBA16F, GL_RGBA, GL_FLOAT };
+			case TextureFormat::RG16UI:   return { GL_RG16UI, GL_RG_INTEGER, GL_UNSIGNED_SHORT };
+			case TextureFormat::Depth24:  return { GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT };
+			case TextureFormat::Depth32F: return { GL_DEPTH_COMPONENT32F, GL_DEPTH_COMPONENT, GL_FLOAT };
+			default:                      return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE };
+		}
+	}
+}
+
+// Without the Extension the Vertex Shader Cannot Pick a Viewport, so One is All there is
+// -------------------------------------------------------------------------------------
+uint32_t GLBackend::maxViewports() const
+{
+	GLint viewports = 1;
+	if (GLEW_ARB_shader_viewport_layer_array)
+		glGetIntegerv(GL_MAX_VIEWPORTS, &viewports);
+	return static_cast<uint32_t>(viewports);
+}
+
+BufferId GLBackend::createBuffer(BufferType type, size_t size, const void* data)
+{
+	GLuint buffer = 0;
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+
+	// Stream and Readback Buffers: Immutable Storage, Mapped for the Buffer's Whole Lifetime;
+	// Readback Storage is Asked For on the Client Side, where the CPU Reads it
+	// ---------------------------------------------------------------------------------------
+	if (type == BufferType::Stream || type == BufferType::Readback)
+	{
+		const GLbitfield flags = ((type == BufferType::Stream) ? GL_MAP_WRITE_BIT : GL_MAP_READ_BIT) | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		const GLbitfield storageFlags = (type == BufferType::Readback) ? flags | GL_CLIENT_STORAGE_BIT : flags;
+		MemoryTracker::bufferStorage(MemoryTracker::Category::StreamBuffers, GL_COPY_WRITE_BUFFER, buffer, static_cast<GLsizeiptr>(size), data, storageFlags);
+		void* mapped = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(size), flags);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		// Error Check: Persistent Mapping
+		// -------------------------------
+		if (!mapped)
+		{
+			cerr << "ERROR::BACKEND::MAP_FAILED " << size << " Bytes" << endl;
+			MemoryTracker::deleteBuffers(1, &buffer);
+			return 0;
+		}
+
+		mMappedBuffers[buffer] = mapped;
+	}
+	else
+	{
+		MemoryTracker::bufferData(MemoryTracker::Category::MeshBuffers, GL_COPY_WRITE_BUFFER, buffer, static_cast<GLsizeiptr>(size), data, GL_STATIC_DRAW);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+
+	mBufferTypes[buffer] = type;
+	return buffer;
+}
+
+// Deleting a Buffer Also Unmaps it
+// --------------------------------
+void GLBackend::destroyBuffer(BufferId buffer)
+{
+	if (buffer)
+	{
+		MemoryTracker::deleteBuffers(1, &buffer);
+		mBufferTypes.erase(buffer);
+		mMappedBuffers.erase(buffer);
+	}
+}
+
+void* GLBackend::mappedData(BufferId buffer)
+{
+	const auto mapped = mMappedBuffers.find(buffer);
+	return mapped != mMappedBuffers.end() ? mapped->second : nullptr;
+}
+
+size_t GLBackend::storageBufferAlignment() const
+{
+	GLint alignment = 16;
+	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	return static_cast<size_t>(alignment);
+}
+
+FenceId GLBackend::insertFence()
+{
+	const FenceId fence = mNextFence++;
+	mFences[fence] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	return fence;
+}
+
+// A Blocking Wait Flushes First, or the Fence might Never Reach the GPU
+// ---------------------------------------------------------------------
+bool GLBackend::waitFence(FenceId fence, uint64_t timeout)
+{
+	const auto sync = mFences.find(fence);
+	if (sync == mFences.end())
+		return true;
+
+	return glClientWaitSync(sync->second, timeout ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, timeout) != GL_TIMEOUT_EXPIRED;
+}
+
+void GLBackend::destroyFence(FenceId fence)
+{
+	const auto sync = mFences.find(fence);
+	if (sync != mFences.end())
+	{
+		glDeleteSync(sync->second);
+		mFences.erase(sync);
+	}
+}
+
+TimestampId GLBackend::createTimestamp()
+{
+	GLuint query = 0;
+	glGenQueries(1, &query);
+	return query;
+}
+
+void GLBackend::destroyTimestamp(TimestampId timestamp)
+{
+	if (timestamp)
+		glDeleteQueries(1, &timestamp);
+}
+
+void GLBackend::writeTimestamp(TimestampId timestamp)
+{
+	glQueryCounter(timestamp, GL_TIMESTAMP);
+}
+
+// GL Timestamps are Already in Nanoseconds
+// ----------------------------------------
+bool GLBackend::timestampResult(TimestampId timestamp, bool wait, uint64_t& nanoseconds)
+{
+	GLint available = GL_FALSE;
+	if (!wait)
+		glGetQueryObjectiv(timestamp, GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!wait && !available)
+		return false;
+
+	GLuint64 result = 0;
+	glGetQueryObjectui64v(timestamp, GL_QUERY_RESULT, &result);
+	nanoseconds = result;
+	return true;
+}
+
+TextureId GLBackend::createTexture(const TextureDesc& desc, const void* pixels)
+{
+	const PixelFormat format = pixelFormat(desc.format);
+	const MemoryTracker::Category category = desc.renderTarget ? MemoryTracker::Category::RenderTargets : MemoryTracker::Category::Textures;
+
+	// Error Check: Empty Textures Cannot be Sampled
+	// ---------------------------------------------
+	if (desc.width <= 0 || desc.height <= 0)
+	{
+		cerr << "ERROR::BACKEND::TEXTURE_SIZE " << desc.width << "x" << desc.height << endl;
+		return 0;
+	}
+
+	GLuint texture = 0;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+
+	const GLint wrap = (desc.wrap == TextureWrap::ClampToEdge) ? GL_CLAMP_TO_EDGE : GL_REPEAT;
+	const GLint filter = (desc.filter == TextureFilter::Nearest) ? GL_NEAREST : GL_LINEAR;
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, desc.filter == TextureFilter::Trilinear ? GL_LINEAR_MIPMAP_LINEAR : filter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+	if (desc.shadowCompare)
+	{
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+	}
+
+	// Empty Immutable Storage for updateTexture() to Fill
+	// ---------------------------------------------------
+	if (desc.levels > 0)
+	{
+		MemoryTracker::textureStorage2D(category, texture, desc.levels, format.internalFormat, desc.width, desc.height);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, desc.levels - 1);
+	}
+	else
+	{
+		// Counted with the Mip Chain glGenerateMipmap Adds Below
+		// -----------------------------------------------------
+		GLsizei levels = 1;
+		while (desc.mipmaps && (max(desc.width, desc.height) >> levels) > 0)
+			++levels;
+
+		MemoryTracker::textureImage2D(category, texture, levels, format.internalFormat, desc.width, desc.height, format.format, format.type, pixels);
+		if (desc.mipmaps)
+			glGenerateMipmap(GL_TEXTURE_2D);
+	}
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	mTextureDescs[texture] = desc;
+	return texture;
+}
+
+void GLBackend::destroyTexture(TextureId texture)
+{
+	if (texture)
+	{
+		MemoryTracker::deleteTextures(1, &texture);
+		mTextureDescs.erase(texture);
+	}
+}
+
+// Single-Byte Rows are Tightly Packed, not Padded to Four Bytes
+// -------------------------------------------------------------
+void GLBackend::updateTexture(TextureId texture, int level, const void* pixels)
+{
+	const TextureDesc& desc = mTextureDescs.at(texture);
+	const PixelFormat format = pixelFormat(desc.format);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	if (desc.format == TextureFormat::R8)
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, max(1, desc.width >> level), max(1, desc.height >> level), format.format, format.type, pixels);
+	if (desc.format == TextureFormat::R8)
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void GLBackend::copyTextureLevel(TextureId source, int sourceLevel, TextureId target, int targetLevel)
+{
+	const TextureDesc& desc = mTextureDescs.at(source);
+	glCopyImageSubData(source, GL_TEXTURE_2D, sourceLevel, 0, 0, 0, target, GL_TEXTURE_2D, targetLevel, 0, 0, 0,
+		max(1, desc.width >> sourceLevel), max(1, desc.height >> sourceLevel), 1);
+}
+
+void GLBackend::setTextureBaseLevel(TextureId texture, int level)
+{
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+RenderTargetId GLBackend::createRenderTarget(const TextureId* colors, size_t colorCount, TextureId depth)
+{
+	// Error Check: Color Count
+	// ------------------------
+	if (colorCount > MAX_COLOR_TARGETS)
+	{
+		cerr << "ERROR::BACKEND::RENDER_TARGET_COLORS " << colorCount << endl;
+		return 0;
+	}
+
+	GLuint framebuffer = 0;
+	glGenFramebuffers(1, &framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+	GLenum drawBuffers[MAX_COLOR_TARGETS] = {};
+	for (size_t i = 0; i < colorCount; ++i)
+	{
+		drawBuffers[i] = GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, drawBuffers[i], GL_TEXTURE_2D, colors[i], 0);
+	}
+	if (depth)
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth, 0);
+
+	// Depth-Only Targets Neither Draw Nor Read Color
+	// ----------------------------------------------
+	if (colorCount == 0)
+	{
+		glDrawBuffer(GL_NONE);
+		glReadBuffer(GL_NONE);
+	}
+	else if (colorCount > 1)
+		glDrawBuffers(static_cast<GLsizei>(colorCount), drawBuffers);
+
+	// Error Check: Target Completeness
+	// --------------------------------
+	const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		cerr << "ERROR::BACKEND::RENDER_TARGET_INCOMPLETE 0x" << hex << status << dec << endl;
+		glDeleteFramebuffers(1, &framebuffer);
+		return 0;
+	}
+
+	mTargetColors[framebuffer].assign(colors, colors + colorCount);
+	return framebuffer;
+}
+
+void GLBackend::destroyRenderTarget(RenderTargetId target)
+{
+	if (target)
+	{
+		glDeleteFramebuffers(1, &target);
+		mTargetColors.erase(target);
+	}
+}
+
+// Equal Sizes Copy Texels Exactly
+// -------------------------------
+void GLBackend::blitRenderTarget(RenderTargetId source, int sourceWidth, int sourceHeight, RenderTargetId target, int targetWidth, int targetHeight)
+{
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, source);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target);
+	glBlitFramebuffer(0, 0, sourceWidth, sourceHeight, 0, 0, targetWidth, targetHeight, GL_COLOR_BUFFER_BIT,
+		(sourceWidth == targetWidth && sourceHeight == targetHeight) ? GL_NEAREST : GL_LINEAR);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+// The Window Reads its Back Buffer, the Frame Not Yet Presented; Texels Keep their Format
+// ---------------------------------------------------------------------------------------
+void GLBackend::readRenderTarget(RenderTargetId target, int width, int height, BufferId buffer)
+{
+	PixelFormat format = pixelFormat(TextureFormat::RGBA8);
+	const auto colors = mTargetColors.find(target);
+	if (colors != mTargetColors.end() && !colors->second.empty())
+		format = pixelFormat(mTextureDescs.at(colors->second[0]).format);
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, target);
+	if (!target)
+		glReadBuffer(GL_BACK);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+	glReadPixels(0, 0, width, height, format.format, format.type, nullptr);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
+
+VertexInputId GLBackend::createVertexInput(const VertexLayout& layout, BufferId vertices, BufferId indices)
+{
+	// Streamed or Attribute-Less: the Vertex Format Only, with Buffers Bound at Each Draw
+	// -----------------------------------------------------------------------------------
+	if (!vertices && !indices)
+	{
+		GLuint vertexArray = 0;
+		glGenVertexArrays(1, &vertexArray);
+		glBindVertexArray(vertexArray);
+		for (size_t i = 0; i < layout.attributeCount; ++i)
+		{
+			const VertexAttribute& attribute = layout.attributes[i];
+			glVertexAttribFormat(attribute.location, attribute.components, attribute.normalizedBytes ? GL_UNSIGNED_BYTE : GL_FLOAT,
+				attribute.normalizedBytes ? GL_TRUE : GL_FALSE, static_cast<GLuint>(attribute.offset));
+			glVertexAttribBinding(attribute.location, 0);
+			glEnableVertexAttribArray(attribute.location);
+		}
+		glBindVertexArray(0);
+
+		mStreamedStrides[vertexArray] = static_cast<GLsizei>(layout.stride);
+		return vertexArray;
+	}
+
+	// Error Check: the Vertex Input Needs a Vertex Buffer and an Index Buffer of this Backend
+	// ---------------------------------------------------------------------------------------
+	const auto vertexType = mBufferTypes.find(vertices);
+	const auto indexType = mBufferTypes.find(indices);
+	if (vertexType == mBufferTypes.end() || vertexType->second != BufferType::Vertex ||
+		indexType == mBufferTypes.end() || indexType->second != BufferType::Index)
+	{
+		cerr << "ERROR::BACKEND::VERTEX_INPUT_BUFFERS " << vertices << " " << indices << endl;
+		return 0;
+	}
+
+	GLuint vertexArray = 0;
+	glGenVertexArrays(1, &vertexArray);
+	glBindVertexArray(vertexArray);
+	glBindBuffer(GL_ARRAY_BUFFER, vertices);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices);
+
+	for (size_t i = 0; i < layout.attributeCount; ++i)
+	{
+		const VertexAttribute& attribute = layout.attributes[i];
+		glVertexAttribPointer(attribute.location, attribute.components, attribute.normalizedBytes ? GL_UNSIGNED_BYTE : GL_FLOAT,
+			attribute.normalizedBytes ? GL_TRUE : GL_FALSE, layout.stride, reinterpret_cast<const void*>(attribute.offset));
+		glEnableVertexAttribArray(attribute.location);
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	return vertexArray;
+}
+
+void GLBackend::destroyVertexInput(VertexInputId vertexInput)
+{
+	if (vertexInput)
+	{
+		glDeleteVertexArrays(1, &vertexInput);
+		mStreamedStrides.erase(vertexInput);
+	}
+}
+
+// Error Check: GL Programs are Linked from GLSL by the ShaderBatch, Not Built from SPIR-V
+// ---------------------------------------------------------------------------------------
+ProgramId GLBackend::createProgram(const vector<uint32_t>& vertexSpirv, const vector<uint32_t>& fragmentSpirv)
+{
+	cerr << "ERROR::BACKEND::SPIRV_PROGRAM Unsupported by " << name() << " (" << vertexSpirv.size() << " and "
+		<< fragmentSpirv.size() << " Words)" << endl;
+	return 0;
+}
+
+void GLBackend::destroyProgram(ProgramId program)
+{
+	if (program)
+		MemoryTracker::deleteProgram(program);
+}
+
+PipelineId GLBackend::createPipeline(const PipelineDesc& desc)
+{
+	Pipeline pipeline;
+	pipeline.desc = desc;
+	pipeline.desc.uniforms = nullptr;
+	pipeline.uniformLocations.resize(desc.uniformCount);
+	for (size_t i = 0; i < desc.uniformCount; ++i)
+		pipeline.uniformLocations[i] = desc.uniforms[i] ? glGetUniformLocation(desc.program, desc.uniforms[i]) : -1;
+
+	mPipelines.push_back(pipeline);
+	return static_cast<PipelineId>(mPipelines.size());
+}
+
+void GLBackend::destroyPipeline(PipelineId pipeline)
+{
+	if (pipeline && pipeline <= mPipelines.size())
+		mPipelines[pipeline - 1] = Pipeline();
+}
+
+void GLBackend::beginPass(const PassDesc& pass)
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, pass.target);
+	glViewport(pass.x, pass.y, pass.width, pass.height);
+	if (!pass.clearColor && !pass.clearDepth)
+		return;
+
+	// glClear Leaves Integer Colors Undefined, so a Target with One Clears Each Color Alone
+	// -------------------------------------------------------------------------------------
+	bool integerColor = false;
+	const auto colors = mTargetColors.find(pass.target);
+	if (colors != mTargetColors.end())
+	{
+		for (TextureId color : colors->second)
+			integerColor = integerColor || mTextureDescs.at(color).format == TextureFormat::RG16UI;
+	}
+
+	// The Scissor Keeps the Clear Inside the Viewport, as a Render Area Would
+	// -----------------------------------------------------------------------
+	GLbitfield mask = 0;
+	if (pass.clearColor && !integerColor)
+	{
+		glClearColor(pass.color.r, pass.color.g, pass.color.b, pass.color.a);
+		mask |= GL_COLOR_BUFFER_BIT;
+	}
+	if (pass.clearDepth)
+		mask |= GL_DEPTH_BUFFER_BIT;
+
+	glEnable(GL_SCISSOR_TEST);
+	glScissor(pass.x, pass.y, pass.width, pass.height);
+	if (mask)
+		glClear(mask);
+	if (pass.clearColor && integerColor)
+	{
+		const GLuint integerValue[4] = { static_cast<GLuint>(pass.color.r), static_cast<GLuint>(pass.color.g),
+			static_cast<GLuint>(pass.color.b), static_cast<GLuint>(pass.color.a) };
+		for (size_t i = 0; i < colors->second.size(); ++i)
+		{
+			if (mTextureDescs.at(colors->second[i]).format == TextureFormat::RG16UI)
+				glClearBufferuiv(GL_COLOR, static_cast<GLint>(i), integerValue);
+			else
+				glClearBufferfv(GL_COLOR, static_cast<GLint>(i), &pass.color[0]);
+		}
+	}
+	glDisable(GL_SCISSOR_TEST);
+}
+
+// Leave Nothing Bound that GL Calls Outside the Backend Could Change by Accident
+// ------------------------------------------------------------------------------
+void GLBackend::endPass()
+{
+	glBindVertexArray(0);
+	if (mTextureUnitChanged)
+	{
+		glActiveTexture(GL_TEXTURE0);
+		mTextureUnitChanged = false;
+	}
+}
+
+void GLBackend::submit(const CommandList* lists, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+		execute(lists[i]);
+}
+
+void GLBackend::setVsync(bool enabled)
+{
+	glfwSwapInterval(enabled ? 1 : 0);
+}
+
+void GLBackend::present()
+{
+	glfwSwapBuffers(mWindow);
+}
+
+// Every Bind Sets the Whole State, so a Pipeline Never Depends on the One Before it
+// --------------------------------------------------------------------------------
+void GLBackend::applyState(const PipelineDesc& desc)
+{
+	mTopology = (desc.topology == Topology::Lines) ? GL_LINES : GL_TRIANGLES;
+
+	if (desc.depthTest)
+		glEnable(GL_DEPTH_TEST);
+	else
+		glDisable(GL_DEPTH_TEST);
+	glDepthFunc((desc.depthCompare == DepthCompare::Always) ? GL_ALWAYS : GL_LESS);
+
+	if (desc.alphaBlend)
+	{
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+	else
+		glDisable(GL_BLEND);
+
+	if (desc.depthBiasSlope != 0.0f || desc.depthBiasConstant != 0.0f)
+	{
+		glEnable(GL_POLYGON_OFFSET_FILL);
+		glPolygonOffset(desc.depthBiasSlope, desc.depthBiasConstant);
+	}
+	else
+		glDisable(GL_POLYGON_OFFSET_FILL);
+
+	glPolygonMode(GL_FRONT_AND_BACK, (mWireframe && !desc.alwaysFilled) ? GL_LINE : GL_FILL);
+}
+
+GLint GLBackend::uniformLocation(uint32_t slot) const
+{
+	return slot < mPipeline->uniformLocations.size() ? mPipeline->uniformLocations[slot] : -1;
+}
+
+// Copies Floats Packed into a Command List's Words
+// ------------------------------------------------
+const float* GLBackend::unpackFloats(const uint32_t* words, size_t count)
+{
+	mFloats.resize(count);
+	memcpy(mFloats.data(), words, count * sizeof(float));
+	return mFloats.data();
+}
+
+// Replays One List; Uniforms Whose Location is -1 are Not in the Program
+// ----------------------------------------------------------------------
+void GLBackend::execute(const CommandList& list)
+{
+	typedef CommandList::Op Op;
+
+	const uint32_t* word = list.words().data();
+	const uint32_t* end = word + list.words().size();
+	while (word < end)
+	{
+		const Op op = static_cast<Op>(*word++);
+		switch (op)
+		{
+			case Op::BindPipeline:
+				mPipeline = &mPipelines[word[0] - 1];
+				glUseProgram(mPipeline->desc.program);
+				applyState(mPipeline->desc);
+				word += 1;
+				break;
+
+			case Op::BindVertexInput:
+				glBindVertexArray(word[0]);
+				mVertexInput = word[0];
+				mIndexType = static_cast<IndexType>(word[1]) == IndexType::UInt32 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+				word += 2;
+				break;
+
+			case Op::BindVertexBuffer:
+			{
+				const auto stride = mStreamedStrides.find(mVertexInput);
+				if (stride != mStreamedStrides.end())
+					glBindVertexBuffer(0, word[0], static_cast<GLintptr>(word[1]), stride->second);
+				word += 2;
+				break;
+			}
+
+			case Op::BindTexture:
+				glActiveTexture(GL_TEXTURE0 + word[0]);
+				glBindTexture(GL_TEXTURE_2D, word[1]);
+				mTextureUnitChanged = mTextureUnitChanged || word[0] != 0;
+				word += 2;
+				break;
+
+			case Op::BindStorageBuffer:
+				glBindBufferRange(GL_SHADER_STORAGE_BUFFER, word[0], word[1], static_cast<GLintptr>(word[2]), static_cast<GLsizeiptr>(word[3]));
+				word += 4;
+				break;
+
+			case Op::SetViewports:
+				glViewportArrayv(0, word[0], unpackFloats(word + 1, 4 * word[0]));
+				word += 1 + 4 * word[0];
+				break;
+
+			case Op::SetInt:
+				if (uniformLocation(word[0]) >= 0)
+					glUniform1i(uniformLocation(word[0]), static_cast<GLint>(word[1]));
+				word += 2;
+				break;
+
+			case Op::SetUInt:
+				if (uniformLocation(word[0]) >= 0)
+					glUniform1ui(uniformLocation(word[0]), word[1]);
+				word += 2;
+				break;
+
+			case Op::SetUVec3:
+				if (uniformLocation(word[0]) >= 0)
+					glUniform3ui(uniformLocation(word[0]), word[1], word[2], word[3]);
+				word += 4;
+				break;
+
+			case Op::SetFloat:
+				if (uniformLocation(word[0]) >= 0)
+					glUniform1fv(uniformLocation(word[0]), word[1], unpackFloats(word + 2, word[1]));
+				word += 2 + word[1];
+				break;
+
+			case Op::SetVec2:
+				if (uniformLocation(word[0]) >= 0)
+					glUniform2fv(uniformLocation(word[0]), word[1], unpackFloats(word + 2, 2 * word[1]));
+				word += 2 + 2 * word[1];
+				break;
+
+			case Op::SetVec3:
+				if (uniformLocation(word[0]) >= 0)
+					glUniform3fv(uniformLocation(word[0]), word[1], unpackFloats(word + 2, 3 * word[1]));
+				word += 2 + 3 * word[1];
+				break;
+
+			case Op::SetVec4:
+				if (uniformLocation(word[0]) >= 0)
+					glUniform4fv(uniformLocation(word[0]), word[1], unpackFloats(word + 2, 4 * word[1]));
+				word += 2 + 4 * word[1];
+				break;
+
+			case Op::SetMat3:
+				if (uniformLocation(word[0]) >= 0)
+					glUniformMatrix3fv(uniformLocation(word[0]), word[1], GL_FALSE, unpackFloats(word + 2, 9 * word[1]));
+				word += 2 + 9 * word[1];
+				break;
+
+			case Op::SetMat4:
+				if (uniformLocation(word[0]) >= 0)
+					glUniformMatrix4fv(uniformLocation(word[0]), word[1], GL_FALSE, unpackFloats(word + 2, 16 * word[1]));
+				word += 2 + 16 * word[1];
+				break;
+
+			case Op::Draw:
+				if (word[2] > 1)
+					glDrawArraysInstanced(mTopology, word[1], word[0], word[2]);
+				else
+					glDrawArrays(mTopology, word[1], word[0]);
+				word += 3;
+				break;
+
+			case Op::DrawIndexed:
+			{
+				const GLsizeiptr indexSize = mIndexType == GL_UNSIGNED_INT ? sizeof(GLuint) : sizeof(GLushort);
+				const void* offset = reinterpret_cast<const void*>(word[1] * indexSize);
+				if (word[2] > 1)
+					glDrawElementsInstanced(mTopology, word[0], mIndexType, offset, word[2]);
+				else
+					glDrawElements(mTopology, word[0], mIndexType, offset);
+				word += 3;
+				break;
+			}
+
+			case Op::DrawIndexedRanges:
+			{
+				const GLsizeiptr indexSize = mIndexType == GL_UNSIGNED_INT ? sizeof(GLuint) : sizeof(GLushort);
+				const uint32_t rangeCount = word[0];
+				mRangeCounts.resize(rangeCount);
+				mRangeOffsets.resize(rangeCount);
+				for (uint32_t i = 0; i < rangeCount; ++i)
+				{
+					mRangeCounts[i] = static_cast<GLsizei>(word[1 + 2 * i]);
+					mRangeOffsets[i] = reinterpret_cast<const void*>(word[2 + 2 * i] * indexSize);
+				}
+
+				if (rangeCount == 1)
+					glDrawElements(mTopology, mRangeCounts[0], mIndexType, mRangeOffsets[0]);
+				else
+					glMultiDrawElements(mTopology, mRangeCounts.data(), mIndexType, mRangeOffsets.data(), rangeCount);
+				word += 1 + 2 * rangeCount;
+				break;
+			}
+		}
+	}
+}
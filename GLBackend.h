@@ -0,0 +1,116 @@
+#pragma once
+
+// Includes
+// -------
+#include <GL/glew.h>      // GLEW library
+#include <unordered_map>  // unordered_map
+#include <vector>         // vector
+
+#include "RenderBackend.h"
+
+struct GLFWwindow;
+
+// OpenGL 4.4 Render Backend
+// -------------------------
+// Buffer, texture, vertex input and render target handles are the GL object names, and
+// every buffer and texture is counted by the MemoryTracker; stream and readback buffers are
+// persistently mapped and coherent, fences are GL sync objects and timestamps are GL
+// timestamp queries. Each buffer's type is kept with its name so a vertex input built from
+// the wrong kind of buffer is refused, and each texture's description so its levels can be
+// filled and copied by index. A pipeline is the program with the locations of its uniform
+// slots looked up once, so replaying a list costs one GL call per command; binding it also
+// sets its depth, blend, polygon offset and polygon mode state, which nothing outside the
+// backend changes. Buffers are filled through the copy-write binding point, which leaves
+// the bound vertex array's index buffer alone. A pass binds its framebuffer and viewport
+// and clears under a scissor of the viewport; a target's color textures are kept so integer
+// colors get their own clear and readbacks know their format. Blits and readbacks go
+// through the read and draw framebuffer bindings and leave the framebuffer unbound.
+// submit() replays the lists on the context's thread, so recording scales across the job
+// system while the driver still sees one thread; the draws, state changes and their order
+// match direct GL calls. Programs come linked from the ShaderBatch, so the backend only
+// deletes them, and present() swaps the window's buffers.
+class GLBackend : public RenderBackend
+{
+public:
+	explicit GLBackend(GLFWwindow* window) : mWindow(window) {}
+
+	const char* name() const override { return "OpenGL 4.4"; }
+	uint32_t maxViewports() const override;
+
+	BufferId createBuffer(BufferType type, size_t size, const void* data) override;
+	void destroyBuffer(BufferId buffer) override;
+	void* mappedData(BufferId buffer) override;
+	size_t storageBufferAlignment() const override;
+
+	FenceId insertFence() override;
+	bool waitFence(FenceId fence, uint64_t timeout) override;
+	void destroyFence(FenceId fence) override;
+	void flush() override { glFlush(); }
+	void setVsync(bool enabled) override;
+
+	TimestampId createTimestamp() override;
+	void destroyTimestamp(TimestampId timestamp) override;
+	void writeTimestamp(TimestampId timestamp) override;
+	bool timestampResult(TimestampId timestamp, bool wait, uint64_t& nanoseconds) override;
+
+	TextureId createTexture(const TextureDesc& desc, const void* pixels) override;
+	void destroyTexture(TextureId texture) override;
+	void updateTexture(TextureId texture, int level, const void* pixels) override;
+	void copyTextureLevel(TextureId source, int sourceLevel, TextureId target, int targetLevel) override;
+	void setTextureBaseLevel(TextureId texture, int level) override;
+
+	RenderTargetId createRenderTarget(const TextureId* colors, size_t colorCount, TextureId depth) override;
+	void destroyRenderTarget(RenderTargetId target) override;
+	void blitRenderTarget(RenderTargetId source, int sourceWidth, int sourceHeight, RenderTargetId target, int targetWidth, int targetHeight) override;
+	void readRenderTarget(RenderTargetId target, int width, int height, BufferId buffer) override;
+
+	VertexInputId createVertexInput(const VertexLayout& layout, BufferId vertices, BufferId indices) override;
+	void destroyVertexInput(VertexInputId vertexInput) override;
+
+	ProgramId createProgram(const std::vector<uint32_t>& vertexSpirv, const std::vector<uint32_t>& fragmentSpirv) override;
+	void destroyProgram(ProgramId program) override;
+
+	PipelineId createPipeline(const PipelineDesc& desc) override;
+	void destroyPipeline(PipelineId pipeline) override;
+
+	void beginPass(const PassDesc& pass) override;
+	void endPass() override;
+	void submit(const CommandList* lists, size_t count) override;
+
+	void setWireframe(bool wireframe) override { mWireframe = wireframe; }
+	void present() override;
+
+private:
+	struct Pipeline
+	{
+		PipelineDesc desc;                      // Program is Zero Once Destroyed
+		std::vector<GLint> uniformLocations;   // One per Slot; -1 if the Program Does Not Use it
+	};
+
+	void execute(const CommandList& list);
+	void applyState(const PipelineDesc& desc);
+	GLint uniformLocation(uint32_t slot) const;
+	const float* unpackFloats(const uint32_t* words, size_t count);
+
+	std::unordered_map<BufferId, BufferType> mBufferTypes;
+	std::unordered_map<BufferId, void*> mMappedBuffers;              // Stream and Readback Buffers, Mapped Until Deleted
+	std::unordered_map<FenceId, GLsync> mFences;
+	FenceId mNextFence = 1;
+	std::unordered_map<TextureId, TextureDesc> mTextureDescs;       // Level Sizes and Formats
+	std::unordered_map<RenderTargetId, std::vector<TextureId>> mTargetColors;
+	std::unordered_map<VertexInputId, GLsizei> mStreamedStrides;   // Vertex Inputs Created Without Buffers
+	std::vector<Pipeline> mPipelines;                                // PipelineId is the Index Plus One
+	bool mWireframe = false;
+	GLFWwindow* mWindow = nullptr;
+
+	// Replay State and Scratch, Kept Between Submits
+	// ----------------------------------------------
+	const Pipeline* mPipeline = nullptr;
+	GLenum mTopology = GL_TRIANGLES;
+	VertexInputId mVertexInput = 0;
+	GLenum mIndexType = GL_UNSIGNED_SHORT;
+	bool mTextureUnitChanged = false;
+	std::vector<GLsizei> mRangeCounts;
+	std::vector<const void*> mRangeOffsets;
+	std::vector<float> mFloats;
+};
@@ -0,0 +1,344 @@
+#include "InputRecording.h"
+
+#include <algorithm>    // max
+#include <cmath>        // abs, llround
+#include <cstring>      // memcpy
+#include <fstream>      // ifstream, ofstream
+#include <iostream>     // cerr
+#include <iterator>     // istreambuf_iterator
+
+using namespace std;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	const uint32_t RECORDING_MAGIC = 0x52495448;   // "HTIR"
+	const uint32_t RECORDING_VERSION = 2;   // 2: 64-Bit Timestamps; Version 1 Stopped at 71.6 Minutes
+
+	struct RecordingHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		InputPose startPose;
+	};
+
+	// Event: Type, 64-Bit Timestamp in Microseconds, then a Payload of the Type's Size
+	// --------------------------------------------------------------------------------
+	enum EventType : uint8_t
+	{
+		EVENT_KEYS = 1,     // uint16_t Key State
+		EVENT_MOUSE = 2,    // float xOffset, yOffset
+		EVENT_SCROLL = 3,   // float Offset
+		EVENT_POSE = 4,     // InputPose
+		EVENT_END = 5       // No Payload
+	};
+
+	const size_t EVENT_HEADER_SIZE = 1 + sizeof(uint64_t);
+
+	// Payload Size of an Event Type; Zero for an Unknown Type
+	// -------------------------------------------------------
+	size_t payloadSize(uint8_t type)
+	{
+		switch (type)
+		{
+			case EVENT_KEYS: return sizeof(uint16_t);
+			case EVENT_MOUSE: return 2 * sizeof(float);
+			case EVENT_SCROLL: return sizeof(float);
+			case EVENT_POSE: return sizeof(InputPose);
+			case EVENT_END: return 0;
+			default: return 0;
+		}
+	}
+
+	bool isKnownEvent(uint8_t type)
+	{
+		return type >= EVENT_KEYS && type <= EVENT_END;
+	}
+
+	uint64_t eventStamp(const unsigned char* event)
+	{
+		uint64_t stamp;
+		memcpy(&stamp, event + 1, sizeof(stamp));
+		return stamp;
+	}
+
+	InputPose cameraPose(const Camera& camera)
+	{
+		InputPose pose;
+		pose.position = camera.Position;
+		pose.yaw = camera.Yaw;
+		pose.pitch = camera.Pitch;
+		pose.zoom = camera.Zoom;
+		return pose;
+	}
+}
+
+void moveCamera(Camera& camera, uint32_t keys, float seconds)
+{
+	if (keys & INPUT_KEY_FORWARD)
+		camera.ProcessKeyboard(FORWARD, seconds);
+	if (keys & INPUT_KEY_BACKWARD)
+		camera.ProcessKeyboard(BACKWARD, seconds);
+	if (keys & INPUT_KEY_LEFT)
+		camera.ProcessKeyboard(LEFT, seconds);
+	if (keys & INPUT_KEY_RIGHT)
+		camera.ProcessKeyboard(RIGHT, seconds);
+}
+
+#pragma region Recorder
+
+bool InputRecorder::create(const char* path, const Camera& camera, double startTime)
+{
+	// Error Check: the File Must be Writable Before Anything is Recorded
+	// ------------------------------------------------------------------
+	if (!ofstream(path, ios::binary | ios::trunc))
+	{
+		cerr << "ERROR::INPUT_RECORDING::OPEN_FAILED " << path << endl;
+		return false;
+	}
+
+	RecordingHeader header = { RECORDING_MAGIC, RECORDING_VERSION, cameraPose(camera) };
+	mData.assign(reinterpret_cast<const unsigned char*>(&header), reinterpret_cast<const unsigned char*>(&header) + sizeof(header));
+
+	mPath = path;
+	mStartTime = startTime;
+	mLastStamp = 0;
+	mKeys = 0;
+	mLastPoseTime = startTime;
+	mEvents = 0;
+	mRecording = true;
+
+	return true;
+}
+
+void InputRecorder::destroy(double endTime)
+{
+	if (!mRecording)
+		return;
+
+	writeEvent(EVENT_END, endTime, nullptr, 0);
+	mRecording = false;
+
+	ofstream file(mPath, ios::binary | ios::trunc);
+	file.write(reinterpret_cast<const char*>(mData.data()), mData.size());
+	if (!file)
+		cerr << "ERROR::INPUT_RECORDING::WRITE_FAILED " << mPath << endl;
+	else
+		cerr << "INFO: Input Recording: " << mEvents << " Events over " << (mLastStamp * 1e-6) << " s, "
+			<< mData.size() << " Bytes Written to " << mPath << endl;
+
+	mData.clear();
+	mData.shrink_to_fit();
+}
+
+void InputRecorder::recordKeys(double intervalStart, uint32_t keys)
+{
+	if (!mRecording || keys == mKeys)
+		return;
+
+	const uint16_t state = static_cast<uint16_t>(keys);
+	writeEvent(EVENT_KEYS, intervalStart, &state, sizeof(state));
+	mKeys = keys;
+}
+
+void InputRecorder::recordMouse(double time, float xOffset, float yOffset)
+{
+	if (!mRecording)
+		return;
+
+	const float offsets[2] = { xOffset, yOffset };
+	writeEvent(EVENT_MOUSE, time, offsets, sizeof(offsets));
+}
+
+void InputRecorder::recordScroll(double time, float offset)
+{
+	if (mRecording)
+		writeEvent(EVENT_SCROLL, time, &offset, sizeof(offset));
+}
+
+void InputRecorder::recordPose(double time, const Camera& camera)
+{
+	if (!mRecording || time - mLastPoseTime < POSE_INTERVAL)
+		return;
+
+	const InputPose pose = cameraPose(camera);
+	writeEvent(EVENT_POSE, time, &pose, sizeof(pose));
+	mLastPoseTime = time;
+}
+
+void InputRecorder::writeEvent(uint8_t type, double time, const void* payload, size_t size)
+{
+	// Timestamps Never Step Backwards, so the Replay can Consume Events in File Order
+	// ------------------------------------------------------------------------------
+	const long long micros = llround((time - mStartTime) * 1e6);
+	const uint64_t stamp = max(static_cast<uint64_t>(max(micros, 0LL)), mLastStamp);
+
+	mData.push_back(type);
+	mData.insert(mData.end(), reinterpret_cast<const unsigned char*>(&stamp), reinterpret_cast<const unsigned char*>(&stamp) + sizeof(stamp));
+	if (size)
+		mData.insert(mData.end(), static_cast<const unsigned char*>(payload), static_cast<const unsigned char*>(payload) + size);
+
+	mLastStamp = stamp;
+	++mEvents;
+}
+
+#pragma endregion
+
+#pragma region Replayer
+
+bool InputReplayer::create(const char* path)
+{
+	ifstream file(path, ios::binary);
+	mData.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+
+	// Error Check: Header
+	// -------------------
+	RecordingHeader header;
+	if (mData.size() < sizeof(header))
+	{
+		cerr << "ERROR::INPUT_REPLAY::OPEN_FAILED " << path << endl;
+		return false;
+	}
+
+	memcpy(&header, mData.data(), sizeof(header));
+	if (header.magic != RECORDING_MAGIC)
+	{
+		cerr << "ERROR::INPUT_REPLAY::NOT_A_RECORDING " << path << endl;
+		return false;
+	}
+	if (header.version != RECORDING_VERSION)
+	{
+		cerr << "ERROR::INPUT_REPLAY::UNSUPPORTED_VERSION " << header.version << " (Expected " << RECORDING_VERSION << ") in " << path << endl;
+		return false;
+	}
+
+	// Error Check: Every Event is Whole and Known; the Duration Comes from the Last One
+	// ---------------------------------------------------------------------------------
+	size_t cursor = sizeof(header);
+	uint64_t lastStamp = 0;
+	while (cursor < mData.size())
+	{
+		const uint8_t type = mData[cursor];
+		if (!isKnownEvent(type) || cursor + EVENT_HEADER_SIZE + payloadSize(type) > mData.size())
+		{
+			cerr << "ERROR::INPUT_REPLAY::CORRUPT_EVENT at Byte " << cursor << " of " << path << endl;
+			return false;
+		}
+
+		lastStamp = eventStamp(&mData[cursor]);
+		cursor += EVENT_HEADER_SIZE + payloadSize(type);
+	}
+
+	mStartPose = header.startPose;
+	mCursor = sizeof(header);
+	mTime = 0.0;
+	mDuration = lastStamp * 1e-6;
+	mKeys = 0;
+	mSteps = 0;
+	mEnded = false;
+	mMaxPositionDrift = 0.0f;
+	mMaxAngleDrift = 0.0f;
+
+	return true;
+}
+
+void InputReplayer::begin(Camera& camera) const
+{
+	camera.Position = mStartPose.position;
+	camera.Yaw = mStartPose.yaw;
+	camera.Pitch = mStartPose.pitch;
+	camera.Zoom = mStartPose.zoom;
+	camera.ProcessMouseMovement(0.0f, 0.0f);   // Rebuilds the Camera Vectors
+}
+
+bool InputReplayer::step(float seconds, Camera& camera)
+{
+	mScrollOffsets.clear();
+	if (mEnded)
+		return false;
+
+	const double end = mTime + seconds;
+
+	// Move for the Held Keys up to Each Event, then Apply it
+	// ------------------------------------------------------
+	while (mCursor < mData.size())
+	{
+		const double time = eventStamp(&mData[mCursor]) * 1e-6;
+		if (time > end)
+			break;
+
+		if (time > mTime)
+		{
+			moveCamera(camera, mKeys, static_cast<float>(time - mTime));
+			mTime = time;
+		}
+		applyEvent(camera);
+
+		if (mEnded)
+			break;
+	}
+
+	// A Truncated Recording Ends at its Last Event
+	// --------------------------------------------
+	if (mCursor >= mData.size())
+		mEnded = true;
+
+	if (!mEnded)
+	{
+		moveCamera(camera, mKeys, static_cast<float>(end - mTime));
+		mTime = end;
+	}
+
+	++mSteps;
+	return !mEnded;
+}
+
+void InputReplayer::applyEvent(Camera& camera)
+{
+	const unsigned char* event = &mData[mCursor];
+	const unsigned char* payload = event + EVENT_HEADER_SIZE;
+	mCursor += EVENT_HEADER_SIZE + payloadSize(event[0]);
+
+	switch (event[0])
+	{
+		case EVENT_KEYS:
+		{
+			uint16_t state;
+			memcpy(&state, payload, sizeof(state));
+			mKeys = state;
+		}
+		break;
+
+		case EVENT_MOUSE:
+		{
+			float offsets[2];
+			memcpy(offsets, payload, sizeof(offsets));
+			camera.ProcessMouseMovement(offsets[0], offsets[1]);
+		}
+		break;
+
+		case EVENT_SCROLL:
+		{
+			float offset;
+			memcpy(&offset, payload, sizeof(offset));
+			mScrollOffsets.push_back(offset);
+		}
+		break;
+
+		case EVENT_POSE:
+		{
+			InputPose pose;
+			memcpy(&pose, payload, sizeof(pose));
+			mMaxPositionDrift = max(mMaxPositionDrift, glm::length(camera.Position - pose.position));
+			mMaxAngleDrift = max(mMaxAngleDrift, max(abs(camera.Yaw - pose.yaw), abs(camera.Pitch - pose.pitch)));
+		}
+		break;
+
+		case EVENT_END:
+			mEnded = true;
+			break;
+	}
+}
+
+#pragma endregion
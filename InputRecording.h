@@ -0,0 +1,129 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>                // size_t
+#include <cstdint>                // uint8_t, uint32_t, uint64_t
+#include <string>                 // string
+#include <vector>                 // vector
+#include <glm/glm.hpp>
+#include <learnOpengl/camera.h>
+
+// Keys a Recording Tracks, One Bit Each in a Key State
+// ----------------------------------------------------
+enum InputKey : uint32_t
+{
+	INPUT_KEY_FORWARD = 1 << 0,
+	INPUT_KEY_BACKWARD = 1 << 1,
+	INPUT_KEY_LEFT = 1 << 2,
+	INPUT_KEY_RIGHT = 1 << 3,
+	INPUT_KEY_WIREFRAME = 1 << 4,
+	INPUT_KEY_FILL = 1 << 5,
+	INPUT_KEY_PROJECTION = 1 << 6
+};
+
+// Move the Camera for the Held Movement Keys; Shared by Live Input and Replay so Both
+// Integrate Exactly the Same Way
+// -----------------------------------------------------------------------------------
+void moveCamera(Camera& camera, uint32_t keys, float seconds);
+
+// Input Recording File
+// --------------------
+// A small header (magic, version, the camera's starting pose) followed by events, each
+// a type byte, a 64-bit timestamp in microseconds since the recording started, and its
+// payload: a key state when it changes, a mouse delta, a scroll offset, or the camera's
+// pose every POSE_INTERVAL seconds. A key state is stamped with the start of the frame
+// interval it moved the camera over, and the mouse deltas with the frame they were
+// applied after, so replaying the events in order reproduces the live camera path
+// independent of the frame rate the recording was made at. The recorded poses are only
+// used to measure drift.
+struct InputPose
+{
+	glm::vec3 position = glm::vec3(0.0f);
+	float yaw = 0.0f;
+	float pitch = 0.0f;
+	float zoom = 0.0f;
+};
+
+// Records Live Input to a Recording File
+// --------------------------------------
+class InputRecorder
+{
+public:
+	static constexpr double POSE_INTERVAL = 0.25;   // Seconds Between Recorded Poses
+
+	// Start a Recording at startTime (glfwGetTime() Seconds) from the Camera's Current Pose
+	// -------------------------------------------------------------------------------------
+	bool create(const char* path, const Camera& camera, double startTime);
+
+	// Write the End Event and the File
+	// --------------------------------
+	void destroy(double endTime);
+
+	// The Key State that Moved the Camera from intervalStart to the Current Frame
+	// --------------------------------------------------------------------------
+	void recordKeys(double intervalStart, uint32_t keys);
+	void recordMouse(double time, float xOffset, float yOffset);
+	void recordScroll(double time, float offset);
+
+	// Record the Camera's Pose if POSE_INTERVAL has Passed; Call After Moving it
+	// ------------------------------------------------------------------------
+	void recordPose(double time, const Camera& camera);
+
+	size_t eventCount() const { return mEvents; }
+
+private:
+	void writeEvent(uint8_t type, double time, const void* payload, size_t size);
+
+	std::string mPath;
+	std::vector<unsigned char> mData;   // Whole File, Written Once by destroy()
+	double mStartTime = 0.0;
+	uint64_t mLastStamp = 0;
+	uint32_t mKeys = 0;
+	double mLastPoseTime = 0.0;
+	size_t mEvents = 0;
+	bool mRecording = false;
+};
+
+// Replays a Recording File with a Fixed Timestep
+// ----------------------------------------------
+// Each step() advances the replay clock by the same amount, however long the frame took to
+// render, and drives the camera through every event up to the new time: held keys move it
+// for exactly the time between events, mouse deltas turn it. The same file and step give
+// the same camera on every frame of every run, on any machine and any build.
+class InputReplayer
+{
+public:
+	bool create(const char* path);
+
+	// Put the Camera in the Recording's Starting Pose
+	// -----------------------------------------------
+	void begin(Camera& camera) const;
+
+	// Advance by seconds; False Once the Recording has Ended
+	// ------------------------------------------------------
+	bool step(float seconds, Camera& camera);
+
+	uint32_t keys() const { return mKeys; }                                       // Key State at the End of the Step
+	const std::vector<float>& scrollOffsets() const { return mScrollOffsets; }   // Scroll Events in the Step
+
+	double duration() const { return mDuration; }
+	size_t stepCount() const { return mSteps; }
+	float maxPositionDrift() const { return mMaxPositionDrift; }   // Against the Recorded Poses
+	float maxAngleDrift() const { return mMaxAngleDrift; }         // Degrees
+
+private:
+	void applyEvent(Camera& camera);
+
+	std::vector<unsigned char> mData;
+	size_t mCursor = 0;          // Next Event in mData
+	InputPose mStartPose;
+	double mTime = 0.0;          // Replay Clock, Seconds Since the Recording Started
+	double mDuration = 0.0;
+	uint32_t mKeys = 0;
+	std::vector<float> mScrollOffsets;
+	size_t mSteps = 0;
+	bool mEnded = false;
+	float mMaxPositionDrift = 0.0f;
+	float mMaxAngleDrift = 0.0f;
+};
@@ -0,0 +1,421 @@
+#include "JobSystem.h"
+
+#include <algorithm>   // min, max
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	// Index of the Calling Thread within the Pool that Owns it
+	// --------------------------------------------------------
+	thread_local const void* tOwner = nullptr;
+	thread_local unsigned tThreadIndex = 0;
+
+	// Spins Before a Worker Goes to Sleep on the Condition Variable
+	// -------------------------------------------------------------
+	const int IDLE_SPINS = 64;
+}
+
+#pragma region Work-Stealing Queue
+
+// Owner Only: Add a Job to the Bottom of the Deque
+// ------------------------------------------------
+bool JobSystem::WorkStealingQueue::push(Job* job)
+{
+	int64_t bottom = mBottom.load(std::memory_order_relaxed);
+	int64_t top = mTop.load(std::memory_order_acquire);
+
+	if (bottom - top >= CAPACITY)
+		return false;   // Full: Caller Runs the Job Inline
+
+	mJobs[bottom & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	mBottom.store(bottom + 1, std::memory_order_relaxed);
+
+	return true;
+}
+
+// Owner Only: Take the Most Recently Pushed Job
+// ---------------------------------------------
+JobSystem::Job* JobSystem::WorkStealingQueue::pop()
+{
+	int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+	mBottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t top = mTop.load(std::memory_order_relaxed);
+
+	if (top > bottom)
+	{
+		// Empty: Restore Bottom
+		// ---------------------
+		mBottom.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job* job = mJobs[bottom & (CAPACITY - 1)].load(std::memory_order_relaxed);
+
+	if (top == bottom)
+	{
+		// Last Job: Race Against Thieves for it
+		// -------------------------------------
+		if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			job = nullptr;
+
+		mBottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	return job;
+}
+
+// Any Thread: Take the Oldest Job from the Top of the Deque
+// ---------------------------------------------------------
+JobSystem::Job* JobSystem::WorkStealingQueue::steal()
+{
+	int64_t top = mTop.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t bottom = mBottom.load(std::memory_order_acquire);
+
+	if (top >= bottom)
+		return nullptr;
+
+	Job* job = mJobs[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+
+	if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		return nullptr;   // Lost the Race to Another Thief or the Owner
+
+	return job;
+}
+
+#pragma endregion
+
+#pragma region Job System
+
+// Create the Worker Threads; the Calling Thread Becomes Thread 0
+// --------------------------------------------------------------
+JobSystem::JobSystem(unsigned threadCount)
+{
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	for (unsigned i = 0; i < threadCount; ++i)
+		mQueues.emplace_back(new ThreadQueue());
+
+	tOwner = this;
+	tThreadIndex = 0;
+
+	for (unsigned i = 1; i < threadCount; ++i)
+		mWorkers.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+// Wake and Join Every Worker
+// --------------------------
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(mSleepMutex);
+		mRunning.store(false);
+	}
+	mWakeCondition.notify_all();
+
+	for (std::thread& worker : mWorkers)
+		worker.join();
+
+	if (tOwner == this)
+		tOwner = nullptr;
+}
+
+void JobSystem::schedule(JobFunction function, JobCounter* counter)
+{
+	if (counter)
+		counter->value.fetch_add(1, std::memory_order_relaxed);
+
+	unsigned threadIndex = currentThreadIndex();
+
+	// Outside the Pool: Deque Pushes are Owner-Only, so Queue the Job Under the Lock
+	// ------------------------------------------------------------------------------
+	if (threadIndex == EXTERNAL_THREAD)
+	{
+		mPendingJobs.fetch_add(1);
+		{
+			std::lock_guard<std::mutex> lock(mInjectionMutex);
+			mInjectedJobs.push_back({ std::move(function), counter });
+			mInjectedCount.fetch_add(1);
+		}
+
+		if (mSleepingWorkers.load() > 0)
+		{
+			std::lock_guard<std::mutex> lock(mSleepMutex);
+			mWakeCondition.notify_one();
+		}
+		return;
+	}
+
+	Job* job = allocateJob(threadIndex);
+
+	// No Free Slot: Execute Immediately on this Thread
+	// ------------------------------------------------
+	if (!job)
+	{
+		function();
+		if (counter)
+			counter->value.fetch_sub(1, std::memory_order_release);
+		return;
+	}
+
+	job->function = std::move(function);
+	job->counter = counter;
+
+	mPendingJobs.fetch_add(1);
+	if (!mQueues[threadIndex]->deque.push(job))
+	{
+		mPendingJobs.fetch_sub(1);
+		runJob(job);
+		return;
+	}
+
+	// Wake a Sleeping Worker; Taking the Lock Prevents a Lost Wake-Up
+	// ---------------------------------------------------------------
+	if (mSleepingWorkers.load() > 0)
+	{
+		std::lock_guard<std::mutex> lock(mSleepMutex);
+		mWakeCondition.notify_one();
+	}
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+	unsigned threadIndex = currentThreadIndex();
+
+	while (!counter.isDone())
+	{
+		if (!executeOne(threadIndex))
+			std::this_thread::yield();
+	}
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize, const RangeFunction& function)
+{
+	if (count == 0)
+		return;
+
+	grainSize = std::max<size_t>(1, grainSize);
+
+	// Small Ranges are not Worth the Scheduling Overhead
+	// --------------------------------------------------
+	if (count <= grainSize || threadCount() == 1)
+	{
+		function(0, count);
+		return;
+	}
+
+	// A Few Chunks per Thread Leaves Room for Stealing to Balance the Load
+	// --------------------------------------------------------------------
+	size_t chunkCount = std::min<size_t>((count + grainSize - 1) / grainSize, static_cast<size_t>(threadCount()) * 4);
+	size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+	// Each Chunk Captures a Pointer to the Shared Range and its Start: Small Enough for
+	// std::function's Inline Buffer, so Scheduling a Chunk Never Allocates
+	// --------------------------------------------------------------------------------
+	struct Range
+	{
+		const RangeFunction* function;
+		size_t chunkSize;
+		size_t count;
+	};
+	const Range range = { &function, chunkSize, count };
+
+	JobCounter counter;
+	for (size_t begin = chunkSize; begin < count; begin += chunkSize)
+	{
+		schedule([&range, begin]() { (*range.function)(begin, std::min(begin + range.chunkSize, range.count)); }, &counter);
+	}
+
+	// The Calling Thread Takes the First Chunk Itself
+	// -----------------------------------------------
+	function(0, std::min(chunkSize, count));
+
+	wait(counter);
+}
+
+// Worker Thread: Run Jobs, Sleep when the Whole Pool is Idle
+// ----------------------------------------------------------
+void JobSystem::workerLoop(unsigned threadIndex)
+{
+	tOwner = this;
+	tThreadIndex = threadIndex;
+
+	int idleSpins = 0;
+	while (mRunning.load(std::memory_order_relaxed))
+	{
+		if (executeOne(threadIndex))
+		{
+			idleSpins = 0;
+			continue;
+		}
+
+		if (++idleSpins < IDLE_SPINS)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mSleepMutex);
+		mSleepingWorkers.fetch_add(1);
+		mWakeCondition.wait(lock, [this]() { return mPendingJobs.load() > 0 || !mRunning.load(); });
+		mSleepingWorkers.fetch_sub(1);
+		idleSpins = 0;
+	}
+}
+
+bool JobSystem::executeOne(unsigned threadIndex)
+{
+	Job* job = findJob(threadIndex);
+	if (!job)
+		return runInjectedJob();
+
+	runJob(job);
+	return true;
+}
+
+// Own Deque First, then Steal Round-Robin Starting After this Thread; a Thread Outside
+// the Pool Only Steals
+// ------------------------------------------------------------------------------------
+JobSystem::Job* JobSystem::findJob(unsigned threadIndex)
+{
+	unsigned count = threadCount();
+	Job* job = nullptr;
+	if (threadIndex == EXTERNAL_THREAD)
+	{
+		for (unsigned i = 0; !job && i < count; ++i)
+			job = mQueues[i]->deque.steal();
+	}
+	else
+	{
+		job = mQueues[threadIndex]->deque.pop();
+		for (unsigned i = 1; !job && i < count; ++i)
+			job = mQueues[(threadIndex + i) % count]->deque.steal();
+	}
+
+	if (job)
+		mPendingJobs.fetch_sub(1);
+
+	return job;
+}
+
+// Claim a Job Slot that is not Still Sitting in a Deque
+// -----------------------------------------------------
+JobSystem::Job* JobSystem::allocateJob(unsigned threadIndex)
+{
+	ThreadQueue& queue = *mQueues[threadIndex];
+
+	for (int64_t attempt = 0; attempt < WorkStealingQueue::CAPACITY; ++attempt)
+	{
+		Job& job = queue.jobPool[queue.nextJob++ & (WorkStealingQueue::CAPACITY - 1)];
+		if (!job.queued.load(std::memory_order_acquire))
+		{
+			job.queued.store(true, std::memory_order_relaxed);
+			return &job;
+		}
+	}
+
+	return nullptr;
+}
+
+// Move the Work Out so the Slot can be Reused, then Run it
+// --------------------------------------------------------
+void JobSystem::runJob(Job* job)
+{
+	JobFunction function = std::move(job->function);
+	JobCounter* counter = job->counter;
+	job->function = nullptr;
+	job->queued.store(false, std::memory_order_release);
+
+	function();
+
+	if (counter)
+		counter->value.fetch_sub(1, std::memory_order_release);
+}
+
+// Take the Oldest Job Scheduled from Outside the Pool, if Any, and Run it
+// -----------------------------------------------------------------------
+bool JobSystem::runInjectedJob()
+{
+	if (mInjectedCount.load() == 0)
+		return false;
+
+	InjectedJob job;
+	{
+		std::lock_guard<std::mutex> lock(mInjectionMutex);
+		if (mInjectedJobs.empty())
+			return false;
+
+		job = std::move(mInjectedJobs.front());
+		mInjectedJobs.pop_front();
+		mInjectedCount.fetch_sub(1);
+	}
+	mPendingJobs.fetch_sub(1);
+
+	job.function();
+
+	if (job.counter)
+		job.counter->value.fetch_sub(1, std::memory_order_release);
+	return true;
+}
+
+unsigned JobSystem::currentThreadIndex() const
+{
+	return tOwner == this ? tThreadIndex : EXTERNAL_THREAD;
+}
+
+#pragma endregion
+
+#pragma region Task Graph
+
+TaskGraph::TaskId TaskGraph::addTask(JobSystem::JobFunction function)
+{
+	mNodes.emplace_back();
+	mNodes.back().function = std::move(function);
+	return mNodes.size() - 1;
+}
+
+void TaskGraph::addDependency(TaskId before, TaskId after)
+{
+	mNodes[before].successors.push_back(after);
+	++mNodes[after].dependencyCount;
+}
+
+void TaskGraph::execute(JobSystem& jobs)
+{
+	// Reset Dependency Counters so the Graph can be Replayed
+	// ------------------------------------------------------
+	for (Node& node : mNodes)
+		node.remaining->store(node.dependencyCount, std::memory_order_relaxed);
+
+	JobCounter counter;
+	for (TaskId id = 0; id < mNodes.size(); ++id)
+	{
+		if (mNodes[id].dependencyCount == 0)
+			scheduleNode(jobs, id, counter);
+	}
+
+	jobs.wait(counter);
+}
+
+// Run a Node, then Release Every Successor whose Last Dependency it Was
+// ---------------------------------------------------------------------
+void TaskGraph::scheduleNode(JobSystem& jobs, TaskId id, JobCounter& counter)
+{
+	jobs.schedule([this, &jobs, id, &counter]()
+	{
+		Node& node = mNodes[id];
+		node.function();
+
+		for (TaskId successor : node.successors)
+		{
+			if (mNodes[successor].remaining->fetch_sub(1, std::memory_order_acq_rel) == 1)
+				scheduleNode(jobs, successor, counter);
+		}
+	}, &counter);
+}
+
+#pragma endregion
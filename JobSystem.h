@@ -0,0 +1,157 @@
+#pragma once
+
+// Includes
+// -------
+#include <atomic>               // atomic counters and deque indices
+#include <condition_variable>   // worker sleep / wake
+#include <cstddef>              // size_t
+#include <cstdint>              // int64_t
+#include <deque>                // deque
+#include <functional>           // std::function
+#include <memory>               // unique_ptr
+#include <mutex>                // mutex
+#include <thread>               // std::thread
+#include <vector>               // vector
+
+// Job Counter: Tracks how many Scheduled Jobs are Still Outstanding
+// -----------------------------------------------------------------
+struct JobCounter
+{
+	std::atomic<int> value{ 0 };
+
+	bool isDone() const { return value.load(std::memory_order_acquire) == 0; }
+};
+
+// Fixed-Size Worker Pool with Per-Thread Work-Stealing Deques
+// -----------------------------------------------------------
+// Every thread (the main thread is thread 0) owns a Chase-Lev deque. A thread pushes and
+// pops jobs at the bottom of its own deque, idle threads steal from the top of the others.
+// Threads outside the pool own no deque: their jobs go to a locked injection queue that
+// any pool thread drains, and while waiting they only steal. Waiting on a counter never
+// blocks the caller: it keeps executing jobs until the counter reaches zero, so nested
+// parallelFor / task graphs cannot deadlock the pool.
+class JobSystem
+{
+public:
+	using JobFunction = std::function<void()>;
+	using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+	// 0 Threads Means One Thread per Hardware Core (Including the Calling Thread)
+	// ---------------------------------------------------------------------------
+	explicit JobSystem(unsigned threadCount = 0);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// Total Threads Executing Jobs, Including the Thread that Created the Pool
+	// ------------------------------------------------------------------------
+	unsigned threadCount() const { return static_cast<unsigned>(mQueues.size()); }
+
+	// Queue a Job; the Counter is Incremented Now and Decremented when the Job Finishes
+	// ---------------------------------------------------------------------------------
+	void schedule(JobFunction function, JobCounter* counter);
+
+	// Execute Pending Jobs on the Calling Thread Until the Counter Reaches Zero
+	// -------------------------------------------------------------------------
+	void wait(JobCounter& counter);
+
+	// Split [0, count) into Chunks of at Least grainSize and Run them Across the Pool
+	// -------------------------------------------------------------------------------
+	void parallelFor(size_t count, size_t grainSize, const RangeFunction& function);
+
+private:
+	struct Job
+	{
+		JobFunction function;
+		JobCounter* counter = nullptr;
+		std::atomic<bool> queued{ false };   // Slot Cannot be Reused while Set
+	};
+
+	// Chase-Lev Deque: Owner Pushes / Pops the Bottom, Thieves Steal the Top
+	// ----------------------------------------------------------------------
+	class WorkStealingQueue
+	{
+	public:
+		static const int64_t CAPACITY = 4096;   // Must be a Power of Two
+
+		bool push(Job* job);
+		Job* pop();
+		Job* steal();
+
+	private:
+		std::atomic<int64_t> mTop{ 0 };
+		std::atomic<int64_t> mBottom{ 0 };
+		std::atomic<Job*> mJobs[CAPACITY];
+	};
+
+	// Per-Thread State: Own Deque and a Ring of Reusable Job Slots
+	// ------------------------------------------------------------
+	struct ThreadQueue
+	{
+		WorkStealingQueue deque;
+		std::unique_ptr<Job[]> jobPool{ new Job[WorkStealingQueue::CAPACITY] };
+		uint32_t nextJob = 0;
+	};
+
+	// Job Scheduled by a Thread Outside the Pool
+	// ------------------------------------------
+	struct InjectedJob
+	{
+		JobFunction function;
+		JobCounter* counter = nullptr;
+	};
+
+	static const unsigned EXTERNAL_THREAD = ~0u;   // currentThreadIndex() Outside the Pool
+
+	void workerLoop(unsigned threadIndex);
+	bool executeOne(unsigned threadIndex);
+	Job* findJob(unsigned threadIndex);
+	Job* allocateJob(unsigned threadIndex);
+	void runJob(Job* job);
+	bool runInjectedJob();
+	unsigned currentThreadIndex() const;
+
+	std::vector<std::unique_ptr<ThreadQueue>> mQueues;
+	std::vector<std::thread> mWorkers;
+
+	std::mutex mInjectionMutex;
+	std::deque<InjectedJob> mInjectedJobs;
+	std::atomic<int> mInjectedCount{ 0 };   // Read Without the Lock to Skip an Empty Queue
+
+	std::atomic<bool> mRunning{ true };
+	std::atomic<int> mPendingJobs{ 0 };
+	std::atomic<int> mSleepingWorkers{ 0 };
+	std::mutex mSleepMutex;
+	std::condition_variable mWakeCondition;
+};
+
+// Task Graph: Jobs with Explicit Dependencies Tracked by Per-Node Counters
+// ------------------------------------------------------------------------
+// A node is scheduled once all of its predecessors have finished. execute() starts every
+// node without predecessors and returns when the whole graph is done; graphs can be
+// executed again every frame without being rebuilt.
+class TaskGraph
+{
+public:
+	using TaskId = size_t;
+
+	TaskId addTask(JobSystem::JobFunction function);
+	void addDependency(TaskId before, TaskId after);
+
+	void execute(JobSystem& jobs);
+	void clear() { mNodes.clear(); }
+
+private:
+	struct Node
+	{
+		JobSystem::JobFunction function;
+		std::vector<TaskId> successors;
+		int dependencyCount = 0;
+		std::unique_ptr<std::atomic<int>> remaining{ new std::atomic<int>(0) };
+	};
+
+	void scheduleNode(JobSystem& jobs, TaskId id, JobCounter& counter);
+
+	std::vector<Node> mNodes;
+};
@@ -0,0 +1,669 @@
+#include "Lightmaps.h"
+#include "JobSystem.h"
+#include "ShaderUniforms.h"
+
+#include <algorithm>   // sort, min, max
+#include <array>       // array
+#include <cfloat>      // FLT_MAX
+#include <cmath>       // ceil, floor, sqrt, cos, sin
+#include <fstream>     // ifstream, ofstream
+#include <iostream>    // cerr
+#include <map>         // map
+#include <unordered_map> // unordered_map
+#include <glm/gtc/packing.hpp>
+
+using namespace std;
+using namespace glm;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	// Atlas File: Header, then size * size Half-Float RGBA Texels
+	// -----------------------------------------------------------
+	const uint32_t LIGHTMAP_MAGIC = 0x4D4C5448;   // "HTLM"
+	const uint32_t LIGHTMAP_VERSION = 1;
+
+	struct FileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t size;
+		uint32_t chartCount;
+		uint64_t hash;
+	};
+
+	const float FILL_RATIO = 0.7f;          // Share of the Atlas the First Packing Attempt Aims to Cover
+	const float DENSITY_STEP = 0.9f;        // Density Kept after a Failed Packing Attempt
+	const float MIN_DENSITY = 1e-3f;
+	const float WELD_SCALE = 1e4f;          // Vertices Closer than 1 / WELD_SCALE Share Edges
+	const float SAMPLE_RADIUS = 1.0f;       // Texels Outside a Triangle Still Lit from its Nearest Point
+	const float RAY_OFFSET = 2e-3f;         // Lift Off the Surface so Rays Miss their Own Triangle
+	const float FAR_DISTANCE = 1e6f;
+	const size_t BAKE_GRAIN = 64;           // Texels per Job
+
+	// FNV-1a, 64-Bit
+	// --------------
+	const uint64_t FNV_OFFSET = 14695981039346656037ull;
+	const uint64_t FNV_PRIME = 1099511628211ull;
+
+	uint64_t hashBytes(uint64_t hash, const void* data, size_t size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; ++i)
+			hash = (hash ^ bytes[i]) * FNV_PRIME;
+		return hash;
+	}
+
+	template <typename T>
+	uint64_t hashValue(uint64_t hash, const T& value)
+	{
+		return hashBytes(hash, &value, sizeof(value));
+	}
+
+	// Per-Texel Random Stream, so a Bake Gives the Same Atlas however the Jobs are Split
+	// ---------------------------------------------------------------------------------
+	struct Random
+	{
+		uint32_t state;
+
+		explicit Random(uint32_t seed) : state(seed * 747796405u + 2891336453u) { next(); }
+
+		float next()
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			return (state >> 8) * (1.0f / 16777216.0f);
+		}
+	};
+
+	// Cosine-Weighted Direction Around n, through an Orthonormal Basis without Branches on n
+	// -------------------------------------------------------------------------------------
+	vec3 cosineDirection(const vec3& n, Random& random)
+	{
+		const float sign = n.z >= 0.0f ? 1.0f : -1.0f;
+		const float a = -1.0f / (sign + n.z);
+		const float b = n.x * n.y * a;
+		const vec3 tangent(1.0f + sign * n.x * n.x * a, sign * b, -sign * n.x);
+		const vec3 bitangent(b, sign + n.y * n.y * a, -n.y);
+
+		const float angle = 6.28318531f * random.next();
+		const float radiusSquared = random.next();
+		const float radius = sqrt(radiusSquared);
+		return tangent * (radius * cos(angle)) + bitangent * (radius * sin(angle)) + n * sqrt(1.0f - radiusSquared);
+	}
+
+	uint64_t edgeKey(uint32_t a, uint32_t b)
+	{
+		return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+	}
+}
+
+bool Lightmap::unwrap(const vector<LightmapInstance>& instances, int size)
+{
+	mSize = size;
+	mVertices.clear();
+	mCornerNormals.clear();
+	mFaceNormals.clear();
+	mTriangleInstance.clear();
+	mAlbedos.clear();
+	mInstanceFirstTriangle.clear();
+	mCharts.clear();
+	mCoordinates.assign(instances.size(), vector<vec2>());
+	mTexels.clear();
+
+	// Every Instance's Triangles in World Space
+	// -----------------------------------------
+	for (size_t i = 0; i < instances.size(); ++i)
+	{
+		const LightmapInstance& instance = instances[i];
+		mInstanceFirstTriangle.push_back(mTriangleInstance.size());
+		mAlbedos.push_back(instance.albedo);
+		mCoordinates[i].assign(instance.indexCount, vec2(0.0f));
+
+		for (size_t k = 0; k + 2 < instance.indexCount; k += 3)
+		{
+			vec3 corners[3];
+			vec3 normalSum(0.0f);
+			for (int c = 0; c < 3; ++c)
+			{
+				const size_t vertex = instance.indices[k + c] * instance.stride;
+				const float* position = instance.positions + vertex;
+				const float* normal = instance.normals + vertex;
+
+				corners[c] = vec3(instance.model * vec4(position[0], position[1], position[2], 1.0f));
+				vec3 worldNormal = instance.normalMatrix * vec3(normal[0], normal[1], normal[2]);
+				const float length = glm::length(worldNormal);
+				worldNormal = length > 0.0f ? worldNormal / length : vec3(0.0f);
+
+				mVertices.push_back(corners[c]);
+				mCornerNormals.push_back(worldNormal);
+				normalSum += worldNormal;
+			}
+
+			// Face Normal on the Side the Vertex Normals Point To; Zero for Degenerate Triangles
+			// ---------------------------------------------------------------------------------
+			vec3 face = cross(corners[1] - corners[0], corners[2] - corners[0]);
+			const float area = glm::length(face);
+			face = area > 0.0f ? face / area : vec3(0.0f);
+			if (dot(face, normalSum) < 0.0f)
+				face = -face;
+
+			mFaceNormals.push_back(face);
+			mTriangleInstance.push_back(static_cast<uint32_t>(i));
+		}
+	}
+	mInstanceFirstTriangle.push_back(mTriangleInstance.size());
+
+	if (mTriangleInstance.empty())
+	{
+		cerr << "ERROR::LIGHTMAP::NO_TRIANGLES" << endl;
+		return false;
+	}
+
+	mBvh.build(mVertices);
+
+	mGeometryHash = hashValue(FNV_OFFSET, LIGHTMAP_VERSION);
+	mGeometryHash = hashValue(mGeometryHash, mSize);
+	mGeometryHash = hashBytes(mGeometryHash, mVertices.data(), mVertices.size() * sizeof(vec3));
+	mGeometryHash = hashBytes(mGeometryHash, mCornerNormals.data(), mCornerNormals.size() * sizeof(vec3));
+	mGeometryHash = hashBytes(mGeometryHash, mAlbedos.data(), mAlbedos.size() * sizeof(vec3));
+	mGeometryHash = hashBytes(mGeometryHash, mInstanceFirstTriangle.data(), mInstanceFirstTriangle.size() * sizeof(size_t));
+
+	// Grow Charts Across Shared Edges of Each Instance
+	// ------------------------------------------------
+	const float minCosine = cos(radians(CHART_ANGLE));
+	vector<int32_t> triangleChart(mTriangleInstance.size(), -1);
+
+	for (size_t i = 0; i < instances.size(); ++i)
+	{
+		const size_t first = mInstanceFirstTriangle[i];
+		const size_t last = mInstanceFirstTriangle[i + 1];
+
+		// Weld Corners by Position: Meshes Split Vertices at UV and Normal Seams
+		// ----------------------------------------------------------------------
+		map<array<int64_t, 3>, uint32_t> weldedIds;
+		vector<uint32_t> cornerIds((last - first) * 3);
+		for (size_t corner = 0; corner < cornerIds.size(); ++corner)
+		{
+			const vec3& position = mVertices[first * 3 + corner];
+			const array<int64_t, 3> key = { llround(position.x * WELD_SCALE), llround(position.y * WELD_SCALE), llround(position.z * WELD_SCALE) };
+			cornerIds[corner] = weldedIds.emplace(key, static_cast<uint32_t>(weldedIds.size())).first->second;
+		}
+
+		unordered_map<uint64_t, vector<uint32_t>> edgeTriangles;
+		for (size_t t = first; t < last; ++t)
+		{
+			const uint32_t* ids = &cornerIds[(t - first) * 3];
+			for (int e = 0; e < 3; ++e)
+			{
+				if (ids[e] != ids[(e + 1) % 3])
+					edgeTriangles[edgeKey(ids[e], ids[(e + 1) % 3])].push_back(static_cast<uint32_t>(t));
+			}
+		}
+
+		for (size_t seed = first; seed < last; ++seed)
+		{
+			if (triangleChart[seed] >= 0 || mFaceNormals[seed] == vec3(0.0f))
+				continue;
+
+			// Neighbours Join while they Face Within CHART_ANGLE of the Seed
+			// --------------------------------------------------------------
+			const vec3 seedNormal = mFaceNormals[seed];
+			Chart chart;
+			triangleChart[seed] = static_cast<int32_t>(mCharts.size());
+			chart.triangles.push_back(static_cast<uint32_t>(seed));
+
+			for (size_t next = 0; next < chart.triangles.size(); ++next)
+			{
+				const uint32_t t = chart.triangles[next];
+				const uint32_t* ids = &cornerIds[(t - first) * 3];
+				for (int e = 0; e < 3; ++e)
+				{
+					auto edge = edgeTriangles.find(edgeKey(ids[e], ids[(e + 1) % 3]));
+					if (edge == edgeTriangles.end())
+						continue;
+
+					for (uint32_t neighbour : edge->second)
+					{
+						if (triangleChart[neighbour] >= 0 || dot(mFaceNormals[neighbour], seedNormal) < minCosine)
+							continue;
+
+						triangleChart[neighbour] = static_cast<int32_t>(mCharts.size());
+						chart.triangles.push_back(neighbour);
+					}
+				}
+			}
+
+			// Project onto the Seed's Plane
+			// -----------------------------
+			const vec3 reference = fabs(seedNormal.y) < 0.99f ? vec3(0.0f, 1.0f, 0.0f) : vec3(1.0f, 0.0f, 0.0f);
+			chart.axisU = normalize(cross(reference, seedNormal));
+			chart.axisV = cross(seedNormal, chart.axisU);
+			chart.planeMin = vec2(FLT_MAX);
+			chart.planeMax = vec2(-FLT_MAX);
+			for (uint32_t t : chart.triangles)
+			{
+				for (int c = 0; c < 3; ++c)
+				{
+					const vec3& position = mVertices[t * 3 + c];
+					const vec2 projected(dot(position, chart.axisU), dot(position, chart.axisV));
+					chart.planeMin = min(chart.planeMin, projected);
+					chart.planeMax = max(chart.planeMax, projected);
+				}
+			}
+
+			mCharts.push_back(chart);
+		}
+	}
+
+	// Densest Uniform Scale that Packs, Starting from the One that Would Fill FILL_RATIO
+	// ---------------------------------------------------------------------------------
+	double chartArea = 0.0;
+	for (const Chart& chart : mCharts)
+		chartArea += static_cast<double>(chart.planeMax.x - chart.planeMin.x) * (chart.planeMax.y - chart.planeMin.y);
+
+	float density = chartArea > 0.0 ? static_cast<float>(sqrt(FILL_RATIO * mSize * mSize / chartArea)) : static_cast<float>(mSize);
+	while (!pack(density))
+	{
+		density *= DENSITY_STEP;
+		if (density < MIN_DENSITY)
+		{
+			cerr << "ERROR::LIGHTMAP::PACKING_FAILED " << mCharts.size() << " Charts Do Not Fit " << mSize << "x" << mSize << endl;
+			return false;
+		}
+	}
+
+	// Coordinates of Each Chart Corner, Normalized to the Atlas
+	// ---------------------------------------------------------
+	for (const Chart& chart : mCharts)
+	{
+		const vec2 origin(static_cast<float>(chart.x + PADDING), static_cast<float>(chart.y + PADDING));
+		for (uint32_t t : chart.triangles)
+		{
+			const uint32_t instance = mTriangleInstance[t];
+			const size_t firstIndex = (t - mInstanceFirstTriangle[instance]) * 3;
+			for (int c = 0; c < 3; ++c)
+			{
+				const vec3& position = mVertices[t * 3 + c];
+				const vec2 projected(dot(position, chart.axisU), dot(position, chart.axisV));
+				mCoordinates[instance][firstIndex + c] = (origin + (projected - chart.planeMin) * mDensity) / static_cast<float>(mSize);
+			}
+		}
+	}
+
+	rasterizeCharts();
+	return true;
+}
+
+// Shelf Packing, Tallest Charts First
+// -----------------------------------
+bool Lightmap::pack(float density)
+{
+	vector<size_t> order(mCharts.size());
+	for (size_t i = 0; i < mCharts.size(); ++i)
+	{
+		Chart& chart = mCharts[i];
+		chart.width = static_cast<int>(ceil((chart.planeMax.x - chart.planeMin.x) * density)) + 1 + 2 * PADDING;
+		chart.height = static_cast<int>(ceil((chart.planeMax.y - chart.planeMin.y) * density)) + 1 + 2 * PADDING;
+		order[i] = i;
+	}
+	sort(order.begin(), order.end(), [this](size_t a, size_t b) { return mCharts[a].height > mCharts[b].height; });
+
+	int x = 0, y = 0, shelfHeight = 0;
+	for (size_t index : order)
+	{
+		Chart& chart = mCharts[index];
+		if (chart.width > mSize)
+			return false;
+
+		if (x + chart.width > mSize)
+		{
+			y += shelfHeight;
+			x = 0;
+			shelfHeight = 0;
+		}
+		if (y + chart.height > mSize)
+			return false;
+
+		chart.x = x;
+		chart.y = y;
+		x += chart.width;
+		shelfHeight = max(shelfHeight, chart.height);
+	}
+
+	mDensity = density;
+	return true;
+}
+
+// Pick the Surface Point of Every Texel a Chart Covers: Texel Centers Inside a Triangle,
+// or Within SAMPLE_RADIUS of One, which Keeps Thin Triangles and Chart Edges Lit
+// -------------------------------------------------------------------------------------
+void Lightmap::rasterizeCharts()
+{
+	const size_t texelCount = static_cast<size_t>(mSize) * mSize;
+	vector<float> nearest(texelCount, FLT_MAX);
+	vector<Sample> samples(texelCount);
+
+	for (const Chart& chart : mCharts)
+	{
+		for (uint32_t t : chart.triangles)
+		{
+			const uint32_t instance = mTriangleInstance[t];
+			const size_t firstIndex = (t - mInstanceFirstTriangle[instance]) * 3;
+			vec2 corners[3];
+			for (int c = 0; c < 3; ++c)
+				corners[c] = mCoordinates[instance][firstIndex + c] * static_cast<float>(mSize);
+
+			const vec2 low = min(corners[0], min(corners[1], corners[2])) - SAMPLE_RADIUS;
+			const vec2 high = max(corners[0], max(corners[1], corners[2])) + SAMPLE_RADIUS;
+			const int x0 = max(chart.x, static_cast<int>(floor(low.x)));
+			const int y0 = max(chart.y, static_cast<int>(floor(low.y)));
+			const int x1 = min(chart.x + chart.width - 1, static_cast<int>(ceil(high.x)));
+			const int y1 = min(chart.y + chart.height - 1, static_cast<int>(ceil(high.y)));
+
+			const vec2 edge1 = corners[1] - corners[0];
+			const vec2 edge2 = corners[2] - corners[0];
+			const float determinant = edge1.x * edge2.y - edge1.y * edge2.x;
+
+			for (int y = y0; y <= y1; ++y)
+			{
+				for (int x = x0; x <= x1; ++x)
+				{
+					const vec2 center(x + 0.5f, y + 0.5f);
+					vec3 weights(0.0f);
+					float distance = FLT_MAX;
+
+					if (fabs(determinant) > 1e-12f)
+					{
+						const vec2 offset = center - corners[0];
+						const float u = (offset.x * edge2.y - offset.y * edge2.x) / determinant;
+						const float v = (edge1.x * offset.y - edge1.y * offset.x) / determinant;
+						if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f)
+						{
+							weights = vec3(1.0f - u - v, u, v);
+							distance = 0.0f;
+						}
+					}
+
+					// Outside: Nearest Point on the Three Edges
+					// -----------------------------------------
+					for (int e = 0; e < 3 && distance > 0.0f; ++e)
+					{
+						const vec2& a = corners[e];
+						const vec2 edge = corners[(e + 1) % 3] - a;
+						const float lengthSquared = dot(edge, edge);
+						const float s = lengthSquared > 0.0f ? clamp(dot(center - a, edge) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+						const float edgeDistance = length(center - (a + edge * s));
+						if (edgeDistance < distance)
+						{
+							distance = edgeDistance;
+							weights = vec3(0.0f);
+							weights[e] = 1.0f - s;
+							weights[(e + 1) % 3] = s;
+						}
+					}
+
+					const size_t texel = static_cast<size_t>(y) * mSize + x;
+					if (distance > SAMPLE_RADIUS || distance >= nearest[texel])
+						continue;
+
+					nearest[texel] = distance;
+					Sample& sample = samples[texel];
+					sample.texel = static_cast<uint32_t>(texel);
+					sample.triangle = t;
+					sample.position = mVertices[t * 3] * weights.x + mVertices[t * 3 + 1] * weights.y + mVertices[t * 3 + 2] * weights.z;
+					const vec3 normal = mCornerNormals[t * 3] * weights.x + mCornerNormals[t * 3 + 1] * weights.y + mCornerNormals[t * 3 + 2] * weights.z;
+					sample.normal = dot(normal, normal) > 0.0f ? normalize(normal) : mFaceNormals[t];
+				}
+			}
+		}
+	}
+
+	mSamples.clear();
+	for (size_t texel = 0; texel < texelCount; ++texel)
+	{
+		if (nearest[texel] <= SAMPLE_RADIUS)
+			mSamples.push_back(samples[texel]);
+	}
+}
+
+uint64_t Lightmap::inputHash(const vector<PointLight>& lights, const LightmapSettings& settings) const
+{
+	uint64_t hash = hashBytes(mGeometryHash, lights.data(), lights.size() * sizeof(PointLight));
+	hash = hashValue(hash, settings.samples);
+	hash = hashValue(hash, settings.bounces);
+	hash = hashValue(hash, settings.occlusionDistance);
+	hash = hashValue(hash, settings.keyLightDirection);
+	return hashValue(hash, settings.keyLightColor);
+}
+
+void Lightmap::bake(JobSystem& jobs, const vector<PointLight>& lights, const LightmapSettings& settings)
+{
+	mTexels.assign(static_cast<size_t>(mSize) * mSize, vec4(0.0f));
+	mRays = 0;
+
+	jobs.parallelFor(mSamples.size(), BAKE_GRAIN, [&](size_t begin, size_t end)
+	{
+		uint64_t rays = 0;
+		for (size_t i = begin; i < end; ++i)
+			mTexels[mSamples[i].texel] = bakeTexel(mSamples[i], lights, settings, rays);
+		mRays += rays;
+	});
+
+	dilate();
+}
+
+// Irradiance from the Point Lights (the Shader's Windowed Falloff) and the Key Light, Both
+// Shadowed by Rays Lifted Along offsetNormal
+// --------------------------------------------------------------------------------------
+vec3 Lightmap::directLight(const vec3& position, const vec3& normal, const vec3& offsetNormal, const vector<PointLight>& lights,
+	const LightmapSettings& settings, uint64_t& rays) const
+{
+	const vec3 origin = position + offsetNormal * RAY_OFFSET;
+	vec3 result(0.0f);
+
+	for (const PointLight& light : lights)
+	{
+		const vec3 toLight = light.position - position;
+		const float distance = length(toLight);
+		if (distance >= light.radius || distance <= RAY_OFFSET)
+			continue;
+
+		const vec3 direction = toLight / distance;
+		const float impact = dot(normal, direction);
+		if (impact <= 0.0f)
+			continue;
+
+		++rays;
+		if (mBvh.occluded(origin, direction, distance - RAY_OFFSET))
+			continue;
+
+		const float window = clamp(1.0f - pow(distance / light.radius, 4.0f), 0.0f, 1.0f);
+		result += impact * light.color * light.intensity * window * window;
+	}
+
+	const vec3 keyDirection = -normalize(settings.keyLightDirection);
+	const float keyImpact = dot(normal, keyDirection);
+	if (keyImpact > 0.0f && settings.keyLightColor != vec3(0.0f))
+	{
+		++rays;
+		if (!mBvh.occluded(origin, keyDirection, FAR_DISTANCE))
+			result += keyImpact * settings.keyLightColor;
+	}
+
+	return result;
+}
+
+vec4 Lightmap::bakeTexel(const Sample& sample, const vector<PointLight>& lights, const LightmapSettings& settings, uint64_t& rays) const
+{
+	const vec3 faceNormal = mFaceNormals[sample.triangle];
+	const vec3 origin = sample.position + faceNormal * RAY_OFFSET;
+	const vec3 direct = directLight(sample.position, sample.normal, faceNormal, lights, settings, rays);
+
+	// Cosine-Weighted Paths: their Mean Radiance is the Indirect Irradiance in Shader Units
+	// ------------------------------------------------------------------------------------
+	Random random(sample.texel);
+	vec3 indirect(0.0f);
+	int unoccluded = 0;
+
+	for (int s = 0; s < settings.samples; ++s)
+	{
+		vec3 direction = cosineDirection(faceNormal, random);
+		Bvh::Hit hit;
+		++rays;
+		if (!mBvh.intersect(origin, direction, FAR_DISTANCE, hit))
+		{
+			++unoccluded;
+			continue;
+		}
+		if (hit.distance >= settings.occlusionDistance)
+			++unoccluded;
+
+		vec3 throughput(1.0f);
+		for (int bounce = 1; ; ++bounce)
+		{
+			const uint32_t t = hit.triangle;
+			vec3 normal = mFaceNormals[t];
+			if (normal == vec3(0.0f))
+				break;
+			if (dot(normal, direction) > 0.0f)
+				normal = -normal;
+
+			const vec3 position = mVertices[t * 3] * (1.0f - hit.u - hit.v) + mVertices[t * 3 + 1] * hit.u + mVertices[t * 3 + 2] * hit.v;
+			throughput *= mAlbedos[mTriangleInstance[t]];
+			indirect += throughput * directLight(position, normal, normal, lights, settings, rays);
+
+			if (bounce >= settings.bounces)
+				break;
+
+			direction = cosineDirection(normal, random);
+			++rays;
+			if (!mBvh.intersect(position + normal * RAY_OFFSET, direction, FAR_DISTANCE, hit))
+				break;
+		}
+	}
+
+	const float sampleCount = static_cast<float>(max(settings.samples, 1));
+	return vec4(direct + indirect / sampleCount, unoccluded / sampleCount);
+}
+
+// Grow Every Chart into its Padding, so Bilinear Taps at its Edge Read its Own Lighting
+// ------------------------------------------------------------------------------------
+void Lightmap::dilate()
+{
+	vector<unsigned char> covered(mTexels.size(), 0);
+	for (const Sample& sample : mSamples)
+		covered[sample.texel] = 1;
+
+	for (int pass = 0; pass < PADDING; ++pass)
+	{
+		const vector<unsigned char> previous = covered;
+		const vector<vec4> source = mTexels;
+		for (int y = 0; y < mSize; ++y)
+		{
+			for (int x = 0; x < mSize; ++x)
+			{
+				const size_t texel = static_cast<size_t>(y) * mSize + x;
+				if (previous[texel])
+					continue;
+
+				vec4 sum(0.0f);
+				int count = 0;
+				for (int dy = -1; dy <= 1; ++dy)
+				{
+					for (int dx = -1; dx <= 1; ++dx)
+					{
+						const int nx = x + dx, ny = y + dy;
+						if (nx < 0 || ny < 0 || nx >= mSize || ny >= mSize)
+							continue;
+
+						const size_t neighbour = static_cast<size_t>(ny) * mSize + nx;
+						if (previous[neighbour])
+						{
+							sum += source[neighbour];
+							++count;
+						}
+					}
+				}
+
+				if (count > 0)
+				{
+					mTexels[texel] = sum / static_cast<float>(count);
+					covered[texel] = 1;
+				}
+			}
+		}
+	}
+}
+
+bool Lightmap::save(const char* path, uint64_t hash) const
+{
+	ofstream file(path, ios::binary);
+	if (!file)
+	{
+		cerr << "ERROR::LIGHTMAP::WRITE_FAILED " << path << endl;
+		return false;
+	}
+
+	const FileHeader header = { LIGHTMAP_MAGIC, LIGHTMAP_VERSION, static_cast<uint32_t>(mSize), static_cast<uint32_t>(mCharts.size()), hash };
+	vector<uint64_t> packed(mTexels.size());
+	for (size_t i = 0; i < mTexels.size(); ++i)
+		packed[i] = packHalf4x16(mTexels[i]);
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(packed.data()), packed.size() * sizeof(uint64_t));
+	return static_cast<bool>(file);
+}
+
+bool Lightmap::load(const char* path, uint64_t hash)
+{
+	ifstream file(path, ios::binary);
+	FileHeader header;
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		return false;
+
+	if (header.magic != LIGHTMAP_MAGIC || header.version != LIGHTMAP_VERSION || header.size != static_cast<uint32_t>(mSize) || header.hash != hash)
+		return false;
+
+	vector<uint64_t> packed(static_cast<size_t>(mSize) * mSize);
+	if (!file.read(reinterpret_cast<char*>(packed.data()), packed.size() * sizeof(uint64_t)))
+		return false;
+
+	mTexels.resize(packed.size());
+	for (size_t i = 0; i < packed.size(); ++i)
+		mTexels[i] = unpackHalf4x16(packed[i]);
+
+	return true;
+}
+
+bool Lightmap::upload(RenderBackend& backend)
+{
+	if (mTexels.empty())
+		return false;
+
+	TextureDesc desc;
+	desc.width = mSize;
+	desc.height = mSize;
+	desc.format = TextureFormat::RGBA16F;
+	desc.wrap = TextureWrap::ClampToEdge;
+	desc.mipmaps = false;
+
+	mBackend = &backend;
+	mTexture = backend.createTexture(desc, mTexels.data());
+	return mTexture != 0;
+}
+
+void Lightmap::destroy()
+{
+	if (mBackend)
+		mBackend->destroyTexture(mTexture);
+	mTexture = 0;
+}
+
+void Lightmap::bind(CommandList& commands) const
+{
+	commands.bindTexture(LIGHTMAP_UNIT, mTexture);
+	commands.setUniform(Uniform::Lightmap, LIGHTMAP_UNIT);
+}
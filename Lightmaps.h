@@ -0,0 +1,145 @@
+#pragma once
+
+// Includes
+// -------
+#include <atomic>         // atomic ray counter
+#include <cstddef>        // size_t
+#include <cstdint>        // uint64_t
+#include <vector>         // vector
+#include <glm/glm.hpp>
+
+#include "Bvh.h"
+#include "ClusteredLighting.h"
+#include "RenderBackend.h"
+
+class JobSystem;
+
+// Static Object Handed to the Baker: Interleaved Model-Space Vertices and its Placement
+// ------------------------------------------------------------------------------------
+struct LightmapInstance
+{
+	const float* positions = nullptr;   // xyz Every stride Floats
+	const float* normals = nullptr;
+	size_t stride = 0;
+	const uint32_t* indices = nullptr;
+	size_t indexCount = 0;
+	glm::mat4 model = glm::mat4(1.0f);
+	glm::mat3 normalMatrix = glm::mat3(1.0f);
+	glm::vec3 albedo = glm::vec3(0.5f);   // Color Light Keeps when it Bounces Off the Surface
+};
+
+// What the Bake Path Traces
+// -------------------------
+struct LightmapSettings
+{
+	int samples = 64;                    // Hemisphere Paths per Texel
+	int bounces = 2;                     // Surfaces Each Path Scatters Off
+	float occlusionDistance = 1.0f;      // Occluders Farther than this Leave the Ambient Term Alone
+	glm::vec3 keyLightDirection = glm::vec3(0.0f, -1.0f, 0.0f);
+	glm::vec3 keyLightColor = glm::vec3(0.0f);
+};
+
+// Baked Lightmap Atlas for Static Geometry
+// ----------------------------------------
+// unwrap() grows planar charts over each instance's triangles (edge neighbours whose
+// normals stay within CHART_ANGLE of the chart's first triangle), projects each chart onto
+// its plane and shelf-packs the charts into a square atlas at the highest uniform texel
+// density that fits. bake() then path-traces every covered texel across the job system
+// against a Bvh of the whole static scene: direct light from the point lights and the key
+// light with shadow rays, and indirect light from cosine-weighted paths of up to `bounces`
+// diffuse bounces. The texels store irradiance in rgb and the share of hemisphere rays
+// escaping past occlusionDistance (ambient occlusion) in alpha. The irradiance is in the
+// shader's units, so albedo * rgb is what the Phong diffuse terms would have given, plus
+// the bounced light they miss. Charts are padded and dilated so bilinear filtering never
+// reads a neighbour. The atlas is saved with a hash of everything it was baked from, so a
+// changed scene, light or setting re-bakes instead of loading stale lighting.
+class Lightmap
+{
+public:
+	static const int DEFAULT_SIZE = 512;
+	static const int PADDING = 2;                  // Texels Between a Chart and its Rectangle's Edge
+	static const int32_t LIGHTMAP_UNIT = 4;         // Texture Unit the Atlas is Bound to
+	static constexpr float CHART_ANGLE = 12.0f;    // Degrees
+
+	// Error Check: Fails if the Instances Hold No Triangles
+	// -----------------------------------------------------
+	bool unwrap(const std::vector<LightmapInstance>& instances, int size);
+
+	// Hash of the Unwrapped Geometry, the Lights and the Settings
+	// -----------------------------------------------------------
+	uint64_t inputHash(const std::vector<PointLight>& lights, const LightmapSettings& settings) const;
+
+	void bake(JobSystem& jobs, const std::vector<PointLight>& lights, const LightmapSettings& settings);
+
+	// Half-Float Atlas on Disk; load() Fails on a Missing File or a Different Hash
+	// ---------------------------------------------------------------------------
+	bool save(const char* path, uint64_t hash) const;
+	bool load(const char* path, uint64_t hash);
+
+	bool upload(RenderBackend& backend);
+	void destroy();
+
+	// Record Binding the Atlas to LIGHTMAP_UNIT and Pointing the Sampler at it
+	// ------------------------------------------------------------------------
+	void bind(CommandList& commands) const;
+
+	// Lightmap Coordinates of Each of an Instance's Indices, in Index Order
+	// ---------------------------------------------------------------------
+	const std::vector<glm::vec2>& coordinates(size_t instance) const { return mCoordinates[instance]; }
+
+	int size() const { return mSize; }
+	size_t chartCount() const { return mCharts.size(); }
+	float density() const { return mDensity; }        // Texels per World Unit
+	size_t texelCount() const { return mSamples.size(); }
+	uint64_t rayCount() const { return mRays.load(); }
+
+private:
+	struct Chart
+	{
+		std::vector<uint32_t> triangles;
+		glm::vec3 axisU, axisV;      // Plane the Chart is Projected On
+		glm::vec2 planeMin, planeMax;
+		int x = 0, y = 0;            // Atlas Rectangle, Padding Included
+		int width = 0, height = 0;
+	};
+
+	// Surface Point a Texel is Lit At
+	// -------------------------------
+	struct Sample
+	{
+		uint32_t texel;
+		uint32_t triangle;
+		glm::vec3 position;
+		glm::vec3 normal;            // Interpolated Shading Normal
+	};
+
+	bool pack(float density);
+	void rasterizeCharts();
+	glm::vec3 directLight(const glm::vec3& position, const glm::vec3& normal, const glm::vec3& offsetNormal,
+		const std::vector<PointLight>& lights, const LightmapSettings& settings, uint64_t& rays) const;
+	glm::vec4 bakeTexel(const Sample& sample, const std::vector<PointLight>& lights, const LightmapSettings& settings, uint64_t& rays) const;
+	void dilate();
+
+	int mSize = 0;
+	float mDensity = 0.0f;
+	uint64_t mGeometryHash = 0;
+
+	// The Static Scene in World Space, Three Entries per Triangle
+	// -----------------------------------------------------------
+	std::vector<glm::vec3> mVertices;
+	std::vector<glm::vec3> mCornerNormals;
+	std::vector<glm::vec3> mFaceNormals;     // Geometric, Turned to the Shading Normals' Side
+	std::vector<uint32_t> mTriangleInstance;
+	std::vector<glm::vec3> mAlbedos;         // One per Instance
+	std::vector<size_t> mInstanceFirstTriangle;
+
+	std::vector<Chart> mCharts;
+	std::vector<std::vector<glm::vec2>> mCoordinates;
+	std::vector<Sample> mSamples;
+	std::vector<glm::vec4> mTexels;          // rgb = Irradiance, a = Ambient Occlusion; Empty Until Baked or Loaded
+	Bvh mBvh;
+	std::atomic<uint64_t> mRays{ 0 };
+
+	RenderBackend* mBackend = nullptr;
+	TextureId mTexture = 0;
+};
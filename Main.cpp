@@ -3,7 +3,19 @@
 // Includes
 // -------
 #include <iostream>         // cout, cerr
-#include <cstdlib>          // EXIT_FAILURE
+#include <algorithm>        // max_element, copy
+#include <cstdio>           // snprintf
+#include <cstdlib>          // EXIT_FAILURE, atoi, atof, atoll
+#include <cstring>          // strcmp
+#include <filesystem>       // create_directories, exists
+#include <fstream>          // ofstream
+#include <limits>           // numeric_limits
+#include <map>              // map
+#include <memory>           // unique_ptr
+#include <random>           // mt19937
+#include <string>           // string
+#include <tuple>            // tuple, make_tuple
+#include <vector>           // vector
 #include <GL/glew.h>        // GLEW library
 #include <GLFW/glfw3.h>     // GLFW library
 #include <glm/glm.hpp>
@@ -11,6 +23,36 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <learnOpengl/camera.h>
 
+#include "Benchmark.h"
+#include "ChangeTracker.h"
+#include "ClusteredLighting.h"
+#include "DebugDraw.h"
+#include "DeferredRenderer.h"
+#include "DynamicResolution.h"
+#include "FrameArena.h"
+#include "FrameCapture.h"
+#include "GLBackend.h"
+#include "InputRecording.h"
+#include "JobSystem.h"
+#include "Lightmaps.h"
+#include "MemoryTracker.h"
+#include "Meshlets.h"
+#include "MultiView.h"
+#include "OcclusionCulling.h"
+#include "PostProcessChain.h"
+#include "Primitives.h"
+#include "ShaderBatch.h"
+#include "ShaderCache.h"
+#include "ShaderUniforms.h"
+#include "ShadowMaps.h"
+#include "SlotMap.h"
+#include "StreamBuffer.h"
+#include "TextureStreaming.h"
+#include "Transform.h"
+#include "TransformBatch.h"
+#include "UsageMeter.h"
+#include "VulkanBackend.h"
+
 // Image Loading Utility Functions
 // -------------------------------
 #define STB_IMAGE_IMPLEMENTATION
@@ -25,6 +67,18 @@ using namespace glm;   // Using GLM Namespace
 #define GLSL(Version, Source) "#version " #Version " core \n" #Source
 #endif
 
+// Shader Library Macro: Source Appended After a GLSL() Shader, so No #version Line
+// --------------------------------------------------------------------------------
+#ifndef GLSL_LIBRARY
+#define GLSL_LIBRARY(Source) #Source
+#endif
+
+// Shader Program Macro Requiring an Extension, which GLSL() Cannot Spell as a Directive
+// -------------------------------------------------------------------------------------
+#ifndef GLSL_EXTENSION
+#define GLSL_EXTENSION(Version, Extension, Source) "#version " #Version " core \n#extension " #Extension " : require \n" #Source
+#endif
+
 // Unnamed Namespace
 // -----------------
 namespace
@@ -35,6 +89,11 @@ namespace
 	const int WINDOW_WIDTH = 1280;
 	const int WINDOW_HEIGHT = 720;
 
+	// Current Framebuffer Size, Updated by resizeWindow()
+	// ---------------------------------------------------
+	int gFramebufferWidth = WINDOW_WIDTH;
+	int gFramebufferHeight = WINDOW_HEIGHT;
+
 	// GLdata for Mesh
 	// ---------------
 	struct GLmesh
@@ -42,25 +101,213 @@ namespace
 		GLuint VAO;         // Vertex Array Object
 		GLuint VBO[2];      // Vertex Buffer Object
 		GLuint nIndices;    // Number of Indices in the Mesh
+		GLenum indexType;   // GL_UNSIGNED_SHORT, or GL_UNSIGNED_INT Past 65,536 Vertices
+		vector<Meshlet> meshlets;   // Index Ranges Culled Individually in the Camera Pass
+		vector<vec3> positions;     // CPU Copies for Software Occlusion Culling
+		vector<uint32_t> indices;
+		vector<GLfloat> vertices;   // Interleaved CPU Copy for the Lightmap Baker
+		size_t floatsPerVertex;
+		vec3 boundsMin, boundsMax;  // Model-Space AABB
+	};
+
+	// GL Names of a Texture and a Linked Program
+	// ------------------------------------------
+	struct GLtexture
+	{
+		GLuint id;
+		int streamSlot = -1;   // TextureStreamer Slot; the Streamer Owns the Backend Texture and Replaces it
+		vec3 meanColor = vec3(0.5f);   // Average Texel, the Albedo Light Bounces Off in the Lightmap Bake
+	};
+
+	struct GLprogram
+	{
+		GLuint id;
 	};
 
+	// Resource Pools: Objects Refer to Resources by Handle, Never by Pointer
+	// ----------------------------------------------------------------------
+	using MeshHandle = SlotMap<GLmesh>::Handle;
+	using TextureHandle = SlotMap<GLtexture>::Handle;
+	using ProgramHandle = SlotMap<GLprogram>::Handle;
+	SlotMap<GLmesh> gMeshes;
+	SlotMap<GLtexture> gTextures;
+	SlotMap<GLprogram> gPrograms;
+
+	const size_t FLOATS_PER_MESH_VERTEX = 8;   // Position, Normal and UV
+
+	// Procedural Props: Generated at Compile Time into Read-Only Data
+	// ---------------------------------------------------------------
+	constexpr auto FLOOR_PRIMITIVE = makePlane<PositionNormalUV>(2.0f, 2.0f);
+	constexpr auto BLOCK_1_PRIMITIVE = makeBox<PositionNormalUV>(1.0f, 0.25f, 0.5f);
+	constexpr auto BLOCK_2_PRIMITIVE = makeBox<PositionNormalUV>(1.0f, 0.25f, 0.25f);
+	constexpr auto LAMP_PRIMITIVE = makeSphere<PositionOnly, 16, 8>(0.25f);   // The Lamp Shader Reads Positions Only
+
+	// Meshlet Culling: the Scene Draws Without GL_CULL_FACE, so Back Faces Stay Visible and Only the Frustum Test Runs
+	// ----------------------------------------------------------------------------------------------------------------
+	const bool MESHLET_CONE_CULLING = false;
+
 	// Create Window Object
 	// --------------------
 	GLFWwindow* gWindow = nullptr;
 
 	// Mesh Data
 	// ---------
-	GLmesh scissorsBladeMesh, floorMesh, blockMesh_1, blockMesh_2, lampMesh;
+	MeshHandle gScissorsBladeMesh, gFloorMesh, gBlockMesh1, gBlockMesh2, gLampMesh;
 
 	// Texture IDs
 	// ----------
-	GLuint gTextureIdMetal, gTextureIdFloor, gTextureIdWood, gTextureIdYellowWood;
+	TextureHandle gMetalTexture, gFloorTexture, gWoodTexture, gYellowWoodTexture;
 	vec2 uvScale(1.0f, 1.0f);
 
+	// Scene Object: Mesh and Texture of a Drawn Object; its Transform Lives in gTransforms
+	// ------------------------------------------------------------------------------------
+	struct SceneObject
+	{
+		MeshHandle mesh;
+		TextureHandle texture;
+		bool isStatic;     // Static Objects Cast into the Cached Shadow Maps
+		bool isOccluder;   // Large Objects Rasterized into the Occlusion Depth Buffer
+		MeshHandle lightmapMesh;   // Chart-Split Copy Carrying Lightmap Coordinates, Once Baked
+	};
+
+	// Which Objects a Camera Pass Draws Once Lightmaps are Baked
+	// ----------------------------------------------------------
+	enum class ObjectSet { All, Lightmapped, Unlightmapped };
+
+	// Scene Data
+	// ----------
+	vector<SceneObject> gSceneObjects;
+	TransformBatch gTransforms;      // Structure-of-Arrays, One per Scene Object
+	vector<mat4> gModelMatrices;     // Composed Each Frame, One per Scene Object
+	vector<mat3> gNormalMatrices;    // Inverse-Transpose of Each Model Matrix
+
+	// Job System: Worker Pool for Per-Frame CPU Work
+	// ----------------------------------------------
+	unique_ptr<JobSystem> gJobSystem;
+	const size_t MATRIX_JOB_GRAIN = 256;   // Objects per Job when Composing Matrices
+
+	// Render Backend: Owns the Mesh Buffers and Textures, Runs the Passes and Replays the
+	// Draws Recorded into Command Lists; Scene Draws are Recorded by the Workers, One List
+	// per Range of Objects, Each Starting with a Copy of the Pass's Setup
+	// -----------------------------------------------------------------------------------
+	unique_ptr<RenderBackend> gBackend;
+	const size_t RECORD_JOB_GRAIN = 64;   // Objects per Command List
+	vector<CommandList> gSceneCommandLists;
+	CommandList gPassCommands;            // A Pass's Setup, or the Whole of a Single-List Pass
+	map<GLuint, PipelineId> gPipelines;   // One per Program Drawn from this File
+
+	// Render Backend API, Selected at Startup with --backend; Vulkan Loads Programs as SPIR-V
+	// from SHADER_DIRECTORY (CompileShaders.bat Output)
+	// ---------------------------------------------------------------------------------------
+	enum class BackendApi { OpenGL, Vulkan };
+	BackendApi gBackendApi = BackendApi::OpenGL;
+	const char* const SHADER_DIRECTORY = "shaders";
+
+	// Software Occlusion Culling, Enabled with --occlusion-culling
+	// ------------------------------------------------------------
+	bool gOcclusionCullingEnabled = false;
+	OcclusionCulling gOcclusionCulling;
+	const uint8_t* gVisibleObjects = nullptr;      // One Flag per Scene Object this Frame; nullptr Draws All
+	const size_t OCCLUSION_TEST_JOB_GRAIN = 256;   // Objects per Job when Testing Occludees
+
+	// Transient Per-Frame Allocations: Draw Lists, Culling Results
+	// ------------------------------------------------------------
+	const size_t FRAME_ARENA_SIZE = 256 * 1024;   // Per Frame in Flight; Grows to the High-Water Mark
+	FrameArena gFrameArena;
+
 	// Shader Program
 	// --------------
-	GLuint gProgramID;
-	GLuint gLampProgramID;
+	ProgramHandle gSceneProgram;
+	ProgramHandle gLampProgram;
+	ProgramHandle gGBufferProgram;
+	ProgramHandle gDeferredLightingProgram;
+	ProgramHandle gShadowProgram;
+	ProgramHandle gBloomBrightProgram;
+	ProgramHandle gBloomBlurProgram;
+	ProgramHandle gToneMapProgram;
+	ProgramHandle gFxaaProgram;
+	ProgramHandle gFeedbackProgram;
+	ProgramHandle gMultiViewProgram;
+	ProgramHandle gMultiViewLampProgram;
+	ProgramHandle gLightmapProgram;
+	ProgramHandle gDebugLineProgram;
+	ProgramHandle gDebugTextProgram;
+
+	// Linked Program Binaries Reused Across Launches
+	// ----------------------------------------------
+	const char* const SHADER_CACHE_DIRECTORY = "shader_cache";
+	ShaderCache gShaderCache;
+
+	// Programs Still Compiling in the Background After the First Frame
+	// ----------------------------------------------------------------
+	ShaderBatch gShaderBatch(&gShaderCache);
+	double gShaderBatchStart = 0.0;
+	bool gShaderBatchReported = false;
+
+	// Render Path, Selected at Startup with --deferred
+	// ------------------------------------------------
+	enum class RenderPath { Forward, Deferred };
+	RenderPath gRenderPath = RenderPath::Forward;
+	DeferredRenderer gDeferredRenderer;
+
+	// Dynamic Resolution, Enabled with --dynamic-resolution
+	// -----------------------------------------------------
+	const float DEFAULT_FRAME_BUDGET = 16.6f;   // GPU Milliseconds per Frame, Overridden by --frame-budget
+	bool gDynamicResolutionEnabled = false;
+	DynamicResolution gDynamicResolution;
+
+	// Post-Processing, Enabled with --post-processing
+	// -----------------------------------------------
+	const int DEFAULT_BLOOM_DIVISOR = 2;     // Bloom Resolution Divisor, Overridden by --bloom-divisor
+	const float DEFAULT_EXPOSURE = 1.0f;     // Overridden by --exposure
+	const float BLOOM_THRESHOLD = 0.8f;      // HDR Brightness Where Bloom Starts
+	const float BLOOM_STRENGTH = 0.6f;
+	bool gPostProcessingEnabled = false;
+	PostProcessChain gPostProcess;
+	float gExposure = DEFAULT_EXPOSURE;
+
+	// Texture Streaming, Enabled with --texture-streaming
+	// ---------------------------------------------------
+	const size_t DEFAULT_TEXTURE_BUDGET_MB = 64;   // Resident Mip Memory, Overridden by --texture-budget
+	bool gTextureStreamingEnabled = false;
+	TextureStreamer gTextureStreamer;
+
+	// Frame Capture, Enabled with --capture DIR
+	// -----------------------------------------
+	const int DEFAULT_CAPTURE_FPS = 60;             // Y4M Frame Rate, Overridden by --capture-fps
+	const int DEFAULT_COMPARE_TOLERANCE = 8;        // Channel Difference a Pixel May Have, Overridden by --compare-tolerance
+	const double DEFAULT_COMPARE_MAX_SHARE = 0.1;   // Percent of Pixels a Frame May Have Above it, Overridden by --compare-max-share
+	bool gFrameCaptureEnabled = false;
+	size_t gCaptureFrameLimit = 0;                  // With --capture-frames: Start Once Every Program is Ready, Close After this Many
+	FrameCapture gFrameCapture;
+
+	// Single-Pass Multi-View, Enabled with --multi-view split|stereo|projections
+	// --------------------------------------------------------------------------
+	bool gMultiViewEnabled = false;
+	MultiView gMultiView;
+
+	// Baked Lightmaps, Enabled with --lightmap FILE
+	// ---------------------------------------------
+	const int DEFAULT_BAKE_SAMPLES = 64;      // Paths per Texel, Overridden by --bake-samples
+	const float LIGHTMAP_AMBIENT = 0.08f;     // Ambient Light, Scaled by the Baked Occlusion
+	bool gLightmapsEnabled = false;
+	Lightmap gLightmap;
+
+	// Debug Overlay, Enabled with --debug-overlay
+	// -------------------------------------------
+	const float OVERLAY_TEXT_MARGIN = 8.0f;      // Window Pixels from the Top Left Corner
+	const float OVERLAY_FRAME_SMOOTHING = 0.1f;  // Weight of the Newest Frame in the Displayed Frame Time
+	bool gDebugOverlayEnabled = false;
+	DebugDraw gDebugDraw;
+	float gDebugOverlayFrameTime = 0.0f;         // Smoothed Seconds per Frame
+	double gDebugOverlayCpuTime = 0.0;           // Last Frame's Overlay Recording, Seconds
+
+	// Where the Camera Passes Draw this Frame: the Post-Processing Scene Target, the Scaled
+	// Offscreen Region, or the Whole Window
+	// ----------------------------------------------------------------------------------------
+	RenderTargetId gSceneTarget = 0;
+	int gRenderWidth = WINDOW_WIDTH;
+	int gRenderHeight = WINDOW_HEIGHT;
 
 	// Camera
 	// ------
@@ -76,6 +323,55 @@ namespace
 	float gDeltaTime = 0.0f;   // Time Between Current and Last Frame
 	float gLastFrame = 0.0f;
 
+	// Input Recording and Fixed-Timestep Replay
+	// -----------------------------------------
+	const float DEFAULT_REPLAY_FPS = 60.0f;
+	bool gInputRecordingEnabled = false;
+	bool gInputReplayEnabled = false;
+	InputRecorder gInputRecorder;
+	InputReplayer gInputReplayer;
+	float gReplayStep = 1.0f / DEFAULT_REPLAY_FPS;
+	double gReplayStart = 0.0;
+
+	// On-Demand Rendering: Frames are Only Drawn when Something they Depend on Changed
+	// --------------------------------------------------------------------------------
+	const double ON_DEMAND_WAIT = 0.5;   // Longest Sleep in glfwWaitEventsTimeout, Seconds
+	bool gOnDemandRendering = false;
+	ChangeTracker gChangeTracker;
+	GLenum gPolygonMode = GL_FILL;
+
+	// CPU and GPU Utilization Report, Printed Whether or Not Frames are Rendered
+	// -------------------------------------------------------------------------
+	UsageMeter gUsageMeter;
+	double gUsageReportTime = 0.0;
+
+	// Live GPU and CPU Memory by Category, Added to the Frame Report by --memory-report
+	// ---------------------------------------------------------------------------------
+	bool gMemoryReportEnabled = false;
+
+	// Frame Time Report
+	// -----------------
+	const float FRAME_REPORT_INTERVAL = 5.0f;   // Seconds Between Reports
+	float gReportTime = 0.0f;
+	int gReportFrames = 0;
+	int gReportShadowCascades = 0;
+	size_t gReportHeapAllocations = 0;   // Process Count at the Last Report; Debug Builds Only
+	double gReportOcclusionTime = 0.0;
+	size_t gReportOccludedObjects = 0;
+
+	// Last Frame's CPU Recording Time (Up to the Swap) and Draw Calls, Read by the Stress Benchmark
+	// ---------------------------------------------------------------------------------------------
+	double gFrameCpuTime = 0.0;
+	size_t gFrameDrawCalls = 0;
+
+	// Stress Benchmark: Every Combination of the --stress-* Lists is One Scene and One CSV Row
+	// ----------------------------------------------------------------------------------------
+	const char* const STRESS_CSV_PATH = "stress.csv";
+	const int STRESS_FRAMES = 240;          // Measured Frames per Scene, One Orbit of the Camera
+	const int STRESS_WARMUP_FRAMES = 30;    // Fill the Shadow Cache and Driver Caches First
+	const int STRESS_QUERY_LAG = 4;         // Timestamp Pairs in Flight Before a Result is Read
+	const float STRESS_SPACING = 2.0f;      // Grid Spacing of the Props
+
 	// Light Settings
 	// --------------
 	vec3 lightColor(1.0f, 1.0f, 1.0f);
@@ -83,6 +379,25 @@ namespace
 	vec3 lightPos(2.0f, 0.5f, -5);
 	vec3 lightPos_1(2.0f, 0.5f, 4);
 	vec3 lightScale(2.0f);
+
+	// Point Lights Shaded by the Clustered Forward Renderer
+	// -----------------------------------------------------
+	vector<PointLight> gLights;
+	ClusteredLighting gClusteredLighting;
+
+	// Persistently Mapped Ring for Per-Frame Dynamic Data
+	// ---------------------------------------------------
+	const size_t FRAME_STREAM_REGION_SIZE = 1 << 20;   // Grows if a Frame Needs More
+	StreamBuffer gFrameStream;
+	const size_t LAMP_MARKER_COUNT = 2;   // Only the Scene Lights Get a Lamp Cube
+
+	// Directional Key Light with Cached Cascaded Shadow Maps
+	// ------------------------------------------------------
+	vec3 keyLightDirection(-0.4f, -1.0f, -0.3f);
+	vec3 keyLightColor(0.35f, 0.35f, 0.4f);
+	ShadowMaps gShadowMaps;
+	size_t gStaticGeometryVersion = 0;    // Bumped when a Static Object is Added, Moved or Removed
+	size_t gShadowStaticVersion = 0;      // gStaticGeometryVersion the Cached Cascades were Rendered At
 }
 
 // Function Prototypes
@@ -93,18 +408,69 @@ void processInput(GLFWwindow * window);
 void mousePositionCallback(GLFWwindow* window, double xPos, double yPos);
 void mouseScrollCallback(GLFWwindow* window, double xOffset, double yOffset); 
 void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+void refreshWindow(GLFWwindow* window);
+void applyInputToggles(uint32_t keys);
+void adjustCameraSpeed(float offset);
+void replayInput();
 void createScissorMesh(GLmesh& mesh);
 void createFloorMesh(GLmesh& mesh);
 void createBlock1Mesh(GLmesh& mesh);
 void createBlock2Mesh(GLmesh& mesh);
 void createLampMesh(GLmesh& mesh);
-void destroyMeshs(GLmesh& mesh, GLmesh& mesh2, GLmesh& mesh3, GLmesh& mesh4, GLmesh& mesh5);
+MeshHandle createMesh(void (*buildMesh)(GLmesh& mesh));
+void uploadMeshIndices(GLmesh& mesh, const GLfloat* vertices, size_t floatCount, const GLuint* indices, size_t indexCount, size_t floatsPerVertex = FLOATS_PER_MESH_VERTEX);
+size_t meshCopyBytes(const GLmesh& mesh);
+void createScene();
+void addSceneObject(const SceneObject& object, const Transform& transform);
+void moveSceneObject(size_t index, const Transform& transform);
+void createRandomLights(size_t count, float extent = 12.0f);
+bool runStressBenchmark(int argc, char* argv[]);
+float createStressScene(size_t objectCount, size_t lightCount, const TextureHandle* textures, size_t textureCount, size_t overdrawLayers);
+void moveStressCamera(float extent, float progress);
+vector<size_t> parseCountList(const char* list, const char* fallback);
+void updateModelMatrices();
+void cullOccludedObjects(const mat4& viewProjection);
+bool hasOption(int argc, char* argv[], const char* option);
+const char* optionValue(int argc, char* argv[], const char* option);
+void destroyMeshs();
 void render();
-bool createShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint & programID);
+void renderForward(const mat4& view, const mat4& projection);
+void renderDeferred(const mat4& view, const mat4& projection);
+void renderMultiView(const mat4& view, const mat4& projection);
+mat4 cameraProjection(bool perspective, float aspectRatio, float& nearPlane, float& farPlane);
+mat4 lampModelMatrix(const PointLight& light);
+bool createLightmaps(int argc, char* argv[], const char* path);
+MeshHandle createLightmapMesh(MeshHandle sourceHandle, const vector<vec2>& coordinates);
+void drawLightmappedObjects(const mat4& view, const mat4& projection);
+bool createPostProcessing(int argc, char* argv[]);
+bool postProcessingReady();
+void updateTextureStreaming(const mat4& view, const mat4& projection);
+void drawDebugOverlay(const mat4& view, const mat4& projection);
+PipelineId programPipeline(GLuint programID, PipelineDesc desc = PipelineDesc());
+PassDesc scenePass(bool clear);
+IndexType meshIndexType(const GLmesh& mesh);
+void drawSceneObjects(const CommandList& pass, const mat4& viewProjection, int viewCount = 1, ObjectSet objects = ObjectSet::All);
+void recordSceneObjects(CommandList& commands, const CommandList& pass, const Frustum& frustum, int viewCount, ObjectSet objects, size_t begin, size_t end);
+void drawShadowCasters(CommandList& commands, bool staticCasters);
+void bindKeyLight(CommandList& commands);
+void reportFrameTime();
+void reportUtilization();
+void reportMemory();
+bool sceneChanged();
+bool createShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint & programID, const char* fragLibrarySource = nullptr);
+ProgramHandle submitShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, const char* fragLibrarySource = nullptr);
+GLuint programId(ProgramHandle program);
+bool programReady(GLuint programID);
+bool loadSpirv(const char* source, vector<uint32_t>& words);
+const char* stageFilename(const char* source);
+bool pollShaderPrograms();
 void destroyShaderProgram(GLuint programID);
-bool createTexture(const char* filename, GLuint& textureId);
+bool exportShaders(const char* directory);
+bool createTexture(const char* filename, TextureHandle& texture);
+bool uploadTexture(const unsigned char* image, int width, int height, int channels, TextureHandle& texture);
+bool createCheckerTexture(size_t seed, TextureHandle& texture);
 void destroyTexture(GLuint textureId);
-void terminateApplication(GLmesh& mesh, GLmesh& mesh2, GLmesh& mesh3, GLmesh& mesh4, GLmesh& mesh5, GLuint & programID_0, GLuint& programID_1, GLuint& textureId_0, GLuint& textureId_1, GLuint& textureId_2, GLuint& textureId_3);
+void terminateApplication();
 
 #pragma endregion
 
@@ -124,6 +490,7 @@ const GLchar* vertexShaderSource = GLSL(440,
 
 	//Uniform / Global variables for the  transform matrices
 	uniform mat4 model;
+	uniform mat3 normalMatrix; // Inverse-transpose of the model matrix, composed on the CPU per object
 	uniform mat4 view;
 	uniform mat4 projection;
 
@@ -133,7 +500,7 @@ const GLchar* vertexShaderSource = GLSL(440,
 
 		vertexFragmentPos = vec3(model * vec4(position, 1.0f)); // Gets fragment / pixel position in world space only (exclude view and projection)
 
-		vertexNormal = mat3(transpose(inverse(model))) * normal; // get normal vectors in world space only and exclude normal translation properties
+		vertexNormal = normalMatrix * normal; // get normal vectors in world space only and exclude normal translation properties
 
 		vertexTextureCoordinate = textureCoordinate;
 	}
@@ -149,245 +516,1180 @@ const GLchar* fragmentShaderSource = GLSL(440,
 
 	out vec4 fragmentColor; // For outgoing cube color to the GPU
 
-	// Uniform / Global variables for object color, light color, light position, and camera/view position
-	uniform vec3 objectColor;
-	uniform vec3 lightColor;
-	uniform vec3 lightPos;
-	uniform vec3 viewPosition;
+	// Uniform / Global variables for the texture; lights and camera are declared in clusteredLightingSource
 	uniform sampler2D uTexture; // Useful when working with multiple textures
 	uniform vec2 uvScale;
 
+	vec3 clusteredLighting(vec3 fragmentPos, vec3 norm, vec2 fragCoord); // Defined in clusteredLightingSource
+	vec3 keyLighting(vec3 fragmentPos, vec3 norm); // Defined in keyLightSource
+
 	void main()
 	{
 		/*Phong lighting model calculations to generate ambient, diffuse, and specular components*/
 
 	//Calculate Ambient lighting*/
 		float ambientStrength = 0.0f; // Set ambient or global lighting strength.
-		vec3 ambient = ambientStrength * lightColor; // Generate ambient light color.
+		vec3 ambient = ambientStrength * vec3(1.0f); // Generate ambient light color.
+
+		// Diffuse and specular lighting from every light in this fragment's cluster, plus the shadowed key light
+		vec3 norm = normalize(vertexNormal);
+		vec3 lighting = clusteredLighting(vertexFragmentPos, norm, gl_FragCoord.xy) + keyLighting(vertexFragmentPos, norm);
+
+		// Texture holds the color to be used for all three components
+		vec4 textureColor = texture(uTexture, vertexTextureCoordinate * uvScale);
+
+		// Calculate phong result
+		vec3 phong = (ambient + lighting) * textureColor.xyz;
+
+		fragmentColor = vec4(phong, 1.0f); // Send lighting results to GPU
+	}
+);
+
+// Clustered Lighting Library: Appended to Fragment Shaders that Shade Point Lights
+// --------------------------------------------------------------------------------
+const GLchar* clusteredLightingSource = GLSL_LIBRARY(
+
+	struct PointLight
+	{
+		vec4 positionRadius; // xyz = world position, w = radius of influence
+		vec4 colorIntensity; // rgb = color, a = intensity
+	};
+
+	layout(std430, binding = 0) readonly buffer LightBuffer { PointLight lights[]; };
+	layout(std430, binding = 1) readonly buffer ClusterBuffer { uvec2 clusters[]; }; // Offset and count into lightIndices
+	layout(std430, binding = 2) readonly buffer LightIndexBuffer { uint lightIndices[]; };
+
+	uniform uvec3 clusterGrid;
+	uniform vec2 clusterScreenSize;
+	uniform vec3 clusterDepth; // Slice scale, slice bias, 1 for logarithmic slices
+	uniform uint lightCount;
+	uniform mat4 view;
+	uniform vec3 viewPosition;
+
+	void addPointLighting(inout vec3 result, PointLight light, vec3 fragmentPos, vec3 norm, vec3 viewDir)
+	{
+		float specularIntensity = 0.2f; // Set specular light strength.
+		float highlightSize = 8.0f; // Set specular highlight size.
+
+		vec3 toLight = light.positionRadius.xyz - fragmentPos;
+		float distance = length(toLight);
+		if (distance >= light.positionRadius.w)
+			return;
+
+		// Smooth window so the light fades to zero at its radius
+		float window = clamp(1.0f - pow(distance / light.positionRadius.w, 4.0f), 0.0f, 1.0f);
+		vec3 lightColor = light.colorIntensity.rgb * light.colorIntensity.a * window * window;
 
 		//Calculate Diffuse lighting*/
-		vec3 norm = normalize(vertexNormal); // Normalize vectors to 1 unit.
-		vec3 lightDirection = normalize(lightPos - vertexFragmentPos); // Calculate distance (light direction) between light source and fragments/pixels on cube.
-		float impact = max(dot(norm, lightDirection), 0.0);// Calculate diffuse impact by generating dot product of normal and light.
+		vec3 lightDirection = toLight / max(distance, 0.0001f); // Calculate direction between light source and fragments/pixels.
+		float impact = max(dot(norm, lightDirection), 0.0f); // Calculate diffuse impact by generating dot product of normal and light.
 		vec3 diffuse = impact * lightColor; // Generate diffuse light color.
 
 		//Calculate Specular lighting*/
-		float specularIntensity = 0.2f; // Set specular light strength.
-		float highlightSize = 8.0f; // Set specular highlight size.
-		vec3 viewDir = normalize(viewPosition - vertexFragmentPos); // Calculate view direction.
-		vec3 reflectDir = reflect(-lightDirection, norm);// Calculate reflection vector.
-		//Calculate specular component.
-		float specularComponent = pow(max(dot(viewDir, reflectDir), 1.0f), highlightSize);
+		vec3 reflectDir = reflect(-lightDirection, norm); // Calculate reflection vector.
+		float specularComponent = pow(max(dot(viewDir, reflectDir), 0.0f), highlightSize);
 		vec3 specular = specularIntensity * specularComponent * lightColor;
 
-		// Texture holds the color to be used for all three components
-		vec4 textureColor = texture(uTexture, vertexTextureCoordinate * uvScale);
+		result += diffuse + specular;
+	}
 
-		// Calculate phong result
-		vec3 phong = (ambient + diffuse + specular) * textureColor.xyz;
+	vec3 clusteredLighting(vec3 fragmentPos, vec3 norm, vec2 fragCoord)
+	{
+		// Find the cluster from the screen tile and view-space depth
+		float depth = -(view * vec4(fragmentPos, 1.0f)).z;
+		float slice = (clusterDepth.z > 0.5f) ? log(max(depth, 0.0001f)) * clusterDepth.x + clusterDepth.y : depth * clusterDepth.x + clusterDepth.y;
+		vec3 cell = clamp(vec3(fragCoord / clusterScreenSize * vec2(clusterGrid.xy), slice), vec3(0.0f), vec3(clusterGrid) - 1.0f);
+		uvec2 cluster = clusters[(uint(cell.z) * clusterGrid.y + uint(cell.y)) * clusterGrid.x + uint(cell.x)];
 
-		fragmentColor = vec4(phong, 1.0f); // Send lighting results to GPU
+		vec3 viewDir = normalize(viewPosition - fragmentPos); // Calculate view direction.
+
+		vec3 result = vec3(0.0f);
+		for (uint i = 0u; i < cluster.y; ++i)
+			addPointLighting(result, lights[lightIndices[cluster.x + i]], fragmentPos, norm, viewDir);
+
+		return result;
+	}
+
+	// Every light, for views the cluster grid was not built for
+	vec3 unclusteredLighting(vec3 fragmentPos, vec3 norm, vec3 viewDir)
+	{
+		vec3 result = vec3(0.0f);
+		for (uint i = 0u; i < lightCount; ++i)
+			addPointLighting(result, lights[i], fragmentPos, norm, viewDir);
+
+		return result;
 	}
 );
 
-	/* Lamp Shader Source Code*/
-	const GLchar* lampVertexShaderSource = GLSL(440,
+// Key Light Library: Directional Light with Cascaded Shadows, Appended After clusteredLightingSource
+// -------------------------------------------------------------------------------------------------
+const GLchar* keyLightSource = GLSL_LIBRARY(
 
-		layout(location = 0) in vec3 position;
+	uniform vec3 keyLightDirection; // Direction the light travels
+	uniform vec3 keyLightColor;
+	uniform sampler2DShadow shadowAtlas;
+	uniform mat4 shadowMatrices[4]; // World to atlas coordinates per cascade
+	uniform vec4 shadowCascadeRadii; // Camera distance covered by each cascade
+	uniform vec4 shadowTexelSizes; // World size of one shadow texel per cascade
+	uniform vec3 shadowCameraPosition;
 
-		//Uniform / Global variables for the  transform matrices
-		uniform mat4 model;
-		uniform mat4 view;
-		uniform mat4 projection;
+	float keyLightShadow(vec3 fragmentPos, vec3 norm)
+	{
+		float distance = length(fragmentPos - shadowCameraPosition);
 
-		void main()
+		for (int i = 0; i < 4; ++i)
 		{
-			gl_Position = projection * view * model * vec4(position, 1.0f); // Transforms vertices into coordinates
+			if (distance < shadowCascadeRadii[i])
+			{
+				// Offset along the normal to hide shadow acne, then take 4 filtered taps
+				vec3 coord = (shadowMatrices[i] * vec4(fragmentPos + norm * shadowTexelSizes[i] * 1.5f, 1.0f)).xyz;
+				vec2 texel = 1.0f / vec2(textureSize(shadowAtlas, 0));
+
+				float lit = 0.0f;
+				lit += texture(shadowAtlas, vec3(coord.xy + vec2(-0.5f, -0.5f) * texel, coord.z));
+				lit += texture(shadowAtlas, vec3(coord.xy + vec2(0.5f, -0.5f) * texel, coord.z));
+				lit += texture(shadowAtlas, vec3(coord.xy + vec2(-0.5f, 0.5f) * texel, coord.z));
+				lit += texture(shadowAtlas, vec3(coord.xy + vec2(0.5f, 0.5f) * texel, coord.z));
+				return lit * 0.25f;
+			}
 		}
-	);
 
+		return 1.0f; // Past the last cascade
+	}
 
-	/* Fragment Shader Source Code*/
-	const GLchar* lampFragmentShaderSource = GLSL(440,
+	vec3 keyLightingFrom(vec3 fragmentPos, vec3 norm, vec3 viewDir)
+	{
+		vec3 lightDirection = -normalize(keyLightDirection);
+		float impact = max(dot(norm, lightDirection), 0.0f);
+		if (impact <= 0.0f)
+			return vec3(0.0f);
 
-		out vec4 fragmentColor;
+		vec3 reflectDir = reflect(-lightDirection, norm);
+		float specularComponent = pow(max(dot(viewDir, reflectDir), 0.0f), 8.0f);
 
-		void main()
-		{
-			fragmentColor = vec4(1.0f); // Set color to white (1.0f,1.0f,1.0f) with alpha 1.0
-		}
-	);
+		return (impact + 0.2f * specularComponent) * keyLightColor * keyLightShadow(fragmentPos, norm);
+	}
 
-// Images are Loaded with Y-Axis going down, but OpenGL's Y-Axis Goes Up this Function Flips it
-// --------------------------------------------------------------------------------------------
-void flipImageVertically(unsigned char* image, int width, int height, int channels)
-{
-	for (int j = 0; j < height / 2; ++j)
+	vec3 keyLighting(vec3 fragmentPos, vec3 norm)
 	{
-		int index1 = j * width * channels;
-		int index2 = (height - 1 - j) * width * channels;
+		return keyLightingFrom(fragmentPos, norm, normalize(viewPosition - fragmentPos));
+	}
+);
 
-		for (int i = width * channels; i > 0; --i)
-		{
-			unsigned char tmp = image[index1];
-			image[index1] = image[index2];
-			image[index2] = tmp;
-			++index1;
-			++index2;
-		}
+// Multi-View Vertex Shader: One Instance per View, Routed to that View's Viewport
+// -------------------------------------------------------------------------------
+const GLchar* multiViewVertexShaderSource = GLSL_EXTENSION(440, GL_ARB_shader_viewport_layer_array,
+
+	layout(location = 0) in vec3 position;
+	layout(location = 1) in vec3 normal;
+	layout(location = 2) in vec2 textureCoordinate;
+
+	out vec3 vertexNormal;
+	out vec3 vertexFragmentPos;
+	out vec2 vertexTextureCoordinate;
+	flat out int vertexView;
+
+	uniform mat4 model;
+	uniform mat3 normalMatrix;
+	uniform mat4 viewProjections[4]; // MultiView::MAX_VIEWS, projection * view of each view
+
+	void main()
+	{
+		vec4 worldPosition = model * vec4(position, 1.0f);
+		gl_Position = viewProjections[gl_InstanceID] * worldPosition;
+		gl_ViewportIndex = gl_InstanceID;
+
+		vertexFragmentPos = vec3(worldPosition);
+		vertexNormal = normalMatrix * normal;
+		vertexTextureCoordinate = textureCoordinate;
+		vertexView = gl_InstanceID;
 	}
-}
+);
 
+// Multi-View Fragment Shader: the Scene Shader, Seen from the Fragment's Own View
+// -------------------------------------------------------------------------------
+const GLchar* multiViewFragmentShaderSource = GLSL(440,
 
-#pragma endregion
+	in vec3 vertexNormal;
+	in vec3 vertexFragmentPos;
+	in vec2 vertexTextureCoordinate;
+	flat in int vertexView;
 
-// Main Function: Entry Point to OpenGL Program
-// --------------------------------------------
-int main(int argc, char* argv[])
-{
-	// Error Check: GLFW and GLEW Initialized
-	// --------------------------------------
-	if (!initialize(argc, argv, &gWindow))
-		return EXIT_FAILURE;
+	out vec4 fragmentColor;
 
-	// Creates the Meshs
-	// -----------------
-	createScissorMesh(scissorsBladeMesh);
-	createFloorMesh(floorMesh);
-	createBlock1Mesh(blockMesh_1);
-	createBlock2Mesh(blockMesh_2);
+	uniform sampler2D uTexture;
+	uniform vec2 uvScale;
+	uniform vec3 viewPositions[4]; // MultiView::MAX_VIEWS
 
-	// Create the Shader Program
-	// -------------------------
-	if (!createShaderProgram(vertexShaderSource, fragmentShaderSource, gProgramID))
-		return EXIT_FAILURE;
-	if (!createShaderProgram(lampVertexShaderSource, lampFragmentShaderSource, gLampProgramID))
-		return EXIT_FAILURE;
+	vec3 unclusteredLighting(vec3 fragmentPos, vec3 norm, vec3 viewDir); // Defined in clusteredLightingSource
+	vec3 keyLightingFrom(vec3 fragmentPos, vec3 norm, vec3 viewDir); // Defined in keyLightSource
 
-	// Load Textures
-	// -------------
-	const char* texFilename = "resources/textures/metalTexture.jpg";
-	if (!createTexture(texFilename, gTextureIdMetal))
+	void main()
 	{
-		cerr << "Failed to Load Texture " << texFilename << endl;
-		return EXIT_FAILURE;
+		// The clusters only cover the main camera's frustum, so every view shades every light
+		vec3 norm = normalize(vertexNormal);
+		vec3 viewDir = normalize(viewPositions[vertexView] - vertexFragmentPos);
+		vec3 lighting = unclusteredLighting(vertexFragmentPos, norm, viewDir) + keyLightingFrom(vertexFragmentPos, norm, viewDir);
+
+		vec4 textureColor = texture(uTexture, vertexTextureCoordinate * uvScale);
+		fragmentColor = vec4(lighting * textureColor.xyz, 1.0f);
 	}
+);
 
-	texFilename = "resources/textures/floorTexture.jpg";
-	if (!createTexture(texFilename, gTextureIdFloor))
+// Lightmap Vertex Shader: the Scene Transform plus the Baked Atlas Coordinate
+// ---------------------------------------------------------------------------
+const GLchar* lightmapVertexShaderSource = GLSL(440,
+
+	layout(location = 0) in vec3 position;
+	layout(location = 2) in vec2 textureCoordinate;
+	layout(location = 3) in vec2 lightmapCoordinate;
+
+	out vec2 vertexTextureCoordinate;
+	out vec2 vertexLightmapCoordinate;
+
+	uniform mat4 model;
+	uniform mat4 view;
+	uniform mat4 projection;
+
+	void main()
 	{
-		cerr << "Failed to Load Texture " << texFilename << endl;
-		return EXIT_FAILURE;
+		gl_Position = projection * view * model * vec4(position, 1.0f);
+		vertexTextureCoordinate = textureCoordinate;
+		vertexLightmapCoordinate = lightmapCoordinate;
 	}
+);
 
-	texFilename = "resources/textures/woodTexture.jpg";
-	if (!createTexture(texFilename, gTextureIdWood))
+// Lightmap Fragment Shader: Baked Direct and Bounced Light, No Per-Light Work
+// --------------------------------------------------------------------------
+const GLchar* lightmapFragmentShaderSource = GLSL(440,
+
+	in vec2 vertexTextureCoordinate;
+	in vec2 vertexLightmapCoordinate;
+
+	out vec4 fragmentColor;
+
+	uniform sampler2D uTexture;
+	uniform sampler2D lightmap; // rgb = irradiance, a = ambient occlusion
+	uniform vec2 uvScale;
+	uniform float lightmapAmbient;
+
+	void main()
 	{
-		cerr << "Failed to Load Texture " << texFilename << endl;
-		return EXIT_FAILURE;
+		vec4 baked = texture(lightmap, vertexLightmapCoordinate);
+		vec3 lighting = baked.rgb + lightmapAmbient * baked.a;
+
+		vec4 textureColor = texture(uTexture, vertexTextureCoordinate * uvScale);
+		fragmentColor = vec4(lighting * textureColor.xyz, 1.0f);
 	}
+);
 
-	texFilename = "resources/textures/yellowWoodTexture.jpg";
-	if (!createTexture(texFilename, gTextureIdYellowWood))
+// Shadow Depth Shaders: Position Only, Into the Light's Clip Space
+// ----------------------------------------------------------------
+const GLchar* shadowVertexShaderSource = GLSL(440,
+
+	layout(location = 0) in vec3 position;
+
+	uniform mat4 model;
+	uniform mat4 lightViewProjection;
+
+	void main()
 	{
-		cerr << "Failed to Load Texture " << texFilename << endl;
-		return EXIT_FAILURE;
+		gl_Position = lightViewProjection * model * vec4(position, 1.0f);
 	}
-	
-	glUseProgram(gProgramID);
+);
 
-	glUniform1i(glGetUniformLocation(gProgramID, "uTexture"), 0);
+const GLchar* shadowFragmentShaderSource = GLSL(440,
 
-	// Render Loop
-	// -----------
-	while (!glfwWindowShouldClose(gWindow))
+	void main()
 	{
-		// Per-Frame Timing
-		// ----------------
-		float currentFrame = glfwGetTime();
-		gDeltaTime = currentFrame - gLastFrame;
-		gLastFrame = currentFrame;
+	}
+);
 
-		// Input
-		// -----
-		processInput(gWindow);
+// Debug Overlay Shaders: World-Space Lines, then Window-Space Glyphs from the Font Atlas
+// -------------------------------------------------------------------------------------
+const GLchar* debugLineVertexShaderSource = GLSL(440,
 
-		// Renders Frame
-		// -------------
-		render();
+	layout(location = 0) in vec3 position;
+	layout(location = 1) in vec4 color;
 
-		// GLFW: Poll IO Events
-		// ------------------------------------
-		glfwPollEvents();
+	out vec4 vertexColor;
+
+	uniform mat4 viewProjection;
+
+	void main()
+	{
+		gl_Position = viewProjection * vec4(position, 1.0f);
+		vertexColor = color;
 	}
+);
 
-	// Terminates Process
-	// ------------------
-	terminateApplication(blockMesh_1, scissorsBladeMesh, blockMesh_2, floorMesh, lampMesh, gProgramID, gLampProgramID, gTextureIdMetal, gTextureIdFloor, gTextureIdWood, gTextureIdYellowWood);
-}
+const GLchar* debugLineFragmentShaderSource = GLSL(440,
 
-// Initialize GLFW, GLEW, and Create the Window Object
-// ---------------------------------------------------
-bool initialize(int argc, char* argv[], GLFWwindow** window)
-{
-	// GLFW: Initialize and Configure
-	// ------------------------------
-	glfwInit();
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 4);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	in vec4 vertexColor;
 
-	// GLFW: Create Window
-	// -------------------
-	*window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE, NULL, NULL);
+	out vec4 fragmentColor;
 
-	// Error Check: Window Creation
-	// ----------------------------
-	if (*window == NULL)
+	void main()
 	{
-		cerr << "Failed to create GLFW window" << endl;
-		terminateApplication(blockMesh_1, blockMesh_2, scissorsBladeMesh, floorMesh, lampMesh, gProgramID, gLampProgramID, gTextureIdMetal, gTextureIdFloor, gTextureIdWood, gTextureIdYellowWood);
-		return false;
+		fragmentColor = vertexColor;
 	}
+);
 
-	// GLFW: Make Window Current Context
-	// ---------------------------------
-	glfwMakeContextCurrent(*window);
-	glfwSetFramebufferSizeCallback(*window, resizeWindow);
+const GLchar* debugTextVertexShaderSource = GLSL(440,
 
-	// GLFW: Mouse Control Callbacks
-	// -----------------------------
-	glfwSetCursorPosCallback(*window, mousePositionCallback);
-	glfwSetScrollCallback(*window, mouseScrollCallback);
-	glfwSetMouseButtonCallback(*window, mouseButtonCallback);
+	layout(location = 0) in vec2 position; // Window pixels, origin at the top left
+	layout(location = 1) in vec4 color;
+	layout(location = 2) in vec2 glyphCoordinate;
 
-	// tell GLFW to capture our mouse
-	glfwSetInputMode(*window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+	out vec4 vertexColor;
+	out vec2 vertexGlyphCoordinate;
 
-	// GLEW: Initialize
-	// ----------------
-	GLenum GlewInitResult = glewInit();
+	uniform vec2 windowSize;
 
-	// Error Check: GLEW Initialization
-	// --------------------------------
-	if (GLEW_OK != GlewInitResult)
+	void main()
 	{
-		cerr << glewGetErrorString(GlewInitResult) << endl;
-		return false;
+		vec2 normalized = position / windowSize;
+		gl_Position = vec4(normalized.x * 2.0f - 1.0f, 1.0f - normalized.y * 2.0f, 0.0f, 1.0f);
+		vertexColor = color;
+		vertexGlyphCoordinate = glyphCoordinate;
 	}
+);
 
-	// Display GPU OpenGL Version
-	// --------------------------
-	cerr << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << endl;
+const GLchar* debugTextFragmentShaderSource = GLSL(440,
 
-	// Background Color - Black
-	// ------------------------
-	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	in vec4 vertexColor;
+	in vec2 vertexGlyphCoordinate;
 
-	return true;
-}
+	out vec4 fragmentColor;
 
-#pragma region Input Handling
+	uniform sampler2D glyphAtlas; // Font coverage in red
+
+	void main()
+	{
+		float coverage = texture(glyphAtlas, vertexGlyphCoordinate).r;
+		fragmentColor = vec4(vertexColor.rgb, vertexColor.a * coverage);
+	}
+);
+
+	/* Lamp Shader Source Code*/
+	const GLchar* lampVertexShaderSource = GLSL(440,
+
+		layout(location = 0) in vec3 position;
+
+		//Uniform / Global variables for the  transform matrices
+		uniform mat4 model;
+		uniform mat4 view;
+		uniform mat4 projection;
+
+		void main()
+		{
+			gl_Position = projection * view * model * vec4(position, 1.0f); // Transforms vertices into coordinates
+		}
+	);
+
+
+	/* Fragment Shader Source Code*/
+	const GLchar* lampFragmentShaderSource = GLSL(440,
+
+		out vec4 fragmentColor;
+
+		void main()
+		{
+			fragmentColor = vec4(1.0f); // Set color to white (1.0f,1.0f,1.0f) with alpha 1.0
+		}
+	);
+
+// G-Buffer Fragment Shader: Albedo and Normal for the Deferred Path
+// -----------------------------------------------------------------
+const GLchar* gBufferFragmentShaderSource = GLSL(440,
+
+	in vec3 vertexNormal;
+	in vec3 vertexFragmentPos;
+	in vec2 vertexTextureCoordinate;
+
+	layout(location = 0) out vec4 gAlbedo;
+	layout(location = 1) out vec4 gNormal;
+
+	uniform sampler2D uTexture;
+	uniform vec2 uvScale;
+
+	void main()
+	{
+		gAlbedo = vec4(texture(uTexture, vertexTextureCoordinate * uvScale).rgb, 1.0f);
+		gNormal = vec4(normalize(vertexNormal), 0.0f); // World-space normal
+	}
+);
+
+// Full-Screen Triangle Vertex Shader: No Vertex Buffers Needed
+// ------------------------------------------------------------
+const GLchar* fullscreenVertexShaderSource = GLSL(440,
+
+	out vec2 screenCoordinate;
+
+	void main()
+	{
+		screenCoordinate = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2); // (0,0), (2,0), (0,2)
+		gl_Position = vec4(screenCoordinate * 2.0f - 1.0f, 0.0f, 1.0f);
+	}
+);
+
+// Deferred Lighting Fragment Shader: Shades the G-Buffer with the Cluster Light Lists
+// -----------------------------------------------------------------------------------
+const GLchar* deferredLightingFragmentShaderSource = GLSL(440,
+
+	in vec2 screenCoordinate;
+
+	out vec4 fragmentColor;
+
+	uniform sampler2D gAlbedo;
+	uniform sampler2D gNormal;
+	uniform sampler2D gDepth;
+	uniform mat4 inverseViewProjection;
+
+	vec3 clusteredLighting(vec3 fragmentPos, vec3 norm, vec2 fragCoord); // Defined in clusteredLightingSource
+	vec3 keyLighting(vec3 fragmentPos, vec3 norm); // Defined in keyLightSource
+
+	void main()
+	{
+		ivec2 texel = ivec2(gl_FragCoord.xy);
+		float depth = texelFetch(gDepth, texel, 0).r;
+		if (depth >= 1.0f)
+			discard; // Nothing was drawn here
+
+		// Reconstruct the world position from depth
+		vec4 world = inverseViewProjection * vec4(vec3(screenCoordinate, depth) * 2.0f - 1.0f, 1.0f);
+		vec3 fragmentPos = world.xyz / world.w;
+
+		vec3 albedo = texelFetch(gAlbedo, texel, 0).rgb;
+		vec3 norm = normalize(texelFetch(gNormal, texel, 0).xyz);
+
+		float ambientStrength = 0.0f; // Matches the forward Phong shader
+		vec3 lighting = ambientStrength + clusteredLighting(fragmentPos, norm, gl_FragCoord.xy) + keyLighting(fragmentPos, norm);
+
+		fragmentColor = vec4(lighting * albedo, 1.0f);
+		gl_FragDepth = depth; // Lets the forward lamp pass depth test against the scene
+	}
+);
+
+// Streaming Feedback Fragment Shader: Writes the Texture Slot and the Mip it Samples at Full Resolution
+// ----------------------------------------------------------------------------------------------------
+const GLchar* feedbackFragmentShaderSource = GLSL(440,
+
+	in vec2 vertexTextureCoordinate;
+
+	out uvec2 feedback;
+
+	uniform vec2 uvScale;
+	uniform uint uTextureSlot; // Streamer slot + 1; 0 for textures that are not streamed
+	uniform vec2 uTextureSize; // Full-resolution size of the streamed texture
+	uniform float uLodBias; // The feedback target is smaller than the window, so its derivatives are larger
+
+	void main()
+	{
+		vec2 texel = vertexTextureCoordinate * uvScale * uTextureSize;
+		vec2 dx = dFdx(texel);
+		vec2 dy = dFdy(texel);
+		float lod = 0.5f * log2(max(max(dot(dx, dx), dot(dy, dy)), 1.0f)) + uLodBias;
+		feedback = uvec2(uTextureSlot, uint(clamp(floor(lod), 0.0f, 15.0f)));
+	}
+);
+
+// Bloom Bright Pass: Keeps the HDR Color Above the Threshold, Downsampled by Bilinear Taps
+// ----------------------------------------------------------------------------------------
+const GLchar* bloomBrightFragmentShaderSource = GLSL(440,
+
+	in vec2 screenCoordinate;
+
+	out vec4 fragmentColor;
+
+	uniform sampler2D uSource;
+	uniform float uThreshold;
+
+	void main()
+	{
+		vec3 color = texture(uSource, screenCoordinate).rgb;
+		float brightness = max(color.r, max(color.g, color.b));
+		fragmentColor = vec4(color * (max(brightness - uThreshold, 0.0f) / max(brightness, 0.0001f)), 1.0f);
+	}
+);
+
+// Bloom Blur: One Axis of a 9-Tap Gaussian in 5 Bilinear Taps, Run Once per Axis
+// ------------------------------------------------------------------------------
+const GLchar* bloomBlurFragmentShaderSource = GLSL(440,
+
+	in vec2 screenCoordinate;
+
+	out vec4 fragmentColor;
+
+	uniform sampler2D uSource;
+	uniform vec2 uDirection; // (1, 0) or (0, 1)
+
+	const float weights[3] = float[](0.2270270270f, 0.3162162162f, 0.0702702703f);
+	const float offsets[3] = float[](0.0f, 1.3846153846f, 3.2307692308f);
+
+	void main()
+	{
+		vec2 texelStep = uDirection / vec2(textureSize(uSource, 0));
+		vec3 sum = texture(uSource, screenCoordinate).rgb * weights[0];
+		for (int i = 1; i < 3; ++i)
+		{
+			sum += texture(uSource, screenCoordinate + texelStep * offsets[i]).rgb * weights[i];
+			sum += texture(uSource, screenCoordinate - texelStep * offsets[i]).rgb * weights[i];
+		}
+
+		fragmentColor = vec4(sum, 1.0f);
+	}
+);
+
+// Tone Mapping: Adds the Blurred Bloom to the HDR Scene and Applies the ACES Filmic Curve
+// --------------------------------------------------------------------------------------
+const GLchar* toneMapFragmentShaderSource = GLSL(440,
+
+	in vec2 screenCoordinate;
+
+	out vec4 fragmentColor;
+
+	uniform sampler2D uSource; // Blurred bloom
+	uniform sampler2D uScene;
+	uniform float uExposure;
+	uniform float uBloomStrength;
+
+	vec3 acesFilm(vec3 x)
+	{
+		return clamp((x * (2.51f * x + 0.03f)) / (x * (2.43f * x + 0.59f) + 0.14f), 0.0f, 1.0f);
+	}
+
+	void main()
+	{
+		vec3 hdr = texture(uScene, screenCoordinate).rgb + texture(uSource, screenCoordinate).rgb * uBloomStrength;
+		vec3 mapped = acesFilm(hdr * uExposure);
+		fragmentColor = vec4(mapped, dot(mapped, vec3(0.299f, 0.587f, 0.114f))); // Luma in alpha for FXAA
+	}
+);
+
+// FXAA: Blends Along the Local Luma Gradient where the Contrast Marks an Edge
+// ---------------------------------------------------------------------------
+const GLchar* fxaaFragmentShaderSource = GLSL(440,
+
+	in vec2 screenCoordinate;
+
+	out vec4 fragmentColor;
+
+	uniform sampler2D uSource; // Tone mapped color with luma in alpha
+
+	const float REDUCE_MIN = 1.0f / 128.0f;
+	const float REDUCE_MUL = 1.0f / 8.0f;
+	const float SPAN_MAX = 8.0f;
+
+	void main()
+	{
+		vec2 texel = 1.0f / vec2(textureSize(uSource, 0));
+		vec4 center = texture(uSource, screenCoordinate);
+		float lumaNW = texture(uSource, screenCoordinate + vec2(-1.0f, 1.0f) * texel).a;
+		float lumaNE = texture(uSource, screenCoordinate + vec2(1.0f, 1.0f) * texel).a;
+		float lumaSW = texture(uSource, screenCoordinate + vec2(-1.0f, -1.0f) * texel).a;
+		float lumaSE = texture(uSource, screenCoordinate + vec2(1.0f, -1.0f) * texel).a;
+		float lumaMin = min(center.a, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+		float lumaMax = max(center.a, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+
+		// Blur direction runs along the edge, perpendicular to the luma gradient
+		vec2 direction = vec2((lumaSW + lumaSE) - (lumaNW + lumaNE), (lumaNW + lumaSW) - (lumaNE + lumaSE));
+		float directionReduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * 0.25f * REDUCE_MUL, REDUCE_MIN);
+		float inverseDirectionMin = 1.0f / (min(abs(direction.x), abs(direction.y)) + directionReduce);
+		direction = clamp(direction * inverseDirectionMin, vec2(-SPAN_MAX), vec2(SPAN_MAX)) * texel;
+
+		vec3 inner = 0.5f * (texture(uSource, screenCoordinate - direction / 6.0f).rgb + texture(uSource, screenCoordinate + direction / 6.0f).rgb);
+		vec3 outer = inner * 0.5f + 0.25f * (texture(uSource, screenCoordinate - direction * 0.5f).rgb + texture(uSource, screenCoordinate + direction * 0.5f).rgb);
+
+		// The wide blend overshot the neighbourhood: it crossed another edge, so keep the narrow one
+		float lumaOuter = dot(outer, vec3(0.299f, 0.587f, 0.114f));
+		fragmentColor = vec4((lumaOuter < lumaMin || lumaOuter > lumaMax) ? inner : outer, 1.0f);
+	}
+);
+
+// --bench-vertex Shaders: the Normal Matrix Inverted per Vertex, then Taken from a Uniform
+// ----------------------------------------------------------------------------------------
+const GLchar* perVertexInverseVertexShaderSource = GLSL(440,
+
+	layout(location = 0) in vec3 position;
+	layout(location = 1) in vec3 normal;
+
+	out vec3 vertexNormal;
+
+	uniform mat4 model;
+	uniform mat4 viewProjection;
+
+	void main()
+	{
+		gl_Position = viewProjection * model * vec4(position, 1.0f);
+		vertexNormal = mat3(transpose(inverse(model))) * normal;
+	}
+);
+
+const GLchar* normalMatrixVertexShaderSource = GLSL(440,
+
+	layout(location = 0) in vec3 position;
+	layout(location = 1) in vec3 normal;
+
+	out vec3 vertexNormal;
+
+	uniform mat4 model;
+	uniform mat3 normalMatrix;
+	uniform mat4 viewProjection;
+
+	void main()
+	{
+		gl_Position = viewProjection * model * vec4(position, 1.0f);
+		vertexNormal = normalMatrix * normal;
+	}
+);
+
+// Consumes the Normal so the Compiler Cannot Drop it
+// --------------------------------------------------
+const GLchar* normalFragmentShaderSource = GLSL(440,
+
+	in vec3 vertexNormal;
+
+	out vec4 fragmentColor;
+
+	void main()
+	{
+		fragmentColor = vec4(vertexNormal, 1.0f);
+	}
+);
+
+// Lighting Library Appended to Every Lit Fragment Shader
+// ------------------------------------------------------
+const string lightingLibrarySource = string(clusteredLightingSource) + keyLightSource;
+
+// Every Shader Stage by File Name, for --export-shaders and the SPIR-V Vulkan Loads
+// ---------------------------------------------------------------------------------
+struct ShaderStage
+{
+	const char* filename;
+	const GLchar* source;
+	const GLchar* librarySource;   // Appended the Same Way createShaderProgram() Does
+};
+
+const ShaderStage SHADER_STAGES[] =
+{
+	{ "scene.vert", vertexShaderSource, nullptr },
+	{ "scene.frag", fragmentShaderSource, lightingLibrarySource.c_str() },
+	{ "lamp.vert", lampVertexShaderSource, nullptr },
+	{ "lamp.frag", lampFragmentShaderSource, nullptr },
+	{ "shadow.vert", shadowVertexShaderSource, nullptr },
+	{ "shadow.frag", shadowFragmentShaderSource, nullptr },
+	{ "debugLine.vert", debugLineVertexShaderSource, nullptr },
+	{ "debugLine.frag", debugLineFragmentShaderSource, nullptr },
+	{ "debugText.vert", debugTextVertexShaderSource, nullptr },
+	{ "debugText.frag", debugTextFragmentShaderSource, nullptr },
+	{ "gbuffer.frag", gBufferFragmentShaderSource, nullptr },
+	{ "fullscreen.vert", fullscreenVertexShaderSource, nullptr },
+	{ "deferredLighting.frag", deferredLightingFragmentShaderSource, lightingLibrarySource.c_str() },
+	{ "feedback.frag", feedbackFragmentShaderSource, nullptr },
+	{ "multiView.vert", multiViewVertexShaderSource, nullptr },
+	{ "multiView.frag", multiViewFragmentShaderSource, lightingLibrarySource.c_str() },
+	{ "lightmap.vert", lightmapVertexShaderSource, nullptr },
+	{ "lightmap.frag", lightmapFragmentShaderSource, nullptr },
+	{ "bloomBright.frag", bloomBrightFragmentShaderSource, nullptr },
+	{ "bloomBlur.frag", bloomBlurFragmentShaderSource, nullptr },
+	{ "toneMap.frag", toneMapFragmentShaderSource, nullptr },
+	{ "fxaa.frag", fxaaFragmentShaderSource, nullptr },
+	{ "perVertexInverse.vert", perVertexInverseVertexShaderSource, nullptr },
+	{ "normalMatrix.vert", normalMatrixVertexShaderSource, nullptr },
+	{ "normal.frag", normalFragmentShaderSource, nullptr },
+};
+
+// Images are Loaded with Y-Axis going down, but OpenGL's Y-Axis Goes Up this Function Flips it
+// --------------------------------------------------------------------------------------------
+void flipImageVertically(unsigned char* image, int width, int height, int channels)
+{
+	for (int j = 0; j < height / 2; ++j)
+	{
+		int index1 = j * width * channels;
+		int index2 = (height - 1 - j) * width * channels;
+
+		for (int i = width * channels; i > 0; --i)
+		{
+			unsigned char tmp = image[index1];
+			image[index1] = image[index2];
+			image[index2] = tmp;
+			++index1;
+			++index2;
+		}
+	}
+}
+
+
+#pragma endregion
+
+// Main Function: Entry Point to OpenGL Program
+// --------------------------------------------
+int main(int argc, char* argv[])
+{
+	// Headless Benchmarks
+	// -------------------
+	if (hasOption(argc, argv, "--bench-jobs"))
+	{
+		benchmarkJobSystem(100000);
+		return EXIT_SUCCESS;
+	}
+
+	if (hasOption(argc, argv, "--bench-transforms"))
+	{
+		benchmarkTransforms(100000);
+		return EXIT_SUCCESS;
+	}
+
+	if (hasOption(argc, argv, "--bench-occlusion"))
+	{
+		benchmarkOcclusion(200, 10000);
+		return EXIT_SUCCESS;
+	}
+
+	// Offline Step: Write the GLSL() Sources Out for Validation and SPIR-V Generation
+	// -------------------------------------------------------------------------------
+	if (const char* exportDirectory = optionValue(argc, argv, "--export-shaders"))
+		return exportShaders(exportDirectory) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	// Offline Step: Compare Two Captures Frame by Frame, e.g. the GL and Vulkan Backends
+	// ----------------------------------------------------------------------------------
+	if (const char* compareDirectory = optionValue(argc, argv, "--compare-captures"))
+	{
+		const char* reference = optionValue(argc, argv, "--compare-reference");
+		if (!reference)
+		{
+			cerr << "--compare-captures Needs --compare-reference DIR" << endl;
+			return EXIT_FAILURE;
+		}
+
+		const char* tolerance = optionValue(argc, argv, "--compare-tolerance");
+		const char* maxShare = optionValue(argc, argv, "--compare-max-share");
+		return FrameCapture::compare(compareDirectory, reference, tolerance ? atoi(tolerance) : DEFAULT_COMPARE_TOLERANCE,
+			maxShare ? atof(maxShare) : DEFAULT_COMPARE_MAX_SHARE) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	// Start the Worker Pool
+	// ---------------------
+	gJobSystem.reset(new JobSystem());
+	gFrameArena.create(FRAME_ARENA_SIZE);
+
+	// Select the Render Path
+	// ----------------------
+	if (hasOption(argc, argv, "--deferred"))
+		gRenderPath = RenderPath::Deferred;
+
+	gOcclusionCullingEnabled = hasOption(argc, argv, "--occlusion-culling");
+	gDynamicResolutionEnabled = hasOption(argc, argv, "--dynamic-resolution");
+	gPostProcessingEnabled = hasOption(argc, argv, "--post-processing");
+	gTextureStreamingEnabled = hasOption(argc, argv, "--texture-streaming");
+	gOnDemandRendering = hasOption(argc, argv, "--on-demand");
+	gMemoryReportEnabled = hasOption(argc, argv, "--memory-report");
+	gDebugOverlayEnabled = hasOption(argc, argv, "--debug-overlay");
+
+	// Select the Render Backend
+	// -------------------------
+	if (const char* backendName = optionValue(argc, argv, "--backend"))
+	{
+		if (strcmp(backendName, "vulkan") == 0)
+		{
+			gBackendApi = BackendApi::Vulkan;
+		}
+		else if (strcmp(backendName, "gl") != 0)
+		{
+			cerr << "Unknown Render Backend " << backendName << " (gl or vulkan)" << endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+#ifndef RENDER_BACKEND_VULKAN
+	if (gBackendApi == BackendApi::Vulkan)
+	{
+		cerr << "ERROR::BACKEND::VULKAN_NOT_BUILT Rebuild with the Vulkan SDK Installed (VULKAN_SDK Set)" << endl;
+		return EXIT_FAILURE;
+	}
+#endif
+
+	// Error Check: GLFW and GLEW Initialized
+	// --------------------------------------
+	if (!initialize(argc, argv, &gWindow))
+		return EXIT_FAILURE;
+
+	// Scene Buffers, Textures and Draws Go Through the Backend
+	// --------------------------------------------------------
+	if (gBackendApi == BackendApi::OpenGL)
+		gBackend.reset(new GLBackend(gWindow));
+#ifdef RENDER_BACKEND_VULKAN
+	else
+	{
+		VulkanBackend* vulkan = new VulkanBackend();
+		gBackend.reset(vulkan);
+		if (!vulkan->create(gWindow, *gJobSystem))
+			return EXIT_FAILURE;
+	}
+#endif
+	cerr << "INFO: Render Backend: " << gBackend->name() << ", Recording on " << gJobSystem->threadCount() << " Threads" << endl;
+
+	// GPU Benchmark: Needs the Backend and its Two Programs but None of the Scene
+	// ---------------------------------------------------------------------------
+	if (hasOption(argc, argv, "--bench-vertex"))
+	{
+		gShaderBatchStart = glfwGetTime();
+		const ProgramHandle inverseProgram = submitShaderProgram(perVertexInverseVertexShaderSource, normalFragmentShaderSource);
+		const ProgramHandle normalMatrixProgram = submitShaderProgram(normalMatrixVertexShaderSource, normalFragmentShaderSource);
+		while (!programReady(programId(inverseProgram)) || !programReady(programId(normalMatrixProgram)))
+		{
+			// Error Check: Vulkan Programs are Never Pending, so One Missing Now Failed to Load
+			// ---------------------------------------------------------------------------------
+			if (gBackendApi == BackendApi::Vulkan || !pollShaderPrograms())
+				return EXIT_FAILURE;
+		}
+
+		benchmarkVertexShader(*gBackend, programId(inverseProgram), programId(normalMatrixProgram));
+		return EXIT_SUCCESS;
+	}
+
+	// Creates the Meshs
+	// -----------------
+	gScissorsBladeMesh = createMesh(createScissorMesh);
+	gFloorMesh = createMesh(createFloorMesh);
+	gBlockMesh1 = createMesh(createBlock1Mesh);
+	gBlockMesh2 = createMesh(createBlock2Mesh);
+	gLampMesh = createMesh(createLampMesh);
+
+	// Streamed Textures Start with their Coarsest Mips Only
+	// ----------------------------------------------------
+	if (gTextureStreamingEnabled)
+	{
+		const char* budget = optionValue(argc, argv, "--texture-budget");
+		const size_t budgetMegabytes = budget ? static_cast<size_t>(atoll(budget)) : DEFAULT_TEXTURE_BUDGET_MB;
+		if (!gTextureStreamer.create(*gBackend, budgetMegabytes * 1024 * 1024))
+			return EXIT_FAILURE;
+	}
+
+	// Load Textures
+	// -------------
+	const char* texFilename = "resources/textures/metalTexture.jpg";
+	if (!createTexture(texFilename, gMetalTexture))
+	{
+		cerr << "Failed to Load Texture " << texFilename << endl;
+		return EXIT_FAILURE;
+	}
+
+	texFilename = "resources/textures/floorTexture.jpg";
+	if (!createTexture(texFilename, gFloorTexture))
+	{
+		cerr << "Failed to Load Texture " << texFilename << endl;
+		return EXIT_FAILURE;
+	}
+
+	texFilename = "resources/textures/woodTexture.jpg";
+	if (!createTexture(texFilename, gWoodTexture))
+	{
+		cerr << "Failed to Load Texture " << texFilename << endl;
+		return EXIT_FAILURE;
+	}
+
+	texFilename = "resources/textures/yellowWoodTexture.jpg";
+	if (!createTexture(texFilename, gYellowWoodTexture))
+	{
+		cerr << "Failed to Load Texture " << texFilename << endl;
+		return EXIT_FAILURE;
+	}
+
+	createScene();
+
+	// Extra Point Lights for Testing the Clustered Renderer
+	// -----------------------------------------------------
+	if (const char* lightCount = optionValue(argc, argv, "--lights"))
+		createRandomLights(static_cast<size_t>(atoi(lightCount)));
+
+	// Bake or Load the Static Lighting
+	// --------------------------------
+	if (const char* lightmapPath = optionValue(argc, argv, "--lightmap"))
+	{
+		if (!createLightmaps(argc, argv, lightmapPath))
+			return EXIT_FAILURE;
+		gLightmapsEnabled = true;
+	}
+
+	gClusteredLighting.create(*gBackend);
+	if (!gFrameStream.create(*gBackend, FRAME_STREAM_REGION_SIZE))
+		return EXIT_FAILURE;
+
+	// Shadow Atlas and Depth Program
+	// ------------------------------
+	if (!gShadowMaps.create(*gBackend))
+		return EXIT_FAILURE;
+
+	if (gDynamicResolutionEnabled)
+	{
+		const char* budget = optionValue(argc, argv, "--frame-budget");
+		if (!gDynamicResolution.create(*gBackend, budget ? static_cast<float>(atof(budget)) : DEFAULT_FRAME_BUDGET))
+			return EXIT_FAILURE;
+	}
+
+	// Capture the Presented Frames to an Image Sequence or Video
+	// ----------------------------------------------------------
+	if (const char* captureDirectory = optionValue(argc, argv, "--capture"))
+	{
+		FrameCapture::Format format = FrameCapture::Format::Qoi;
+		const char* formatName = optionValue(argc, argv, "--capture-format");
+		if (formatName && !FrameCapture::parseFormat(formatName, format))
+		{
+			cerr << "Unknown Capture Format " << formatName << " (png, qoi or y4m)" << endl;
+			return EXIT_FAILURE;
+		}
+
+		const char* fps = optionValue(argc, argv, "--capture-fps");
+		if (!gFrameCapture.create(*gBackend, captureDirectory, format, fps ? atoi(fps) : DEFAULT_CAPTURE_FPS))
+			return EXIT_FAILURE;
+		gFrameCaptureEnabled = true;
+
+		if (const char* frames = optionValue(argc, argv, "--capture-frames"))
+			gCaptureFrameLimit = static_cast<size_t>(max(atoi(frames), 0));
+	}
+
+	// Draw Split-Screen, Stereo or Both Projections in One Pass; Unsupported Drivers Keep One View
+	// -------------------------------------------------------------------------------------------
+	if (const char* layoutName = optionValue(argc, argv, "--multi-view"))
+	{
+		MultiView::Layout layout;
+		if (!MultiView::parseLayout(layoutName, layout))
+		{
+			cerr << "Unknown Multi-View Layout " << layoutName << " (split, stereo or projections)" << endl;
+			return EXIT_FAILURE;
+		}
+
+		gMultiViewEnabled = gMultiView.create(*gBackend, layout);
+	}
+
+	// Warm Starts Load Linked Binaries Instead of Compiling
+	// -----------------------------------------------------
+	if (gBackendApi == BackendApi::OpenGL && !hasOption(argc, argv, "--no-shader-cache"))
+		gShaderCache.open(SHADER_CACHE_DIRECTORY);
+
+	// Submit Every Shader Program at Once so the Driver Compiles them in Parallel
+	// --------------------------------------------------------------------------
+	gShaderBatchStart = glfwGetTime();
+	gSceneProgram = submitShaderProgram(vertexShaderSource, fragmentShaderSource, lightingLibrarySource.c_str());
+	gShadowProgram = submitShaderProgram(shadowVertexShaderSource, shadowFragmentShaderSource);
+	gLampProgram = submitShaderProgram(lampVertexShaderSource, lampFragmentShaderSource);
+
+	// Deferred Path: G-Buffer Programs and Targets
+	// --------------------------------------------
+	if (gRenderPath == RenderPath::Deferred)
+	{
+		gGBufferProgram = submitShaderProgram(vertexShaderSource, gBufferFragmentShaderSource);
+		gDeferredLightingProgram = submitShaderProgram(fullscreenVertexShaderSource, deferredLightingFragmentShaderSource, lightingLibrarySource.c_str());
+		if (!gDeferredRenderer.create(*gBackend, gFramebufferWidth, gFramebufferHeight))
+			return EXIT_FAILURE;
+	}
+
+	if (gTextureStreamingEnabled)
+		gFeedbackProgram = submitShaderProgram(vertexShaderSource, feedbackFragmentShaderSource);
+
+	if (gLightmapsEnabled)
+		gLightmapProgram = submitShaderProgram(lightmapVertexShaderSource, lightmapFragmentShaderSource);
+
+	if (gMultiViewEnabled)
+	{
+		gMultiViewProgram = submitShaderProgram(multiViewVertexShaderSource, multiViewFragmentShaderSource, lightingLibrarySource.c_str());
+		gMultiViewLampProgram = submitShaderProgram(multiViewVertexShaderSource, lampFragmentShaderSource);
+	}
+
+	// Post-Processing: Bloom at Reduced Resolution, Tone Mapping, then FXAA
+	// ---------------------------------------------------------------------
+	if (gPostProcessingEnabled && !createPostProcessing(argc, argv))
+		return EXIT_FAILURE;
+
+	// Debug Overlay: Programs and the Font Atlas
+	// ------------------------------------------
+	if (gDebugOverlayEnabled)
+	{
+		gDebugLineProgram = submitShaderProgram(debugLineVertexShaderSource, debugLineFragmentShaderSource);
+		gDebugTextProgram = submitShaderProgram(debugTextVertexShaderSource, debugTextFragmentShaderSource);
+		if (!gDebugDraw.create(*gBackend))
+			return EXIT_FAILURE;
+	}
+	// The First Frame Needs the Forward Scene and Shadow Programs; the Rest can Arrive Later
+	// ---------------------------------------------------------------------------------------
+	while (!programReady(programId(gSceneProgram)) || !programReady(programId(gShadowProgram)))
+	{
+		// Error Check: Vulkan Programs are Never Pending, so One Missing Now Failed to Load
+		// ---------------------------------------------------------------------------------
+		if (gBackendApi == BackendApi::Vulkan)
+		{
+			cerr << "ERROR::SHADER::PROGRAM_NOT_READY " << (programReady(programId(gSceneProgram)) ? "Shadow" : "Scene") << " Program" << endl;
+			return EXIT_FAILURE;
+		}
+
+		if (!pollShaderPrograms())
+			return EXIT_FAILURE;
+	}
+
+	// Stress Benchmark: Replaces the Scene and the Render Loop
+	// --------------------------------------------------------
+	if (hasOption(argc, argv, "--stress"))
+	{
+		if (!runStressBenchmark(argc, argv))
+			return EXIT_FAILURE;
+		terminateApplication();
+	}
+
+	// Record the Live Input, or Replay a Recording in its Place
+	// ---------------------------------------------------------
+	gLastFrame = glfwGetTime();
+	if (const char* replayPath = optionValue(argc, argv, "--replay-input"))
+	{
+		if (!gInputReplayer.create(replayPath))
+			return EXIT_FAILURE;
+
+		const char* fps = optionValue(argc, argv, "--replay-fps");
+		gReplayStep = 1.0f / (fps ? static_cast<float>(atof(fps)) : DEFAULT_REPLAY_FPS);
+		gInputReplayer.begin(gCamera);
+		gReplayStart = gLastFrame;
+		gInputReplayEnabled = true;
+	}
+	else if (const char* recordPath = optionValue(argc, argv, "--record-input"))
+	{
+		if (!gInputRecorder.create(recordPath, gCamera, gLastFrame))
+			return EXIT_FAILURE;
+		gInputRecordingEnabled = true;
+	}
+
+	gUsageMeter.create(*gBackend);
+	gUsageMeter.reset(glfwGetTime());
+	gUsageReportTime = glfwGetTime();
+
+	// Render Loop
+	// -----------
+	while (!glfwWindowShouldClose(gWindow))
+	{
+		// Recycle the Oldest Frame's Transient Allocations
+		// -------------------------------------------------
+		gFrameArena.beginFrame();
+
+		// Per-Frame Timing
+		// ----------------
+		float currentFrame = glfwGetTime();
+		gDeltaTime = gInputReplayEnabled ? gReplayStep : currentFrame - gLastFrame;
+		gLastFrame = currentFrame;
+
+		// Input
+		// -----
+		processInput(gWindow);
+
+		// Pick Up Programs that Finished Compiling Since the Last Frame
+		// -------------------------------------------------------------
+		if (!pollShaderPrograms())
+			return EXIT_FAILURE;
+
+		// On-Demand: Sleep Until the Next Event when Nothing a Frame Depends on Changed
+		// -----------------------------------------------------------------------------
+		if (gOnDemandRendering && !sceneChanged())
+		{
+			glfwWaitEventsTimeout(ON_DEMAND_WAIT);
+			gLastFrame = glfwGetTime();   // Time Spent Idle Moves Nothing
+			reportUtilization();
+			continue;
+		}
+
+		// Renders Frame
+		// -------------
+		gUsageMeter.beginFrame();
+		render();
+		gUsageMeter.endFrame();
+		reportFrameTime();
+		reportUtilization();
+
+		// GLFW: Poll IO Events
+		// ------------------------------------
+		glfwPollEvents();
+	}
+
+	// Terminates Process
+	// ------------------
+	terminateApplication();
+}
+
+// Initialize GLFW, GLEW, and Create the Window Object
+// ---------------------------------------------------
+bool initialize(int argc, char* argv[], GLFWwindow** window)
+{
+	// GLFW: Initialize and Configure
+	// ------------------------------
+	glfwInit();
+	if (gBackendApi == BackendApi::Vulkan)
+	{
+		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);   // The Backend Creates the Surface
+	}
+	else
+	{
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 4);
+		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	}
+
+	// GLFW: Create Window
+	// -------------------
+	*window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE, NULL, NULL);
+
+	// Error Check: Window Creation
+	// ----------------------------
+	if (*window == NULL)
+	{
+		cerr << "Failed to create GLFW window" << endl;
+		terminateApplication();
+		return false;
+	}
+
+	// GLFW: Make Window Current Context
+	// ---------------------------------
+	if (gBackendApi == BackendApi::OpenGL)
+		glfwMakeContextCurrent(*window);
+	glfwSetFramebufferSizeCallback(*window, resizeWindow);
+	glfwGetFramebufferSize(*window, &gFramebufferWidth, &gFramebufferHeight);
+
+	// GLFW: Mouse Control Callbacks
+	// -----------------------------
+	glfwSetCursorPosCallback(*window, mousePositionCallback);
+	glfwSetScrollCallback(*window, mouseScrollCallback);
+	glfwSetMouseButtonCallback(*window, mouseButtonCallback);
+	glfwSetWindowRefreshCallback(*window, refreshWindow);
+
+	// tell GLFW to capture our mouse
+	glfwSetInputMode(*window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+
+	// Vulkan: No Context, so Nothing for GLEW to Load
+	// -----------------------------------------------
+	if (gBackendApi == BackendApi::Vulkan)
+		return true;
+
+	// GLEW: Initialize
+	// ----------------
+	GLenum GlewInitResult = glewInit();
+
+	// Error Check: GLEW Initialization
+	// --------------------------------
+	if (GLEW_OK != GlewInitResult)
+	{
+		cerr << glewGetErrorString(GlewInitResult) << endl;
+		return false;
+	}
+
+	// Display GPU OpenGL Version
+	// --------------------------
+	cerr << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << endl;
+
+	// Background Color - Black
+	// ------------------------
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+	return true;
+}
+
+#pragma region Input Handling
 
 // GLFW: Process All Input
 // -----------------------
@@ -407,27 +1709,89 @@ void processInput(GLFWwindow* window)
 	// ------------------------------------------
 	if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
 		glfwSetWindowShouldClose(window, true);
+
+	// A Replay Drives the Camera in Place of the Keyboard and Mouse
+	// -------------------------------------------------------------
+	if (gInputReplayEnabled)
+	{
+		replayInput();
+		return;
+	}
+
+	uint32_t keys = 0;
 	if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS)
-		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+		keys |= INPUT_KEY_WIREFRAME;
 	if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS)
-		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+		keys |= INPUT_KEY_FILL;
 	if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-		gCamera.ProcessKeyboard(FORWARD, gDeltaTime);
+		keys |= INPUT_KEY_FORWARD;
 	if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-		gCamera.ProcessKeyboard(BACKWARD, gDeltaTime);
+		keys |= INPUT_KEY_BACKWARD;
 	if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-		gCamera.ProcessKeyboard(LEFT, gDeltaTime);
+		keys |= INPUT_KEY_LEFT;
 	if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-		gCamera.ProcessKeyboard(RIGHT, gDeltaTime);
+		keys |= INPUT_KEY_RIGHT;
 	if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS)
+		keys |= INPUT_KEY_PROJECTION;
+
+	// The Keys Moved the Camera Over the Interval Since the Last Frame
+	// ----------------------------------------------------------------
+	if (gInputRecordingEnabled)
+		gInputRecorder.recordKeys(static_cast<double>(gLastFrame) - gDeltaTime, keys);
+
+	moveCamera(gCamera, keys, gDeltaTime);
+	applyInputToggles(keys);
+
+	if (gInputRecordingEnabled)
+		gInputRecorder.recordPose(gLastFrame, gCamera);
+}
+
+// Polygon Mode and Projection Keys
+// --------------------------------
+void applyInputToggles(uint32_t keys)
+{
+	if (keys & INPUT_KEY_WIREFRAME)
+		gPolygonMode = GL_LINE;
+	if (keys & INPUT_KEY_FILL)
+		gPolygonMode = GL_FILL;
+	if (keys & (INPUT_KEY_WIREFRAME | INPUT_KEY_FILL))
+		gBackend->setWireframe(gPolygonMode == GL_LINE);
+	if (keys & INPUT_KEY_PROJECTION)
 		viewProjection = !viewProjection;
 }
 
+// Advance the Replay by One Fixed Step; Closes the Window when the Recording Ends
+// ------------------------------------------------------------------------------
+void replayInput()
+{
+	const bool playing = gInputReplayer.step(gReplayStep, gCamera);
+	applyInputToggles(gInputReplayer.keys());
+	for (float offset : gInputReplayer.scrollOffsets())
+		adjustCameraSpeed(offset);
+
+	if (playing)
+		return;
+
+	const double elapsed = glfwGetTime() - gReplayStart;
+	cerr << "INFO: Input Replay: " << gInputReplayer.stepCount() << " Frames of " << (1000.0f * gReplayStep) << " ms over "
+		<< gInputReplayer.duration() << " s Recorded, " << (1000.0 * elapsed / gInputReplayer.stepCount()) << " ms/frame Average, Max Drift "
+		<< gInputReplayer.maxPositionDrift() << " Units and " << gInputReplayer.maxAngleDrift() << " Degrees from the Recorded Poses" << endl;
+	glfwSetWindowShouldClose(gWindow, true);
+}
+
 // GLFW: Whenever the Window Size Changes this Function Executes
 // -------------------------------------------------------------
 void resizeWindow(GLFWwindow* window, int width, int height)
 {
-	glViewport(0, 0, width, height);
+	gFramebufferWidth = width;
+	gFramebufferHeight = height;
+}
+
+// GLFW: the Window's Contents were Damaged (Uncovered, Restored) and Need Drawing Again
+// ------------------------------------------------------------------------------------
+void refreshWindow(GLFWwindow* window)
+{
+	gChangeTracker.requestRedraw();
 }
 
 // GLFW: When the Mouse Moves, this is Called
@@ -447,6 +1811,12 @@ void mousePositionCallback(GLFWwindow* window, double xPos, double yPos)
 	gLastX = xPos;
 	gLastY = yPos;
 
+	if (gInputReplayEnabled)
+		return;
+
+	if (gInputRecordingEnabled)
+		gInputRecorder.recordMouse(gLastFrame, xOffset, yOffset);
+
 	gCamera.ProcessMouseMovement(xOffset, yOffset);
 }
 
@@ -454,9 +1824,22 @@ void mousePositionCallback(GLFWwindow* window, double xPos, double yPos)
 // -------------------------------------------------------------
 void mouseScrollCallback(GLFWwindow* window, double xOffset, double yOffset) 
 {
-	if (yOffset > 0 && cameraSpeed < 0.1f)
+	if (gInputReplayEnabled)
+		return;
+
+	if (gInputRecordingEnabled)
+		gInputRecorder.recordScroll(gLastFrame, static_cast<float>(yOffset));
+
+	adjustCameraSpeed(static_cast<float>(yOffset));
+}
+
+// Scrolling Steps the Camera Speed
+// --------------------------------
+void adjustCameraSpeed(float offset)
+{
+	if (offset > 0 && cameraSpeed < 0.1f)
 		cameraSpeed += 0.01f;
-	if (yOffset < 0 && cameraSpeed > 0.01f)
+	if (offset < 0 && cameraSpeed > 0.01f)
 		cameraSpeed -= 0.01f;
 }
 
@@ -505,251 +1888,1308 @@ void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
 // ------------------
 void render()
 {
-	// Enable Z-Depth
-	// --------------
-	glEnable(GL_DEPTH_TEST);
+	const double frameStart = glfwGetTime();
+	gFrameDrawCalls = 0;
+
+	// Pick this Frame's Render Size; the Whole Frame is Timed Against the Budget
+	// --------------------------------------------------------------------------
+	gSceneTarget = 0;
+	gRenderWidth = gFramebufferWidth;
+	gRenderHeight = gFramebufferHeight;
+	if (gDynamicResolutionEnabled)
+	{
+		gDynamicResolution.beginFrame(gFramebufferWidth, gFramebufferHeight);
+		if (gDynamicResolution.target())
+		{
+			gSceneTarget = gDynamicResolution.target();
+			gRenderWidth = gDynamicResolution.width();
+			gRenderHeight = gDynamicResolution.height();
+		}
+	}
 
-	// Clear the Frame and Z-Buffers
-	// -----------------------------
-	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	// Post-Processing Redirects the Camera Passes into its HDR Target Once its Programs are
+	// Ready, then Writes the Result Where they Would Have Drawn
+	// -------------------------------------------------------------------------------------
+	const RenderTargetId outputTarget = gSceneTarget;
+	const bool postProcessing = gPostProcessingEnabled && postProcessingReady() && gPostProcess.beginScene(gRenderWidth, gRenderHeight);
+	if (postProcessing)
+		gSceneTarget = gPostProcess.sceneTarget();
 
-	// Set Shader being Used
-	// ---------------------
-	glUseProgram(gProgramID);
+	// Recycle the Stream Region the GPU Finished Reading Three Frames Ago
+	// -------------------------------------------------------------------
+	gFrameStream.beginFrame();
 
 	// Transforms the Camera
 	// ---------------------
 	mat4 view = gCamera.GetViewMatrix();
 
 	// Creates a Perspective Projection: 4 Parameters (FOV, Aspect Ratio, Near PLane, Far Plane)
-	// -----------------------------------------------------------------------------------------
-	mat4 projection;
-	if (viewProjection) {
-		projection = perspective(radians(gCamera.Zoom), (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
+	// The Aspect Ratio Follows the Window, so Resizing (or Scaling the Render Size) Never Stretches
+	// ----------------------------------------------------------------------------------------------
+	float nearPlane, farPlane;
+	float aspectRatio = (gFramebufferHeight > 0) ? (GLfloat)gFramebufferWidth / (GLfloat)gFramebufferHeight : 1.0f;
+	mat4 projection = cameraProjection(viewProjection, aspectRatio, nearPlane, farPlane);
+
+	// Multi-View Replaces the Camera Passes Once its Programs are Ready
+	// -----------------------------------------------------------------
+	const bool multiView = gMultiViewEnabled && programReady(programId(gMultiViewProgram)) && programReady(programId(gMultiViewLampProgram));
+
+	// Assign the Point Lights to Clusters and Upload the Light Lists
+	// --------------------------------------------------------------
+	gClusteredLighting.update(*gJobSystem, gFrameStream, gLights, view, projection, nearPlane, farPlane, gRenderWidth, gRenderHeight);
+
+	// Compose Every Model Matrix in Parallel Before Issuing Draws
+	// -----------------------------------------------------------
+	updateModelMatrices();
+
+	// Skip Objects Hidden Behind the Floor and Blocks in the Camera Passes; the Other Views
+	// Look Past the Camera's Occluders, so Multi-View Draws Everything
+	// -------------------------------------------------------------------------------------
+	if (multiView)
+		gVisibleObjects = nullptr;
+	else
+		cullOccludedObjects(projection * view);
+
+	// Refresh Only the Shadow Cascades the Camera, the Light or Changed Static Geometry Invalidated
+	// ---------------------------------------------------------------------------------------------
+	bool hasDynamicCasters = false;
+	for (const SceneObject& object : gSceneObjects)
+		hasDynamicCasters = hasDynamicCasters || !object.isStatic;
+
+	if (gStaticGeometryVersion != gShadowStaticVersion)
+	{
+		gShadowMaps.invalidate();
+		gShadowStaticVersion = gStaticGeometryVersion;
 	}
-	else {
-		float scale = 120;
-		projection = ortho((800.0f / scale), -(800.0f / scale), -(600.0f / scale), (600.0f / scale), -2.5f, 6.5f);
+
+	gShadowMaps.update(gCamera.Position, keyLightDirection, programId(gShadowProgram), drawShadowCasters, hasDynamicCasters);
+	gReportShadowCascades += gShadowMaps.renderedCascadeCount();
+
+	// Record the Mips the Camera Samples, then Stream Levels In and Out
+	// -----------------------------------------------------------------
+	if (gTextureStreamingEnabled)
+		updateTextureStreaming(view, projection);
+
+	// Forward Shading Stands In Until the Deferred Programs Finish Compiling
+	// ---------------------------------------------------------------------
+	bool deferredReady = programReady(programId(gGBufferProgram)) && programReady(programId(gDeferredLightingProgram));
+	if (multiView)
+		renderMultiView(view, projection);
+	else if (gRenderPath == RenderPath::Deferred && deferredReady)
+		renderDeferred(view, projection);
+	else
+		renderForward(view, projection);
+
+#pragma region Light Binding / Generation
+
+	// LAMP: draw lamps once their program is ready
+	//----------------
+	const GLuint lampProgramID = programId(gLampProgram);
+	const GLmesh* lampMesh = gMeshes.get(gLampMesh);
+	if (!multiView && programReady(lampProgramID) && lampMesh)
+	{
+		CommandList& commands = gPassCommands;
+		commands.reset();
+		commands.bindPipeline(programPipeline(lampProgramID));
+
+		// Pass matrix data to the Lamp Shader program's matrix uniforms
+		commands.setUniform(Uniform::View, view);
+		commands.setUniform(Uniform::Projection, projection);
+		commands.bindVertexInput(lampMesh->VAO, meshIndexType(*lampMesh));
+
+		for (size_t i = 0; i < gLights.size() && i < LAMP_MARKER_COUNT; ++i)
+		{
+			commands.setUniform(Uniform::Model, lampModelMatrix(gLights[i]));
+			commands.drawIndexed(lampMesh->nIndices, 0);
+		}
+
+		// Over the Camera Pass, Depth Tested Against it
+		// ---------------------------------------------
+		gBackend->beginPass(scenePass(false));
+		gBackend->submit(&commands, 1);
+		gBackend->endPass();
+		gFrameDrawCalls += commands.drawCount();
 	}
 
-	GLint viewLoc = glGetUniformLocation(gProgramID, "view");
-	GLint projLoc = glGetUniformLocation(gProgramID, "projection");
+#pragma endregion
 
-	glUniformMatrix4fv(viewLoc, 1, GL_FALSE, value_ptr(view));
-	glUniformMatrix4fv(projLoc, 1, GL_FALSE, value_ptr(projection));
+	// Resolve the HDR Scene into the Window or the Scaled Target
+	// ----------------------------------------------------------
+	if (postProcessing)
+		gPostProcess.apply(outputTarget);
 
-	// Reference matrix uniforms from the Cube Shader program for the cub color, light color, light position, and camera position
-	GLint objectColorLoc = glGetUniformLocation(gProgramID, "objectColor");
-	GLint lightColorLoc = glGetUniformLocation(gProgramID, "lightColor");
-	GLint keyLightColorLoc = glGetUniformLocation(gProgramID, "keyLightColor");
-	GLint lightPositionLoc = glGetUniformLocation(gProgramID, "lightPos");
-	GLint viewPositionLoc = glGetUniformLocation(gProgramID, "viewPosition");
+	// GLFW: Swap Buffers and Poll IO Events
+	// -------------------------------------
+	if (gDynamicResolutionEnabled)
+		gDynamicResolution.endFrame();
 
-	// Pass color, light, and camera data to the Cube Shader program's corresponding uniforms
-	glUniform3f(lightColorLoc, lightColor.r, lightColor.g, lightColor.b);
-	glUniform3f(lightPositionLoc, lightPos.x, lightPos.y, lightPos.z);
-	const glm::vec3 cameraPosition = gCamera.Position;
-	glUniform3f(viewPositionLoc, cameraPosition.x, cameraPosition.y, cameraPosition.z);
+	// Overlay at Window Resolution, After Post-Processing and Scaling so Text Stays Sharp
+	// ----------------------------------------------------------------------------------
+	if (gDebugOverlayEnabled)
+		drawDebugOverlay(view, projection);
 
-	GLint UVScaleLoc = glGetUniformLocation(gProgramID, "uvScale");
-	glUniform2fv(UVScaleLoc, 1, value_ptr(uvScale));
+	// Queue the Finished Frame's Readback; the Encoder Thread Picks it Up Frames Later
+	// -------------------------------------------------------------------------------
+	if (gFrameCaptureEnabled && (gCaptureFrameLimit == 0 || gShaderBatchReported))
+	{
+		gFrameCapture.capture(gFramebufferWidth, gFramebufferHeight);
+		if (gCaptureFrameLimit > 0 && gFrameCapture.capturedFrameCount() >= gCaptureFrameLimit)
+			glfwSetWindowShouldClose(gWindow, true);
+	}
 
-#pragma region Scissors Rendering
+	gFrameCpuTime = glfwGetTime() - frameStart;
+	gBackend->present();
+}
 
-	// Left Blade
-	// Bind Textures to Corresponding Texture Units
-	// --------------------------------------------
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, gTextureIdMetal);
+// Forward Path: Phong Shading with Clustered Lights While Rasterizing
+// -------------------------------------------------------------------
+void renderForward(const mat4& view, const mat4& projection)
+{
+	// Clear the Frame and Z-Buffers
+	// -----------------------------
+	gBackend->beginPass(scenePass(true));
 
-	mat4 scale = glm::scale(vec3(1.2f, 1.2f, 1.2f));
-	mat4 yRotation = rotate(1.28f, vec3(1.0f, 0.0f, 0.0f));
-	mat4 xRotation = rotate(0.0f, vec3(0.0f, 1.0f, 0.0f));
-	mat4 zRotation = rotate(-0.4f, vec3(0.0f, 0.0f, 1.0f));
-	mat4 translation = glm::translate(vec3(2.2f, -0.582f, -1.4f));
+	// Set Shader being Used
+	// ---------------------
+	CommandList& pass = gPassCommands;
+	pass.reset();
+	pass.bindPipeline(programPipeline(programId(gSceneProgram)));
+	pass.setUniform(Uniform::View, view);
+	pass.setUniform(Uniform::Projection, projection);
+
+	// Pass camera data to the Cube Shader program's corresponding uniforms
+	pass.setUniform(Uniform::ViewPosition, gCamera.Position);
+	pass.setUniform(Uniform::UVScale, uvScale);
+	pass.setUniform(Uniform::Texture, 0);
+
+	// Bind the Light Lists and Shadow Maps
+	// ------------------------------------
+	gClusteredLighting.bind(pass);
+	bindKeyLight(pass);
+
+	// Baked Objects Switch to the Lightmap Variant; Only the Rest Shade Lights Here
+	// -----------------------------------------------------------------------------
+	if (gLightmapsEnabled && programReady(programId(gLightmapProgram)))
+	{
+		drawSceneObjects(pass, projection * view, 1, ObjectSet::Unlightmapped);
+		drawLightmappedObjects(view, projection);
+	}
+	else
+		drawSceneObjects(pass, projection * view);
 
-	// Transformation are Applied Right-To-Left
-	// ----------------------------------------
-	mat4 model = translation * (xRotation * yRotation * zRotation) * scale;
+	gBackend->endPass();
+}
 
-	// Retrieves and Passes Transform Matriceces to the Shader Program
-	// ---------------------------------------------------------------
-	GLint modelLoc = glGetUniformLocation(gProgramID, "model");
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, value_ptr(model));
+// Static Objects Lit from the Baked Atlas
+// ---------------------------------------
+void drawLightmappedObjects(const mat4& view, const mat4& projection)
+{
+	CommandList& pass = gPassCommands;
+	pass.reset();
+	pass.bindPipeline(programPipeline(programId(gLightmapProgram)));
+	pass.setUniform(Uniform::View, view);
+	pass.setUniform(Uniform::Projection, projection);
+	pass.setUniform(Uniform::UVScale, uvScale);
+	pass.setUniform(Uniform::Texture, 0);
+	pass.setUniform(Uniform::LightmapAmbient, LIGHTMAP_AMBIENT);
+	gLightmap.bind(pass);
+
+	drawSceneObjects(pass, projection * view, 1, ObjectSet::Lightmapped);
+}
 
-	// Activate VBO's winthin mesh's VAO
-	// ---------------------------------
-	glBindVertexArray(scissorsBladeMesh.VAO);
+// Multi-View Path: Every View in One Instanced Pass, Shaded Against Every Light
+// ----------------------------------------------------------------------------
+void renderMultiView(const mat4& view, const mat4& projection)
+{
+	gMultiView.update(gCamera, gRenderWidth, gRenderHeight, [](bool perspective, float aspectRatio)
+	{
+		float nearPlane, farPlane;
+		return cameraProjection(perspective, aspectRatio, nearPlane, farPlane);
+	});
 
-	glDrawElements(GL_TRIANGLES, scissorsBladeMesh.nIndices, GL_UNSIGNED_SHORT, NULL);
+	// Scene: Each Object is One Draw of viewCount() Instances
+	// -------------------------------------------------------
+	gBackend->beginPass(scenePass(true));
 
-	// Right Blade 
-	// Bind Textures to Corresponding Texture Units
-	// --------------------------------------------
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, gTextureIdMetal);
+	CommandList& pass = gPassCommands;
+	pass.reset();
+	pass.bindPipeline(programPipeline(programId(gMultiViewProgram)));
+	gMultiView.bind(pass);
+	pass.setUniform(Uniform::UVScale, uvScale);
+	pass.setUniform(Uniform::Texture, 0);
 
-	scale = glm::scale(vec3(-1.2f, 1.2f, 1.2f));
-	yRotation = rotate(1.18f, vec3(1.0f, 0.0f, 0.0f));
-	xRotation = rotate(0.0f, vec3(0.0f, 1.0f, 0.0f));
-	zRotation = rotate(-0.8f, vec3(0.0f, 0.0f, 1.0f));
-	translation = glm::translate(vec3(1.9f, -0.5f, -1.2f));
+	gClusteredLighting.bind(pass);
+	bindKeyLight(pass);
 
-	// Transformation are Applied Right-To-Left
-	// ----------------------------------------
-	model = translation * (xRotation * yRotation * zRotation) * scale;
+	drawSceneObjects(pass, projection * view, gMultiView.viewCount());
 
-	// Retrieves and Passes Transform Matriceces to the Shader Program
-	// ---------------------------------------------------------------
-	modelLoc = glGetUniformLocation(gProgramID, "model");
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, value_ptr(model));
+	// Lamps, Likewise Instanced Across the Views
+	// ------------------------------------------
+	const GLmesh* lampMesh = gMeshes.get(gLampMesh);
+	if (lampMesh)
+	{
+		CommandList& commands = gPassCommands;
+		commands.reset();
+		commands.bindPipeline(programPipeline(programId(gMultiViewLampProgram)));
+		gMultiView.bind(commands);
+		commands.bindVertexInput(lampMesh->VAO, meshIndexType(*lampMesh));
 
-	// Activate VBO's winthin mesh's VAO
-	// ---------------------------------
-	glBindVertexArray(scissorsBladeMesh.VAO);
+		for (size_t i = 0; i < gLights.size() && i < LAMP_MARKER_COUNT; ++i)
+		{
+			commands.setUniform(Uniform::Model, lampModelMatrix(gLights[i]));
+			commands.drawIndexed(lampMesh->nIndices, 0, static_cast<uint32_t>(gMultiView.viewCount()));
+		}
+
+		gBackend->submit(&commands, 1);
+		gFrameDrawCalls += commands.drawCount();
+	}
+
+	gBackend->endPass();
+}
+
+// Camera Projection: 4 Parameters (FOV, Aspect Ratio, Near PLane, Far Plane), or Orthographic
+// ------------------------------------------------------------------------------------------
+mat4 cameraProjection(bool perspective, float aspectRatio, float& nearPlane, float& farPlane)
+{
+	if (perspective) {
+		nearPlane = 0.1f;
+		farPlane = 100.0f;
+		return glm::perspective(radians(gCamera.Zoom), aspectRatio, nearPlane, farPlane);
+	}
+
+	float scale = 120;
+	float halfHeight = 600.0f / scale;
+	nearPlane = -2.5f;
+	farPlane = 6.5f;
+	return ortho(halfHeight * aspectRatio, -halfHeight * aspectRatio, -halfHeight, halfHeight, nearPlane, farPlane);
+}
 
-	// Draw Triangle
+// Transform the Small Sphere Used as a Visual Cue for a Light Source
+// ------------------------------------------------------------------
+mat4 lampModelMatrix(const PointLight& light)
+{
+	Transform lampTransform;
+	lampTransform.scale = lightScale;
+	lampTransform.rotation = vec3(-0.25f, 0.0f, 0.0f);
+	lampTransform.translation = light.position;
+	return composeModelMatrix(lampTransform);
+}
+
+// Deferred Path: G-Buffer Pass, then One Full-Screen Clustered Lighting Pass
+// --------------------------------------------------------------------------
+void renderDeferred(const mat4& view, const mat4& projection)
+{
+	// Geometry Pass
 	// -------------
-	glDrawElements(GL_TRIANGLES, scissorsBladeMesh.nIndices, GL_UNSIGNED_SHORT, NULL);
+	if (!gDeferredRenderer.beginGeometryPass(gFramebufferWidth, gFramebufferHeight, gRenderWidth, gRenderHeight))
+		return;
+
+	CommandList& pass = gPassCommands;
+	pass.reset();
+	pass.bindPipeline(programPipeline(programId(gGBufferProgram)));
+	pass.setUniform(Uniform::Texture, 0);
+	pass.setUniform(Uniform::View, view);
+	pass.setUniform(Uniform::Projection, projection);
+	pass.setUniform(Uniform::UVScale, uvScale);
+
+	drawSceneObjects(pass, projection * view);
+	gBackend->endPass();
+
+	// Lighting Pass into the Scene Target; the Full-Screen Triangle Always Passes the Depth Test
+	// ------------------------------------------------------------------------------------------
+	PipelineDesc lighting;
+	lighting.depthCompare = DepthCompare::Always;
+
+	CommandList& commands = gPassCommands;
+	commands.reset();
+	commands.bindPipeline(programPipeline(programId(gDeferredLightingProgram), lighting));
+	commands.setUniform(Uniform::InverseViewProjection, inverse(projection * view));
+	commands.setUniform(Uniform::View, view);
+	commands.setUniform(Uniform::ViewPosition, gCamera.Position);
+
+	gClusteredLighting.bind(commands);
+	bindKeyLight(commands);
+	gDeferredRenderer.lightingPass(commands);
+
+	gBackend->beginPass(scenePass(true));
+	gBackend->submit(&commands, 1);
+	gBackend->endPass();
+	gFrameDrawCalls += commands.drawCount();
+}
 
-#pragma endregion
+// Post-Processing Chain: Bright Pass and Separable Blur at 1/--bloom-divisor Resolution,
+// Tone Mapping with the Bloom Added, then FXAA into the Output
+// --------------------------------------------------------------------------------------
+bool createPostProcessing(int argc, char* argv[])
+{
+	const char* divisor = optionValue(argc, argv, "--bloom-divisor");
+	const int bloomDivisor = divisor ? atoi(divisor) : DEFAULT_BLOOM_DIVISOR;
+	if (const char* exposure = optionValue(argc, argv, "--exposure"))
+		gExposure = static_cast<float>(atof(exposure));
 
-#pragma region Floor Rendering
+	gBloomBrightProgram = submitShaderProgram(fullscreenVertexShaderSource, bloomBrightFragmentShaderSource);
+	gBloomBlurProgram = submitShaderProgram(fullscreenVertexShaderSource, bloomBlurFragmentShaderSource);
+	gToneMapProgram = submitShaderProgram(fullscreenVertexShaderSource, toneMapFragmentShaderSource);
+	gFxaaProgram = submitShaderProgram(fullscreenVertexShaderSource, fxaaFragmentShaderSource);
 
-	// Bind Textures to Corresponding Texture Units
-	// --------------------------------------------
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, gTextureIdFloor);
-	
-	scale = glm::scale(vec3(12.0f, 12.0f, 12.0f));
-	yRotation = rotate(0.0f, vec3(1.0f, 0.0f, 0.0f));
-	xRotation = rotate(0.0f, vec3(0.0f, 1.0f, 0.0f));
-	zRotation = rotate(0.0f, vec3(0.0f, 0.0f, 1.0f));
-	translation = glm::translate(vec3(0.0f, -1.0f, 0.0f));
+	if (!gPostProcess.create(*gBackend))
+		return false;
 
-	// Transformation are Applied Right-To-Left
-	// ----------------------------------------
-	model = translation * (xRotation * yRotation * zRotation) * scale;
+	// Bloom Stays in HDR; Tone Mapping Writes 8-Bit Color with Luma for FXAA
+	// ----------------------------------------------------------------------
+	const GLuint blurProgramID = programId(gBloomBlurProgram);
+	return gPostProcess.addPass("Bloom Bright", programId(gBloomBrightProgram), bloomDivisor, TextureFormat::RGBA16F, [](CommandList& commands)
+		{
+			commands.setUniform(Uniform::Threshold, BLOOM_THRESHOLD);
+		})
+		&& gPostProcess.addPass("Bloom Blur X", blurProgramID, bloomDivisor, TextureFormat::RGBA16F, [](CommandList& commands)
+		{
+			commands.setUniform(Uniform::Direction, vec2(1.0f, 0.0f));
+		})
+		&& gPostProcess.addPass("Bloom Blur Y", blurProgramID, bloomDivisor, TextureFormat::RGBA16F, [](CommandList& commands)
+		{
+			commands.setUniform(Uniform::Direction, vec2(0.0f, 1.0f));
+		})
+		&& gPostProcess.addPass("Tone Map", programId(gToneMapProgram), 1, TextureFormat::RGBA8, [](CommandList& commands)
+		{
+			commands.setUniform(Uniform::Exposure, gExposure);
+			commands.setUniform(Uniform::BloomStrength, BLOOM_STRENGTH);
+		})
+		&& gPostProcess.addPass("FXAA", programId(gFxaaProgram), 1, TextureFormat::RGBA8);
+}
 
-	// Retrieves and Passes Transform Matriceces to the Shader Program
-	// ---------------------------------------------------------------
-	modelLoc = glGetUniformLocation(gProgramID, "model");
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, value_ptr(model));
+// Feedback Pass Every Few Frames, then Residency Changes and Uploads from Finished Readbacks
+// ----------------------------------------------------------------------------------------
+void updateTextureStreaming(const mat4& view, const mat4& projection)
+{
+	const GLuint programID = programId(gFeedbackProgram);
+	if (programReady(programID) && gTextureStreamer.beginFeedback(gFramebufferWidth, gFramebufferHeight))
+	{
+		PassDesc feedbackPass;
+		feedbackPass.target = gTextureStreamer.feedbackTarget();
+		feedbackPass.width = gTextureStreamer.feedbackWidth();
+		feedbackPass.height = gTextureStreamer.feedbackHeight();
+		feedbackPass.clearColor = true;   // Zero: No Texture Sampled
+		feedbackPass.clearDepth = true;
+		gBackend->beginPass(feedbackPass);
+
+		CommandList& pass = gPassCommands;
+		pass.reset();
+		pass.bindPipeline(programPipeline(programID));
+		pass.setUniform(Uniform::View, view);
+		pass.setUniform(Uniform::Projection, projection);
+		pass.setUniform(Uniform::UVScale, uvScale);
+		pass.setUniform(Uniform::LodBias, -log2(static_cast<float>(TextureStreamer::FEEDBACK_DIVISOR)));
+
+		drawSceneObjects(pass, projection * view);
+		gBackend->endPass();
+		gTextureStreamer.endFeedback();
+	}
 
-	// Activate VBO's winthin mesh's VAO
-	// ---------------------------------
-	glBindVertexArray(floorMesh.VAO);
+	gTextureStreamer.update();
+}
 
-	// Bind Textures to Corresponding Texture Units
-	// --------------------------------------------
+// True Once Every Post-Processing Program has Finished Compiling
+// --------------------------------------------------------------
+bool postProcessingReady()
+{
+	for (ProgramHandle program : { gBloomBrightProgram, gBloomBlurProgram, gToneMapProgram, gFxaaProgram })
+	{
+		if (!programReady(programId(program)))
+			return false;
+	}
+
+	return true;
+}
+
+// Queues Object Bounds, Light Ranges, Shadow Cascades and Frame Statistics, then Draws them
+// in Two Calls over the Finished Frame
+// -----------------------------------------------------------------------------------------
+void drawDebugOverlay(const mat4& view, const mat4& projection)
+{
+	const double start = glfwGetTime();
+	gDebugOverlayFrameTime += (gDeltaTime - gDebugOverlayFrameTime) * OVERLAY_FRAME_SMOOTHING;
+
+	// World Bounds of Each Object: Green if Drawn, Red if Occlusion Culling Skipped it
+	// --------------------------------------------------------------------------------
+	size_t drawnObjects = 0;
+	for (size_t i = 0; i < gSceneObjects.size(); ++i)
+	{
+		const GLmesh* mesh = gMeshes.get(gSceneObjects[i].mesh);
+		if (!mesh)
+			continue;
+
+		vec3 worldMin(numeric_limits<float>::max());
+		vec3 worldMax(-numeric_limits<float>::max());
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			const vec3 local((corner & 1) ? mesh->boundsMax.x : mesh->boundsMin.x, (corner & 2) ? mesh->boundsMax.y : mesh->boundsMin.y,
+				(corner & 4) ? mesh->boundsMax.z : mesh->boundsMin.z);
+			const vec3 world = vec3(gModelMatrices[i] * vec4(local, 1.0f));
+			worldMin = min(worldMin, world);
+			worldMax = max(worldMax, world);
+		}
+
+		const bool visible = !gVisibleObjects || gVisibleObjects[i];
+		drawnObjects += visible;
+		gDebugDraw.box(worldMin, worldMax, visible ? vec4(0.2f, 1.0f, 0.2f, 0.8f) : vec4(1.0f, 0.2f, 0.2f, 0.8f));
+	}
+
+	// Each Light's Range in its Own Color
+	// -----------------------------------
+	for (const PointLight& light : gLights)
+		gDebugDraw.sphere(light.position, light.radius, vec4(light.color, 0.5f));
+
+	// The Volume Each Shadow Cascade Renders
+	// --------------------------------------
+	for (int cascade = 0; cascade < ShadowMaps::CASCADE_COUNT; ++cascade)
+		gDebugDraw.frustum(gShadowMaps.cascadeViewProjection(cascade), vec4(1.0f, 0.8f, 0.2f, 0.6f));
+
+	// Frame Statistics; the Overlay's Own Cost is From the Previous Frame
+	// -------------------------------------------------------------------
+	const char* path = gMultiViewEnabled ? "Multi-View" : (gRenderPath == RenderPath::Deferred) ? "Deferred" : "Forward";
+	char text[512];
+	snprintf(text, sizeof(text),
+		"%s Path  %.2f ms/frame\n"
+		"%zu Draw Calls\n"
+		"%zu of %zu Objects Drawn\n"
+		"%zu Lights\n"
+		"%.1f MB GPU Memory\n"
+		"Overlay %.3f ms CPU, %zu Lines, %zu Glyphs",
+		path, 1000.0f * gDebugOverlayFrameTime, gFrameDrawCalls, drawnObjects, gSceneObjects.size(), gLights.size(),
+		MemoryTracker::gpuBytes() / (1024.0 * 1024.0), 1000.0 * gDebugOverlayCpuTime, gDebugDraw.lineCount(), gDebugDraw.glyphCount());
+	gDebugDraw.text(OVERLAY_TEXT_MARGIN, OVERLAY_TEXT_MARGIN, text, vec4(1.0f));
+
+	// Draw Over the Whole Window; the Overlay Pipelines Stay Filled in Wireframe Mode
+	// -------------------------------------------------------------------------------
+	const GLuint lineProgramID = programId(gDebugLineProgram);
+	const GLuint textProgramID = programId(gDebugTextProgram);
+	PassDesc window;
+	window.width = gFramebufferWidth;
+	window.height = gFramebufferHeight;
+	gBackend->beginPass(window);
+
+	gFrameDrawCalls += gDebugDraw.flush(gFrameStream, programReady(lineProgramID) ? lineProgramID : 0,
+		programReady(textProgramID) ? textProgramID : 0, projection * view, gFramebufferWidth, gFramebufferHeight);
+
+	gBackend->endPass();
+
+	gDebugOverlayCpuTime = glfwGetTime() - start;
+}
+
+// One Pipeline per Program, Created the First Time it Draws; a Program is Always Drawn
+// with the Same State, which desc Gives
+// ------------------------------------------------------------------------------------
+PipelineId programPipeline(GLuint programID, PipelineDesc desc)
+{
+	PipelineId& pipeline = gPipelines[programID];
+	if (!pipeline)
+	{
+		desc.program = programID;
+		desc.uniforms = Uniform::NAMES;
+		desc.uniformCount = Uniform::Count;
+		pipeline = gBackend->createPipeline(desc);
+	}
 
-	glDrawElements(GL_TRIANGLES, floorMesh.nIndices, GL_UNSIGNED_SHORT, NULL);
+	return pipeline;
+}
+
+// The Camera Passes Draw into the Scene Target at the Render Size, Cleared to Opaque Black
+// ----------------------------------------------------------------------------------------
+PassDesc scenePass(bool clear)
+{
+	PassDesc pass;
+	pass.target = gSceneTarget;
+	pass.width = gRenderWidth;
+	pass.height = gRenderHeight;
+	pass.clearColor = pass.clearDepth = clear;
+	pass.color = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	return pass;
+}
+
+IndexType meshIndexType(const GLmesh& mesh)
+{
+	return mesh.indexType == GL_UNSIGNED_INT ? IndexType::UInt32 : IndexType::UInt16;
+}
+
+// Draws Every Scene Object into the Current Pass after the pass List's Setup, Skipping
+// Meshlets the Camera Cannot See; with Several Views, Each Object is Instanced Once per
+// View. Workers Record Consecutive Object Ranges into Command Lists, which the Backend
+// Replays in Order
+// -------------------------------------------------------------------------------------
+void drawSceneObjects(const CommandList& pass, const mat4& viewProjection, int viewCount, ObjectSet objects)
+{
+	// At Most One List per Thread, Each Covering a Contiguous Range so Draw Order is Kept
+	// -----------------------------------------------------------------------------------
+	const size_t objectCount = gSceneObjects.size();
+	const size_t listCount = min<size_t>((objectCount + RECORD_JOB_GRAIN - 1) / RECORD_JOB_GRAIN, gJobSystem->threadCount());
+	if (listCount == 0)
+		return;
+
+	if (gSceneCommandLists.size() < listCount)
+		gSceneCommandLists.resize(listCount);
+
+	const size_t objectsPerList = (objectCount + listCount - 1) / listCount;
+	const Frustum frustum = extractFrustum(viewProjection);
+	gJobSystem->parallelFor(listCount, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t list = begin; list < end; ++list)
+			recordSceneObjects(gSceneCommandLists[list], pass, frustum, viewCount, objects, list * objectsPerList, min(objectCount, (list + 1) * objectsPerList));
+	});
+
+	gBackend->submit(gSceneCommandLists.data(), listCount);
+	for (size_t list = 0; list < listCount; ++list)
+		gFrameDrawCalls += gSceneCommandLists[list].drawCount();
+}
+
+// Records Objects [begin, end) of the Scene; Reads Shared State Only, so Ranges Record in Parallel
+// -----------------------------------------------------------------------------------------------
+void recordSceneObjects(CommandList& commands, const CommandList& pass, const Frustum& frustum, int viewCount, ObjectSet objects, size_t begin, size_t end)
+{
+	commands.reset();
+	commands.append(pass);
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		const SceneObject& object = gSceneObjects[i];
+		if (gVisibleObjects && !gVisibleObjects[i])
+			continue;
+		if (objects != ObjectSet::All && (objects == ObjectSet::Lightmapped) != static_cast<bool>(object.lightmapMesh))
+			continue;
+
+		// Error Check: a Stale Mesh Handle Draws Nothing; a Stale Texture Binds None
+		// --------------------------------------------------------------------------
+		const GLmesh* mesh = gMeshes.get(objects == ObjectSet::Lightmapped ? object.lightmapMesh : object.mesh);
+		const GLtexture* texture = gTextures.get(object.texture);
+		if (!mesh)
+			continue;
+
+		// Bind Textures to Corresponding Texture Units; Streamed Textures are Renamed as they Grow
+		// ---------------------------------------------------------------------------------------
+		const int streamSlot = texture ? texture->streamSlot : -1;
+		commands.bindTexture(0, streamSlot >= 0 ? gTextureStreamer.textureId(streamSlot) : (texture ? texture->id : 0));
+
+		commands.setUniform(Uniform::TextureSlot, static_cast<uint32_t>(streamSlot + 1));
+		if (streamSlot >= 0)
+			commands.setUniform(Uniform::TextureSize, vec2(static_cast<float>(gTextureStreamer.width(streamSlot)), static_cast<float>(gTextureStreamer.height(streamSlot))));
+
+		// Passes the Transform Matrix to the Shader Program
+		// -------------------------------------------------
+		commands.setUniform(Uniform::Model, gModelMatrices[i]);
+		commands.setUniform(Uniform::NormalMatrix, gNormalMatrices[i]);
+
+		// Activate VBO's winthin mesh's VAO
+		// ---------------------------------
+		commands.bindVertexInput(mesh->VAO, meshIndexType(*mesh));
+
+		// Meshlet Culling is Against the Camera Alone, so Multi-View Draws Whole Meshes
+		// -----------------------------------------------------------------------------
+		if (viewCount > 1)
+		{
+			commands.drawIndexed(mesh->nIndices, 0, static_cast<uint32_t>(viewCount));
+			continue;
+		}
+
+		// Cull Meshlets; Contiguous Survivors Merge into One Range
+		// --------------------------------------------------------
+		vec3 modelSpaceCamera = vec3(inverse(gModelMatrices[i]) * vec4(gCamera.Position, 1.0f));
+		commands.beginRanges();
+		for (const Meshlet& meshlet : mesh->meshlets)
+		{
+			if (isMeshletVisible(meshlet, gModelMatrices[i], frustum, modelSpaceCamera, MESHLET_CONE_CULLING))
+				commands.addRange(meshlet.indexCount, meshlet.firstIndex);
+		}
+		commands.endRanges();
+	}
+}
+
+// Records the Static or Dynamic Scene Objects for a Shadow Map Tile
+// -----------------------------------------------------------------
+void drawShadowCasters(CommandList& commands, bool staticCasters)
+{
+	for (size_t i = 0; i < gSceneObjects.size(); ++i)
+	{
+		const SceneObject& object = gSceneObjects[i];
+		if (object.isStatic != staticCasters)
+			continue;
+
+		const GLmesh* mesh = gMeshes.get(object.mesh);
+		if (!mesh)
+			continue;
+
+		commands.setUniform(Uniform::Model, gModelMatrices[i]);
+		commands.bindVertexInput(mesh->VAO, meshIndexType(*mesh));
+		commands.drawIndexed(mesh->nIndices, 0);
+		++gFrameDrawCalls;
+	}
+}
+
+// Records the Key Light Uniforms and Binding its Shadow Atlas
+// -----------------------------------------------------------
+void bindKeyLight(CommandList& commands)
+{
+	commands.setUniform(Uniform::KeyLightDirection, keyLightDirection);
+	commands.setUniform(Uniform::KeyLightColor, keyLightColor);
+	gShadowMaps.bind(commands);
+}
+
+// Prints the Average Frame Time of the Active Render Path
+// -------------------------------------------------------
+void reportFrameTime()
+{
+	++gReportFrames;
+
+	float now = glfwGetTime();
+	float elapsed = now - gReportTime;
+	if (elapsed < FRAME_REPORT_INTERVAL)
+		return;
+
+	const char* path = gMultiViewEnabled ? "Multi-View" : (gRenderPath == RenderPath::Deferred) ? "Deferred" : "Forward";
+	cerr << "INFO: " << path << " Path: " << (1000.0f * elapsed / gReportFrames) << " ms/frame, "
+		<< gLights.size() << " Lights, " << gReportShadowCascades << " Shadow Cascade Renders" << endl;
+
+	if (gDynamicResolutionEnabled)
+		cerr << "INFO: Dynamic Resolution: " << (100.0f * gDynamicResolution.scale()) << "% (" << gRenderWidth << "x" << gRenderHeight
+			<< "), GPU " << gDynamicResolution.gpuMilliseconds() << " ms of " << gDynamicResolution.budgetMilliseconds() << " ms Budget" << endl;
+
+	if (gPostProcessingEnabled)
+	{
+		float totalMilliseconds = 0.0f;
+		cerr << "INFO: Post-Processing:";
+		for (size_t i = 0; i < gPostProcess.passCount(); ++i)
+		{
+			cerr << " " << gPostProcess.passName(i) << " " << gPostProcess.passMilliseconds(i) << " ms,";
+			totalMilliseconds += gPostProcess.passMilliseconds(i);
+		}
+		cerr << " Total " << totalMilliseconds << " ms GPU, " << gPostProcess.pool().targetCount() << " Pooled Targets ("
+			<< gPostProcess.pool().createdCount() << " Created)" << endl;
+	}
+
+	if (gTextureStreamingEnabled)
+		cerr << "INFO: Texture Streaming: " << (gTextureStreamer.residentBytes() / (1024.0f * 1024.0f)) << " of "
+			<< (gTextureStreamer.budgetBytes() / (1024.0f * 1024.0f)) << " MB Resident, " << gTextureStreamer.textureCount() << " Textures, "
+			<< gTextureStreamer.uploadedLevelCount() << " Levels Uploaded, " << gTextureStreamer.evictedLevelCount() << " Evicted" << endl;
+
+	if (gFrameCaptureEnabled)
+	{
+		const size_t written = gFrameCapture.writtenFrameCount();
+		const double perFrame = written ? 1000.0 / written : 0.0;
+		cerr << "INFO: Frame Capture: " << (gFrameCapture.renderThreadSeconds() * perFrame) << " ms/frame on the Render Thread ("
+			<< (gFrameCapture.stallSeconds() * perFrame) << " ms Stalled), " << (gFrameCapture.encodeSeconds() * perFrame) << " ms/frame Encoding, "
+			<< written << " Frames Written, " << gFrameCapture.skippedFrameCount() << " Skipped" << endl;
+	}
+
+	if (gOcclusionCullingEnabled)
+		cerr << "INFO: Occlusion Culling: " << (1000.0 * gReportOcclusionTime / gReportFrames) << " ms/frame, "
+			<< (static_cast<float>(gReportOccludedObjects) / gReportFrames) << " Objects Culled/frame, "
+			<< gOcclusionCulling.triangleCount() << " Occluder Triangles" << endl;
+
+	if (gMemoryReportEnabled)
+		reportMemory();
+
+#ifdef _DEBUG
+	// Steady State Should Show Zero Heap Allocations per Frame
+	// --------------------------------------------------------
+	size_t heapAllocations = FrameArena::heapAllocationCount();
+	cerr << "DEBUG: Frame Arena High-Water " << gFrameArena.highWaterMark() << " of " << gFrameArena.capacity() << " Bytes, "
+		<< (static_cast<float>(heapAllocations - gReportHeapAllocations) / gReportFrames) << " Heap Allocations/frame" << endl;
+	gReportHeapAllocations = heapAllocations;
+#endif
+
+	gReportTime = now;
+	gReportFrames = 0;
+	gReportShadowCascades = 0;
+	gReportOcclusionTime = 0.0;
+	gReportOccludedObjects = 0;
+	gPostProcess.resetTimings();
+}
+
+// Prints Live GPU and CPU Memory, their High-Water Marks and Each Category's Share
+// --------------------------------------------------------------------------------
+void reportMemory()
+{
+	const float megabyte = 1024.0f * 1024.0f;
+	cerr << "INFO: Memory: GPU " << (MemoryTracker::gpuBytes() / megabyte) << " MB (Peak " << (MemoryTracker::gpuHighWaterMark() / megabyte)
+		<< " MB), CPU " << (MemoryTracker::cpuBytes() / megabyte) << " MB (Peak " << (MemoryTracker::cpuHighWaterMark() / megabyte) << " MB);";
+
+	for (int i = 0; i < static_cast<int>(MemoryTracker::Category::Count); ++i)
+	{
+		const MemoryTracker::Category category = static_cast<MemoryTracker::Category>(i);
+		cerr << " " << MemoryTracker::categoryName(category) << " " << (MemoryTracker::liveBytes(category) / megabyte) << " MB in "
+			<< MemoryTracker::liveObjects(category) << (i + 1 < static_cast<int>(MemoryTracker::Category::Count) ? "," : "");
+	}
+	cerr << endl;
+}
+
+// Prints the Process's CPU Use and the GPU Time of the Rendered Frames, Idle Time Included
+// ----------------------------------------------------------------------------------------
+void reportUtilization()
+{
+	const double now = glfwGetTime();
+	if (now - gUsageReportTime < FRAME_REPORT_INTERVAL)
+		return;
+
+	cerr << "INFO: Utilization: CPU " << gUsageMeter.cpuPercent(now) << "% of a Core, GPU " << gUsageMeter.gpuPercent(now) << "%, "
+		<< gUsageMeter.frameCount() << " Frames Rendered";
+	if (gOnDemandRendering)
+		cerr << " (" << gChangeTracker.renderedFrameCount() << " Rendered, " << gChangeTracker.skippedFrameCount() << " Skipped Since Startup)";
+	cerr << endl;
+
+	gUsageMeter.reset(now);
+	gUsageReportTime = now;
+}
+
+// Hash Everything a Frame is Drawn From; True when this Iteration Needs a Frame
+// -----------------------------------------------------------------------------
+bool sceneChanged()
+{
+	gChangeTracker.beginState();
+	gChangeTracker.track(gCamera.Position);
+	gChangeTracker.track(gCamera.Yaw);
+	gChangeTracker.track(gCamera.Pitch);
+	gChangeTracker.track(gCamera.Zoom);
+	gChangeTracker.track(gFramebufferWidth);
+	gChangeTracker.track(gFramebufferHeight);
+	gChangeTracker.track(gPolygonMode);
+	gChangeTracker.track(viewProjection);
+
+	gChangeTracker.track(gLights.size());
+	gChangeTracker.track(gLights.data(), gLights.size() * sizeof(PointLight));
+	gChangeTracker.track(lightPos);
+	gChangeTracker.track(lightPos_1);
+	gChangeTracker.track(lightColor);
+	gChangeTracker.track(lightColor_1);
+	gChangeTracker.track(keyLightDirection);
+	gChangeTracker.track(keyLightColor);
+
+	gChangeTracker.track(gSceneObjects.size());
+	gChangeTracker.track(gTransforms.version());
+
+	// Work Still Converging Keeps Frames Coming: Programs Compiling, Textures Streaming In,
+	// and a Replay, which Advances by One Step per Frame
+	// ------------------------------------------------------------------------------------
+	if (!gShaderBatchReported || gInputReplayEnabled || (gTextureStreamingEnabled && gTextureStreamer.isStreaming()))
+		gChangeTracker.requestRedraw();
+
+	return gChangeTracker.shouldRender();
+}
+
+#pragma region Scene
+
+// Describes Every Textured Object Drawn by render()
+// -------------------------------------------------
+void createScene()
+{
+	SceneObject object;
+	object.isStatic = true;
+	object.isOccluder = false;
+	Transform transform;
+
+	// Left Blade
+	// ----------
+	object.mesh = gScissorsBladeMesh;
+	object.texture = gMetalTexture;
+	transform.scale = vec3(1.2f, 1.2f, 1.2f);
+	transform.rotation = vec3(1.28f, 0.0f, -0.4f);
+	transform.translation = vec3(2.2f, -0.582f, -1.4f);
+	addSceneObject(object, transform);
+
+	// Right Blade
+	// -----------
+	transform.scale = vec3(-1.2f, 1.2f, 1.2f);
+	transform.rotation = vec3(1.18f, 0.0f, -0.8f);
+	transform.translation = vec3(1.9f, -0.5f, -1.2f);
+	addSceneObject(object, transform);
+
+	// Floor
+	// -----
+	object.mesh = gFloorMesh;
+	object.texture = gFloorTexture;
+	object.isOccluder = true;
+	transform.scale = vec3(12.0f, 12.0f, 12.0f);
+	transform.rotation = vec3(0.0f, 0.0f, 0.0f);
+	transform.translation = vec3(0.0f, -1.0f, 0.0f);
+	addSceneObject(object, transform);
+
+	// Block 1
+	// -------
+	object.mesh = gBlockMesh1;
+	object.texture = gWoodTexture;
+	transform.scale = vec3(2.0f, 2.0f, 2.0f);
+	transform.rotation = vec3(0.0f, 0.3f, 0.0f);
+	transform.translation = vec3(0.8f, -0.9999f, -0.7f);
+	addSceneObject(object, transform);
+
+	// Block 2
+	// -------
+	object.mesh = gBlockMesh2;
+	object.texture = gYellowWoodTexture;
+	transform.scale = vec3(2.0f, 2.0f, 2.0f);
+	transform.rotation = vec3(0.0f, 0.3f, 1.565f);
+	transform.translation = vec3(2.6f, -0.999f, -0.2f);
+	addSceneObject(object, transform);
+
+
+	// Scene Lights
+	// ------------
+	PointLight light;
+	light.position = lightPos;
+	light.color = lightColor;
+	gLights.push_back(light);
+
+	light.position = lightPos_1;
+	light.color = lightColor_1;
+	gLights.push_back(light);
+}
+
+// Loads the Lightmap Atlas, Baking it on Every Core First if the File is Missing or was
+// Baked from a Different Scene, then Gives Each Static Object its Lightmapped Mesh
+// -------------------------------------------------------------------------------------
+bool createLightmaps(int argc, char* argv[], const char* path)
+{
+	updateModelMatrices();
+
+	vector<LightmapInstance> instances;
+	vector<size_t> objects;
+	for (size_t i = 0; i < gSceneObjects.size(); ++i)
+	{
+		const SceneObject& object = gSceneObjects[i];
+		const GLmesh* mesh = gMeshes.get(object.mesh);
+		if (!object.isStatic || !mesh)
+			continue;
+
+		const GLtexture* texture = gTextures.get(object.texture);
+		LightmapInstance instance;
+		instance.positions = mesh->vertices.data();
+		instance.normals = mesh->vertices.data() + 3;
+		instance.stride = mesh->floatsPerVertex;
+		instance.indices = mesh->indices.data();
+		instance.indexCount = mesh->indices.size();
+		instance.model = gModelMatrices[i];
+		instance.normalMatrix = gNormalMatrices[i];
+		instance.albedo = texture ? texture->meanColor : vec3(0.5f);
+		instances.push_back(instance);
+		objects.push_back(i);
+	}
+
+	const char* sizeOption = optionValue(argc, argv, "--lightmap-size");
+	if (!gLightmap.unwrap(instances, sizeOption ? atoi(sizeOption) : Lightmap::DEFAULT_SIZE))
+		return false;
+
+	const char* samples = optionValue(argc, argv, "--bake-samples");
+	LightmapSettings settings;
+	settings.samples = samples ? atoi(samples) : DEFAULT_BAKE_SAMPLES;
+	settings.keyLightDirection = keyLightDirection;
+	settings.keyLightColor = keyLightColor;
+
+	const uint64_t hash = gLightmap.inputHash(gLights, settings);
+	if (gLightmap.load(path, hash))
+		cerr << "INFO: Lightmap Loaded from " << path << endl;
+	else
+	{
+		const double start = glfwGetTime();
+		gLightmap.bake(*gJobSystem, gLights, settings);
+		const double seconds = glfwGetTime() - start;
+
+		cerr << "INFO: Lightmap Baked in " << seconds << " s on " << gJobSystem->threadCount() << " Threads: "
+			<< gLightmap.texelCount() << " Texels in " << gLightmap.chartCount() << " Charts at " << gLightmap.density() << " Texels per Unit, "
+			<< (gLightmap.rayCount() / seconds * 1e-6) << " Mrays/s" << endl;
+
+		if (!gLightmap.save(path, hash))
+			return false;
+	}
+
+	if (!gLightmap.upload(*gBackend))
+		return false;
+
+	for (size_t k = 0; k < objects.size(); ++k)
+	{
+		SceneObject& object = gSceneObjects[objects[k]];
+		object.lightmapMesh = createLightmapMesh(object.mesh, gLightmap.coordinates(k));
+	}
+
+	return true;
+}
+
+// Adds a Drawn Object and its Transform
+// -------------------------------------
+void addSceneObject(const SceneObject& object, const Transform& transform)
+{
+	gSceneObjects.push_back(object);
+	gTransforms.add(transform);
+	gModelMatrices.resize(gSceneObjects.size());
+	gNormalMatrices.resize(gSceneObjects.size());
+	if (object.isStatic)
+		++gStaticGeometryVersion;
+}
+
+// Moves a Drawn Object; Only Moving a Static Object Re-Renders the Cached Shadow Maps
+// -----------------------------------------------------------------------------------
+void moveSceneObject(size_t index, const Transform& transform)
+{
+	gTransforms.set(index, transform);
+	if (gSceneObjects[index].isStatic)
+		++gStaticGeometryVersion;
+}
+
+// Scatters Small Colored Point Lights Over the Floor
+// --------------------------------------------------
+void createRandomLights(size_t count, float extent)
+{
+	mt19937 random(42);
+	uniform_real_distribution<float> position(-extent, extent);
+	uniform_real_distribution<float> height(-0.9f, 1.0f);
+	uniform_real_distribution<float> channel(0.2f, 1.0f);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		PointLight light;
+		light.position = vec3(position(random), height(random), position(random));
+		light.radius = 1.5f;
+		light.color = vec3(channel(random), channel(random), channel(random));
+		gLights.push_back(light);
+	}
+}
+
+// Composes the Model and Normal Matrices of Every Scene Object Across the Worker Pool
+// -----------------------------------------------------------------------------------
+void updateModelMatrices()
+{
+	gJobSystem->parallelFor(gTransforms.size(), MATRIX_JOB_GRAIN, [](size_t begin, size_t end)
+	{
+		gTransforms.compose(begin, end, gModelMatrices.data(), gNormalMatrices.data());
+	});
+}
+
+// Rasterizes the Occluders on the CPU, then Flags Each Object Whose Bounds Remain Visible
+// ---------------------------------------------------------------------------------------
+void cullOccludedObjects(const mat4& viewProjection)
+{
+	gVisibleObjects = nullptr;
+	if (!gOcclusionCullingEnabled)
+		return;
+
+	double start = glfwGetTime();
+
+	gOcclusionCulling.beginFrame(viewProjection);
+	for (size_t i = 0; i < gSceneObjects.size(); ++i)
+	{
+		const GLmesh* mesh = gMeshes.get(gSceneObjects[i].mesh);
+		if (mesh && gSceneObjects[i].isOccluder)
+			gOcclusionCulling.addOccluder(mesh->positions.data(), mesh->positions.size(), mesh->indices.data(), mesh->indices.size(), gModelMatrices[i]);
+	}
+	gOcclusionCulling.rasterize(*gJobSystem);
+
+	// An Occluder Only Hides what is Behind it, so Occluders are Tested Too; the Tests Only
+	// Read the Depth Buffer, so they Run Across the Worker Pool
+	// -------------------------------------------------------------------------------------
+	uint8_t* visible = gFrameArena.alloc<uint8_t>(gSceneObjects.size());
+	gJobSystem->parallelFor(gSceneObjects.size(), OCCLUSION_TEST_JOB_GRAIN, [visible](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			const GLmesh* mesh = gMeshes.get(gSceneObjects[i].mesh);
+			visible[i] = !mesh || gOcclusionCulling.isVisible(mesh->boundsMin, mesh->boundsMax, gModelMatrices[i]);
+		}
+	});
+
+	for (size_t i = 0; i < gSceneObjects.size(); ++i)
+		gReportOccludedObjects += !visible[i];
+	gVisibleObjects = visible;
+
+	gReportOcclusionTime += glfwGetTime() - start;
+}
 
 #pragma endregion
 
-#pragma region Block_1 Rendering
+#pragma region Stress Benchmark
+
+// Runs Every Combination of the --stress-* Lists Along the Same Camera Orbit, One CSV Row Each
+// --------------------------------------------------------------------------------------------
+bool runStressBenchmark(int argc, char* argv[])
+{
+	const vector<size_t> objectCounts = parseCountList(optionValue(argc, argv, "--stress-objects"), "250,1000,4000");
+	const vector<size_t> lightCounts = parseCountList(optionValue(argc, argv, "--stress-lights"), "64");
+	const vector<size_t> textureCounts = parseCountList(optionValue(argc, argv, "--stress-textures"), "4");
+	const vector<size_t> overdrawCounts = parseCountList(optionValue(argc, argv, "--stress-overdraw"), "0");
+
+	const char* frameOption = optionValue(argc, argv, "--stress-frames");
+	const int frameCount = frameOption ? max(1, atoi(frameOption)) : STRESS_FRAMES;
+	const char* csvPath = optionValue(argc, argv, "--stress-csv");
+	if (!csvPath)
+		csvPath = STRESS_CSV_PATH;
+	const char* label = optionValue(argc, argv, "--stress-label");
+	if (!label)
+		label = "local";
+
+	// Error Check: CSV Opened; Rows are Appended so Runs from Every Commit Accumulate
+	// -------------------------------------------------------------------------------
+	const bool writeHeader = !filesystem::exists(csvPath);
+	ofstream csv(csvPath, ios::app);
+	if (!csv)
+	{
+		cerr << "ERROR::STRESS::CSV_NOT_OPENED " << csvPath << endl;
+		return false;
+	}
+	if (writeHeader)
+		csv << "label,path,occlusion_culling,objects,lights,textures,overdraw,frames,fps,cpu_ms,gpu_ms,draw_calls" << endl;
+
+	// Distinct Textures, Generated Once for the Largest Scene
+	// -------------------------------------------------------
+	vector<TextureHandle> textures(max<size_t>(1, *max_element(textureCounts.begin(), textureCounts.end())));
+	for (size_t i = 0; i < textures.size(); ++i)
+	{
+		if (!createCheckerTexture(i, textures[i]))
+			return false;
+	}
 
-	// Bind Textures to Corresponding Texture Units
-	// --------------------------------------------
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, gTextureIdWood);
+	// Every Program Compiled Before Timing Starts; Swaps Uncapped
+	// -----------------------------------------------------------
+	for (const GLprogram& program : gPrograms)
+	{
+		while (!programReady(program.id))
+		{
+			// Error Check: Vulkan Programs are Never Pending, so One Missing Now Failed to Load
+			// ---------------------------------------------------------------------------------
+			if (gBackendApi == BackendApi::Vulkan || !pollShaderPrograms())
+				return false;
+		}
+	}
+	gBackend->setVsync(false);
 
-	scale = glm::scale(vec3(2.f, 2.0f, 2.0f));
-	yRotation = rotate(0.0f, vec3(1.0f, 0.0f, 0.0f));
-	xRotation = rotate(0.3f, vec3(0.0f, 1.0f, 0.0f));
-	zRotation = rotate(0.0f, vec3(0.0f, 0.0f, 1.0f));
-	translation = glm::translate(vec3(0.8f, -0.9999f, -0.7f));
+	TimestampId timestamps[STRESS_QUERY_LAG][2];
+	for (TimestampId* pair : timestamps)
+	{
+		pair[0] = gBackend->createTimestamp();
+		pair[1] = gBackend->createTimestamp();
+	}
+	auto gpuSeconds = [](const TimestampId* pair)
+	{
+		uint64_t begin = 0, end = 0;
+		gBackend->timestampResult(pair[0], true, begin);
+		gBackend->timestampResult(pair[1], true, end);
+		return (end - begin) * 1e-9;
+	};
 
-	// Transformation are Applied Right-To-Left
-	// ----------------------------------------
-	model = translation * (xRotation * yRotation * zRotation) * scale;
+	const char* path = (gRenderPath == RenderPath::Deferred) ? "deferred" : "forward";
+	for (size_t objectCount : objectCounts)
+	for (size_t lightCount : lightCounts)
+	for (size_t textureCount : textureCounts)
+	for (size_t overdraw : overdrawCounts)
+	{
+		const size_t sceneTextures = max<size_t>(1, textureCount);
+		const float extent = createStressScene(objectCount, lightCount, textures.data(), sceneTextures, overdraw);
 
-	// Retrieves and Passes Transform Matriceces to the Shader Program
-	// ---------------------------------------------------------------
-	modelLoc = glGetUniformLocation(gProgramID, "model");
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, value_ptr(model));
+		double cpuTime = 0.0, gpuTime = 0.0, start = 0.0;
+		size_t drawCalls = 0;
+		for (int frame = -STRESS_WARMUP_FRAMES; frame < frameCount; ++frame)
+		{
+			if (frame == 0)
+				start = glfwGetTime();
+
+			gFrameArena.beginFrame();
+			moveStressCamera(extent, static_cast<float>(max(frame, 0)) / frameCount);
+
+			// Read the Pair Written STRESS_QUERY_LAG Frames Ago Before Reusing it
+			// -------------------------------------------------------------------
+			const TimestampId* pair = timestamps[(frame + STRESS_WARMUP_FRAMES) % STRESS_QUERY_LAG];
+			if (frame - STRESS_QUERY_LAG >= 0)
+				gpuTime += gpuSeconds(pair);
+
+			gBackend->writeTimestamp(pair[0]);
+			render();
+			gBackend->writeTimestamp(pair[1]);
+			gBackend->flush();
+			glfwPollEvents();
+
+			if (frame >= 0)
+			{
+				cpuTime += gFrameCpuTime;
+				drawCalls += gFrameDrawCalls;
+			}
+		}
 
-	// Activate VBO's winthin mesh's VAO
-	// ---------------------------------
-	glBindVertexArray(blockMesh_1.VAO);
+		const double elapsed = glfwGetTime() - start;
+		for (int frame = max(0, frameCount - STRESS_QUERY_LAG); frame < frameCount; ++frame)
+			gpuTime += gpuSeconds(timestamps[(frame + STRESS_WARMUP_FRAMES) % STRESS_QUERY_LAG]);
+
+		const double fps = frameCount / elapsed;
+		const double cpuMilliseconds = 1000.0 * cpuTime / frameCount;
+		const double gpuMilliseconds = 1000.0 * gpuTime / frameCount;
+		const double drawCallsPerFrame = static_cast<double>(drawCalls) / frameCount;
+
+		csv << label << ',' << path << ',' << gOcclusionCullingEnabled << ',' << objectCount << ',' << lightCount << ','
+			<< sceneTextures << ',' << overdraw << ',' << frameCount << ',' << fps << ',' << cpuMilliseconds << ','
+			<< gpuMilliseconds << ',' << drawCallsPerFrame << endl;
+		cerr << "INFO: Stress " << objectCount << " Objects, " << lightCount << " Lights, " << sceneTextures << " Textures, "
+			<< overdraw << " Overdraw: " << fps << " fps, CPU " << cpuMilliseconds << " ms, GPU " << gpuMilliseconds << " ms, "
+			<< drawCallsPerFrame << " Draw Calls, " << (MemoryTracker::gpuBytes() / (1024.0 * 1024.0)) << " MB GPU Memory" << endl;
+	}
 
-	// Bind Textures to Corresponding Texture Units
-	// --------------------------------------------
+	for (TimestampId* pair : timestamps)
+	{
+		gBackend->destroyTimestamp(pair[0]);
+		gBackend->destroyTimestamp(pair[1]);
+	}
+	return true;
+}
 
-	glDrawElements(GL_TRIANGLES, blockMesh_1.nIndices, GL_UNSIGNED_SHORT, NULL);
+// Replaces the Scene with a Floor, Overdraw Layers and a Grid of Props; Returns the Grid Width
+// --------------------------------------------------------------------------------------------
+float createStressScene(size_t objectCount, size_t lightCount, const TextureHandle* textures, size_t textureCount, size_t overdrawLayers)
+{
+	// Removing a Static Object Re-Renders the Cached Shadow Maps
+	// ----------------------------------------------------------
+	for (const SceneObject& object : gSceneObjects)
+	{
+		if (object.isStatic)
+		{
+			++gStaticGeometryVersion;
+			break;
+		}
+	}
 
-#pragma endregion
+	gSceneObjects.clear();
+	gTransforms.resize(0);
+	gModelMatrices.clear();
+	gNormalMatrices.clear();
+	gLights.clear();
+
+	const size_t side = static_cast<size_t>(ceil(sqrt(static_cast<double>(max<size_t>(objectCount, 1)))));
+	const float extent = side * STRESS_SPACING;
+
+	SceneObject object;
+	object.isStatic = true;
+	object.isOccluder = true;
+	Transform transform;
+	transform.scale = vec3(extent * 0.5f + STRESS_SPACING, 1.0f, extent * 0.5f + STRESS_SPACING);
+
+	// Overdraw: Full Copies of the Floor Beneath it, Lowest First so Each Layer Passes the Depth Test
+	// -----------------------------------------------------------------------------------------------
+	object.mesh = gFloorMesh;
+	for (size_t layer = overdrawLayers; layer > 0; --layer)
+	{
+		object.texture = textures[layer % textureCount];
+		transform.translation = vec3(0.0f, -1.0f - 0.01f * layer, 0.0f);
+		addSceneObject(object, transform);
+	}
 
-#pragma region Block_2 Rendering
+	object.texture = gFloorTexture;
+	transform.translation = vec3(0.0f, -1.0f, 0.0f);
+	addSceneObject(object, transform);
 
-	// Bind Textures to Corresponding Texture Units
-	// --------------------------------------------
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, gTextureIdYellowWood);
-	scale = glm::scale(vec3(2.0f, 2.0f, 2.0f));
-	yRotation = rotate(0.0f, vec3(1.0f, 0.0f, 0.0f));
-	xRotation = rotate(0.3f, vec3(0.0f, 1.0f, 0.0f));
-	zRotation = rotate(1.565f, vec3(0.0f, 0.0f, 1.0f));
-	translation = glm::translate(vec3(2.6f, -0.999f, -0.2f));
-
-	// Transformation are Applied Right-To-Left
-	// ----------------------------------------
-	model = translation * (xRotation * yRotation * zRotation) * scale;
-
-	// Retrieves and Passes Transform Matriceces to the Shader Program
-	// ---------------------------------------------------------------
-	modelLoc = glGetUniformLocation(gProgramID, "model");
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, value_ptr(model));
+	// Props: Scissor Blades and Both Blocks in Turn, Each with a Random Heading
+	// -------------------------------------------------------------------------
+	const MeshHandle meshes[3] = { gScissorsBladeMesh, gBlockMesh1, gBlockMesh2 };
+	mt19937 random(7);
+	uniform_real_distribution<float> heading(0.0f, 6.2831853f);
 
-	// Activate VBO's winthin mesh's VAO
-	// ---------------------------------
-	glBindVertexArray(blockMesh_2.VAO);
+	for (size_t i = 0; i < objectCount; ++i)
+	{
+		const bool blade = (i % 3) == 0;
+		object.mesh = meshes[i % 3];
+		object.texture = textures[i % textureCount];
+		object.isOccluder = !blade;
+
+		const float x = ((i % side) + 0.5f) * STRESS_SPACING - extent * 0.5f;
+		const float z = ((i / side) + 0.5f) * STRESS_SPACING - extent * 0.5f;
+		transform.scale = blade ? vec3(1.2f) : vec3(1.5f);
+		transform.rotation = blade ? vec3(1.28f, 0.0f, heading(random)) : vec3(0.0f, heading(random), 0.0f);
+		transform.translation = vec3(x, blade ? -0.58f : -1.0f, z);
+		addSceneObject(object, transform);
+	}
 
-	// Bind Textures to Corresponding Texture Units
-	// --------------------------------------------
+	createRandomLights(lightCount, extent * 0.5f);
+	return extent;
+}
 
-	glDrawElements(GL_TRIANGLES, blockMesh_2.nIndices, GL_UNSIGNED_SHORT, NULL);
+// Fixed Camera Path: One Orbit Around the Grid, Looking at its Centre; progress is 0 to 1
+// ---------------------------------------------------------------------------------------
+void moveStressCamera(float extent, float progress)
+{
+	const float angle = 6.2831853f * progress;
+	const float radius = extent * 0.5f + 4.0f;
+	gCamera.Position = vec3(cos(angle) * radius, extent * 0.25f + 2.0f, sin(angle) * radius);
+
+	const vec3 direction = normalize(vec3(0.0f, -1.0f, 0.0f) - gCamera.Position);
+	gCamera.Yaw = degrees(atan2(direction.z, direction.x));
+	gCamera.Pitch = degrees(asin(direction.y));
+	gCamera.ProcessMouseMovement(0.0f, 0.0f);   // Rebuilds the Camera Vectors
+}
 
 #pragma endregion
 
-#pragma region Light Binding / Generation
+#pragma region Meshs and Shaders
 
-	// LAMP: draw lamps
-	//----------------
-	glUseProgram(gLampProgramID);
+// Builds a Mesh Directly into its Pool Slot
+// -----------------------------------------
+MeshHandle createMesh(void (*buildMesh)(GLmesh& mesh))
+{
+	MeshHandle handle = gMeshes.insert(GLmesh());
 
-	yRotation = rotate(-0.25f, vec3(1.0f, 0.0f, 0.0f));
-	xRotation = rotate(0.0f, vec3(0.0f, 1.0f, 0.0f));
-	zRotation = rotate(0.0f, vec3(0.0f, 0.0f, 1.0f));
+	// Error Check: Pool Full
+	// ----------------------
+	if (!handle)
+	{
+		cerr << "ERROR::MESH::POOL_FULL" << endl;
+		return handle;
+	}
 
-	//Transform the smaller cube used as a visual que for the light source
-	model = translate(lightPos) * (xRotation * yRotation * zRotation) * glm::scale(lightScale);
+	buildMesh(*gMeshes.get(handle));
+	return handle;
+}
 
-	// Reference matrix uniforms from the Lamp Shader program
-	modelLoc = glGetUniformLocation(gLampProgramID, "model");
-	viewLoc = glGetUniformLocation(gLampProgramID, "view");
-	projLoc = glGetUniformLocation(gLampProgramID, "projection");
+// Partitions the Mesh into Meshlets and Uploads its Indices with the Smallest Type that Fits
+// -----------------------------------------------------------------------------------------
+void uploadMeshIndices(GLmesh& mesh, const GLfloat* vertices, size_t floatCount, const GLuint* indices, size_t indexCount, size_t floatsPerVertex)
+{
+	const size_t vertexCount = floatCount / floatsPerVertex;
 
-	// Pass matrix data to the Lamp Shader program's matrix uniforms
-	glUniformMatrix4fv(modelLoc, 1, GL_FALSE, value_ptr(model));
-	glUniformMatrix4fv(viewLoc, 1, GL_FALSE, value_ptr(view));
-	glUniformMatrix4fv(projLoc, 1, GL_FALSE, value_ptr(projection));
-	glBindVertexArray(blockMesh_1.VAO);
-	glDrawElements(GL_TRIANGLES, blockMesh_1.nIndices, GL_UNSIGNED_SHORT, NULL);
+	vector<uint32_t> meshletIndices(indices, indices + indexCount);
+	buildMeshlets(vertices, floatsPerVertex, vertexCount, meshletIndices, mesh.meshlets);
 
-#pragma endregion
+	// Keep Positions, Indices and Bounds for the CPU Occlusion Rasterizer
+	// -------------------------------------------------------------------
+	mesh.positions.resize(vertexCount);
+	mesh.boundsMin = vec3(numeric_limits<float>::max());
+	mesh.boundsMax = vec3(-numeric_limits<float>::max());
+	for (size_t i = 0; i < vertexCount; ++i)
+	{
+		const GLfloat* position = vertices + i * floatsPerVertex;
+		mesh.positions[i] = vec3(position[0], position[1], position[2]);
+		mesh.boundsMin = min(mesh.boundsMin, mesh.positions[i]);
+		mesh.boundsMax = max(mesh.boundsMax, mesh.positions[i]);
+	}
+	mesh.indices = meshletIndices;
+	mesh.vertices.assign(vertices, vertices + floatCount);
+	mesh.floatsPerVertex = floatsPerVertex;
 
-	// Deactivate the Vertex Array Object
-	// ----------------------------------
-	glBindVertexArray(0);
+	mesh.nIndices = static_cast<GLuint>(indexCount);
 
-	// GLFW: Swap Buffers and Poll IO Events
-	// -------------------------------------
-	glfwSwapBuffers(gWindow);
+	// 16-Bit Indices Halve the Index Buffer Whenever Every Vertex is Addressable
+	// --------------------------------------------------------------------------
+	if (vertexCount <= 65536)
+	{
+		vector<GLushort> shortIndices(meshletIndices.begin(), meshletIndices.end());
+		mesh.indexType = GL_UNSIGNED_SHORT;
+		mesh.VBO[1] = gBackend->createBuffer(BufferType::Index, shortIndices.size() * sizeof(GLushort), shortIndices.data());
+	}
+	else
+	{
+		mesh.indexType = GL_UNSIGNED_INT;
+		mesh.VBO[1] = gBackend->createBuffer(BufferType::Index, meshletIndices.size() * sizeof(GLuint), meshletIndices.data());
+	}
+
+	MemoryTracker::allocateCpu(MemoryTracker::Category::CpuMeshes, meshCopyBytes(mesh));
 }
 
-#pragma region Meshs and Shaders
+// Bytes of the Copies a Mesh Keeps on the CPU After Upload
+// --------------------------------------------------------
+size_t meshCopyBytes(const GLmesh& mesh)
+{
+	return mesh.meshlets.size() * sizeof(Meshlet) + mesh.positions.size() * sizeof(vec3)
+		+ mesh.indices.size() * sizeof(uint32_t) + mesh.vertices.size() * sizeof(GLfloat);
+}
 
 void createScissorMesh(GLmesh& mesh)
 {
@@ -1210,7 +3650,7 @@ void createScissorMesh(GLmesh& mesh)
 
 	// Create VBO: for Indices
 	// -----------------------
-	GLushort scissorIndices[] =
+	GLuint scissorIndices[] =
 	{
 		// Blade - Front
 		// -------------
@@ -1358,670 +3798,296 @@ void createScissorMesh(GLmesh& mesh)
 		27, 28, 52,
 		28, 52, 53,
 		28, 30, 53,
-		30, 53, 55,
-		30, 32, 55,
-		32, 55, 57,
-		32, 34, 57,
-		34, 57, 59,
-		34, 36, 59,
-		36, 59, 61,
-		36, 38, 61,
-		38, 61, 63,
-		38, 49, 63,
-		49, 63, 74,
-		49, 43, 74,
-		43, 74, 68,
-		43, 45, 68,
-		45, 68, 70,
-		45, 47, 70,
-		47, 70, 72,
-		47, 48, 72,
-		48, 72, 73,
-		48, 27, 73,
-		27, 73, 52
-
-	};
-
-	// Creates the Vertex Attribute Pointer fot the Screen Coordinates
-	// ---------------------------------------------------------------
-	const GLuint floatsPerVertex = 3;   // Number of Coordinates per Vertex
-	const GLuint floatsPerUV = 2;    // (X, Y)
-	const GLuint floatsPerNormal = 3;
-
-	// Generates VAO's and VBO's and Activate
-	// those Buffers, Then send vertices to GPU
-	// ----------------------------------------
-	glGenVertexArrays(1, &mesh.VAO);
-	glBindVertexArray(mesh.VAO);
-
-	// Creates 2 Buffers (VBO): First One is Vertex Data; Second One for Indices
-	// -------------------------------------------------------------------
-	glGenBuffers(2, mesh.VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO[0]);   // Activates Buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(scissorVerts), scissorVerts, GL_STATIC_DRAW);   // Sends Vertex or Coordinate Data to the GPU
-
-	mesh.nIndices = sizeof(scissorIndices) / sizeof(scissorIndices[0]);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.VBO[1]);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(scissorIndices), scissorIndices, GL_STATIC_DRAW);
-
-	// Strides between vertex coordinates is 6 (x, y, r, g, b, a). A tightly packed stride is 0.
-	// -----------------------------------------------------------------------------------------
-	GLint stride = sizeof(float) * (static_cast<int64_t>(floatsPerVertex) + floatsPerNormal + floatsPerUV);   // The number of floats before each
-
-	// Creates Vertex Attribute Pointer
-	// --------------------------------
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float)* floatsPerVertex));
-	glEnableVertexAttribArray(1);
-
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (char*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(2);
-}
-
-void createFloorMesh(GLmesh& mesh)
-{
-	// Specifies NDC for Triangle Vertices and Color
-	// ---------------------------------------------
-	GLfloat floorVerts[] =
-	{
-		// Index 0
-		// -------
-		-1.0f, 0.0f, -1.0f,
-		0.0f, 1.0f, 0.0f,
-		0, 0,
-
-		// Index 1
-		// -------
-		1.0f, 0.0f, -1.0f,
-		0.0f, 1.0f, 0.0f,
-		1, 0,
-
-		// Index 2
-		// -------
-		1.0f, 0.0f, 1.0f,
-		0.0f, 1.0f, 0.0f,
-		1, 1,
-
-		// Index 3
-		// -------
-		-1.0f, 0.0f, 1.0f,
-		0.0f, 1.0f, 0.0f,
-		0, 1
-
-
-	};
-
-	// Create VBO: for Indices
-	// -----------------------
-	GLushort floorIndices[] =
-	{
-		0, 1, 2,
-		2, 3, 0
-	};
-
-	// Creates the Vertex Attribute Pointer fot the Screen Coordinates
-	// ---------------------------------------------------------------
-	const GLuint floatsPerVertex = 3;   // Number of Coordinates per Vertex
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;    // (X, Y)
-
-	// Generates VAO's and VBO's and Activate
-	// those Buffers, Then send vertices to GPU
-	// ----------------------------------------
-	glGenVertexArrays(1, &mesh.VAO);
-	glBindVertexArray(mesh.VAO);
-
-	// Creates 2 Buffers (VBO): First One is Vertex Data; Second One for Indices
-	// -------------------------------------------------------------------
-	glGenBuffers(2, mesh.VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO[0]);   // Activates Buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(floorVerts), floorVerts, GL_STATIC_DRAW);   // Sends Vertex or Coordinate Data to the GPU
-
-	mesh.nIndices = sizeof(floorIndices) / sizeof(floorIndices[0]);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.VBO[1]);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(floorIndices), floorIndices, GL_STATIC_DRAW);
-
-
-	// Strides between vertex coordinates is 6 (x, y, r, g, b, a). A tightly packed stride is 0.
-	// -----------------------------------------------------------------------------------------
-	GLint stride = sizeof(float) * (static_cast<int64_t>(floatsPerVertex) + floatsPerNormal + floatsPerUV);   // The number of floats before each
-
-	// Creates Vertex Attribute Pointer
-	// --------------------------------
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (char*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(2);
-}
-
-void createBlock1Mesh(GLmesh& mesh)
-{
-	// Specifies NDC for Triangle Vertices and Color
-	// ---------------------------------------------
-	GLfloat block_1Verts[] =
-	{
-		// Index 0
-		// -------
-		0, 0, 0,
-		0.0f,  0.0f, -1.0f,
-		0, 0,
-
-		// Index 1
-		// -------
-		0, 0.25f, 0,
-		0.0f,  0.0f, -1.0f,
-		0.25f, 0,
-
-		// Index 2
-		// -------
-		1, 0, 0,
-		0.0f,  0.0f, -1.0f,
-		0.25f, 1,
-
-		// Index 3
-		// -------
-		1, 0.25f, 0,
-		0.0f,  0.0f, -1.0f,
-		0, 1,
-
-		// Index 4
-		// -------
-		0, 0, 0.5f,
-		0.0f,  0.0f,  1.0f,
-		0, 0,
-
-		// Index 5
-		// -------
-		0, 0.25f, 0.5f,
-		0.0f,  0.0f,  1.0f,
-		0.25f, 0,
-
-		// Index 6
-		// -------
-		1, 0, 0.5f,
-		0.0f,  0.0f,  1.0f,
-		0.25f, 1,
-
-		// Index 7
-		// -------
-		1, 0.25f, 0.5f,
-		0.0f,  0.0f,  1.0f,
-		0, 1,
-
-		//////////////////
-
-		// Index 8
-		// -------
-		0, 0, 0,
-		-1.0f,  0.0f,  0.0f,
-		0, 0,
-
-		// Index 9
-		// -------
-		0, 0.25f, 0,
-		-1.0f,  0.0f,  0.0f,
-		0, 1,
-
-		// Index 10
-		// -------
-		1, 0, 0,
-		1.0f,  0.0f,  0.0f,
-		0, 0,
-
-		// Index 11
-		// -------
-		1, 0.25f, 0,
-		1.0f,  0.0f,  0.0f,
-		1, 0,
-
-		// Index 12
-		// -------
-		0, 0, 0.5f,
-		-1.0f,  0.0f,  0.0f,
-		1, 0,
-
-		// Index 13
-		// -------
-		0, 0.25f, 0.5f,
-		-1.0f,  0.0f,  0.0f,
-		1, 1,
-
-		// Index 14
-		// -------
-		1, 0, 0.5f,
-		1.0f,  0.0f,  0.0f,
-		0, 1,
-
-		// Index 15
-		// -------
-		1, 0.25f, 0.5f,
-		1.0f,  0.0f,  0.0f,
-		1, 1,
-
-		///////////////////////
-
-		// Index 16
-		// -------
-		0, 0, 0,
-		0.0f, -1.0f, 0.0f,
-		0, 1,
-
-		// Index 17
-		// -------
-		0, 0.25f, 0,
-		0.0f, 1.0f, 0.0f,
-		0, 0,
-
-		// Index 18
-		// -------
-		1, 0, 0,
-		0.0f, -1.0f, 0.0f,
-		1, 1,
-
-		// Index 19
-		// -------
-		1, 0.25f, 0,
-		0.0f, 1.0f, 0.0f,
-		0, 1,
-
-		// Index 20
-		// -------
-		0, 0, 0.5f,
-		0.0f, -1.0f, 0.0f,
-		1, 0,
-
-		// Index 21
-		// -------
-		0, 0.25f, 0.5f,
-		0.0f, 1.0f, 0.0f,
-		1, 1,
-
-		// Index 22
-		// -------
-		1, 0, 0.5f,
-		0.0f, -1.0f, 0.0f,
-		0, 0,
-
-		// Index 23
-		// -------
-		1, 0.25f, 0.5f,
-		0.0f, 1.0f, 0.0f,
-		1, 0,
-
-	};
-
-	// Create VBO: for Indices
-	// -----------------------
-	GLushort block_1Indices[] =
-	{
-		// Side 1 - left
-		0, 1, 2,
-		1, 2, 3,
-
-		// Side 2 - right
-		4, 5, 6,
-		5, 6, 7,
-
-		// Side 3 - front -1.0f,  0.0f,  0.0f,
-		8, 9, 12,
-		9, 12, 13,
-
-		// Side 4 - back 0.0f,  0.0f,  -1.0f,
-		10, 11, 14,
-		11, 14, 15,
-
-		// Side 5 - bottom 0.0f, -1.0f, 0.0f,
-		16, 18, 20,
-		18, 20, 22,
-
-		// Side 6 - top 0.0f, 1.0f, 0.0f,
-		17, 19, 21,
-		19, 21, 23
+		30, 53, 55,
+		30, 32, 55,
+		32, 55, 57,
+		32, 34, 57,
+		34, 57, 59,
+		34, 36, 59,
+		36, 59, 61,
+		36, 38, 61,
+		38, 61, 63,
+		38, 49, 63,
+		49, 63, 74,
+		49, 43, 74,
+		43, 74, 68,
+		43, 45, 68,
+		45, 68, 70,
+		45, 47, 70,
+		47, 70, 72,
+		47, 48, 72,
+		48, 72, 73,
+		48, 27, 73,
+		27, 73, 52
 
 	};
 
 	// Creates the Vertex Attribute Pointer fot the Screen Coordinates
 	// ---------------------------------------------------------------
 	const GLuint floatsPerVertex = 3;   // Number of Coordinates per Vertex
-	const GLuint floatsPerNormal = 3;
 	const GLuint floatsPerUV = 2;    // (X, Y)
+	const GLuint floatsPerNormal = 3;
 
-	// Generates VAO's and VBO's and Activate
-	// those Buffers, Then send vertices to GPU
-	// ----------------------------------------
-	glGenVertexArrays(1, &mesh.VAO);
-	glBindVertexArray(mesh.VAO);
-
-	// Creates 2 Buffers (VBO): First One is Vertex Data; Second One for Indices
+	// Creates 2 Buffers: First One is Vertex Data; Second One for Indices
 	// -------------------------------------------------------------------
-	glGenBuffers(2, mesh.VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO[0]);   // Activates Buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(block_1Verts), block_1Verts, GL_STATIC_DRAW);   // Sends Vertex or Coordinate Data to the GPU
-
-	mesh.nIndices = sizeof(block_1Indices) / sizeof(block_1Indices[0]);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.VBO[1]);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(block_1Indices), block_1Indices, GL_STATIC_DRAW);
+	mesh.VBO[0] = gBackend->createBuffer(BufferType::Vertex, sizeof(scissorVerts), scissorVerts);   // Sends Vertex or Coordinate Data to the GPU
 
+	uploadMeshIndices(mesh, scissorVerts, sizeof(scissorVerts) / sizeof(scissorVerts[0]), scissorIndices, sizeof(scissorIndices) / sizeof(scissorIndices[0]));
 
 	// Strides between vertex coordinates is 6 (x, y, r, g, b, a). A tightly packed stride is 0.
 	// -----------------------------------------------------------------------------------------
-	GLint stride = sizeof(float) * (static_cast<int64_t>(floatsPerVertex) + floatsPerNormal + floatsPerUV);   // The number of floats before each
+	VertexLayout layout;
+	layout.stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);   // The number of floats before each
 
 	// Creates Vertex Attribute Pointer
 	// --------------------------------
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float)* floatsPerVertex));
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (char*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(2);
+	layout.attributes[0] = { 0, floatsPerVertex, 0 };
+	layout.attributes[1] = { 1, floatsPerNormal, sizeof(float) * floatsPerVertex };
+	layout.attributes[2] = { 2, floatsPerUV, sizeof(float) * (floatsPerVertex + floatsPerNormal) };
+	layout.attributeCount = 3;
+
+	mesh.VAO = gBackend->createVertexInput(layout, mesh.VBO[0], mesh.VBO[1]);
 }
 
-void createBlock2Mesh(GLmesh& mesh)
+// Uploads a Compile-Time Primitive: Attribute Layout Comes from its Vertex Format
+// --------------------------------------------------------------------------------
+template <typename Vertex, size_t VertexCount, size_t IndexCount>
+void createPrimitiveMesh(GLmesh& mesh, const PrimitiveMesh<Vertex, VertexCount, IndexCount>& primitive)
 {
-	// Specifies NDC for Triangle Vertices and Color
-	// ---------------------------------------------
-	GLfloat block_2Verts[] =
-	{
-		// Index 0
-		// -------
-		0, 0, 0,
-		0.0f,  0.0f, -1.0f,
-		0, 0,
-
-		// Index 1
-		// -------
-		0, 0.25f, 0,
-		0.0f,  0.0f, -1.0f,
-		0, 1,
-
-		// Index 2
-		// -------
-		1, 0, 0,
-		0.0f,  0.0f, -1.0f,
-		1, 0,
-
-		// Index 3
-		// -------
-		1, 0.25f, 0,
-		0.0f,  0.0f, -1.0f,
-		1, 1,
-
-		// Index 4
-		// -------
-		0, 0, 0.25f,
-		0.0f,  0.0f, 1.0f,
-		0, 0,
-
-		// Index 5
-		// -------
-		0, 0.25f, 0.25f,
-		0.0f,  0.0f, 1.0f,
-		0, 1,
-
-		// Index 6
-		// -------
-		1, 0, 0.25f,
-		0.0f,  0.0f, 1.0f,
-		1, 0,
-
-		// Index 7
-		// -------
-		1, 0.25f, 0.25f,
-		0.0f,  0.0f, 1.0f,
-		1, 1,
-
-		//////////////////
-
-		// Index 8
-		// -------
-		0, 0, 0,
-		0.0f,  -1.0f,  0.0f,
-		0, 0,
-
-		// Index 9
-		// -------
-		0, 0.25f, 0,
-		0.0f,  -1.0f,  0.0f,
-		0, 1,
+	mesh.VBO[0] = gBackend->createBuffer(BufferType::Vertex, sizeof(primitive.vertices), primitive.vertices.data());
 
-		// Index 10
-		// -------
-		1, 0, 0,
-		0.0f,  1.0f,  0.0f,
-		0, 0,
+	uploadMeshIndices(mesh, primitive.vertices[0].position, VertexCount * sizeof(Vertex) / sizeof(float), primitive.indices.data(), IndexCount,
+		sizeof(Vertex) / sizeof(float));
 
-		// Index 11
-		// -------
-		1, 0.25f, 0,
-		0.0f,  1.0f,  0.0f,
-		0, 1,
+	VertexLayout layout;
+	layout.stride = sizeof(Vertex);
+	for (const VertexAttribute& attribute : Vertex::ATTRIBUTES)
+		layout.attributes[layout.attributeCount++] = attribute;
 
-		// Index 12
-		// -------
-		0, 0, 0.25f,
-		0.0f,  -1.0f,  0.0f,
-		0, 0,
+	mesh.VAO = gBackend->createVertexInput(layout, mesh.VBO[0], mesh.VBO[1]);
+}
 
-		// Index 13
-		// -------
-		0, 0.25f, 0.25f,
-		0.0f,  -1.0f,  0.0f,
-		0, 1,
+// Copy of a Mesh with a Lightmap Coordinate at Location 3; Vertices on Chart Seams are Split
+// -----------------------------------------------------------------------------------------
+MeshHandle createLightmapMesh(MeshHandle sourceHandle, const vector<vec2>& coordinates)
+{
+	const GLmesh& source = *gMeshes.get(sourceHandle);
+	const size_t sourceFloats = source.floatsPerVertex;
+	const size_t floatsPerVertex = sourceFloats + 2;
+
+	vector<GLfloat> vertices;
+	vector<GLuint> indices;
+	map<tuple<uint32_t, float, float>, GLuint> splitVertices;
+	for (size_t i = 0; i < source.indices.size(); ++i)
+	{
+		const uint32_t vertex = source.indices[i];
+		auto inserted = splitVertices.emplace(make_tuple(vertex, coordinates[i].x, coordinates[i].y), static_cast<GLuint>(splitVertices.size()));
+		if (inserted.second)
+		{
+			const GLfloat* sourceVertex = source.vertices.data() + vertex * sourceFloats;
+			vertices.insert(vertices.end(), sourceVertex, sourceVertex + sourceFloats);
+			vertices.push_back(coordinates[i].x);
+			vertices.push_back(coordinates[i].y);
+		}
+		indices.push_back(inserted.first->second);
+	}
 
-		// Index 14
-		// -------
-		1, 0, 0.25f,
-		0.0f,  1.0f,  0.0f,
-		1, 0,
+	// Error Check: Pool Full; the Object Keeps its Runtime Lighting
+	// -------------------------------------------------------------
+	MeshHandle handle = gMeshes.insert(GLmesh());
+	if (!handle)
+	{
+		cerr << "ERROR::MESH::POOL_FULL" << endl;
+		return handle;
+	}
 
-		// Index 15
-		// -------
-		1, 0.25f, 0.25f,
-		0.0f,  1.0f,  0.0f,
-		1, 1,
+	GLmesh& mesh = *gMeshes.get(handle);
+	mesh.VBO[0] = gBackend->createBuffer(BufferType::Vertex, vertices.size() * sizeof(GLfloat), vertices.data());
 
-		///////////////////////
+	uploadMeshIndices(mesh, vertices.data(), vertices.size(), indices.data(), indices.size(), floatsPerVertex);
 
-		// Index 16
-		// -------
-		0, 0, 0,
-		1.0f, 0.0f, 0.0f,
-		0.25f, 0,
+	// Position, Normal and UV Keep the Scene Layout
+	// ---------------------------------------------
+	VertexLayout layout;
+	layout.stride = static_cast<uint32_t>(sizeof(GLfloat) * floatsPerVertex);
+	layout.attributes[0] = { 0, 3, 0 };
+	layout.attributes[1] = { 1, 3, sizeof(GLfloat) * 3 };
+	layout.attributes[2] = { 2, 2, sizeof(GLfloat) * 6 };
+	layout.attributes[3] = { 3, 2, sizeof(GLfloat) * sourceFloats };
+	layout.attributeCount = 4;
+	mesh.VAO = gBackend->createVertexInput(layout, mesh.VBO[0], mesh.VBO[1]);
+
+	return handle;
+}
 
-		// Index 17
-		// -------
-		0, 0.25f, 0,
-		-1.0f, 0.0f, 0.0f,
-		0, 0,
+void createFloorMesh(GLmesh& mesh)
+{
+	createPrimitiveMesh(mesh, FLOOR_PRIMITIVE);
+}
 
-		// Index 18
-		// -------
-		1, 0, 0,
-		1.0f, 0.0f, 0.0f,
-		0, 1,
+void createBlock1Mesh(GLmesh& mesh)
+{
+	createPrimitiveMesh(mesh, BLOCK_1_PRIMITIVE);
+}
 
-		// Index 19
-		// -------
-		1, 0.25f, 0,
-		-1.0f, 0.0f, 0.0f,
-		0.25f, 1,
+void createBlock2Mesh(GLmesh& mesh)
+{
+	createPrimitiveMesh(mesh, BLOCK_2_PRIMITIVE);
+}
 
-		// Index 20
-		// -------
-		0, 0, 0.25f,
-		1.0f, 0.0f, 0.0f,
-		1, 1,
+void createLampMesh(GLmesh& mesh)
+{
+	createPrimitiveMesh(mesh, LAMP_PRIMITIVE);
+}
 
-		// Index 21
-		// -------
-		0, 0.25f, 0.25f,
-		-1.0f, 0.0f, 0.0f,
-		0.25f, 0,
+// Creates Shaders: Builds One Program and Blocks Until it is Ready
+// -----------------------------------------------------------------
+bool createShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programID, const char* fragLibrarySource)
+{
+	ShaderBatch batch(&gShaderCache);
+	batch.submit(vtxShaderSource, fragShaderSource, programID, fragLibrarySource);
 
-		// Index 22
-		// -------
-		1, 0, 0.25f,
-		1.0f, 0.0f, 0.0f,
-		1, 0,
+	if (!batch.finish())
+		return false;
 
-		// Index 23
-		// -------
-		1, 0.25f, 0.25f,
-		-1.0f, 0.0f, 0.0f,
-		1, 1
+	glUseProgram(programID);   // Uses Shader Program
 
+	return true;
+}
 
-	};
+// Reserves a Program Slot and Starts Building it in the Background Batch
+// ----------------------------------------------------------------------
+ProgramHandle submitShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, const char* fragLibrarySource)
+{
+	ProgramHandle handle = gPrograms.insert(GLprogram());
+	GLprogram* program = gPrograms.get(handle);
+	if (!program)
+		return handle;
 
-	// Create VBO: for Indices
-	// -----------------------
-	GLushort block_2Indices[] =
+	// Vulkan: SPIR-V Built Offline; a Missing or Rejected Module Leaves the Program Never Ready
+	// -----------------------------------------------------------------------------------------
+	if (gBackendApi == BackendApi::Vulkan)
 	{
-		// Side 1 - left
-		0, 1, 2,
-		1, 2, 3,
-
-		// Side 2 - right
-		4, 5, 6,
-		5, 6, 7,
-
-		// Side 3 - bottom
-		8, 9, 12,
-		9, 12, 13,
-
-		// Side 4 - top
-		10, 11, 14,
-		11, 14, 15,
-
-		// Side 5 - front
-		16, 18, 20,
-		18, 20, 22,
+		vector<uint32_t> vertexWords;
+		vector<uint32_t> fragmentWords;
+		if (loadSpirv(vtxShaderSource, vertexWords) && loadSpirv(fragShaderSource, fragmentWords))
+			program->id = gBackend->createProgram(vertexWords, fragmentWords);
+
+		// Error Check: Name the Stages, since the Program Stays Unready Without a Word
+		// ----------------------------------------------------------------------------
+		if (!program->id)
+			cerr << "ERROR::SHADER::PROGRAM_FAILED " << stageFilename(vtxShaderSource) << " + " << stageFilename(fragShaderSource) << endl;
+	}
+	else
+		gShaderBatch.submit(vtxShaderSource, fragShaderSource, program->id, fragLibrarySource);
 
-		// Side 6 - back
-		17, 19, 21,
-		19, 21, 23
-	};
+	return handle;
+}
 
-	// Creates the Vertex Attribute Pointer fot the Screen Coordinates
-	// ---------------------------------------------------------------
-	const GLuint floatsPerVertex = 3;   // Number of Coordinates per Vertex
-	const GLuint floatsPerNormal = 3;
-	const GLuint floatsPerUV = 2;    // (X, Y)
+// GL Name of a Program; 0 for a Null or Stale Handle, which Never Reports Ready
+// -----------------------------------------------------------------------------
+GLuint programId(ProgramHandle program)
+{
+	const GLprogram* found = gPrograms.get(program);
+	return found ? found->id : 0;
+}
 
-	// Generates VAO's and VBO's and Activate
-	// those Buffers, Then send vertices to GPU
-	// ----------------------------------------
-	glGenVertexArrays(1, &mesh.VAO);
-	glBindVertexArray(mesh.VAO);
+// Vulkan Programs are Created Whole, so Any that has a Name is Ready
+// ------------------------------------------------------------------
+bool programReady(GLuint programID)
+{
+	return gBackendApi == BackendApi::Vulkan ? programID != 0 : gShaderBatch.isReady(programID);
+}
 
-	// Creates 2 Buffers (VBO): First One is Vertex Data; Second One for Indices
-	// -------------------------------------------------------------------
-	glGenBuffers(2, mesh.VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO[0]);   // Activates Buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(block_2Verts), block_2Verts, GL_STATIC_DRAW);   // Sends Vertex or Coordinate Data to the GPU
+// File Name of a Stage's Source in SHADER_STAGES, for Messages
+// ------------------------------------------------------------
+const char* stageFilename(const char* source)
+{
+	const ShaderStage* stage = find_if(begin(SHADER_STAGES), end(SHADER_STAGES), [source](const ShaderStage& candidate) { return candidate.source == source; });
+	return stage != end(SHADER_STAGES) ? stage->filename : "(Unlisted Stage)";
+}
 
-	mesh.nIndices = sizeof(block_2Indices) / sizeof(block_2Indices[0]);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.VBO[1]);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(block_2Indices), block_2Indices, GL_STATIC_DRAW);
+// Reads the Stage CompileShaders.bat Built from this Source into SHADER_DIRECTORY
+// -------------------------------------------------------------------------------
+bool loadSpirv(const char* source, vector<uint32_t>& words)
+{
+	const ShaderStage* stage = find_if(begin(SHADER_STAGES), end(SHADER_STAGES), [source](const ShaderStage& candidate) { return candidate.source == source; });
+	if (stage == end(SHADER_STAGES))
+		return false;
 
+	const string path = string(SHADER_DIRECTORY) + "/" + stage->filename + ".vk.spv";
+	ifstream file(path, ios::binary | ios::ate);
+	const streamoff size = file ? static_cast<streamoff>(file.tellg()) : 0;
 
-	// Strides between vertex coordinates is 6 (x, y, r, g, b, a). A tightly packed stride is 0.
-	// -----------------------------------------------------------------------------------------
-	GLint stride = sizeof(float) * (static_cast<int64_t>(floatsPerVertex) + floatsPerNormal + floatsPerUV);   // The number of floats before each
+	// Error Check: a Whole Number of Words
+	// ------------------------------------
+	if (size <= 0 || size % sizeof(uint32_t) != 0)
+	{
+		cerr << "ERROR::SHADER::SPIRV_MISSING " << path << " (Run CompileShaders.bat)" << endl;
+		return false;
+	}
 
-	// Creates Vertex Attribute Pointer
-	// --------------------------------
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float)* floatsPerVertex));
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (char*)(sizeof(float) * floatsPerVertex));
-	glEnableVertexAttribArray(2);
+	words.resize(static_cast<size_t>(size) / sizeof(uint32_t));
+	file.seekg(0);
+	file.read(reinterpret_cast<char*>(words.data()), size);
+	return static_cast<bool>(file);
 }
 
-// Creates Shaders
-// ---------------
-bool createShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programID)
+// Finishes Background Programs the Driver has Completed; False on a Build Error
+// -----------------------------------------------------------------------------
+bool pollShaderPrograms()
 {
-	// Compilation and Linkage Error Reporting
-	// ---------------------------------------
-	int success = 0;
-	char infoLog[512];
-
-	// Create Shader Program Object
-	// ----------------------------
-	programID = glCreateProgram();
-
-	// Create Shader Objects
-	// ---------------------
-	GLuint vertexShaderID = glCreateShader(GL_VERTEX_SHADER);
-	GLuint fragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
-
-	// Attach Shader Object to Shader Source
-	// -------------------------------------
-	glShaderSource(vertexShaderID, 1, &vtxShaderSource, NULL);
-	glShaderSource(fragmentShaderID, 1, &fragShaderSource, NULL);
+	if (gShaderBatchReported)
+		return true;
 
-	// Compile Vertex Shader
-	// ---------------------
-	glCompileShader(vertexShaderID);
+	if (!gShaderBatch.poll())
+		return false;
 
-	// Error Check: Vertex Shader Compilation
-	// --------------------------------------
-	glGetShaderiv(vertexShaderID, GL_COMPILE_STATUS, &success);
-	if (!success)
+	if (gShaderBatch.pendingCount() == 0)
 	{
-		glGetShaderInfoLog(vertexShaderID, 512, NULL, infoLog);
-		cerr << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << endl;
-
-		return false;
+		gShaderBatchReported = true;
+		cerr << "INFO: All Shader Programs Ready after " << (1000.0 * (glfwGetTime() - gShaderBatchStart)) << " ms";
+		if (gShaderCache.isEnabled())
+			cerr << ", Program Binary Cache: " << gShaderCache.hitCount() << " Hits, " << gShaderCache.missCount() << " Misses";
+		cerr << endl;
 	}
 
-	// Compile Fragment Shader
-	// -----------------------
-	glCompileShader(fragmentShaderID);
+	return true;
+}
 
-	// Error Check: Fragment Shader Compilation
-	// ----------------------------------------
-	glGetShaderiv(fragmentShaderID, GL_COMPILE_STATUS, &success);
-	if (!success)
+// Writes Every Shader Stage as a Standalone GLSL File for CompileShaders.bat
+// --------------------------------------------------------------------------
+bool exportShaders(const char* directory)
+{
+	error_code error;
+	filesystem::create_directories(directory, error);
+	if (error)
 	{
-		glGetShaderInfoLog(fragmentShaderID, sizeof(infoLog), NULL, infoLog);
-		cerr << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << endl;
-
+		cerr << "ERROR::SHADER::EXPORT_DIRECTORY " << directory << ": " << error.message() << endl;
 		return false;
 	}
 
-	// Attach the Compiled Shaders to the Shader Program Object
-	// --------------------------------------------------------
-	glAttachShader(programID, vertexShaderID);
-	glAttachShader(programID, fragmentShaderID);
-	glLinkProgram(programID);
-
-	// Error Check: Shader Program Link
-	// --------------------------------
-	glGetProgramiv(programID, GL_LINK_STATUS, &success);
-	if (!success)
+	for (const ShaderStage& stage : SHADER_STAGES)
 	{
-		glGetProgramInfoLog(programID, sizeof(infoLog), NULL, infoLog);
-		cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << endl;
+		string path = string(directory) + "/" + stage.filename;
+		ofstream file(path);
+		file << stage.source << "\n";
+		if (stage.librarySource)
+			file << stage.librarySource << "\n";
 
-		return false;
+		if (!file)
+		{
+			cerr << "ERROR::SHADER::EXPORT_FAILED " << path << endl;
+			return false;
+		}
 	}
 
-	glUseProgram(programID);   // Uses Shader Program
-
 	return true;
 }
 
 // Create Textures
 // ---------------
-bool createTexture(const char* filename, GLuint& textureId)
+bool createTexture(const char* filename, TextureHandle& texture)
 {
 	int width, height, channels;
 	unsigned char* image = stbi_load(filename, &width, &height, &channels, 0);
@@ -2029,89 +4095,219 @@ bool createTexture(const char* filename, GLuint& textureId)
 	if (image)
 	{
 		flipImageVertically(image, width, height, channels);
+		bool uploaded = uploadTexture(image, width, height, channels, texture);
+		stbi_image_free(image);
+		return uploaded;
+	}
 
-		glGenTextures(1, &textureId);
-		glBindTexture(GL_TEXTURE_2D, textureId);
-
-		// Set Texture Wrapping Params
-		// ---------------------------
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	return false;   // Error Loading Image 
+}
 
-		// Set Texture Filtering Params
-		// ----------------------------
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+// Creates a Pooled Texture from 8-Bit Pixels, Handed to the Streamer when Streaming is On
+// ---------------------------------------------------------------------------------------
+bool uploadTexture(const unsigned char* image, int width, int height, int channels, TextureHandle& texture)
+{
+	// Mean Color of the Texels, for the Lightmap Baker
+	// ------------------------------------------------
+	vec3 meanColor(0.5f);
+	if (channels >= 3 && width > 0 && height > 0)
+	{
+		dvec3 sum(0.0);
+		for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i)
+			sum += dvec3(image[i * channels], image[i * channels + 1], image[i * channels + 2]);
+		meanColor = vec3(sum / (255.0 * width * height));
+	}
 
-		if (channels == 3)
-		{
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		}
-		else if (channels == 4)
-		{
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-		}
-		else
-		{
-			cerr << "Not Implemented to Handle Image With " << channels << " Channels" << endl;
+	if (gTextureStreamingEnabled)
+	{
+		GLtexture streamed{ 0 };
+		streamed.meanColor = meanColor;
+		streamed.streamSlot = gTextureStreamer.addTexture(image, width, height, channels);
+		if (streamed.streamSlot < 0)
 			return false;
-		}
 
-		glGenerateMipmap(GL_TEXTURE_2D);
+		texture = gTextures.insert(streamed);
+		return static_cast<bool>(texture);
+	}
 
-		stbi_image_free(image);
-		glBindTexture(GL_TEXTURE_2D, 0);   // Unbind the Texture
+	// Repeating, Linearly Filtered, with the Full Mip Chain
+	// -----------------------------------------------------
+	TextureDesc desc;
+	desc.width = width;
+	desc.height = height;
+	if (channels == 3)
+	{
+		desc.format = TextureFormat::RGB8;
+	}
+	else if (channels == 4)
+	{
+		desc.format = TextureFormat::RGBA8;
+	}
+	else
+	{
+		cerr << "Not Implemented to Handle Image With " << channels << " Channels" << endl;
+		return false;
+	}
 
-		return true;
+	const GLuint textureId = gBackend->createTexture(desc, image);
+	if (!textureId)
+		return false;
+
+	GLtexture uploaded{ textureId };
+	uploaded.meanColor = meanColor;
+	texture = gTextures.insert(uploaded);
+	return static_cast<bool>(texture);
+}
+
+// Procedural Two-Color Checker Texture; the Seed Picks the Colors
+// ---------------------------------------------------------------
+bool createCheckerTexture(size_t seed, TextureHandle& texture)
+{
+	const int size = 128;
+	const int cell = 16;
+
+	mt19937 random(static_cast<unsigned>(seed));
+	uniform_int_distribution<int> channel(32, 255);
+	const unsigned char colors[2][3] =
+	{
+		{ static_cast<unsigned char>(channel(random)), static_cast<unsigned char>(channel(random)), static_cast<unsigned char>(channel(random)) },
+		{ static_cast<unsigned char>(channel(random)), static_cast<unsigned char>(channel(random)), static_cast<unsigned char>(channel(random)) }
+	};
+
+	vector<unsigned char> image(size * size * 3);
+	for (int y = 0; y < size; ++y)
+	{
+		for (int x = 0; x < size; ++x)
+		{
+			const unsigned char* color = colors[((x / cell) + (y / cell)) & 1];
+			copy(color, color + 3, image.begin() + (y * size + x) * 3);
+		}
 	}
 
-	return false;   // Error Loading Image 
+	return uploadTexture(image.data(), size, size, 3, texture);
 }
 
 #pragma endregion
 
 #pragma region Terminate Functions
 
-// Destroy VAO's and VBO's to Release Mesh Data
+// Destroy VAO's and VBO's of Every Pooled Mesh
 // --------------------------------------------
-void destroyMeshs(GLmesh& mesh, GLmesh& mesh2, GLmesh& mesh3, GLmesh& mesh4, GLmesh& mesh5)
+void destroyMeshs()
 {
-	glDeleteVertexArrays(1, &mesh.VAO);
-	glDeleteBuffers(2, mesh.VBO);
-	glDeleteVertexArrays(1, &mesh2.VAO);
-	glDeleteBuffers(2, mesh2.VBO);
-	glDeleteVertexArrays(1, &mesh3.VAO);
-	glDeleteBuffers(2, mesh3.VBO);
-	glDeleteVertexArrays(1, &mesh4.VAO);
-	glDeleteBuffers(2, mesh4.VBO);
+	for (GLmesh& mesh : gMeshes)
+	{
+		gBackend->destroyVertexInput(mesh.VAO);
+		gBackend->destroyBuffer(mesh.VBO[0]);
+		gBackend->destroyBuffer(mesh.VBO[1]);
+		MemoryTracker::releaseCpu(MemoryTracker::Category::CpuMeshes, meshCopyBytes(mesh));
+	}
+	gMeshes.clear();
 }
 
 // Destroy Shader Program
 // ----------------------
 void destroyShaderProgram(GLuint programID)
 {
-	glDeleteProgram(programID);
+	gBackend->destroyProgram(programID);
 }
 
-// Destroy Textures
-// ----------------
+// Destroy Textures; Streamed Textures have No Name Here, the Streamer Deletes them
+// --------------------------------------------------------------------------------
 void destroyTexture(GLuint textureId)
 {
-	glGenTextures(1, &textureId);
+	gBackend->destroyTexture(textureId);
 }
 
 // Terminates Application
 // ----------------------
-void terminateApplication(GLmesh& mesh, GLmesh& mesh2, GLmesh& mesh3, GLmesh& mesh4, GLmesh& mesh5, GLuint& programID_0, GLuint& programID_1, GLuint& textureId_0, GLuint& textureId_1, GLuint& textureId_2, GLuint& textureId_3)
-{
-	destroyMeshs(mesh, mesh2, mesh3, mesh4, mesh5);
-	destroyTexture(textureId_0);
-	destroyTexture(textureId_1);
-	destroyTexture(textureId_2);
-	destroyTexture(textureId_3);
-	destroyShaderProgram(programID_0);
-	destroyShaderProgram(programID_1);
+void terminateApplication()
+{
+	gFrameCapture.destroy();
+	gInputRecorder.destroy(gLastFrame);
+	gUsageMeter.destroy();
+	destroyMeshs();
+	gFrameArena.destroy();
+	gFrameStream.destroy();
+	gShadowMaps.destroy();
+	gDebugDraw.destroy();
+	gDeferredRenderer.destroy();
+	gDynamicResolution.destroy();
+	gPostProcess.destroy();
+	gTextureStreamer.destroy();
+	gLightmap.destroy();
+
+	for (const GLtexture& texture : gTextures)
+		destroyTexture(texture.id);
+	gTextures.clear();
+
+	for (const GLprogram& program : gPrograms)
+		destroyShaderProgram(program.id);
+	gPrograms.clear();
+
+	for (const auto& pipeline : gPipelines)
+		gBackend->destroyPipeline(pipeline.second);
+	gPipelines.clear();
+	gBackend.reset();
+
+	// Everything Above Freed what it Made, so Anything Still Counted Leaked
+	// ---------------------------------------------------------------------
+	MemoryTracker::reportLeaks();
+
 	exit(EXIT_SUCCESS);
 }
 
-#pragma endregion
\ No newline at end of file
+#pragma endregion
+
+#pragma region Command Line
+
+// Returns True when the Option was Passed on the Command Line
+// -----------------------------------------------------------
+bool hasOption(int argc, char* argv[], const char* option)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], option) == 0)
+			return true;
+	}
+
+	return false;
+}
+
+// Returns the Argument Following the Option, or Null when it is Missing
+// ---------------------------------------------------------------------
+const char* optionValue(int argc, char* argv[], const char* option)
+{
+	for (int i = 1; i + 1 < argc; ++i)
+	{
+		if (strcmp(argv[i], option) == 0)
+			return argv[i + 1];
+	}
+
+	return nullptr;
+}
+
+// Parses a Comma-Separated List of Counts, e.g. "250,1000,4000"
+// -------------------------------------------------------------
+vector<size_t> parseCountList(const char* list, const char* fallback)
+{
+	vector<size_t> counts;
+	string text = list ? list : fallback;
+
+	size_t begin = 0;
+	while (begin <= text.size())
+	{
+		size_t end = text.find(',', begin);
+		if (end == string::npos)
+			end = text.size();
+		if (end > begin)
+			counts.push_back(static_cast<size_t>(atoll(text.substr(begin, end - begin).c_str())));
+		begin = end + 1;
+	}
+
+	if (counts.empty())
+		counts.push_back(0);
+	return counts;
+}
+
+#pragma endregion
@@ -0,0 +1,288 @@
+#include "MemoryTracker.h"
+
+#include <algorithm>       // max
+#include <cstdint>         // uint64_t
+#include <iostream>        // cerr
+#include <mutex>           // mutex, lock_guard
+#include <unordered_map>   // unordered_map
+
+using namespace std;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	typedef MemoryTracker::Category Category;
+
+	const size_t CATEGORY_COUNT = static_cast<size_t>(Category::Count);
+	const double MEGABYTE = 1024.0 * 1024.0;
+
+	const char* const CATEGORY_NAMES[CATEGORY_COUNT] =
+	{
+		"Mesh Buffers", "Stream Buffers", "Textures", "Render Targets", "Programs", "CPU Meshes", "CPU Textures"
+	};
+
+	// GL Names are Only Unique per Object Type, so the Type Goes in the Key's High Bits
+	// ---------------------------------------------------------------------------------
+	enum class ObjectType : uint64_t { Buffer, Texture, Renderbuffer, Program, DeviceBuffer, DeviceImage, DeviceProgram };
+
+	struct Allocation
+	{
+		Category category;
+		size_t bytes;
+	};
+
+	mutex gMutex;
+	unordered_map<uint64_t, Allocation> gObjects;
+	size_t gBytes[CATEGORY_COUNT] = {};
+	size_t gObjectCounts[CATEGORY_COUNT] = {};
+	size_t gGpuBytes = 0;
+	size_t gCpuBytes = 0;
+	size_t gGpuHighWater = 0;
+	size_t gCpuHighWater = 0;
+
+	uint64_t objectKey(ObjectType type, GLuint name)
+	{
+		return (static_cast<uint64_t>(type) << 32) | name;
+	}
+
+	ObjectType deviceObjectType(MemoryTracker::DeviceObject type)
+	{
+		return static_cast<ObjectType>(static_cast<uint64_t>(ObjectType::DeviceBuffer) + static_cast<uint64_t>(type));
+	}
+
+	// Totals and High-Water Marks; the Caller Holds gMutex
+	// ----------------------------------------------------
+	void add(Category category, size_t bytes, size_t objects)
+	{
+		gBytes[static_cast<size_t>(category)] += bytes;
+		gObjectCounts[static_cast<size_t>(category)] += objects;
+
+		size_t& total = MemoryTracker::isCpu(category) ? gCpuBytes : gGpuBytes;
+		size_t& highWater = MemoryTracker::isCpu(category) ? gCpuHighWater : gGpuHighWater;
+		total += bytes;
+		highWater = max(highWater, total);
+	}
+
+	void remove(Category category, size_t bytes, size_t objects)
+	{
+		gBytes[static_cast<size_t>(category)] -= bytes;
+		gObjectCounts[static_cast<size_t>(category)] -= objects;
+		(MemoryTracker::isCpu(category) ? gCpuBytes : gGpuBytes) -= bytes;
+	}
+
+	// Respecifying an Object's Storage Replaces its Old Size Rather than Adding to it
+	// -------------------------------------------------------------------------------
+	void record(ObjectType type, GLuint name, Category category, size_t bytes)
+	{
+		if (name == 0)
+			return;
+
+		lock_guard<mutex> lock(gMutex);
+		auto inserted = gObjects.emplace(objectKey(type, name), Allocation{ category, bytes });
+		if (!inserted.second)
+		{
+			remove(inserted.first->second.category, inserted.first->second.bytes, 1);
+			inserted.first->second = Allocation{ category, bytes };
+		}
+		add(category, bytes, 1);
+	}
+
+	void forget(ObjectType type, GLsizei count, const GLuint* names)
+	{
+		lock_guard<mutex> lock(gMutex);
+		for (GLsizei i = 0; i < count; ++i)
+		{
+			auto found = gObjects.find(objectKey(type, names[i]));
+			if (found == gObjects.end())
+				continue;
+
+			remove(found->second.category, found->second.bytes, 1);
+			gObjects.erase(found);
+		}
+	}
+
+	// Bytes per Texel as Drivers Lay the Format Out; Unlisted Formats Count as Four
+	// -----------------------------------------------------------------------------
+	size_t texelBytes(GLenum internalFormat)
+	{
+		switch (internalFormat)
+		{
+			case GL_R8:
+				return 1;
+			case GL_RG8:
+			case GL_R16F:
+			case GL_DEPTH_COMPONENT16:
+				return 2;
+			case GL_RGBA16F:
+			case GL_DEPTH32F_STENCIL8:
+				return 8;
+			case GL_RGBA32F:
+				return 16;
+			default:
+				return 4;   // RGB8, RGBA8, RG16UI, RGB10_A2, R11F_G11F_B10F, 24- and 32-Bit Depth
+		}
+	}
+
+	size_t imageBytes(GLenum internalFormat, GLsizei levels, GLsizei width, GLsizei height)
+	{
+		size_t bytes = 0;
+		for (GLsizei level = 0; level < levels; ++level)
+			bytes += static_cast<size_t>(max(1, width >> level)) * max(1, height >> level) * texelBytes(internalFormat);
+
+		return bytes;
+	}
+}
+
+const char* MemoryTracker::categoryName(Category category)
+{
+	return CATEGORY_NAMES[static_cast<size_t>(category)];
+}
+
+void MemoryTracker::bufferData(Category category, GLenum target, GLuint buffer, GLsizeiptr size, const void* data, GLenum usage)
+{
+	glBufferData(target, size, data, usage);
+	record(ObjectType::Buffer, buffer, category, static_cast<size_t>(size));
+}
+
+void MemoryTracker::bufferStorage(Category category, GLenum target, GLuint buffer, GLsizeiptr size, const void* data, GLbitfield flags)
+{
+	glBufferStorage(target, size, data, flags);
+	record(ObjectType::Buffer, buffer, category, static_cast<size_t>(size));
+}
+
+void MemoryTracker::textureStorage2D(Category category, GLuint texture, GLsizei levels, GLenum internalFormat, GLsizei width, GLsizei height)
+{
+	glTexStorage2D(GL_TEXTURE_2D, levels, internalFormat, width, height);
+	record(ObjectType::Texture, texture, category, imageBytes(internalFormat, levels, width, height));
+}
+
+void MemoryTracker::renderbufferStorage(Category category, GLuint renderbuffer, GLenum internalFormat, GLsizei width, GLsizei height)
+{
+	glRenderbufferStorage(GL_RENDERBUFFER, internalFormat, width, height);
+	record(ObjectType::Renderbuffer, renderbuffer, category, imageBytes(internalFormat, 1, width, height));
+}
+
+void MemoryTracker::textureImage2D(Category category, GLuint texture, GLsizei levels, GLenum internalFormat, GLsizei width, GLsizei height,
+	GLenum format, GLenum type, const void* pixels)
+{
+	glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, pixels);
+	record(ObjectType::Texture, texture, category, imageBytes(internalFormat, levels, width, height));
+}
+
+GLuint MemoryTracker::createProgram()
+{
+	GLuint program = glCreateProgram();
+	record(ObjectType::Program, program, Category::Programs, 0);
+	return program;
+}
+
+void MemoryTracker::programLinked(GLuint program)
+{
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	record(ObjectType::Program, program, Category::Programs, static_cast<size_t>(max(length, 0)));
+}
+
+void MemoryTracker::deleteBuffers(GLsizei count, const GLuint* buffers)
+{
+	glDeleteBuffers(count, buffers);
+	forget(ObjectType::Buffer, count, buffers);
+}
+
+void MemoryTracker::deleteTextures(GLsizei count, const GLuint* textures)
+{
+	glDeleteTextures(count, textures);
+	forget(ObjectType::Texture, count, textures);
+}
+
+void MemoryTracker::deleteRenderbuffers(GLsizei count, const GLuint* renderbuffers)
+{
+	glDeleteRenderbuffers(count, renderbuffers);
+	forget(ObjectType::Renderbuffer, count, renderbuffers);
+}
+
+void MemoryTracker::deleteProgram(GLuint program)
+{
+	glDeleteProgram(program);
+	forget(ObjectType::Program, 1, &program);
+}
+
+void MemoryTracker::deviceAllocated(DeviceObject type, uint32_t handle, Category category, size_t bytes)
+{
+	record(deviceObjectType(type), handle, category, bytes);
+}
+
+void MemoryTracker::deviceFreed(DeviceObject type, uint32_t handle)
+{
+	forget(deviceObjectType(type), 1, &handle);
+}
+
+void MemoryTracker::allocateCpu(Category category, size_t bytes)
+{
+	lock_guard<mutex> lock(gMutex);
+	add(category, bytes, 1);
+}
+
+void MemoryTracker::releaseCpu(Category category, size_t bytes)
+{
+	lock_guard<mutex> lock(gMutex);
+	remove(category, bytes, 1);
+}
+
+size_t MemoryTracker::liveBytes(Category category)
+{
+	lock_guard<mutex> lock(gMutex);
+	return gBytes[static_cast<size_t>(category)];
+}
+
+size_t MemoryTracker::liveObjects(Category category)
+{
+	lock_guard<mutex> lock(gMutex);
+	return gObjectCounts[static_cast<size_t>(category)];
+}
+
+size_t MemoryTracker::gpuBytes()
+{
+	lock_guard<mutex> lock(gMutex);
+	return gGpuBytes;
+}
+
+size_t MemoryTracker::cpuBytes()
+{
+	lock_guard<mutex> lock(gMutex);
+	return gCpuBytes;
+}
+
+size_t MemoryTracker::gpuHighWaterMark()
+{
+	lock_guard<mutex> lock(gMutex);
+	return gGpuHighWater;
+}
+
+size_t MemoryTracker::cpuHighWaterMark()
+{
+	lock_guard<mutex> lock(gMutex);
+	return gCpuHighWater;
+}
+
+bool MemoryTracker::reportLeaks()
+{
+	lock_guard<mutex> lock(gMutex);
+
+	bool leaked = false;
+	for (size_t i = 0; i < CATEGORY_COUNT; ++i)
+	{
+		if (gObjectCounts[i] == 0 && gBytes[i] == 0)
+			continue;
+
+		cerr << "ERROR::MEMORY::LEAK " << CATEGORY_NAMES[i] << ": " << gObjectCounts[i] << " Allocations, "
+			<< (gBytes[i] / MEGABYTE) << " MB Never Freed" << endl;
+		leaked = true;
+	}
+
+	cerr << "INFO: Memory High-Water: GPU " << (gGpuHighWater / MEGABYTE) << " MB, CPU " << (gCpuHighWater / MEGABYTE) << " MB"
+		<< (leaked ? "" : ", No Leaks") << endl;
+
+	return !leaked;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+// Includes
+// -------
+#include <GL/glew.h>      // GLEW library
+#include <cstddef>        // size_t
+#include <cstdint>        // uint32_t
+
+// GPU and CPU Memory Accounting
+// -----------------------------
+// Every buffer, texture, renderbuffer and program the renderer creates goes through these
+// wrappers, which make the GL call and record the object's size under a Category; the
+// matching delete wrappers forget it. Sizes are what the storage needs, estimated from
+// the internal format (RGB8 padded to four bytes, as drivers store it), and programs count
+// at their binary length. Objects of other graphics APIs are recorded by the backend that
+// allocates them, at the size it allocated. Long-lived CPU copies of GPU data are added and
+// released by hand.
+// Live bytes and the high-water mark of each side are kept as objects come and go, so
+// reportLeaks() at shutdown lists anything never deleted and the peak a deployment has to
+// fit. The state is process-wide and locked, so any module or thread can record into it.
+class MemoryTracker
+{
+public:
+	enum class Category
+	{
+		MeshBuffers,      // Vertex and Index Buffers
+		StreamBuffers,    // Persistently Mapped Uploads, Readback and Capture Buffers
+		Textures,         // Scene Textures, Streamed or Not, and the Lightmap Atlas
+		RenderTargets,    // G-Buffer, Shadow Atlases, Post-Processing and Feedback Targets
+		Programs,         // Linked Shader Programs
+		CpuMeshes,        // Mesh Copies Kept for Culling and Baking
+		CpuTextures,      // Texture Levels Kept for Streaming
+		Count
+	};
+
+	static bool isCpu(Category category) { return category >= Category::CpuMeshes; }
+	static const char* categoryName(Category category);
+
+	// Storage Wrappers; the Object has to be Bound to target (GL_TEXTURE_2D, GL_RENDERBUFFER)
+	// ----------------------------------------------------------------------------------------
+	static void bufferData(Category category, GLenum target, GLuint buffer, GLsizeiptr size, const void* data, GLenum usage);
+	static void bufferStorage(Category category, GLenum target, GLuint buffer, GLsizeiptr size, const void* data, GLbitfield flags);
+	static void textureStorage2D(Category category, GLuint texture, GLsizei levels, GLenum internalFormat, GLsizei width, GLsizei height);
+	static void renderbufferStorage(Category category, GLuint renderbuffer, GLenum internalFormat, GLsizei width, GLsizei height);
+
+	// Level 0 of a Texture; levels Counts the Chain glGenerateMipmap will Add
+	// -----------------------------------------------------------------------
+	static void textureImage2D(Category category, GLuint texture, GLsizei levels, GLenum internalFormat, GLsizei width, GLsizei height,
+		GLenum format, GLenum type, const void* pixels);
+
+	// Programs are Counted Once Created and Sized Once Linked or Loaded from a Binary
+	// -------------------------------------------------------------------------------
+	static GLuint createProgram();
+	static void programLinked(GLuint program);
+
+	static void deleteBuffers(GLsizei count, const GLuint* buffers);
+	static void deleteTextures(GLsizei count, const GLuint* textures);
+	static void deleteRenderbuffers(GLsizei count, const GLuint* renderbuffers);
+	static void deleteProgram(GLuint program);
+
+	// Objects a Non-GL Backend Allocated, Sized by its Allocations; Handles are Unique per Type
+	// -----------------------------------------------------------------------------------------
+	enum class DeviceObject { Buffer, Image, Program };
+
+	static void deviceAllocated(DeviceObject type, uint32_t handle, Category category, size_t bytes);
+	static void deviceFreed(DeviceObject type, uint32_t handle);
+
+	// CPU Copies, Counted in Bytes Only
+	// ---------------------------------
+	static void allocateCpu(Category category, size_t bytes);
+	static void releaseCpu(Category category, size_t bytes);
+
+	static size_t liveBytes(Category category);
+	static size_t liveObjects(Category category);
+	static size_t gpuBytes();
+	static size_t cpuBytes();
+	static size_t gpuHighWaterMark();
+	static size_t cpuHighWaterMark();
+
+	// Prints Every Category Still Holding Memory and the High-Water Marks; True if Nothing Leaked
+	// -------------------------------------------------------------------------------------------
+	static bool reportLeaks();
+};
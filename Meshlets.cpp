@@ -0,0 +1,276 @@
+#include "Meshlets.h"
+
+#include <algorithm>   // min, max
+#include <cfloat>      // FLT_MAX
+#include <cmath>       // sqrt
+
+using namespace std;
+using namespace glm;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	const uint32_t NO_MESHLET = ~0u;
+
+	vec3 vertexPosition(const float* vertices, size_t floatsPerVertex, uint32_t index)
+	{
+		const float* position = vertices + index * floatsPerVertex;
+		return vec3(position[0], position[1], position[2]);
+	}
+
+	// Bounding Sphere and Normal Cone of the Triangles [firstIndex, firstIndex + indexCount)
+	// ---------------------------------------------------------------------------------------
+	void computeBounds(Meshlet& meshlet, const float* vertices, size_t floatsPerVertex, const uint32_t* indices)
+	{
+		vec3 lower(FLT_MAX), upper(-FLT_MAX);
+		for (uint32_t i = 0; i < meshlet.indexCount; ++i)
+		{
+			vec3 position = vertexPosition(vertices, floatsPerVertex, indices[i]);
+			lower = min(lower, position);
+			upper = max(upper, position);
+		}
+
+		meshlet.center = (lower + upper) * 0.5f;
+		meshlet.radius = 0.0f;
+		for (uint32_t i = 0; i < meshlet.indexCount; ++i)
+			meshlet.radius = std::max(meshlet.radius, length(vertexPosition(vertices, floatsPerVertex, indices[i]) - meshlet.center));
+
+		// Face Normals from the Winding; Degenerate Triangles Face Nowhere
+		// ----------------------------------------------------------------
+		vector<vec3> normals;
+		vec3 normalSum(0.0f);
+		for (uint32_t i = 0; i < meshlet.indexCount; i += 3)
+		{
+			vec3 p0 = vertexPosition(vertices, floatsPerVertex, indices[i]);
+			vec3 p1 = vertexPosition(vertices, floatsPerVertex, indices[i + 1]);
+			vec3 p2 = vertexPosition(vertices, floatsPerVertex, indices[i + 2]);
+			vec3 normal = cross(p1 - p0, p2 - p0);
+			float area = length(normal);
+
+			normals.push_back(area > 0.0f ? normal / area : vec3(0.0f));
+			normalSum += normals.back();
+		}
+
+		meshlet.coneApex = meshlet.center;
+		meshlet.coneAxis = vec3(0.0f);
+		meshlet.coneCutoff = 1.0f;
+
+		if (length(normalSum) < 1e-6f)
+			return;
+
+		vec3 axis = normalize(normalSum);
+		float minimumDot = 1.0f;
+		for (const vec3& normal : normals)
+			if (normal != vec3(0.0f))
+				minimumDot = std::min(minimumDot, dot(axis, normal));
+
+		// Normals Spread Past ~84 Degrees: No Viewpoint Sees Only Back Faces
+		// -------------------------------------------------------------------
+		if (minimumDot <= 0.1f)
+			return;
+
+		// Move the Apex Back Along the Axis Until it is Behind Every Triangle's Plane
+		// ---------------------------------------------------------------------------
+		float maximumT = 0.0f;
+		for (size_t t = 0; t < normals.size(); ++t)
+		{
+			if (normals[t] == vec3(0.0f))
+				continue;
+
+			vec3 p0 = vertexPosition(vertices, floatsPerVertex, indices[t * 3]);
+			maximumT = std::max(maximumT, dot(meshlet.center - p0, normals[t]) / dot(axis, normals[t]));
+		}
+
+		// Normal Cone Half-Angle a Widens by 90 Degrees into the Cone of Back-Facing Views: cos(90 - a) = sin(a)
+		// -------------------------------------------------------------------------------------------------------
+		meshlet.coneApex = meshlet.center - axis * maximumT;
+		meshlet.coneAxis = axis;
+		meshlet.coneCutoff = sqrt(1.0f - minimumDot * minimumDot);
+	}
+}
+
+// Gribb-Hartmann: Planes are Sums and Differences of the Clip Matrix Rows
+// -----------------------------------------------------------------------
+Frustum extractFrustum(const mat4& viewProjection)
+{
+	vec4 rows[4];
+	for (int i = 0; i < 4; ++i)
+		rows[i] = vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+
+	Frustum frustum;
+	for (int i = 0; i < 3; ++i)
+	{
+		frustum.planes[i * 2] = rows[3] + rows[i];
+		frustum.planes[i * 2 + 1] = rows[3] - rows[i];
+	}
+
+	for (vec4& plane : frustum.planes)
+		plane = plane / length(vec3(plane));
+
+	return frustum;
+}
+
+void buildMeshlets(const float* vertices, size_t floatsPerVertex, size_t vertexCount,
+	vector<uint32_t>& indices, vector<Meshlet>& meshlets)
+{
+	const size_t triangleCount = indices.size() / 3;
+	meshlets.clear();
+
+	// Triangles Around Each Vertex, Packed by Vertex
+	// ----------------------------------------------
+	vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+	for (uint32_t index : indices)
+		++adjacencyOffsets[index + 1];
+	for (size_t v = 0; v < vertexCount; ++v)
+		adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+
+	vector<uint32_t> adjacency(indices.size());
+	vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+	for (size_t i = 0; i < indices.size(); ++i)
+		adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+
+	vector<bool> emitted(triangleCount, false);
+	vector<uint32_t> liveTriangles(vertexCount);   // Unemitted Triangles Around Each Vertex
+	for (size_t v = 0; v < vertexCount; ++v)
+		liveTriangles[v] = adjacencyOffsets[v + 1] - adjacencyOffsets[v];
+	vector<uint32_t> vertexMeshlet(vertexCount, NO_MESHLET);   // Last Meshlet that Used the Vertex
+	vector<uint32_t> triangleMeshlet(triangleCount, NO_MESHLET);   // Last Meshlet that Queued the Triangle
+	vector<uint32_t> candidates;
+	vector<uint32_t> reordered;
+	reordered.reserve(indices.size());
+
+	size_t scan = 0;
+	while (reordered.size() < indices.size())
+	{
+		const uint32_t meshletIndex = static_cast<uint32_t>(meshlets.size());
+
+		Meshlet meshlet = {};
+		meshlet.firstIndex = static_cast<uint32_t>(reordered.size());
+		vec3 positionSum(0.0f);
+
+		// Seed: the Previous Meshlet's Leftover Neighbour with the Fewest Live Triangles
+		// Around it, which Hugs the Emitted Region Instead of Leaving Islands Behind
+		// ------------------------------------------------------------------------------
+		uint32_t triangle = NO_MESHLET;
+		uint32_t seedLive = ~0u;
+		for (uint32_t candidate : candidates)
+		{
+			if (emitted[candidate])
+				continue;
+
+			uint32_t live = 0;
+			for (int corner = 0; corner < 3; ++corner)
+				live += liveTriangles[indices[candidate * 3 + corner]];
+			if (live < seedLive)
+			{
+				triangle = candidate;
+				seedLive = live;
+			}
+		}
+		candidates.clear();
+
+		if (triangle == NO_MESHLET)
+		{
+			while (emitted[scan])
+				++scan;
+			triangle = static_cast<uint32_t>(scan);
+		}
+
+		for (;;)
+		{
+			// Emit the Triangle and Queue its Unemitted Neighbours
+			// ----------------------------------------------------
+			emitted[triangle] = true;
+			for (int corner = 0; corner < 3; ++corner)
+			{
+				uint32_t vertex = indices[triangle * 3 + corner];
+				reordered.push_back(vertex);
+				--liveTriangles[vertex];
+
+				if (vertexMeshlet[vertex] != meshletIndex)
+				{
+					vertexMeshlet[vertex] = meshletIndex;
+					++meshlet.vertexCount;
+					positionSum += vertexPosition(vertices, floatsPerVertex, vertex);
+				}
+
+				for (uint32_t a = adjacencyOffsets[vertex]; a < adjacencyOffsets[vertex + 1]; ++a)
+				{
+					uint32_t neighbour = adjacency[a];
+					if (!emitted[neighbour] && triangleMeshlet[neighbour] != meshletIndex)
+					{
+						triangleMeshlet[neighbour] = meshletIndex;
+						candidates.push_back(neighbour);
+					}
+				}
+			}
+			meshlet.indexCount += 3;
+
+			if (meshlet.indexCount / 3 >= Meshlet::MAX_TRIANGLES)
+				break;
+
+			// Next: the Neighbour that Adds the Fewest New Vertices and Still Fits, then the
+			// One Nearest the Meshlet's Centroid, so Clusters Grow Round Rather than as Strips
+			// --------------------------------------------------------------------------------
+			const vec3 centroid = positionSum / static_cast<float>(meshlet.vertexCount);
+			uint32_t best = NO_MESHLET;
+			uint32_t bestNewVertices = 4;
+			float bestDistance = FLT_MAX;
+			size_t kept = 0;
+			for (uint32_t candidate : candidates)
+			{
+				if (emitted[candidate])
+					continue;
+				candidates[kept++] = candidate;
+
+				uint32_t newVertices = 0;
+				for (int corner = 0; corner < 3; ++corner)
+					newVertices += vertexMeshlet[indices[candidate * 3 + corner]] != meshletIndex;
+
+				if (meshlet.vertexCount + newVertices > Meshlet::MAX_VERTICES || newVertices > bestNewVertices)
+					continue;
+
+				vec3 offset = vertexPosition(vertices, floatsPerVertex, indices[candidate * 3]) - centroid;
+				float distance = dot(offset, offset);
+				if (newVertices < bestNewVertices || distance < bestDistance)
+				{
+					best = candidate;
+					bestNewVertices = newVertices;
+					bestDistance = distance;
+				}
+			}
+			candidates.resize(kept);
+
+			if (best == NO_MESHLET)
+				break;
+			triangle = best;
+		}
+
+		computeBounds(meshlet, vertices, floatsPerVertex, reordered.data() + meshlet.firstIndex);
+		meshlets.push_back(meshlet);
+	}
+
+	indices.swap(reordered);
+}
+
+bool isMeshletVisible(const Meshlet& meshlet, const mat4& model, const Frustum& frustum,
+	const vec3& modelSpaceCamera, bool testCone)
+{
+	// Back-Facing: Facing is Preserved by the Model Matrix, so the Cone is Tested Before it
+	// -------------------------------------------------------------------------------------
+	if (testCone && dot(normalize(meshlet.coneApex - modelSpaceCamera), meshlet.coneAxis) >= meshlet.coneCutoff)
+		return false;
+
+	// Off Screen: Sphere Moved to World Space and Grown by the Largest Axis Scale
+	// ---------------------------------------------------------------------------
+	vec3 center = vec3(model * vec4(meshlet.center, 1.0f));
+	float scale = std::max(length(vec3(model[0])), std::max(length(vec3(model[1])), length(vec3(model[2]))));
+	float radius = meshlet.radius * scale;
+
+	for (const vec4& plane : frustum.planes)
+		if (dot(vec3(plane), center) + plane.w < -radius)
+			return false;
+
+	return true;
+}
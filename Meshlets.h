@@ -0,0 +1,51 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <cstdint>        // uint32_t
+#include <vector>         // vector
+#include <glm/glm.hpp>
+
+// Meshlet: a Small Cluster of Triangles that is Culled as a Unit
+// --------------------------------------------------------------
+// buildMeshlets() reorders a mesh's index buffer so each meshlet is one contiguous range
+// of at most MAX_VERTICES unique vertices and MAX_TRIANGLES triangles, grown greedily
+// from neighbouring triangles so clusters stay compact. Every meshlet carries a bounding
+// sphere and a normal cone in model space; a huge mesh can then skip the clusters that
+// are off screen, or facing away, instead of drawing all of its triangles.
+struct Meshlet
+{
+	static const size_t MAX_VERTICES = 64;
+	static const size_t MAX_TRIANGLES = 124;
+
+	uint32_t firstIndex;     // Range in the Reordered Index Buffer
+	uint32_t indexCount;
+	uint32_t vertexCount;    // Unique Vertices Referenced
+
+	glm::vec3 center;        // Bounding Sphere
+	float radius;
+
+	glm::vec3 coneApex;      // Every Triangle Faces Away from a Viewer Inside the Cone
+	glm::vec3 coneAxis;
+	float coneCutoff;        // 1 When the Normals Spread Too Far to Ever Cull
+};
+
+// View Frustum Planes, Normals Point Inside
+// -----------------------------------------
+struct Frustum
+{
+	glm::vec4 planes[6];
+};
+
+Frustum extractFrustum(const glm::mat4& viewProjection);
+
+// Partition Triangles into Meshlets; indices is Reordered in Place
+// ----------------------------------------------------------------
+void buildMeshlets(const float* vertices, size_t floatsPerVertex, size_t vertexCount,
+	std::vector<uint32_t>& indices, std::vector<Meshlet>& meshlets);
+
+// Frustum Test in World Space and, if testCone, Back-Face Cone Test in Model Space
+// --------------------------------------------------------------------------------
+bool isMeshletVisible(const Meshlet& meshlet, const glm::mat4& model, const Frustum& frustum,
+	const glm::vec3& modelSpaceCamera, bool testCone);
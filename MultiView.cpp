@@ -0,0 +1,148 @@
+#include "MultiView.h"
+
+#include <cstring>      // strcmp
+#include <iostream>     // cerr
+#include <glm/gtx/transform.hpp>
+
+#include "ShaderUniforms.h"
+
+using namespace std;
+using namespace glm;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	// Fixed Overview Cameras of the Split Layout, All Aimed at the Middle of the Scene
+	// --------------------------------------------------------------------------------
+	const vec3 SCENE_CENTER(0.0f, -1.0f, 0.0f);
+	const vec3 OVERVIEW_ABOVE(0.0f, 9.0f, 0.0f);
+	const vec3 OVERVIEW_FRONT(0.0f, 1.0f, 9.0f);
+	const vec3 OVERVIEW_SIDE(9.0f, 1.0f, 0.0f);
+
+	void setViewport(MultiView::View& view, int x, int y, int width, int height)
+	{
+		view.viewport[0] = static_cast<float>(x);
+		view.viewport[1] = static_cast<float>(y);
+		view.viewport[2] = static_cast<float>(width);
+		view.viewport[3] = static_cast<float>(height);
+	}
+
+	void setOverview(MultiView::View& view, const vec3& position, const vec3& up, const mat4& projection)
+	{
+		view.view = lookAt(position, SCENE_CENTER, up);
+		view.projection = projection;
+		view.position = position;
+	}
+}
+
+bool MultiView::parseLayout(const char* name, Layout& layout)
+{
+	if (strcmp(name, "split") == 0)
+		layout = Layout::Split;
+	else if (strcmp(name, "stereo") == 0)
+		layout = Layout::Stereo;
+	else if (strcmp(name, "projections") == 0)
+		layout = Layout::Projections;
+	else
+		return false;
+
+	return true;
+}
+
+bool MultiView::create(RenderBackend& backend, Layout layout)
+{
+	const uint32_t maxViewports = backend.maxViewports();
+	if (maxViewports < MAX_VIEWS)
+	{
+		cerr << "ERROR::MULTI_VIEW::UNSUPPORTED " << backend.name() << " Routes Primitives to Only " << maxViewports << " Viewports" << endl;
+		return false;
+	}
+
+	mLayout = layout;
+	mViewCount = (layout == Layout::Split) ? 4 : 2;
+	return true;
+}
+
+void MultiView::update(const Camera& camera, int width, int height, const Projection& projection)
+{
+	// Side-by-Side Halves, or a 2x2 Grid with the Camera Top-Left
+	// -----------------------------------------------------------
+	const int halfWidth = width / 2;
+	const int halfHeight = height / 2;
+	const mat4 cameraView = lookAt(camera.Position, camera.Position + camera.Front, camera.Up);   // Camera::GetViewMatrix()
+
+	switch (mLayout)
+	{
+		case Layout::Split:
+		{
+			const float aspectRatio = halfHeight > 0 ? static_cast<float>(halfWidth) / halfHeight : 1.0f;
+			const mat4 overviewProjection = projection(true, aspectRatio);
+
+			mViews[0].view = cameraView;
+			mViews[0].projection = overviewProjection;
+			mViews[0].position = camera.Position;
+			setOverview(mViews[1], OVERVIEW_ABOVE, vec3(0.0f, 0.0f, -1.0f), overviewProjection);
+			setOverview(mViews[2], OVERVIEW_FRONT, vec3(0.0f, 1.0f, 0.0f), overviewProjection);
+			setOverview(mViews[3], OVERVIEW_SIDE, vec3(0.0f, 1.0f, 0.0f), overviewProjection);
+
+			setViewport(mViews[0], 0, halfHeight, halfWidth, height - halfHeight);
+			setViewport(mViews[1], halfWidth, halfHeight, width - halfWidth, height - halfHeight);
+			setViewport(mViews[2], 0, 0, halfWidth, halfHeight);
+			setViewport(mViews[3], halfWidth, 0, width - halfWidth, halfHeight);
+		}
+		break;
+
+		case Layout::Stereo:
+		{
+			const float aspectRatio = height > 0 ? static_cast<float>(halfWidth) / height : 1.0f;
+			const vec3 offset = camera.Right * (0.5f * EYE_SEPARATION);
+
+			for (int i = 0; i < 2; ++i)
+			{
+				const vec3 position = camera.Position + (i == 0 ? -offset : offset);
+				mViews[i].view = lookAt(position, position + camera.Front, camera.Up);
+				mViews[i].projection = projection(true, aspectRatio);
+				mViews[i].position = position;
+			}
+
+			setViewport(mViews[0], 0, 0, halfWidth, height);
+			setViewport(mViews[1], halfWidth, 0, width - halfWidth, height);
+		}
+		break;
+
+		case Layout::Projections:
+		{
+			const float aspectRatio = height > 0 ? static_cast<float>(halfWidth) / height : 1.0f;
+
+			for (int i = 0; i < 2; ++i)
+			{
+				mViews[i].view = cameraView;
+				mViews[i].projection = projection(i == 0, aspectRatio);
+				mViews[i].position = camera.Position;
+			}
+
+			setViewport(mViews[0], 0, 0, halfWidth, height);
+			setViewport(mViews[1], halfWidth, 0, width - halfWidth, height);
+		}
+		break;
+	}
+}
+
+void MultiView::bind(CommandList& commands) const
+{
+	mat4 viewProjections[MAX_VIEWS];
+	vec3 positions[MAX_VIEWS];
+	float viewports[MAX_VIEWS * 4];
+	for (int i = 0; i < mViewCount; ++i)
+	{
+		viewProjections[i] = mViews[i].projection * mViews[i].view;
+		positions[i] = mViews[i].position;
+		for (int j = 0; j < 4; ++j)
+			viewports[i * 4 + j] = mViews[i].viewport[j];
+	}
+
+	commands.setUniform(Uniform::ViewProjections, viewProjections, mViewCount);
+	commands.setUniform(Uniform::ViewPositions, positions, mViewCount);
+	commands.setViewports(viewports, mViewCount);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+// Includes
+// -------
+#include <functional>             // std::function
+#include <glm/glm.hpp>
+#include <learnOpengl/camera.h>
+
+#include "RenderBackend.h"
+
+// Single-Pass Multi-View Rendering
+// --------------------------------
+// Every view is a viewport of the same target with its own view and projection. Draws are
+// instanced once per view: the vertex shader takes its view from gl_InstanceID, transforms
+// by that view's matrix from a uniform array and routes the triangle to the view's viewport
+// through gl_ViewportIndex (GL_ARB_shader_viewport_layer_array, or Vulkan's
+// VK_EXT_shader_viewport_index_layer), so the scene is submitted once however many views
+// there are. The layouts are:
+//   Split        the camera and three fixed overview cameras (above, front, side), 2x2
+//   Stereo       left and right eyes EYE_SEPARATION apart, side by side
+//   Projections  the camera's perspective and orthographic projections, side by side
+class MultiView
+{
+public:
+	enum class Layout { Split, Stereo, Projections };
+
+	static const int MAX_VIEWS = 4;                       // Size of the Shaders' Uniform Arrays
+	static constexpr float EYE_SEPARATION = 0.065f;       // World Units Between the Stereo Eyes
+
+	struct View
+	{
+		glm::mat4 view = glm::mat4(1.0f);
+		glm::mat4 projection = glm::mat4(1.0f);
+		glm::vec3 position = glm::vec3(0.0f);
+		float viewport[4] = {};   // x, y, Width, Height in the Render Target
+	};
+
+	// Builds a Projection for a Viewport of the Given Aspect Ratio
+	// ------------------------------------------------------------
+	using Projection = std::function<glm::mat4(bool perspective, float aspectRatio)>;
+
+	// Parse "split", "stereo" or "projections"
+	// ----------------------------------------
+	static bool parseLayout(const char* name, Layout& layout);
+
+	// Error Check: the Backend Must Route Primitives to Viewports from the Vertex Shader
+	// ---------------------------------------------------------------------------------
+	bool create(RenderBackend& backend, Layout layout);
+
+	// Lay Out this Frame's Views Over a width x height Target
+	// -------------------------------------------------------
+	void update(const Camera& camera, int width, int height, const Projection& projection);
+
+	// Record the Per-View Matrices, Positions and Viewports; the Next Pass Resets the Viewports
+	// -----------------------------------------------------------------------------------------
+	void bind(CommandList& commands) const;
+
+	int viewCount() const { return mViewCount; }
+	const View& view(int index) const { return mViews[index]; }
+
+private:
+	Layout mLayout = Layout::Split;
+	View mViews[MAX_VIEWS];
+	int mViewCount = 0;
+};
@@ -0,0 +1,339 @@
+#include "OcclusionCulling.h"
+#include "JobSystem.h"
+
+#include <algorithm>   // min, max, fill
+#include <cmath>       // floor, ceil
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OCCLUSION_CULLING_SSE2
+#endif
+
+using namespace std;
+using namespace glm;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	const float FAR_DEPTH = 1.0f;
+	const float MIN_TRIANGLE_AREA = 1e-6f;   // Twice the Area in Buffer Pixels
+	const size_t TILE_JOB_GRAIN = 8;
+
+	// Signed Distance to the Near Plane (z = -w); Positive in Front
+	// -------------------------------------------------------------
+	float nearDistance(const vec4& clip)
+	{
+		return clip.z + clip.w;
+	}
+
+	int clampInt(int value, int low, int high)
+	{
+		return value < low ? low : (value > high ? high : value);
+	}
+}
+
+OcclusionCulling::OcclusionCulling() :
+	mViewProjection(1.0f),
+	mBins(TILES_X * TILES_Y),
+	mDepth(static_cast<size_t>(BUFFER_WIDTH) * BUFFER_HEIGHT, FAR_DEPTH),
+	mTileMaxDepth(TILES_X * TILES_Y, FAR_DEPTH)
+{
+}
+
+void OcclusionCulling::beginFrame(const mat4& viewProjection)
+{
+	mViewProjection = viewProjection;
+	mTriangles.clear();
+
+	for (vector<uint32_t>& bin : mBins)
+		bin.clear();
+}
+
+void OcclusionCulling::addOccluder(const vec3* positions, size_t vertexCount, const uint32_t* indices, size_t indexCount, const mat4& model)
+{
+	const mat4 modelViewProjection = mViewProjection * model;
+
+	mClipPositions.resize(vertexCount);
+	for (size_t i = 0; i < vertexCount; ++i)
+		mClipPositions[i] = modelViewProjection * vec4(positions[i], 1.0f);
+
+	for (size_t i = 0; i + 2 < indexCount; i += 3)
+	{
+		const vec4 triangle[3] = { mClipPositions[indices[i]], mClipPositions[indices[i + 1]], mClipPositions[indices[i + 2]] };
+
+		// Trivially Reject Triangles Wholly Outside One Side Plane
+		// --------------------------------------------------------
+		bool outside = false;
+		for (int axis = 0; axis < 2 && !outside; ++axis)
+		{
+			outside = (triangle[0][axis] > triangle[0].w && triangle[1][axis] > triangle[1].w && triangle[2][axis] > triangle[2].w)
+				|| (triangle[0][axis] < -triangle[0].w && triangle[1][axis] < -triangle[1].w && triangle[2][axis] < -triangle[2].w);
+		}
+		if (outside)
+			continue;
+
+		// Clip Against the Near Plane: a Triangle Becomes at Most a Quad
+		// --------------------------------------------------------------
+		vec4 polygon[4];
+		int polygonCount = 0;
+		for (int edge = 0; edge < 3; ++edge)
+		{
+			const vec4& from = triangle[edge];
+			const vec4& to = triangle[(edge + 1) % 3];
+			const float fromDistance = nearDistance(from);
+			const float toDistance = nearDistance(to);
+
+			if (fromDistance >= 0.0f)
+				polygon[polygonCount++] = from;
+			if ((fromDistance >= 0.0f) != (toDistance >= 0.0f))
+				polygon[polygonCount++] = from + (to - from) * (fromDistance / (fromDistance - toDistance));
+		}
+
+		for (int vertex = 2; vertex < polygonCount; ++vertex)
+			addTriangle(polygon[0], polygon[vertex - 1], polygon[vertex]);
+	}
+}
+
+void OcclusionCulling::addTriangle(const vec4& a, const vec4& b, const vec4& c)
+{
+	ScreenTriangle triangle;
+	const vec4* vertices[3] = { &a, &b, &c };
+	for (int i = 0; i < 3; ++i)
+	{
+		const float inverseW = 1.0f / vertices[i]->w;
+		triangle.x[i] = (vertices[i]->x * inverseW * 0.5f + 0.5f) * BUFFER_WIDTH;
+		triangle.y[i] = (vertices[i]->y * inverseW * 0.5f + 0.5f) * BUFFER_HEIGHT;
+		triangle.z[i] = vertices[i]->z * inverseW;
+	}
+
+	// Back Faces Only Ever Hide what a Closed Occluder's Front Faces Already Hide: Drop them
+	// -------------------------------------------------------------------------------------
+	const float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) - (triangle.y[1] - triangle.y[0]) * (triangle.x[2] - triangle.x[0]);
+	if (area < MIN_TRIANGLE_AREA)
+		return;
+
+	const float minX = min(triangle.x[0], min(triangle.x[1], triangle.x[2]));
+	const float maxX = max(triangle.x[0], max(triangle.x[1], triangle.x[2]));
+	const float minY = min(triangle.y[0], min(triangle.y[1], triangle.y[2]));
+	const float maxY = max(triangle.y[0], max(triangle.y[1], triangle.y[2]));
+	if (maxX < 0.0f || maxY < 0.0f || minX >= BUFFER_WIDTH || minY >= BUFFER_HEIGHT)
+		return;
+
+	// Bin into Every Tile the Bounds Overlap
+	// --------------------------------------
+	const uint32_t index = static_cast<uint32_t>(mTriangles.size());
+	mTriangles.push_back(triangle);
+
+	const int tileX0 = clampInt(static_cast<int>(floor(minX)) / TILE_WIDTH, 0, TILES_X - 1);
+	const int tileX1 = clampInt(static_cast<int>(floor(maxX)) / TILE_WIDTH, 0, TILES_X - 1);
+	const int tileY0 = clampInt(static_cast<int>(floor(minY)) / TILE_HEIGHT, 0, TILES_Y - 1);
+	const int tileY1 = clampInt(static_cast<int>(floor(maxY)) / TILE_HEIGHT, 0, TILES_Y - 1);
+
+	for (int tileY = tileY0; tileY <= tileY1; ++tileY)
+		for (int tileX = tileX0; tileX <= tileX1; ++tileX)
+			mBins[tileY * TILES_X + tileX].push_back(index);
+}
+
+void OcclusionCulling::rasterize(JobSystem& jobs)
+{
+	jobs.parallelFor(mBins.size(), TILE_JOB_GRAIN, [this](size_t begin, size_t end)
+	{
+		for (size_t tile = begin; tile < end; ++tile)
+			rasterizeTile(static_cast<int>(tile));
+	});
+}
+
+void OcclusionCulling::rasterizeTile(int tile) const
+{
+	float* depth = tileDepth(tile);
+	fill(depth, depth + TILE_WIDTH * TILE_HEIGHT, FAR_DEPTH);
+
+	const int originX = (tile % TILES_X) * TILE_WIDTH;
+	const int originY = (tile / TILES_X) * TILE_HEIGHT;
+	const float cornerX[4] = { float(originX), float(originX + TILE_WIDTH), float(originX), float(originX + TILE_WIDTH) };
+	const float cornerY[4] = { float(originY), float(originY), float(originY + TILE_HEIGHT), float(originY + TILE_HEIGHT) };
+
+	// Upper Bound on Every Depth in the Tile: Falls Once a Triangle Covers the Whole Tile
+	// -----------------------------------------------------------------------------------
+	float tileMax = FAR_DEPTH;
+
+	for (uint32_t index : mBins[tile])
+	{
+		const ScreenTriangle& triangle = mTriangles[index];
+
+		// Edge Functions E = A x + B y + C, Positive Inside; Depth is a Plane in Screen Space
+		// -----------------------------------------------------------------------------------
+		float edgeA[3], edgeB[3], edgeC[3];
+		for (int edge = 0; edge < 3; ++edge)
+		{
+			const int next = (edge + 1) % 3;
+			edgeA[edge] = triangle.y[edge] - triangle.y[next];
+			edgeB[edge] = triangle.x[next] - triangle.x[edge];
+			edgeC[edge] = -(edgeA[edge] * triangle.x[edge] + edgeB[edge] * triangle.y[edge]);
+		}
+
+		const float x10 = triangle.x[1] - triangle.x[0], y10 = triangle.y[1] - triangle.y[0], z10 = triangle.z[1] - triangle.z[0];
+		const float x20 = triangle.x[2] - triangle.x[0], y20 = triangle.y[2] - triangle.y[0], z20 = triangle.z[2] - triangle.z[0];
+		const float inverseArea = 1.0f / (x10 * y20 - y10 * x20);
+		const float depthDx = (z10 * y20 - y10 * z20) * inverseArea;
+		const float depthDy = (x10 * z20 - z10 * x20) * inverseArea;
+		const float depthC = triangle.z[0] - depthDx * triangle.x[0] - depthDy * triangle.y[0];
+
+		// Depth is Linear, so its Extremes Over the Tile are at the Corners
+		// -----------------------------------------------------------------
+		float planeMin = 1e30f, planeMax = -1e30f;
+		bool coversTile = true;
+		for (int corner = 0; corner < 4; ++corner)
+		{
+			const float depth = depthDx * cornerX[corner] + depthDy * cornerY[corner] + depthC;
+			planeMin = min(planeMin, depth);
+			planeMax = max(planeMax, depth);
+			for (int edge = 0; edge < 3; ++edge)
+				coversTile = coversTile && edgeA[edge] * cornerX[corner] + edgeB[edge] * cornerY[corner] + edgeC[edge] >= 0.0f;
+		}
+
+		// Hidden Behind Everything Already in the Tile: Skip the Pixels Entirely
+		// ----------------------------------------------------------------------
+		const float nearest = max(planeMin, min(triangle.z[0], min(triangle.z[1], triangle.z[2])));
+		if (nearest >= tileMax)
+			continue;
+		if (coversTile)
+			tileMax = min(tileMax, planeMax);
+
+		// Clamp the Bounds to this Tile; Columns Start on a SIMD Group
+		// ------------------------------------------------------------
+		const int x0 = max(originX, static_cast<int>(floor(min(triangle.x[0], min(triangle.x[1], triangle.x[2]))))) & ~3;
+		const int x1 = min(originX + TILE_WIDTH - 1, static_cast<int>(ceil(max(triangle.x[0], max(triangle.x[1], triangle.x[2])))));
+		const int y0 = max(originY, static_cast<int>(floor(min(triangle.y[0], min(triangle.y[1], triangle.y[2])))));
+		const int y1 = min(originY + TILE_HEIGHT - 1, static_cast<int>(ceil(max(triangle.y[0], max(triangle.y[1], triangle.y[2])))));
+
+		for (int y = y0; y <= y1; ++y)
+		{
+			const float centerY = y + 0.5f;
+			const float centerX = x0 + 0.5f;
+			float* row = depth + (y - originY) * TILE_WIDTH - originX;
+
+#ifdef OCCLUSION_CULLING_SSE2
+			const __m128 laneOffsets = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+			const __m128 zero = _mm_setzero_ps();
+
+			__m128 edge[3], edgeStep[3];
+			for (int i = 0; i < 3; ++i)
+			{
+				edge[i] = _mm_add_ps(_mm_set1_ps(edgeA[i] * centerX + edgeB[i] * centerY + edgeC[i]), _mm_mul_ps(laneOffsets, _mm_set1_ps(edgeA[i])));
+				edgeStep[i] = _mm_set1_ps(edgeA[i] * 4.0f);
+			}
+			__m128 z = _mm_add_ps(_mm_set1_ps(depthDx * centerX + depthDy * centerY + depthC), _mm_mul_ps(laneOffsets, _mm_set1_ps(depthDx)));
+			const __m128 zStep = _mm_set1_ps(depthDx * 4.0f);
+
+			for (int x = x0; x <= x1; x += 4)
+			{
+				const __m128 inside = _mm_and_ps(_mm_cmpge_ps(edge[0], zero), _mm_and_ps(_mm_cmpge_ps(edge[1], zero), _mm_cmpge_ps(edge[2], zero)));
+				if (_mm_movemask_ps(inside))
+				{
+					const __m128 current = _mm_loadu_ps(row + x);
+					const __m128 nearer = _mm_min_ps(current, z);
+					_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, current)));
+				}
+
+				for (int i = 0; i < 3; ++i)
+					edge[i] = _mm_add_ps(edge[i], edgeStep[i]);
+				z = _mm_add_ps(z, zStep);
+			}
+#else
+			for (int x = x0; x <= x1; ++x)
+			{
+				const float centerPixelX = x + 0.5f;
+				if (edgeA[0] * centerPixelX + edgeB[0] * centerY + edgeC[0] >= 0.0f
+					&& edgeA[1] * centerPixelX + edgeB[1] * centerY + edgeC[1] >= 0.0f
+					&& edgeA[2] * centerPixelX + edgeB[2] * centerY + edgeC[2] >= 0.0f)
+				{
+					row[x] = min(row[x], depthDx * centerPixelX + depthDy * centerY + depthC);
+				}
+			}
+#endif
+		}
+	}
+
+	mTileMaxDepth[tile] = tileMax;
+}
+
+bool OcclusionCulling::isVisible(const vec3& boundsMin, const vec3& boundsMax, const mat4& model) const
+{
+	const mat4 modelViewProjection = mViewProjection * model;
+
+	// Project the Corners; a Box Crossing the Near Plane is Always Drawn
+	// ------------------------------------------------------------------
+	vec2 screenMin(1e30f), screenMax(-1e30f);
+	float nearestDepth = 1e30f;
+	for (int corner = 0; corner < 8; ++corner)
+	{
+		const vec3 position((corner & 1) ? boundsMax.x : boundsMin.x, (corner & 2) ? boundsMax.y : boundsMin.y, (corner & 4) ? boundsMax.z : boundsMin.z);
+		const vec4 clip = modelViewProjection * vec4(position, 1.0f);
+		if (clip.w <= 0.0f || nearDistance(clip) < 0.0f)
+			return true;
+
+		const vec2 ndc(clip.x / clip.w, clip.y / clip.w);
+		screenMin = min(screenMin, ndc);
+		screenMax = max(screenMax, ndc);
+		nearestDepth = std::min(nearestDepth, clip.z / clip.w);
+	}
+
+	if (screenMax.x < -1.0f || screenMax.y < -1.0f || screenMin.x > 1.0f || screenMin.y > 1.0f || nearestDepth > 1.0f)
+		return false;
+
+	// Grow the Rectangle by a Pixel: Occluders are Sampled at Pixel Centers, so a Pixel on an
+	// Occluder's Silhouette Holds its Depth Even Where the Occluder Covers Only Part of it
+	// ---------------------------------------------------------------------------------------
+	const int x0 = clampInt(static_cast<int>(floor((screenMin.x * 0.5f + 0.5f) * BUFFER_WIDTH)) - 1, 0, BUFFER_WIDTH - 1);
+	const int x1 = clampInt(static_cast<int>(floor((screenMax.x * 0.5f + 0.5f) * BUFFER_WIDTH)) + 1, 0, BUFFER_WIDTH - 1);
+	const int y0 = clampInt(static_cast<int>(floor((screenMin.y * 0.5f + 0.5f) * BUFFER_HEIGHT)) - 1, 0, BUFFER_HEIGHT - 1);
+	const int y1 = clampInt(static_cast<int>(floor((screenMax.y * 0.5f + 0.5f) * BUFFER_HEIGHT)) + 1, 0, BUFFER_HEIGHT - 1);
+
+	// Hidden Only if the Farthest Depth Under the Rectangle is Nearer than the Box's Nearest
+	// Point, so Visible as Soon as Any Pixel is at Least as Far
+	// --------------------------------------------------------------------------------------
+#ifdef OCCLUSION_CULLING_SSE2
+	const __m128 nearest = _mm_set1_ps(nearestDepth);
+#endif
+	for (int tileY = y0 / TILE_HEIGHT; tileY <= y1 / TILE_HEIGHT; ++tileY)
+	{
+		for (int tileX = x0 / TILE_WIDTH; tileX <= x1 / TILE_WIDTH; ++tileX)
+		{
+			// The Whole Tile is Nearer than the Box: No Pixel Needs Reading
+			// -------------------------------------------------------------
+			const int tile = tileY * TILES_X + tileX;
+			if (mTileMaxDepth[tile] < nearestDepth)
+				continue;
+
+			const float* depth = tileDepth(tile);
+			const int originX = tileX * TILE_WIDTH;
+			const int originY = tileY * TILE_HEIGHT;
+			const int columnBegin = max(x0, originX) - originX;
+			const int columnEnd = min(x1, originX + TILE_WIDTH - 1) - originX + 1;
+
+			for (int y = max(y0, originY); y <= min(y1, originY + TILE_HEIGHT - 1); ++y)
+			{
+				const float* row = depth + (y - originY) * TILE_WIDTH;
+				int x = columnBegin;
+#ifdef OCCLUSION_CULLING_SSE2
+				for (; x + 4 <= columnEnd; x += 4)
+					if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), nearest)))
+						return true;
+#endif
+				for (; x < columnEnd; ++x)
+					if (row[x] >= nearestDepth)
+						return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+float OcclusionCulling::depthAt(int x, int y) const
+{
+	const int tile = (y / TILE_HEIGHT) * TILES_X + x / TILE_WIDTH;
+	return tileDepth(tile)[(y % TILE_HEIGHT) * TILE_WIDTH + x % TILE_WIDTH];
+}
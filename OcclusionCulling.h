@@ -0,0 +1,81 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <cstdint>        // uint32_t
+#include <vector>         // vector
+#include <glm/glm.hpp>
+
+class JobSystem;
+
+// CPU Software Occlusion Culling
+// ------------------------------
+// Large occluders (floors, walls, blocks) are rasterized on the CPU into a small depth
+// buffer covering the whole viewport at BUFFER_WIDTH x BUFFER_HEIGHT, a quarter of 1080p on
+// each axis. Occluder triangles are transformed, near-clipped and binned into tiles on the
+// calling thread; each tile is then cleared and rasterized by its own job, four pixels
+// per SSE2 instruction, so no two threads touch the same depth. Each tile also keeps an
+// upper bound on its depth, lowered whenever a triangle covers the whole tile: triangles
+// behind it are skipped without touching a pixel, and so are occludee tests against it.
+// Occludees are tested as model AABBs, conservatively: the box's screen rectangle, grown by
+// a pixel on every side, is compared with its nearest depth, and the object is culled only
+// if the farthest depth under the rectangle is nearer than that. Growing the rectangle
+// covers silhouette pixels the occluders only partly cover. Nothing here touches GL, so
+// the whole system runs (and is benchmarked) headless. The tests only read the buffer, so
+// any number of threads can run them at once after rasterize().
+class OcclusionCulling
+{
+public:
+	static const int BUFFER_WIDTH = 480;
+	static const int BUFFER_HEIGHT = 272;
+	static const int TILE_WIDTH = 32;    // Multiple of the SIMD Width
+	static const int TILE_HEIGHT = 16;
+	static const int TILES_X = BUFFER_WIDTH / TILE_WIDTH;
+	static const int TILES_Y = BUFFER_HEIGHT / TILE_HEIGHT;
+
+	OcclusionCulling();
+
+	// Start a Frame: Drops Last Frame's Occluders
+	// -------------------------------------------
+	void beginFrame(const glm::mat4& viewProjection);
+
+	// Transform, Clip and Bin an Occluder's Triangles
+	// -----------------------------------------------
+	void addOccluder(const glm::vec3* positions, size_t vertexCount, const uint32_t* indices, size_t indexCount, const glm::mat4& model);
+
+	// Clear and Rasterize Every Tile Across the Job System
+	// ---------------------------------------------------
+	void rasterize(JobSystem& jobs);
+
+	// False Only if the Box is Off Screen or Entirely Behind Rasterized Occluders
+	// ---------------------------------------------------------------------------
+	bool isVisible(const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::mat4& model) const;
+
+	size_t triangleCount() const { return mTriangles.size(); }
+
+	// Depth at a Buffer Pixel, Row 0 at the Bottom; 1 Where Nothing was Drawn
+	// -----------------------------------------------------------------------
+	float depthAt(int x, int y) const;
+
+private:
+	// Front-Facing Triangle in Buffer Pixels with NDC Depth; Edge Functions are Positive Inside
+	// -----------------------------------------------------------------------------------------
+	struct ScreenTriangle
+	{
+		float x[3];
+		float y[3];
+		float z[3];
+	};
+
+	void addTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+	void rasterizeTile(int tile) const;
+	float* tileDepth(int tile) const { return mDepth.data() + static_cast<size_t>(tile) * TILE_WIDTH * TILE_HEIGHT; }
+
+	glm::mat4 mViewProjection;
+	std::vector<glm::vec4> mClipPositions;           // Reused Per Occluder
+	std::vector<ScreenTriangle> mTriangles;
+	std::vector<std::vector<uint32_t>> mBins;        // Triangle Indices Overlapping Each Tile
+	mutable std::vector<float> mDepth;               // Tile-Major: Each Tile's Pixels are Contiguous
+	mutable std::vector<float> mTileMaxDepth;        // Farthest Depth Any Pixel of Each Tile Can Hold
+};
@@ -0,0 +1,234 @@
+#include "PostProcessChain.h"
+
+#include <algorithm>   // max
+#include <iostream>    // cerr
+
+#include "ShaderUniforms.h"
+
+using namespace std;
+
+bool PostProcessChain::create(RenderBackend& backend)
+{
+	mBackend = &backend;
+	mFullscreenInput = backend.createVertexInput(VertexLayout(), 0, 0);
+	mPool.create(backend);
+	for (TimestampId* timestamps : mTimestamps)
+		for (int i = 0; i <= MAX_PASSES; ++i)
+			timestamps[i] = backend.createTimestamp();
+	for (int& passes : mQueryPasses)
+		passes = 0;
+	mFrame = 0;
+
+	return true;
+}
+
+void PostProcessChain::destroy()
+{
+	if (!mBackend)
+		return;
+
+	mBackend->destroyRenderTarget(mSceneTarget);
+	mPool.destroy();
+	for (const Pass& pass : mPasses)
+		mBackend->destroyPipeline(pass.pipeline);
+	mPasses.clear();
+	mSceneColor = mSceneDepth = RenderTarget();
+	mSceneTarget = mAttachedColor = mAttachedDepth = 0;
+
+	for (TimestampId* timestamps : mTimestamps)
+		for (int i = 0; i <= MAX_PASSES; ++i)
+		{
+			mBackend->destroyTimestamp(timestamps[i]);
+			timestamps[i] = 0;
+		}
+	mBackend->destroyVertexInput(mFullscreenInput);
+	mFullscreenInput = 0;
+}
+
+bool PostProcessChain::addPass(const char* name, ProgramId program, int divisor, TextureFormat format, SetUniforms setUniforms)
+{
+	// Error Check: Pass Limit and Resolution Divisor
+	// ----------------------------------------------
+	if (mPasses.size() >= static_cast<size_t>(MAX_PASSES) || (divisor != 1 && divisor != 2 && divisor != 4))
+	{
+		cerr << "ERROR::POST_PROCESS::INVALID_PASS " << name << endl;
+		return false;
+	}
+
+	Pass pass;
+	pass.name = name;
+	pass.program = program;
+	pass.divisor = divisor;
+	pass.format = format;
+	pass.setUniforms = setUniforms;
+	mPasses.push_back(pass);
+	return true;
+}
+
+bool PostProcessChain::beginScene(int width, int height)
+{
+	mSceneColor = mPool.acquire(width, height, SCENE_FORMAT);
+	mSceneDepth = mPool.acquire(width, height, SCENE_DEPTH_FORMAT);
+	if (!mSceneColor.texture || !mSceneDepth.texture)
+	{
+		mPool.release(mSceneColor);
+		mPool.release(mSceneDepth);
+		mSceneColor = mSceneDepth = RenderTarget();
+		return false;
+	}
+
+	// The Pool Usually Hands Back Last Frame's Targets, so this Rarely Runs
+	// ---------------------------------------------------------------------
+	if (mSceneColor.texture != mAttachedColor || mSceneDepth.texture != mAttachedDepth)
+	{
+		mBackend->destroyRenderTarget(mSceneTarget);
+		mSceneTarget = mBackend->createRenderTarget(&mSceneColor.texture, 1, mSceneDepth.texture);
+		mAttachedColor = mSceneColor.texture;
+		mAttachedDepth = mSceneDepth.texture;
+
+		// Error Check: Scene Target Completeness
+		// --------------------------------------
+		if (!mSceneTarget)
+		{
+			cerr << "ERROR::POST_PROCESS::SCENE_TARGET_INCOMPLETE " << width << "x" << height << endl;
+			mPool.release(mSceneColor);
+			mPool.release(mSceneDepth);
+			mSceneColor = mSceneDepth = RenderTarget();
+			mAttachedColor = mAttachedDepth = 0;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void PostProcessChain::apply(RenderTargetId output)
+{
+	if (!mSceneColor.texture)
+		return;
+
+	const int slot = mFrame % QUERY_COUNT;
+	readTimings(slot);
+
+	const int width = mSceneColor.width;
+	const int height = mSceneColor.height;
+
+	// No Passes: Copy the Scene Straight Through
+	// ------------------------------------------
+	if (mPasses.empty())
+		mBackend->blitRenderTarget(mSceneTarget, width, height, output, width, height);
+
+	mBackend->writeTimestamp(mTimestamps[slot][0]);
+
+	RenderTarget source = mSceneColor;
+	int timedPasses = 0;
+	for (size_t i = 0; i < mPasses.size(); ++i)
+	{
+		Pass& pass = mPasses[i];
+
+		// The Last Pass Writes the Output at Scene Size; the Rest Write Pooled Targets
+		// ----------------------------------------------------------------------------
+		RenderTarget target;
+		RenderTargetId passTarget = output;
+		int passWidth = width;
+		int passHeight = height;
+		if (i + 1 < mPasses.size())
+		{
+			target = mPool.acquire(max(1, (width + pass.divisor - 1) / pass.divisor), max(1, (height + pass.divisor - 1) / pass.divisor), pass.format);
+			if (!target.target)
+				break;
+
+			passTarget = target.target;
+			passWidth = target.width;
+			passHeight = target.height;
+		}
+
+		// Full-Screen Triangle; Every Pixel is Written, so Nothing is Cleared
+		// -------------------------------------------------------------------
+		if (!pass.pipeline)
+		{
+			PipelineDesc desc;
+			desc.program = pass.program;
+			desc.uniforms = Uniform::NAMES;
+			desc.uniformCount = Uniform::Count;
+			desc.depthTest = false;
+			pass.pipeline = mBackend->createPipeline(desc);
+		}
+
+		mCommands.reset();
+		mCommands.bindPipeline(pass.pipeline);
+		mCommands.bindTexture(SOURCE_UNIT, source.texture);
+		mCommands.bindTexture(SCENE_UNIT, mSceneColor.texture);
+		mCommands.setUniform(Uniform::Source, SOURCE_UNIT);
+		mCommands.setUniform(Uniform::Scene, SCENE_UNIT);
+		if (pass.setUniforms)
+			pass.setUniforms(mCommands);
+		mCommands.bindVertexInput(mFullscreenInput);
+		mCommands.draw(3);
+
+		PassDesc backendPass;
+		backendPass.target = passTarget;
+		backendPass.width = passWidth;
+		backendPass.height = passHeight;
+		mBackend->beginPass(backendPass);
+		mBackend->submit(&mCommands, 1);
+		mBackend->endPass();
+		mBackend->writeTimestamp(mTimestamps[slot][++timedPasses]);
+
+		// The Input is Free Once Read, so the Next Pass can Reuse it
+		// ----------------------------------------------------------
+		if (source.texture != mSceneColor.texture)
+			mPool.release(source);
+		source = target;
+	}
+	mQueryPasses[slot] = timedPasses;
+
+	// Hand the Frame's Targets Back for the Next Frame
+	// ------------------------------------------------
+	if (source.texture)
+		mPool.release(source);
+	mPool.release(mSceneColor);
+	mPool.release(mSceneDepth);
+	mSceneColor = mSceneDepth = RenderTarget();
+	mPool.endFrame();
+	++mFrame;
+}
+
+// Accumulate a Finished Frame's Pass Times; Never Wait if the Driver Lags Further
+// -------------------------------------------------------------------------------
+void PostProcessChain::readTimings(int slot)
+{
+	const int passes = mQueryPasses[slot];
+	mQueryPasses[slot] = 0;
+	if (passes == 0)
+		return;
+
+	uint64_t previous = 0;
+	if (!mBackend->timestampResult(mTimestamps[slot][passes], false, previous))
+		return;
+
+	mBackend->timestampResult(mTimestamps[slot][0], true, previous);
+	for (int i = 0; i < passes && i < static_cast<int>(mPasses.size()); ++i)
+	{
+		uint64_t end = 0;
+		mBackend->timestampResult(mTimestamps[slot][i + 1], true, end);
+		mPasses[i].totalMilliseconds += (end - previous) * 1e-6;
+		++mPasses[i].samples;
+		previous = end;
+	}
+}
+
+float PostProcessChain::passMilliseconds(size_t pass) const
+{
+	const Pass& timed = mPasses[pass];
+	return timed.samples ? static_cast<float>(timed.totalMilliseconds / timed.samples) : 0.0f;
+}
+
+void PostProcessChain::resetTimings()
+{
+	for (Pass& pass : mPasses)
+	{
+		pass.totalMilliseconds = 0.0;
+		pass.samples = 0;
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <functional>     // std::function
+#include <string>         // string
+#include <vector>         // vector
+
+#include "RenderBackend.h"
+#include "RenderTargetPool.h"
+
+// Post-Processing Chain of Full-Screen Passes
+// -------------------------------------------
+// The camera passes draw into an HDR scene target taken from the pool, then each pass runs
+// in the order it was added: it reads the previous pass's output (the scene for the first
+// pass) as uSource and the scene itself as uScene, and writes a pooled target of its own
+// format at 1/divisor of the scene size, so expensive effects can run at half or quarter
+// resolution. The last pass writes straight into the output target at the scene size.
+// Each pass is one backend pass with its own depth-less pipeline, made on its first run.
+// A pass's input is released as soon as the next pass has read it, so passes with the same
+// size and format ping-pong between two targets. Each pass is bracketed by backend
+// timestamps read QUERY_COUNT frames later, and its average GPU time is kept until
+// resetTimings().
+class PostProcessChain
+{
+public:
+	static const int32_t SOURCE_UNIT = 0;
+	static const int32_t SCENE_UNIT = 1;
+	static const TextureFormat SCENE_FORMAT = TextureFormat::RGBA16F;
+	static const TextureFormat SCENE_DEPTH_FORMAT = TextureFormat::Depth24;
+	static const int MAX_PASSES = 8;
+	static const int QUERY_COUNT = 4;
+
+	// Records a Pass's Own Uniforms; its Pipeline is Already Bound
+	// ------------------------------------------------------------
+	using SetUniforms = std::function<void(CommandList& commands)>;
+
+	bool create(RenderBackend& backend);
+	void destroy();
+
+	// Append a Pass; divisor is 1, 2 or 4 for Full, Half or Quarter Resolution
+	// ------------------------------------------------------------------------
+	bool addPass(const char* name, ProgramId program, int divisor, TextureFormat format, SetUniforms setUniforms = nullptr);
+
+	// Acquire this Frame's width x height Scene Target for the Camera Passes to Draw Into
+	// -----------------------------------------------------------------------------------
+	bool beginScene(int width, int height);
+	RenderTargetId sceneTarget() const { return mSceneTarget; }
+
+	// Run Every Pass, Write the Result into output and Release the Frame's Targets
+	// ----------------------------------------------------------------------------
+	void apply(RenderTargetId output);
+
+	size_t passCount() const { return mPasses.size(); }
+	const std::string& passName(size_t pass) const { return mPasses[pass].name; }
+	float passMilliseconds(size_t pass) const;   // Average Since the Last resetTimings()
+	void resetTimings();
+
+	const RenderTargetPool& pool() const { return mPool; }
+
+private:
+	struct Pass
+	{
+		std::string name;
+		ProgramId program = 0;
+		PipelineId pipeline = 0;
+		int divisor = 1;
+		TextureFormat format = TextureFormat::RGBA8;
+		SetUniforms setUniforms;
+		double totalMilliseconds = 0.0;
+		int samples = 0;
+	};
+
+	void readTimings(int slot);
+
+	std::vector<Pass> mPasses;
+	RenderTargetPool mPool;
+
+	RenderTarget mSceneColor;
+	RenderTarget mSceneDepth;
+	RenderTargetId mSceneTarget = 0;   // Pooled Color and Depth, Remade Only When they Change
+	TextureId mAttachedColor = 0;
+	TextureId mAttachedDepth = 0;
+	RenderBackend* mBackend = nullptr;
+	VertexInputId mFullscreenInput = 0;   // Attribute-Less; the Vertex Shader Makes the Triangle
+	CommandList mCommands;
+
+	TimestampId mTimestamps[QUERY_COUNT][MAX_PASSES + 1] = {};   // Before, Between and After the Passes
+	int mQueryPasses[QUERY_COUNT] = {};                           // Passes Timed in Each Slot; Zero if None in Flight
+	int mFrame = 0;
+};
@@ -0,0 +1,321 @@
+#pragma once
+
+// Includes
+// -------
+#include <array>          // array
+#include <cstddef>        // size_t
+#include <cstdint>        // uint32_t
+
+// Compile-Time Procedural Meshes
+// ------------------------------
+// makeBox(), makePlane(), makeCylinder() and makeSphere() are constexpr, so a mesh declared
+// as "static constexpr auto" is generated by the compiler and lands in read-only data with
+// no start-up cost. Subdivision counts are template parameters because they size the
+// tables; dimensions are ordinary arguments. The vertex format is a template parameter
+// too: it builds a vertex from a position, normal and UV through make() and lists its
+// attributes so the VAO can be set up from the same description. Triangles wind counter-
+// clockwise seen from outside, matching the face normals.
+
+// Constexpr Math: <cmath> is not constexpr, so Sine and Cosine are Taylor Series
+// -----------------------------------------------------------------------------
+namespace PrimitiveMath
+{
+	constexpr float PI = 3.14159265358979f;
+
+	constexpr float sin(float x)
+	{
+		// Reduce to [-PI, PI], Where 11 Terms are Accurate to Float Precision
+		// -------------------------------------------------------------------
+		long turns = static_cast<long>(x / (2.0f * PI) + (x < 0.0f ? -0.5f : 0.5f));
+		x -= static_cast<float>(turns) * 2.0f * PI;
+
+		float term = x;
+		float sum = x;
+		for (int n = 1; n <= 11; ++n)
+		{
+			term *= -x * x / static_cast<float>((2 * n) * (2 * n + 1));
+			sum += term;
+		}
+		return sum;
+	}
+
+	constexpr float cos(float x)
+	{
+		return sin(x + PI * 0.5f);
+	}
+}
+
+// Attribute of a Vertex Format: Shader Location, Component Count and Byte Offset; Components
+// are Floats Unless they are Unsigned Bytes Read as [0, 1]
+// ------------------------------------------------------------------------------------------
+struct VertexAttribute
+{
+	unsigned location;
+	int components;
+	size_t offset;
+	bool normalizedBytes = false;
+};
+
+// Vertex Format of the Scene Shaders: Locations 0, 1 and 2
+// --------------------------------------------------------
+struct PositionNormalUV
+{
+	float position[3] = {};
+	float normal[3] = {};
+	float uv[2] = {};
+
+	static constexpr size_t ATTRIBUTE_COUNT = 3;
+	static constexpr VertexAttribute ATTRIBUTES[ATTRIBUTE_COUNT] =
+	{
+		{ 0, 3, 0 },
+		{ 1, 3, sizeof(float) * 3 },
+		{ 2, 2, sizeof(float) * 6 }
+	};
+
+	static constexpr PositionNormalUV make(float x, float y, float z, float nx, float ny, float nz, float u, float v)
+	{
+		PositionNormalUV vertex;
+		vertex.position[0] = x; vertex.position[1] = y; vertex.position[2] = z;
+		vertex.normal[0] = nx; vertex.normal[1] = ny; vertex.normal[2] = nz;
+		vertex.uv[0] = u; vertex.uv[1] = v;
+		return vertex;
+	}
+};
+
+// Vertex Format for Depth-Only Passes: Location 0
+// -----------------------------------------------
+struct PositionOnly
+{
+	float position[3] = {};
+
+	static constexpr size_t ATTRIBUTE_COUNT = 1;
+	static constexpr VertexAttribute ATTRIBUTES[ATTRIBUTE_COUNT] =
+	{
+		{ 0, 3, 0 }
+	};
+
+	static constexpr PositionOnly make(float x, float y, float z, float, float, float, float, float)
+	{
+		PositionOnly vertex;
+		vertex.position[0] = x; vertex.position[1] = y; vertex.position[2] = z;
+		return vertex;
+	}
+};
+
+// Generated Vertex and Index Tables
+// ---------------------------------
+template <typename Vertex, size_t VertexCount, size_t IndexCount>
+struct PrimitiveMesh
+{
+	std::array<Vertex, VertexCount> vertices = {};
+	std::array<uint32_t, IndexCount> indices = {};
+};
+
+// Box from the Origin to (width, height, depth); Each Face is Subdivisions x Subdivisions Quads
+// ---------------------------------------------------------------------------------------------
+template <typename Vertex, size_t Subdivisions = 1>
+constexpr PrimitiveMesh<Vertex, 6 * (Subdivisions + 1) * (Subdivisions + 1), 36 * Subdivisions * Subdivisions>
+	makeBox(float width, float height, float depth)
+{
+	// Per Face: Corner, U and V Edges of the Unit Cube, with cross(U, V) the Outward Normal
+	// -------------------------------------------------------------------------------------
+	constexpr float faces[6][9] =
+	{
+		{ 1, 0, 1,    0, 0, -1,   0, 1, 0 },    // +X
+		{ 0, 0, 0,    0, 0, 1,    0, 1, 0 },    // -X
+		{ 0, 1, 1,    1, 0, 0,    0, 0, -1 },   // +Y
+		{ 0, 0, 0,    1, 0, 0,    0, 0, 1 },    // -Y
+		{ 0, 0, 1,    1, 0, 0,    0, 1, 0 },    // +Z
+		{ 1, 0, 0,    -1, 0, 0,   0, 1, 0 }     // -Z
+	};
+	const size_t row = Subdivisions + 1;
+
+	PrimitiveMesh<Vertex, 6 * (Subdivisions + 1) * (Subdivisions + 1), 36 * Subdivisions * Subdivisions> mesh;
+	size_t vertex = 0;
+	size_t index = 0;
+
+	for (size_t face = 0; face < 6; ++face)
+	{
+		const float* f = faces[face];
+		const float nx = f[4] * f[8] - f[5] * f[7];
+		const float ny = f[5] * f[6] - f[3] * f[8];
+		const float nz = f[3] * f[7] - f[4] * f[6];
+		const uint32_t base = static_cast<uint32_t>(vertex);
+
+		for (size_t j = 0; j < row; ++j)
+		{
+			for (size_t i = 0; i < row; ++i)
+			{
+				const float u = static_cast<float>(i) / Subdivisions;
+				const float v = static_cast<float>(j) / Subdivisions;
+				mesh.vertices[vertex++] = Vertex::make(
+					(f[0] + f[3] * u + f[6] * v) * width,
+					(f[1] + f[4] * u + f[7] * v) * height,
+					(f[2] + f[5] * u + f[8] * v) * depth,
+					nx, ny, nz, u, v);
+			}
+		}
+
+		for (size_t j = 0; j < Subdivisions; ++j)
+		{
+			for (size_t i = 0; i < Subdivisions; ++i)
+			{
+				const uint32_t a = base + static_cast<uint32_t>(j * row + i);
+				const uint32_t c = a + static_cast<uint32_t>(row);
+				mesh.indices[index++] = a; mesh.indices[index++] = a + 1; mesh.indices[index++] = c + 1;
+				mesh.indices[index++] = a; mesh.indices[index++] = c + 1; mesh.indices[index++] = c;
+			}
+		}
+	}
+
+	return mesh;
+}
+
+// Plane on XZ Centered at the Origin, Facing +Y
+// ---------------------------------------------
+template <typename Vertex, size_t Subdivisions = 1>
+constexpr PrimitiveMesh<Vertex, (Subdivisions + 1) * (Subdivisions + 1), 6 * Subdivisions * Subdivisions>
+	makePlane(float width, float depth)
+{
+	const size_t row = Subdivisions + 1;
+
+	PrimitiveMesh<Vertex, (Subdivisions + 1) * (Subdivisions + 1), 6 * Subdivisions * Subdivisions> mesh;
+	size_t vertex = 0;
+	size_t index = 0;
+
+	for (size_t j = 0; j < row; ++j)
+	{
+		for (size_t i = 0; i < row; ++i)
+		{
+			const float u = static_cast<float>(i) / Subdivisions;
+			const float v = static_cast<float>(j) / Subdivisions;
+			mesh.vertices[vertex++] = Vertex::make((u - 0.5f) * width, 0.0f, (0.5f - v) * depth, 0.0f, 1.0f, 0.0f, u, 1.0f - v);
+		}
+	}
+
+	for (size_t j = 0; j < Subdivisions; ++j)
+	{
+		for (size_t i = 0; i < Subdivisions; ++i)
+		{
+			const uint32_t a = static_cast<uint32_t>(j * row + i);
+			const uint32_t c = a + static_cast<uint32_t>(row);
+			mesh.indices[index++] = a; mesh.indices[index++] = a + 1; mesh.indices[index++] = c + 1;
+			mesh.indices[index++] = a; mesh.indices[index++] = c + 1; mesh.indices[index++] = c;
+		}
+	}
+
+	return mesh;
+}
+
+// Capped Cylinder Along Y, Centered at the Origin
+// -----------------------------------------------
+template <typename Vertex, size_t Segments = 32, size_t Stacks = 1>
+constexpr PrimitiveMesh<Vertex, (Segments + 1) * (Stacks + 1) + 2 * (Segments + 2), 6 * Segments * Stacks + 6 * Segments>
+	makeCylinder(float radius, float height)
+{
+	const size_t row = Segments + 1;
+
+	PrimitiveMesh<Vertex, (Segments + 1) * (Stacks + 1) + 2 * (Segments + 2), 6 * Segments * Stacks + 6 * Segments> mesh;
+	size_t vertex = 0;
+	size_t index = 0;
+
+	// Side: the Seam Column is Duplicated so U Runs from 0 to 1
+	// ---------------------------------------------------------
+	for (size_t j = 0; j <= Stacks; ++j)
+	{
+		for (size_t i = 0; i < row; ++i)
+		{
+			const float u = static_cast<float>(i) / Segments;
+			const float v = static_cast<float>(j) / Stacks;
+			const float s = PrimitiveMath::sin(u * 2.0f * PrimitiveMath::PI);
+			const float c = PrimitiveMath::cos(u * 2.0f * PrimitiveMath::PI);
+			mesh.vertices[vertex++] = Vertex::make(radius * s, (v - 0.5f) * height, radius * c, s, 0.0f, c, u, v);
+		}
+	}
+
+	for (size_t j = 0; j < Stacks; ++j)
+	{
+		for (size_t i = 0; i < Segments; ++i)
+		{
+			const uint32_t a = static_cast<uint32_t>(j * row + i);
+			const uint32_t c = a + static_cast<uint32_t>(row);
+			mesh.indices[index++] = a; mesh.indices[index++] = a + 1; mesh.indices[index++] = c + 1;
+			mesh.indices[index++] = a; mesh.indices[index++] = c + 1; mesh.indices[index++] = c;
+		}
+	}
+
+	// Caps: a Center Vertex and a Ring with the Cap's Flat Normal
+	// -----------------------------------------------------------
+	for (int cap = 0; cap < 2; ++cap)
+	{
+		const float ny = cap == 0 ? 1.0f : -1.0f;
+		const uint32_t center = static_cast<uint32_t>(vertex);
+		mesh.vertices[vertex++] = Vertex::make(0.0f, ny * height * 0.5f, 0.0f, 0.0f, ny, 0.0f, 0.5f, 0.5f);
+
+		for (size_t i = 0; i < row; ++i)
+		{
+			const float angle = static_cast<float>(i) / Segments * 2.0f * PrimitiveMath::PI;
+			const float s = PrimitiveMath::sin(angle);
+			const float c = PrimitiveMath::cos(angle);
+			mesh.vertices[vertex++] = Vertex::make(radius * s, ny * height * 0.5f, radius * c, 0.0f, ny, 0.0f, 0.5f + 0.5f * s, 0.5f + 0.5f * c);
+		}
+
+		for (uint32_t i = 0; i < Segments; ++i)
+		{
+			mesh.indices[index++] = center;
+			mesh.indices[index++] = center + 1 + (cap == 0 ? i : i + 1);
+			mesh.indices[index++] = center + 1 + (cap == 0 ? i + 1 : i);
+		}
+	}
+
+	return mesh;
+}
+
+// UV Sphere Centered at the Origin; the Pole Rows Emit One Triangle per Segment
+// -----------------------------------------------------------------------------
+template <typename Vertex, size_t Segments = 32, size_t Rings = 16>
+constexpr PrimitiveMesh<Vertex, (Segments + 1) * (Rings + 1), 6 * Segments * (Rings - 1)>
+	makeSphere(float radius)
+{
+	static_assert(Rings >= 2, "A sphere needs at least two rings");
+	const size_t row = Segments + 1;
+
+	PrimitiveMesh<Vertex, (Segments + 1) * (Rings + 1), 6 * Segments * (Rings - 1)> mesh;
+	size_t vertex = 0;
+	size_t index = 0;
+
+	for (size_t j = 0; j <= Rings; ++j)
+	{
+		const float v = static_cast<float>(j) / Rings;
+		const float ringSin = PrimitiveMath::sin(v * PrimitiveMath::PI);
+		const float ringCos = PrimitiveMath::cos(v * PrimitiveMath::PI);
+
+		for (size_t i = 0; i < row; ++i)
+		{
+			const float u = static_cast<float>(i) / Segments;
+			const float x = ringSin * PrimitiveMath::sin(u * 2.0f * PrimitiveMath::PI);
+			const float z = ringSin * PrimitiveMath::cos(u * 2.0f * PrimitiveMath::PI);
+			mesh.vertices[vertex++] = Vertex::make(radius * x, radius * ringCos, radius * z, x, ringCos, z, u, v);
+		}
+	}
+
+	for (size_t j = 0; j < Rings; ++j)
+	{
+		for (size_t i = 0; i < Segments; ++i)
+		{
+			const uint32_t a = static_cast<uint32_t>(j * row + i);
+			const uint32_t c = a + static_cast<uint32_t>(row);
+
+			if (j != Rings - 1)
+			{
+				mesh.indices[index++] = a; mesh.indices[index++] = c; mesh.indices[index++] = c + 1;
+			}
+			if (j != 0)
+			{
+				mesh.indices[index++] = a; mesh.indices[index++] = c + 1; mesh.indices[index++] = a + 1;
+			}
+		}
+	}
+
+	return mesh;
+}
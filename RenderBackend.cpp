@@ -0,0 +1,187 @@
+#include "RenderBackend.h"
+
+#include <cstring>     // memcpy
+#include <glm/gtc/type_ptr.hpp>
+
+using namespace std;
+using namespace glm;
+
+void CommandList::reset()
+{
+	mWords.clear();
+	mDrawCount = 0;
+}
+
+void CommandList::append(const CommandList& commands)
+{
+	mWords.insert(mWords.end(), commands.mWords.begin(), commands.mWords.end());
+	mDrawCount += commands.mDrawCount;
+}
+
+void CommandList::bindPipeline(PipelineId pipeline)
+{
+	push(Op::BindPipeline);
+	mWords.push_back(pipeline);
+}
+
+void CommandList::bindVertexInput(VertexInputId vertexInput, IndexType indexType)
+{
+	push(Op::BindVertexInput);
+	mWords.push_back(vertexInput);
+	mWords.push_back(static_cast<uint32_t>(indexType));
+}
+
+void CommandList::bindVertexBuffer(BufferId buffer, uint32_t offset)
+{
+	push(Op::BindVertexBuffer);
+	mWords.push_back(buffer);
+	mWords.push_back(offset);
+}
+
+void CommandList::bindTexture(uint32_t unit, TextureId texture)
+{
+	push(Op::BindTexture);
+	mWords.push_back(unit);
+	mWords.push_back(texture);
+}
+
+void CommandList::bindStorageBuffer(uint32_t binding, BufferId buffer, uint32_t offset, uint32_t size)
+{
+	push(Op::BindStorageBuffer);
+	mWords.push_back(binding);
+	mWords.push_back(buffer);
+	mWords.push_back(offset);
+	mWords.push_back(size);
+}
+
+void CommandList::setViewports(const float* viewports, uint32_t count)
+{
+	push(Op::SetViewports);
+	mWords.push_back(count);
+	pushFloats(viewports, 4 * count);
+}
+
+void CommandList::setUniform(uint32_t slot, int32_t value)
+{
+	push(Op::SetInt);
+	mWords.push_back(slot);
+	mWords.push_back(static_cast<uint32_t>(value));
+}
+
+void CommandList::setUniform(uint32_t slot, uint32_t value)
+{
+	push(Op::SetUInt);
+	mWords.push_back(slot);
+	mWords.push_back(value);
+}
+
+void CommandList::setUniform(uint32_t slot, const uvec3& value)
+{
+	push(Op::SetUVec3);
+	mWords.push_back(slot);
+	mWords.insert(mWords.end(), { value.x, value.y, value.z });
+}
+
+void CommandList::setUniform(uint32_t slot, float value)
+{
+	pushUniform(Op::SetFloat, slot, &value, 1, 1);
+}
+
+void CommandList::setUniform(uint32_t slot, const vec2& value)
+{
+	pushUniform(Op::SetVec2, slot, value_ptr(value), 1, 2);
+}
+
+void CommandList::setUniform(uint32_t slot, const vec3& value)
+{
+	pushUniform(Op::SetVec3, slot, value_ptr(value), 1, 3);
+}
+
+void CommandList::setUniform(uint32_t slot, const vec4& value)
+{
+	pushUniform(Op::SetVec4, slot, value_ptr(value), 1, 4);
+}
+
+void CommandList::setUniform(uint32_t slot, const mat3& value)
+{
+	pushUniform(Op::SetMat3, slot, value_ptr(value), 1, 9);
+}
+
+void CommandList::setUniform(uint32_t slot, const mat4& value)
+{
+	pushUniform(Op::SetMat4, slot, value_ptr(value), 1, 16);
+}
+
+void CommandList::setUniform(uint32_t slot, const vec3* values, uint32_t count)
+{
+	pushUniform(Op::SetVec3, slot, value_ptr(values[0]), count, 3);
+}
+
+void CommandList::setUniform(uint32_t slot, const mat4* values, uint32_t count)
+{
+	pushUniform(Op::SetMat4, slot, value_ptr(values[0]), count, 16);
+}
+
+void CommandList::draw(uint32_t vertexCount, uint32_t firstVertex, uint32_t instanceCount)
+{
+	push(Op::Draw);
+	mWords.push_back(vertexCount);
+	mWords.push_back(firstVertex);
+	mWords.push_back(instanceCount);
+	++mDrawCount;
+}
+
+void CommandList::drawIndexed(uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount)
+{
+	push(Op::DrawIndexed);
+	mWords.push_back(indexCount);
+	mWords.push_back(firstIndex);
+	mWords.push_back(instanceCount);
+	++mDrawCount;
+}
+
+void CommandList::beginRanges()
+{
+	push(Op::DrawIndexedRanges);
+	mRangeHeader = mWords.size();
+	mWords.push_back(0);
+}
+
+void CommandList::addRange(uint32_t indexCount, uint32_t firstIndex)
+{
+	uint32_t& rangeCount = mWords[mRangeHeader];
+	if (rangeCount > 0 && mWords[mWords.size() - 1] + mWords[mWords.size() - 2] == firstIndex)
+	{
+		mWords[mWords.size() - 2] += indexCount;
+		return;
+	}
+
+	++rangeCount;
+	mWords.push_back(indexCount);
+	mWords.push_back(firstIndex);
+}
+
+void CommandList::endRanges()
+{
+	if (mWords[mRangeHeader] == 0)
+		mWords.resize(mRangeHeader - 1);
+	else
+		++mDrawCount;
+}
+
+// Arrays are Consecutive Values in the Words, the Layout of the glm Types they Came From
+// --------------------------------------------------------------------------------------
+void CommandList::pushUniform(Op op, uint32_t slot, const float* values, uint32_t count, size_t floatsPerValue)
+{
+	push(op);
+	mWords.push_back(slot);
+	mWords.push_back(count);
+	pushFloats(values, count * floatsPerValue);
+}
+
+void CommandList::pushFloats(const float* values, size_t count)
+{
+	const size_t start = mWords.size();
+	mWords.resize(start + count);
+	memcpy(mWords.data() + start, values, count * sizeof(float));
+}
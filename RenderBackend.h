@@ -0,0 +1,304 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <cstdint>        // uint32_t
+#include <vector>         // vector
+#include <glm/glm.hpp>
+
+#include "Primitives.h"   // VertexAttribute
+
+// Backend Object Handles; Zero is No Object. Each Backend Picks its Own Values, and the GL
+// Backend Hands Out the GL Object Names
+// ----------------------------------------------------------------------------------------
+typedef uint32_t BufferId;
+typedef uint32_t TextureId;
+typedef uint32_t VertexInputId;   // Vertex Layout with its Vertex and Index Buffers
+typedef uint32_t ProgramId;       // Vertex and Fragment Stages Linked Together
+typedef uint32_t PipelineId;      // Linked Program, its Fixed-Function State and Uniform Slots
+typedef uint32_t RenderTargetId;  // Framebuffer a Pass Draws Into; Zero is the Window
+typedef uint32_t FenceId;         // Marks the Point in the Submitted Work the CPU Waits For
+typedef uint32_t TimestampId;     // GPU Clock Reading Taken Between Passes
+
+enum class BufferType { Vertex, Index, Stream, Readback };   // Stream Buffers Stay Mapped for Writing, Readback Buffers for Reading
+enum class IndexType { UInt16, UInt32 };
+enum class TextureFormat { R8, RGB8, RGBA8, RGBA16F, RG16UI, Depth24, Depth32F };   // RGBA16F Takes Float Pixels
+enum class TextureFilter { Nearest, Linear, Trilinear };   // Trilinear Blends the Two Nearest Mip Levels
+enum class TextureWrap { Repeat, ClampToEdge };
+enum class Topology { Triangles, Lines };
+enum class DepthCompare { Less, Always };
+
+// Interleaved Attributes in One Vertex Buffer
+// -------------------------------------------
+struct VertexLayout
+{
+	static const size_t MAX_ATTRIBUTES = 4;
+
+	VertexAttribute attributes[MAX_ATTRIBUTES];
+	size_t attributeCount = 0;
+	uint32_t stride = 0;   // Bytes
+};
+
+// Sampled 2D Texture, with a Full Mip Chain Generated from the Pixels when Asked; with
+// levels Set, it is Created Empty with that Many Levels for updateTexture(). RG16UI is
+// an Integer Format: Render Targets Only, Read Back Rather than Sampled
+// ------------------------------------------------------------------------------------
+struct TextureDesc
+{
+	int width = 0;
+	int height = 0;
+	TextureFormat format = TextureFormat::RGBA8;
+	TextureFilter filter = TextureFilter::Linear;
+	TextureWrap wrap = TextureWrap::Repeat;
+	bool mipmaps = true;
+	int levels = 0;
+	bool shadowCompare = false;   // Depth Formats: Samples Return the Less-or-Equal Test Against the Reference
+	bool renderTarget = false;    // Attached to a Render Target, and Counted as One
+};
+
+// A Program with the State it Draws With. Uniforms are Named Once in a Table and Addressed
+// by their Index (their Slot) while Recording; Pipelines Built from the Same Table Share
+// Slots, and Setting a Slot the Program Does Not Use Does Nothing
+// ----------------------------------------------------------------------------------------
+struct PipelineDesc
+{
+	ProgramId program = 0;                     // Linked Program the Backend Compiled
+	const char* const* uniforms = nullptr;     // Slot Names
+	size_t uniformCount = 0;
+
+	Topology topology = Topology::Triangles;
+	bool depthTest = true;                     // Passing Fragments Write Depth
+	DepthCompare depthCompare = DepthCompare::Less;
+	bool alphaBlend = false;                   // Source Alpha Over the Target
+	float depthBiasSlope = 0.0f;               // Polygon Offset; Both Zero Turns it Off
+	float depthBiasConstant = 0.0f;
+	bool alwaysFilled = false;                 // Ignores setWireframe()
+};
+
+// Target, Viewport and Clears of a Pass; Clears Only Touch the Viewport, and Set Every Color
+// of the Target (Integer Colors to the Color Converted to Integers)
+// ------------------------------------------------------------------------------------------
+struct PassDesc
+{
+	RenderTargetId target = 0;
+	int x = 0;
+	int y = 0;
+	int width = 0;
+	int height = 0;
+	bool clearColor = false;
+	glm::vec4 color = glm::vec4(0.0f);
+	bool clearDepth = false;
+};
+
+// Recorded Draw Commands
+// ----------------------
+// A CommandList only appends packed words to an array that keeps its capacity, so any
+// thread can record one while other threads record theirs, without touching the API.
+// The backend's submit() then executes the lists in the order given, on the thread that
+// owns the device. Lists recorded in parallel over consecutive object ranges and submitted
+// in range order issue exactly the draws one thread would have, so the frame is unchanged.
+// Each list starts with nothing bound: it binds its own pipeline, inputs and textures and
+// sets every uniform it reads, so no list depends on state another list left behind.
+class CommandList
+{
+public:
+	enum class Op : uint32_t
+	{
+		BindPipeline,        // PipelineId
+		BindVertexInput,     // VertexInputId, IndexType
+		BindVertexBuffer,    // BufferId, Offset
+		BindTexture,         // Unit, TextureId
+		BindStorageBuffer,   // Binding, BufferId, Offset, Size
+		SetViewports,        // Count, then x, y, Width and Height of Each as Floats
+		SetInt,              // Slot, Value
+		SetUInt,             // Slot, Value
+		SetUVec3,            // Slot, 3 Values
+		SetFloat,            // Slot, Count, Count Floats
+		SetVec2,             // Slot, Count, 2 * Count Floats
+		SetVec3,             // Slot, Count, 3 * Count Floats
+		SetVec4,             // Slot, Count, 4 * Count Floats
+		SetMat3,             // Slot, Count, 9 * Count Floats
+		SetMat4,             // Slot, Count, 16 * Count Floats
+		Draw,                // Vertex Count, First Vertex, Instance Count
+		DrawIndexed,         // Index Count, First Index, Instance Count
+		DrawIndexedRanges    // Range Count, then Count and First Index of Each Range
+	};
+
+	void reset();
+
+	// Copy Another List's Commands onto the End, Typically a Pass's Shared Setup
+	// --------------------------------------------------------------------------
+	void append(const CommandList& commands);
+
+	void bindPipeline(PipelineId pipeline);
+	void bindVertexInput(VertexInputId vertexInput, IndexType indexType = IndexType::UInt16);
+	void bindTexture(uint32_t unit, TextureId texture);
+
+	// Vertex Data for a Vertex Input Created Without Buffers, at its Layout's Stride
+	// ------------------------------------------------------------------------------
+	void bindVertexBuffer(BufferId buffer, uint32_t offset);
+
+	void bindStorageBuffer(uint32_t binding, BufferId buffer, uint32_t offset, uint32_t size);
+
+	// One Viewport per View, Picked by the Vertex Shader; the Pass's Viewport Otherwise
+	// ---------------------------------------------------------------------------------
+	void setViewports(const float* viewports, uint32_t count);
+
+	void setUniform(uint32_t slot, int32_t value);
+	void setUniform(uint32_t slot, uint32_t value);
+	void setUniform(uint32_t slot, const glm::uvec3& value);
+	void setUniform(uint32_t slot, float value);
+	void setUniform(uint32_t slot, const glm::vec2& value);
+	void setUniform(uint32_t slot, const glm::vec3& value);
+	void setUniform(uint32_t slot, const glm::vec4& value);
+	void setUniform(uint32_t slot, const glm::mat3& value);
+	void setUniform(uint32_t slot, const glm::mat4& value);
+	void setUniform(uint32_t slot, const glm::vec3* values, uint32_t count);
+	void setUniform(uint32_t slot, const glm::mat4* values, uint32_t count);
+
+	void draw(uint32_t vertexCount, uint32_t firstVertex = 0, uint32_t instanceCount = 1);
+	void drawIndexed(uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount = 1);
+
+	// Several Index Ranges of the Bound Vertex Input as One Draw; a Range Starting where the
+	// Last Ended Extends it, and a Draw that Gets No Ranges is Dropped
+	// --------------------------------------------------------------------------------------
+	void beginRanges();
+	void addRange(uint32_t indexCount, uint32_t firstIndex);
+	void endRanges();
+
+	const std::vector<uint32_t>& words() const { return mWords; }
+	size_t drawCount() const { return mDrawCount; }
+
+private:
+	void push(Op op) { mWords.push_back(static_cast<uint32_t>(op)); }
+	void pushFloats(const float* values, size_t count);
+	void pushUniform(Op op, uint32_t slot, const float* values, uint32_t count, size_t floatsPerValue);
+
+	std::vector<uint32_t> mWords;
+	size_t mDrawCount = 0;
+	size_t mRangeHeader = 0;   // Word Holding the Open Draw's Range Count
+};
+
+// Render Backend Interface
+// ------------------------
+// Creates the buffers, textures, vertex inputs and pipelines the frame draws with, and
+// executes recorded command lists inside passes, then presents the window target. Creation,
+// passes, submit() and present() run on the thread that owns the device (the GL context's
+// thread, or the thread that created the Vulkan device); only CommandList recording is
+// free-threaded.
+class RenderBackend
+{
+public:
+	static const size_t MAX_COLOR_TARGETS = 2;   // Colors One Render Target can Draw Into
+
+	virtual ~RenderBackend() {}
+
+	virtual const char* name() const = 0;
+
+	// Viewports One setViewports() can Give, with the Vertex Shader Picking One per Primitive;
+	// 1 Without that Support
+	// ----------------------------------------------------------------------------------------
+	virtual uint32_t maxViewports() const = 0;
+
+	virtual BufferId createBuffer(BufferType type, size_t size, const void* data) = 0;
+	virtual void destroyBuffer(BufferId buffer) = 0;
+
+	// Where the CPU Writes a Stream Buffer or Reads a Readback Buffer, Without a Copy: Ranges
+	// the GPU May Still Read are Only Rewritten Once a Fence Inserted After their Use has
+	// Passed, and Copied Bytes Only Arrive Once a Fence Inserted After the Copy has
+	// ---------------------------------------------------------------------------------------
+	virtual void* mappedData(BufferId buffer) = 0;
+
+	// Offsets of Storage Buffer Ranges are Multiples of this
+	// ------------------------------------------------------
+	virtual size_t storageBufferAlignment() const = 0;
+
+	// Error Check: waitFence() Returns False if the Work Before the Fence is Still Running
+	// after timeout Nanoseconds; Zero Only Polls
+	// ------------------------------------------------------------------------------------
+	virtual FenceId insertFence() = 0;
+	virtual bool waitFence(FenceId fence, uint64_t timeout) = 0;
+	virtual void destroyFence(FenceId fence) = 0;
+
+	// Start the Work Recorded So Far on the GPU Without Waiting for it
+	// ----------------------------------------------------------------
+	virtual void flush() = 0;
+
+	// Whether present() Waits for the Display's Refresh
+	// -------------------------------------------------
+	virtual void setVsync(bool enabled) = 0;
+
+	// GPU Clock Readings, Written Outside Passes; a Result is in Nanoseconds, Only Comparable
+	// to Readings of the Same Backend. Error Check: timestampResult() Returns False Until the
+	// Work Before the Reading has Finished, Unless wait is Set
+	// ---------------------------------------------------------------------------------------
+	virtual TimestampId createTimestamp() = 0;
+	virtual void destroyTimestamp(TimestampId timestamp) = 0;
+	virtual void writeTimestamp(TimestampId timestamp) = 0;
+	virtual bool timestampResult(TimestampId timestamp, bool wait, uint64_t& nanoseconds) = 0;
+
+	// Error Check: Returns Zero when the Format or Size Cannot be Created
+	// -------------------------------------------------------------------
+	virtual TextureId createTexture(const TextureDesc& desc, const void* pixels) = 0;
+	virtual void destroyTexture(TextureId texture) = 0;
+
+	// Fill a Whole Level of a Texture Created with levels, or Copy One Between Two Textures
+	// of the Same Format; Level Sizes Halve from the Created Size. Outside Passes Only
+	// -------------------------------------------------------------------------------------
+	virtual void updateTexture(TextureId texture, int level, const void* pixels) = 0;
+	virtual void copyTextureLevel(TextureId source, int sourceLevel, TextureId target, int targetLevel) = 0;
+
+	// Sampling Starts at level; the Finer Levels are Ignored, Filled or Not
+	// ---------------------------------------------------------------------
+	virtual void setTextureBaseLevel(TextureId texture, int level) = 0;
+
+	// Error Check: Returns Zero when the Textures Cannot be Drawn Into Together; Up to
+	// MAX_COLOR_TARGETS Colors, Written by the Fragment Outputs at their Indices, and the
+	// Depth may be Zero. Every Texture Needs renderTarget Set
+	// -----------------------------------------------------------------------------------
+	virtual RenderTargetId createRenderTarget(const TextureId* colors, size_t colorCount, TextureId depth) = 0;
+	virtual void destroyRenderTarget(RenderTargetId target) = 0;
+
+	// Scale the Lower-Left sourceWidth x sourceHeight of One Target's First Color onto the
+	// Lower-Left targetWidth x targetHeight of Another, Filtered Linearly when the Sizes
+	// Differ. Outside Passes Only
+	// ------------------------------------------------------------------------------------
+	virtual void blitRenderTarget(RenderTargetId source, int sourceWidth, int sourceHeight, RenderTargetId target, int targetWidth, int targetHeight) = 0;
+
+	// Copy the Lower-Left width x height of a Target's First Color into a Readback Buffer,
+	// Bottom Row First with Tightly Packed Rows; the Bytes are in mappedData() Once a Fence
+	// Inserted After this has Passed. Outside Passes Only
+	// -------------------------------------------------------------------------------------
+	virtual void readRenderTarget(RenderTargetId target, int width, int height, BufferId buffer) = 0;
+
+	// Error Check: Returns Zero Unless vertices is a Vertex Buffer and indices an Index Buffer;
+	// with Neither, the Layout's Vertices are Bound Per Draw by bindVertexBuffer() (Streamed
+	// Data) or the Layout is Empty (Vertices Generated in the Shader)
+	// -----------------------------------------------------------------------------------------
+	virtual VertexInputId createVertexInput(const VertexLayout& layout, BufferId vertices, BufferId indices) = 0;
+	virtual void destroyVertexInput(VertexInputId vertexInput) = 0;
+
+	// Error Check: Returns Zero when the Backend Links its Programs Another Way (GL Builds them
+	// from GLSL in the ShaderBatch) or Rejects the SPIR-V Modules
+	// -----------------------------------------------------------------------------------------
+	virtual ProgramId createProgram(const std::vector<uint32_t>& vertexSpirv, const std::vector<uint32_t>& fragmentSpirv) = 0;
+	virtual void destroyProgram(ProgramId program) = 0;
+
+	virtual PipelineId createPipeline(const PipelineDesc& desc) = 0;
+	virtual void destroyPipeline(PipelineId pipeline) = 0;
+
+	// Lists are Submitted Between beginPass() and endPass(); Passes do Not Nest
+	// -------------------------------------------------------------------------
+	virtual void beginPass(const PassDesc& pass) = 0;
+	virtual void endPass() = 0;
+	virtual void submit(const CommandList* lists, size_t count) = 0;
+
+	// Pipelines that are Not alwaysFilled Draw Triangle Edges Only
+	// ------------------------------------------------------------
+	virtual void setWireframe(bool wireframe) = 0;
+
+	// Show the Frame Drawn into the Window Target; Outside Passes Only
+	// ----------------------------------------------------------------
+	virtual void present() = 0;
+};
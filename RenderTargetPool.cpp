@@ -0,0 +1,112 @@
+#include "RenderTargetPool.h"
+
+#include <iostream>   // cerr
+
+using namespace std;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	bool isDepthFormat(TextureFormat format)
+	{
+		return format == TextureFormat::Depth24 || format == TextureFormat::Depth32F;
+	}
+}
+
+void RenderTargetPool::destroy()
+{
+	for (Entry& entry : mEntries)
+		destroyTarget(entry.target);
+	mEntries.clear();
+}
+
+RenderTarget RenderTargetPool::acquire(int width, int height, TextureFormat format)
+{
+	for (Entry& entry : mEntries)
+	{
+		const RenderTarget& target = entry.target;
+		if (!entry.inUse && target.width == width && target.height == height && target.format == format)
+		{
+			entry.inUse = true;
+			entry.idleFrames = 0;
+			return target;
+		}
+	}
+
+	Entry entry;
+	if (!createTarget(width, height, format, entry.target))
+		return RenderTarget();
+
+	entry.inUse = true;
+	mEntries.push_back(entry);
+	++mCreated;
+	return entry.target;
+}
+
+void RenderTargetPool::release(const RenderTarget& target)
+{
+	for (Entry& entry : mEntries)
+	{
+		if (entry.target.texture == target.texture)
+		{
+			entry.inUse = false;
+			return;
+		}
+	}
+}
+
+void RenderTargetPool::endFrame()
+{
+	for (size_t i = 0; i < mEntries.size();)
+	{
+		Entry& entry = mEntries[i];
+		if (!entry.inUse && ++entry.idleFrames > MAX_IDLE_FRAMES)
+		{
+			destroyTarget(entry.target);
+			entry = mEntries.back();
+			mEntries.pop_back();
+		}
+		else
+			++i;
+	}
+}
+
+bool RenderTargetPool::createTarget(int width, int height, TextureFormat format, RenderTarget& target)
+{
+	target.width = width;
+	target.height = height;
+	target.format = format;
+
+	TextureDesc desc;
+	desc.width = width;
+	desc.height = height;
+	desc.format = format;
+	desc.wrap = TextureWrap::ClampToEdge;
+	desc.levels = 1;
+	desc.renderTarget = true;
+	target.texture = mBackend->createTexture(desc, nullptr);
+
+	if (target.texture && isDepthFormat(format))
+		return true;
+
+	// Error Check: Target Completeness
+	// --------------------------------
+	if (target.texture)
+		target.target = mBackend->createRenderTarget(&target.texture, 1, 0);
+	if (!target.target)
+	{
+		cerr << "ERROR::RENDER_TARGET_POOL::TARGET_INCOMPLETE " << width << "x" << height << endl;
+		destroyTarget(target);
+		return false;
+	}
+
+	return true;
+}
+
+void RenderTargetPool::destroyTarget(RenderTarget& target)
+{
+	mBackend->destroyRenderTarget(target.target);
+	mBackend->destroyTexture(target.texture);
+	target = RenderTarget();
+}
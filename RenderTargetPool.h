@@ -0,0 +1,63 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <vector>         // vector
+
+#include "RenderBackend.h"
+
+// Transient Texture Target Handed Out by the Pool
+// -----------------------------------------------
+struct RenderTarget
+{
+	TextureId texture = 0;
+	RenderTargetId target = 0;   // Color Formats Only; Depth Targets are Attached by the Caller
+	int width = 0;
+	int height = 0;
+	TextureFormat format = TextureFormat::RGBA8;
+};
+
+// Pool of Transient Render Targets Keyed by Size and Format
+// ---------------------------------------------------------
+// Passes acquire a target for as long as they need it and release it afterwards, so a
+// later pass (or the next frame) with the same width, height and internal format gets the
+// same texture back instead of a new allocation. Color targets come with a backend render
+// target that draws into the texture. Targets left unused for MAX_IDLE_FRAMES frames, such as
+// the sizes a window resize or a dynamic resolution step left behind, are deleted by
+// endFrame(). Textures sample bilinearly and clamp to the edge.
+class RenderTargetPool
+{
+public:
+	static const int MAX_IDLE_FRAMES = 60;
+
+	void create(RenderBackend& backend) { mBackend = &backend; }
+	void destroy();
+
+	// A Free Target of this Size and Format, Created if None is Free; Empty on Failure
+	// -------------------------------------------------------------------------------
+	RenderTarget acquire(int width, int height, TextureFormat format);
+	void release(const RenderTarget& target);
+
+	// Age the Free Targets and Delete the Ones Idle Too Long
+	// ------------------------------------------------------
+	void endFrame();
+
+	size_t targetCount() const { return mEntries.size(); }
+	size_t createdCount() const { return mCreated; }   // Allocations Since Startup; Flat in Steady State
+
+private:
+	struct Entry
+	{
+		RenderTarget target;
+		bool inUse = false;
+		int idleFrames = 0;
+	};
+
+	bool createTarget(int width, int height, TextureFormat format, RenderTarget& target);
+	void destroyTarget(RenderTarget& target);
+
+	RenderBackend* mBackend = nullptr;
+	std::vector<Entry> mEntries;
+	size_t mCreated = 0;
+};
@@ -0,0 +1,162 @@
+#include "ShaderBatch.h"
+
+#include <algorithm>   // find
+#include <iostream>    // cerr
+
+#include "MemoryTracker.h"
+#include "ShaderCache.h"
+
+using namespace std;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	bool hasParallelCompile()
+	{
+		return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+	}
+}
+
+void ShaderBatch::submit(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programID, const char* fragLibrarySource)
+{
+	// Let the Driver Use as Many Compiler Threads as it Likes
+	// -------------------------------------------------------
+	if (!mThreadsRequested)
+	{
+		if (GLEW_KHR_parallel_shader_compile)
+			glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+		else if (GLEW_ARB_parallel_shader_compile)
+			glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+		mThreadsRequested = true;
+	}
+
+	programID = MemoryTracker::createProgram();
+
+	// Warm Start: Cached Binaries are Ready Immediately
+	// -------------------------------------------------
+	uint64_t cacheKey = 0;
+	if (mCache)
+	{
+		cacheKey = mCache->makeKey({ vtxShaderSource, fragShaderSource, fragLibrarySource });
+		if (mCache->load(cacheKey, programID))
+		{
+			MemoryTracker::programLinked(programID);
+			mReady.push_back(programID);
+			return;
+		}
+	}
+
+	// Compile and Link Without Querying Status; Errors Surface at Completion
+	// ----------------------------------------------------------------------
+	GLuint vertexShaderID = glCreateShader(GL_VERTEX_SHADER);
+	GLuint fragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
+
+	const char* fragSources[] = { fragShaderSource, fragLibrarySource };
+	glShaderSource(vertexShaderID, 1, &vtxShaderSource, NULL);
+	glShaderSource(fragmentShaderID, fragLibrarySource ? 2 : 1, fragSources, NULL);
+	glCompileShader(vertexShaderID);
+	glCompileShader(fragmentShaderID);
+
+	glAttachShader(programID, vertexShaderID);
+	glAttachShader(programID, fragmentShaderID);
+	if (mCache && mCache->isEnabled())
+		glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(programID);
+
+	mPending.push_back({ programID, vertexShaderID, fragmentShaderID, cacheKey });
+}
+
+bool ShaderBatch::poll()
+{
+	bool parallel = hasParallelCompile();
+	bool success = true;
+
+	for (size_t i = 0; i < mPending.size();)
+	{
+		// Error Check: Completion Status Never Blocks, Unlike GL_LINK_STATUS
+		// ------------------------------------------------------------------
+		if (parallel)
+		{
+			GLint done = GL_FALSE;
+			glGetProgramiv(mPending[i].program, GL_COMPLETION_STATUS_KHR, &done);
+			if (!done)
+			{
+				++i;
+				continue;
+			}
+		}
+
+		success = complete(mPending[i]) && success;
+		mPending.erase(mPending.begin() + i);
+	}
+
+	return success;
+}
+
+bool ShaderBatch::finish()
+{
+	bool success = true;
+
+	for (const PendingProgram& pending : mPending)
+		success = complete(pending) && success;
+	mPending.clear();
+
+	return success;
+}
+
+bool ShaderBatch::isReady(GLuint programID) const
+{
+	return find(mReady.begin(), mReady.end(), programID) != mReady.end();
+}
+
+// Check a Finished Program, Report Errors and Store it in the Cache
+// -----------------------------------------------------------------
+bool ShaderBatch::complete(const PendingProgram& pending)
+{
+	int linked = 0;
+	int success = 0;
+	char infoLog[512];
+
+	glGetProgramiv(pending.program, GL_LINK_STATUS, &linked);
+	if (!linked)
+	{
+		// Error Check: Shader Compilation, to Name the Stage that Broke the Link
+		// ----------------------------------------------------------------------
+		glGetShaderiv(pending.vertexShader, GL_COMPILE_STATUS, &success);
+		if (!success)
+		{
+			glGetShaderInfoLog(pending.vertexShader, sizeof(infoLog), NULL, infoLog);
+			cerr << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << endl;
+		}
+
+		glGetShaderiv(pending.fragmentShader, GL_COMPILE_STATUS, &success);
+		if (!success)
+		{
+			glGetShaderInfoLog(pending.fragmentShader, sizeof(infoLog), NULL, infoLog);
+			cerr << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << endl;
+		}
+
+		glGetProgramInfoLog(pending.program, sizeof(infoLog), NULL, infoLog);
+		cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << endl;
+	}
+	else if (mCache)
+	{
+		mCache->store(pending.cacheKey, pending.program);
+	}
+
+	// The Linked Program Keeps its Code; the Shader Objects are No Longer Needed
+	// --------------------------------------------------------------------------
+	glDetachShader(pending.program, pending.vertexShader);
+	glDetachShader(pending.program, pending.fragmentShader);
+	glDeleteShader(pending.vertexShader);
+	glDeleteShader(pending.fragmentShader);
+
+	if (linked)
+	{
+		MemoryTracker::programLinked(pending.program);
+		mReady.push_back(pending.program);
+	}
+
+	return linked != 0;
+}
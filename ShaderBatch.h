@@ -0,0 +1,55 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <cstdint>        // uint64_t
+#include <vector>         // vector
+#include <GL/glew.h>      // GLEW library
+
+class ShaderCache;
+
+// Non-Blocking Batch Shader Compilation
+// -------------------------------------
+// submit() issues the compile and link of a program without querying any status, so the
+// driver can build every program of the batch at once on its own threads. poll() then
+// checks GL_COMPLETION_STATUS_KHR, which never waits, and finishes only the programs
+// that are done; callers render with whatever isReady() while the rest keep compiling.
+// Without KHR/ARB_parallel_shader_compile every status query blocks, so poll() simply
+// finishes the whole batch. Programs found in the binary cache are ready on submit.
+class ShaderBatch
+{
+public:
+	explicit ShaderBatch(ShaderCache* cache = nullptr) : mCache(cache) {}
+
+	// Start Building a Program; programID is Valid Immediately but not Usable until Ready
+	// -----------------------------------------------------------------------------------
+	void submit(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programID, const char* fragLibrarySource = nullptr);
+
+	// Finish Every Program the Driver has Completed; False if Any of them Failed
+	// --------------------------------------------------------------------------
+	bool poll();
+
+	// Block Until the Whole Batch is Built; False if Any Program Failed
+	// -----------------------------------------------------------------
+	bool finish();
+
+	bool isReady(GLuint programID) const;
+	size_t pendingCount() const { return mPending.size(); }
+
+private:
+	struct PendingProgram
+	{
+		GLuint program;
+		GLuint vertexShader;
+		GLuint fragmentShader;
+		uint64_t cacheKey;
+	};
+
+	bool complete(const PendingProgram& pending);
+
+	ShaderCache* mCache;
+	std::vector<PendingProgram> mPending;
+	std::vector<GLuint> mReady;
+	bool mThreadsRequested = false;
+};
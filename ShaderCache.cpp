@@ -0,0 +1,155 @@
+#include "ShaderCache.h"
+
+#include <cstdio>       // snprintf
+#include <filesystem>   // create_directories
+#include <fstream>      // ifstream, ofstream
+#include <iostream>     // cerr
+#include <vector>       // vector
+
+using namespace std;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	// Entry Header: Magic, Binary Format, Binary Length
+	// -------------------------------------------------
+	const uint32_t ENTRY_MAGIC = 0x42505347;   // "GSPB"
+
+	struct EntryHeader
+	{
+		uint32_t magic;
+		uint32_t format;
+		uint32_t length;
+	};
+
+	// FNV-1a, 64-Bit
+	// --------------
+	const uint64_t FNV_OFFSET = 14695981039346656037ull;
+	const uint64_t FNV_PRIME = 1099511628211ull;
+
+	uint64_t hashString(uint64_t hash, const char* text)
+	{
+		for (; *text; ++text)
+			hash = (hash ^ static_cast<unsigned char>(*text)) * FNV_PRIME;
+
+		// Terminator Keeps {"ab", "c"} and {"a", "bc"} Apart
+		// --------------------------------------------------
+		return (hash ^ 0xFF) * FNV_PRIME;
+	}
+
+	const char* glString(GLenum name)
+	{
+		const GLubyte* value = glGetString(name);
+		return value ? reinterpret_cast<const char*>(value) : "";
+	}
+}
+
+bool ShaderCache::open(const string& directory)
+{
+	mEnabled = false;
+
+	GLint formatCount = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+	if (formatCount <= 0)
+	{
+		cerr << "INFO: Program Binary Cache Disabled, Driver Exposes No Binary Formats" << endl;
+		return false;
+	}
+
+	error_code error;
+	filesystem::create_directories(directory, error);
+	if (error)
+	{
+		cerr << "ERROR::SHADER_CACHE::CREATE_DIRECTORY " << directory << ": " << error.message() << endl;
+		return false;
+	}
+
+	mDirectory = directory;
+	mDriver = string(glString(GL_VENDOR)) + "\n" + glString(GL_RENDERER) + "\n" + glString(GL_VERSION);
+	mEnabled = true;
+
+	return true;
+}
+
+uint64_t ShaderCache::makeKey(initializer_list<const char*> sources) const
+{
+	uint64_t hash = hashString(FNV_OFFSET, mDriver.c_str());
+
+	for (const char* source : sources)
+	{
+		if (source)
+			hash = hashString(hash, source);
+	}
+
+	return hash;
+}
+
+string ShaderCache::entryPath(uint64_t key) const
+{
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+
+	return mDirectory + "/" + name;
+}
+
+bool ShaderCache::load(uint64_t key, GLuint programID)
+{
+	if (!mEnabled)
+		return false;
+
+	ifstream file(entryPath(key), ios::binary);
+	EntryHeader header;
+
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != ENTRY_MAGIC)
+	{
+		++mMisses;
+		return false;
+	}
+
+	vector<char> binary(header.length);
+	if (!file.read(binary.data(), binary.size()))
+	{
+		++mMisses;
+		return false;
+	}
+
+	// Error Check: the Driver may Reject Binaries from an Older Build of Itself
+	// -------------------------------------------------------------------------
+	glProgramBinary(programID, header.format, binary.data(), header.length);
+
+	GLint success = 0;
+	glGetProgramiv(programID, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		++mMisses;
+		return false;
+	}
+
+	++mHits;
+	return true;
+}
+
+void ShaderCache::store(uint64_t key, GLuint programID)
+{
+	if (!mEnabled)
+		return;
+
+	GLint length = 0;
+	glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+
+	vector<char> binary(length);
+	GLenum format = 0;
+	glGetProgramBinary(programID, length, &length, &format, binary.data());
+
+	EntryHeader header = { ENTRY_MAGIC, format, static_cast<uint32_t>(length) };
+
+	ofstream file(entryPath(key), ios::binary | ios::trunc);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(binary.data(), length);
+
+	if (!file)
+		cerr << "ERROR::SHADER_CACHE::WRITE_FAILED " << entryPath(key) << endl;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstdint>          // uint64_t
+#include <initializer_list> // initializer_list
+#include <string>           // string
+#include <GL/glew.h>        // GLEW library
+
+// Persistent Program Binary Cache
+// -------------------------------
+// Linked programs are written to disk with glGetProgramBinary and reloaded with
+// glProgramBinary on the next launch, so warm starts skip GLSL compilation entirely.
+// A cache entry is keyed by a hash of every source string of the program (which carries
+// any defines) and the driver's vendor, renderer and version strings, so a driver update
+// or a shader edit simply misses. A binary the driver rejects is treated as a miss too.
+class ShaderCache
+{
+public:
+	// Enable the Cache if the Driver Exposes at Least One Binary Format
+	// -----------------------------------------------------------------
+	bool open(const std::string& directory);
+	bool isEnabled() const { return mEnabled; }
+
+	// Key for a Program Built from these Sources; Null Sources are Skipped
+	// --------------------------------------------------------------------
+	uint64_t makeKey(std::initializer_list<const char*> sources) const;
+
+	// Load a Cached Binary into programID; False on Any Miss or Driver Rejection
+	// --------------------------------------------------------------------------
+	bool load(uint64_t key, GLuint programID);
+
+	// Save a Linked Program; Needs GL_PROGRAM_BINARY_RETRIEVABLE_HINT Set Before Linking
+	// ----------------------------------------------------------------------------------
+	void store(uint64_t key, GLuint programID);
+
+	int hitCount() const { return mHits; }
+	int missCount() const { return mMisses; }
+
+private:
+	std::string entryPath(uint64_t key) const;
+
+	std::string mDirectory;
+	std::string mDriver;   // Vendor, Renderer and Version, Hashed into Every Key
+	bool mEnabled = false;
+	int mHits = 0;
+	int mMisses = 0;
+};
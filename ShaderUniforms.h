@@ -0,0 +1,92 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstdint>        // uint32_t
+
+// Uniforms of the Built-In Shaders
+// --------------------------------
+// Every pipeline is created with this one table, so a slot means the same uniform whichever
+// pipeline is bound and a module can set its uniforms without knowing the program they land
+// in. A slot the program does not declare (or the compiler optimized out) is ignored. The
+// names are the GLSL declarations in Main.cpp; samplers take the texture unit they read.
+namespace Uniform
+{
+	enum Slot : uint32_t
+	{
+		// Scene Objects and Cameras
+		// -------------------------
+		Model,
+		NormalMatrix,
+		View,
+		Projection,
+		ViewPosition,
+		UVScale,
+		Texture,
+
+		// Clustered Lights
+		// ----------------
+		ClusterGrid,
+		ClusterScreenSize,
+		ClusterDepth,
+		LightCount,
+
+		// Key Light and Shadow Cascades
+		// -----------------------------
+		KeyLightDirection,
+		KeyLightColor,
+		ShadowAtlas,
+		ShadowMatrices,
+		ShadowCascadeRadii,
+		ShadowTexelSizes,
+		ShadowCameraPosition,
+		LightViewProjection,
+
+		// Multi-View, Lightmaps and Deferred Lighting
+		// -------------------------------------------
+		ViewProjections,
+		ViewPositions,
+		Lightmap,
+		LightmapAmbient,
+		GAlbedo,
+		GNormal,
+		GDepth,
+		InverseViewProjection,
+
+		// Texture Streaming Feedback
+		// --------------------------
+		TextureSlot,
+		TextureSize,
+		LodBias,
+
+		// Debug Overlay and Post-Processing
+		// ---------------------------------
+		ViewProjection,
+		WindowSize,
+		GlyphAtlas,
+		Source,
+		Scene,
+		Threshold,
+		Direction,
+		Exposure,
+		BloomStrength,
+
+		Count
+	};
+
+	// GLSL Name of Each Slot, in Slot Order
+	// -------------------------------------
+	constexpr const char* NAMES[] =
+	{
+		"model", "normalMatrix", "view", "projection", "viewPosition", "uvScale", "uTexture",
+		"clusterGrid", "clusterScreenSize", "clusterDepth", "lightCount",
+		"keyLightDirection", "keyLightColor", "shadowAtlas", "shadowMatrices", "shadowCascadeRadii",
+		"shadowTexelSizes", "shadowCameraPosition", "lightViewProjection",
+		"viewProjections", "viewPositions", "lightmap", "lightmapAmbient", "gAlbedo", "gNormal", "gDepth",
+		"inverseViewProjection",
+		"uTextureSlot", "uTextureSize", "uLodBias",
+		"viewProjection", "windowSize", "glyphAtlas", "uSource", "uScene", "uThreshold", "uDirection",
+		"uExposure", "uBloomStrength"
+	};
+	static_assert(sizeof(NAMES) / sizeof(NAMES[0]) == Count, "One Name per Uniform Slot");
+}
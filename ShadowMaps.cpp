@@ -0,0 +1,212 @@
+#include "ShadowMaps.h"
+
+#include <cmath>      // floor
+#include <iostream>   // cerr
+#include <glm/gtx/transform.hpp>
+
+#include "ShaderUniforms.h"
+
+using namespace std;
+using namespace glm;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	// Camera Distance Covered by Each Cascade
+	// ---------------------------------------
+	const float CASCADE_RADII[ShadowMaps::CASCADE_COUNT] = { 3.0f, 8.0f, 20.0f, 50.0f };
+
+	// The Map Covers 1.25x the Cascade Radius, Leaving Room for the Center to Lag
+	// Up to Half a Grid Step Behind the Camera; 8 Steps Across Keeps Texel Alignment
+	// ------------------------------------------------------------------------------
+	const float COVERAGE_SCALE = 1.25f;
+	const float GRID_STEPS = 8.0f;
+
+	// Casters this Far Outside the Cascade Along the Light Still Cast Shadows
+	// -----------------------------------------------------------------------
+	const float CASTER_DEPTH_MARGIN = 30.0f;
+}
+
+bool ShadowMaps::create(RenderBackend& backend)
+{
+	mBackend = &backend;
+	for (int i = 0; i < CASCADE_COUNT; ++i)
+	{
+		mCascades[i].radius = CASCADE_RADII[i];
+		mCascades[i].valid = false;
+	}
+
+	return createAtlas(mStaticAtlas, mStaticTarget) && createAtlas(mCompositeAtlas, mCompositeTarget);
+}
+
+void ShadowMaps::destroy()
+{
+	if (mBackend)
+	{
+		mBackend->destroyRenderTarget(mStaticTarget);
+		mBackend->destroyRenderTarget(mCompositeTarget);
+		mBackend->destroyTexture(mStaticAtlas);
+		mBackend->destroyTexture(mCompositeAtlas);
+		mBackend->destroyPipeline(mDepthPipeline);
+	}
+	mStaticTarget = mCompositeTarget = mStaticAtlas = mCompositeAtlas = 0;
+	mDepthPipeline = 0;
+	mDepthProgram = 0;
+}
+
+void ShadowMaps::invalidate()
+{
+	for (Cascade& cascade : mCascades)
+		cascade.valid = false;
+}
+
+// Depth Atlas Sampled with Hardware Depth Comparison
+// --------------------------------------------------
+bool ShadowMaps::createAtlas(TextureId& texture, RenderTargetId& target)
+{
+	TextureDesc desc;
+	desc.width = desc.height = ATLAS_SIZE;
+	desc.format = TextureFormat::Depth32F;
+	desc.wrap = TextureWrap::ClampToEdge;
+	desc.levels = 1;
+	desc.shadowCompare = true;
+	desc.renderTarget = true;
+	texture = mBackend->createTexture(desc, nullptr);
+	target = texture ? mBackend->createRenderTarget(nullptr, 0, texture) : 0;
+
+	// Error Check: Atlas Completeness
+	// -------------------------------
+	if (!target)
+	{
+		cerr << "ERROR::SHADOW::ATLAS_INCOMPLETE" << endl;
+		return false;
+	}
+
+	return true;
+}
+
+void ShadowMaps::update(const vec3& cameraPosition, const vec3& lightDirection, GLuint depthProgramID,
+	const DrawCasters& drawCasters, bool hasDynamicCasters)
+{
+	mRenderedCascades = 0;
+	mCameraPosition = cameraPosition;
+
+	vec3 direction = normalize(lightDirection);
+	if (direction != mLightDirection)
+	{
+		mLightDirection = direction;
+		invalidate();
+	}
+
+	// Light-Space Basis
+	// -----------------
+	vec3 worldUp = (std::abs(direction.y) < 0.99f) ? vec3(0.0f, 1.0f, 0.0f) : vec3(1.0f, 0.0f, 0.0f);
+	vec3 right = normalize(cross(direction, worldUp));
+	vec3 up = cross(right, direction);
+
+	// Depth Only, Biased Against Acne; Wireframe Mode Must Not Reach the Depth Tiles
+	// ------------------------------------------------------------------------------
+	if (depthProgramID != mDepthProgram)
+	{
+		mBackend->destroyPipeline(mDepthPipeline);
+
+		PipelineDesc desc;
+		desc.program = depthProgramID;
+		desc.uniforms = Uniform::NAMES;
+		desc.uniformCount = Uniform::Count;
+		desc.depthBiasSlope = 2.0f;
+		desc.depthBiasConstant = 4.0f;
+		desc.alwaysFilled = true;
+		mDepthPipeline = mBackend->createPipeline(desc);
+		mDepthProgram = depthProgramID;
+	}
+
+	for (int i = 0; i < CASCADE_COUNT; ++i)
+	{
+		Cascade& cascade = mCascades[i];
+
+		// Snap the Center to the Light-Space Grid
+		// ---------------------------------------
+		float halfSize = cascade.radius * COVERAGE_SCALE;
+		float step = 2.0f * halfSize / GRID_STEPS;
+		vec3 snapped(floor(dot(cameraPosition, right) / step + 0.5f) * step,
+			floor(dot(cameraPosition, up) / step + 0.5f) * step,
+			floor(dot(cameraPosition, direction) / step + 0.5f) * step);
+
+		if (cascade.valid && snapped == cascade.snappedCenter)
+			continue;
+
+		cascade.snappedCenter = snapped;
+		cascade.valid = true;
+
+		vec3 center = right * snapped.x + up * snapped.y + direction * snapped.z;
+		float depthRange = halfSize + CASTER_DEPTH_MARGIN;
+		mat4 lightView = lookAt(center - direction * depthRange, center, up);
+		mat4 lightProjection = ortho(-halfSize, halfSize, -halfSize, halfSize, 0.0f, 2.0f * depthRange);
+		cascade.viewProjection = lightProjection * lightView;
+
+		// Clip Space to the Cascade's Tile in Atlas Texture Space
+		// -------------------------------------------------------
+		vec2 tileOffset(0.5f * (i % 2), 0.5f * (i / 2));
+		mat4 toTile = translate(vec3(tileOffset, 0.0f)) * scale(vec3(0.5f, 0.5f, 1.0f))
+			* translate(vec3(0.5f)) * scale(vec3(0.5f));
+		cascade.shadowMatrix = toTile * cascade.viewProjection;
+
+		renderTile(i, mStaticTarget, drawCasters, true);
+		++mRenderedCascades;
+	}
+
+	// Composite Dynamic Casters Over a Copy of the Static Cache
+	// ---------------------------------------------------------
+	mUsingComposite = hasDynamicCasters;
+	if (hasDynamicCasters)
+	{
+		mBackend->copyTextureLevel(mStaticAtlas, 0, mCompositeAtlas, 0);
+
+		for (int i = 0; i < CASCADE_COUNT; ++i)
+			renderTile(i, mCompositeTarget, drawCasters, false);
+	}
+}
+
+void ShadowMaps::renderTile(int cascade, RenderTargetId target, const DrawCasters& drawCasters, bool staticCasters)
+{
+	// Only the Static Pass Clears; Dynamic Casters Draw Over the Copied Cache
+	// -----------------------------------------------------------------------
+	PassDesc pass;
+	pass.target = target;
+	pass.x = (cascade % 2) * TILE_SIZE;
+	pass.y = (cascade / 2) * TILE_SIZE;
+	pass.width = pass.height = TILE_SIZE;
+	pass.clearDepth = staticCasters;
+
+	mCommands.reset();
+	mCommands.bindPipeline(mDepthPipeline);
+	mCommands.setUniform(Uniform::LightViewProjection, mCascades[cascade].viewProjection);
+	drawCasters(mCommands, staticCasters);
+
+	mBackend->beginPass(pass);
+	mBackend->submit(&mCommands, 1);
+	mBackend->endPass();
+}
+
+void ShadowMaps::bind(CommandList& commands) const
+{
+	commands.bindTexture(SHADOW_UNIT, mUsingComposite ? mCompositeAtlas : mStaticAtlas);
+
+	mat4 matrices[CASCADE_COUNT];
+	float radii[CASCADE_COUNT];
+	float texelSizes[CASCADE_COUNT];
+	for (int i = 0; i < CASCADE_COUNT; ++i)
+	{
+		matrices[i] = mCascades[i].shadowMatrix;
+		radii[i] = mCascades[i].radius;
+		texelSizes[i] = 2.0f * mCascades[i].radius * COVERAGE_SCALE / TILE_SIZE;
+	}
+
+	commands.setUniform(Uniform::ShadowAtlas, SHADOW_UNIT);
+	commands.setUniform(Uniform::ShadowMatrices, matrices, CASCADE_COUNT);
+	commands.setUniform(Uniform::ShadowCascadeRadii, vec4(radii[0], radii[1], radii[2], radii[3]));
+	commands.setUniform(Uniform::ShadowTexelSizes, vec4(texelSizes[0], texelSizes[1], texelSizes[2], texelSizes[3]));
+	commands.setUniform(Uniform::ShadowCameraPosition, mCameraPosition);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+// Includes
+// -------
+#include <functional>     // std::function
+#include <GL/glew.h>      // GLEW library
+#include <glm/glm.hpp>
+
+#include "RenderBackend.h"
+
+// Cached Cascaded Shadow Maps for the Directional Key Light
+// ---------------------------------------------------------
+// The four cascades share one depth atlas (2x2 tiles). Each cascade covers a sphere around
+// the camera that does not depend on where the camera looks, and its center is snapped to
+// a coarse light-space grid, so a cascade is only re-rendered when the camera crosses a
+// grid cell, the light turns, or invalidate() is called because static geometry moved.
+// Static casters are rendered into the cached atlas; when dynamic casters exist, the cache
+// is copied into a second atlas each frame and only the dynamic casters are drawn on top.
+// Each tile is one backend pass whose depth pipeline stays filled in wireframe mode.
+class ShadowMaps
+{
+public:
+	static const int CASCADE_COUNT = 4;
+	static const int TILE_SIZE = 2048;
+	static const int ATLAS_SIZE = TILE_SIZE * 2;
+	static const GLint SHADOW_UNIT = 3;   // Texture Unit the Atlas is Bound to
+
+	// Records Static or Dynamic Casters; the Model Matrix is the Only Uniform Left to Set
+	// -----------------------------------------------------------------------------------
+	using DrawCasters = std::function<void(CommandList& commands, bool staticCasters)>;
+
+	bool create(RenderBackend& backend);
+	void destroy();
+
+	// Static Geometry Changed: Every Cascade is Re-Rendered Next Update
+	// -----------------------------------------------------------------
+	void invalidate();
+
+	// Refresh Stale Cascades and Composite Dynamic Casters
+	// ----------------------------------------------------
+	void update(const glm::vec3& cameraPosition, const glm::vec3& lightDirection, GLuint depthProgramID,
+		const DrawCasters& drawCasters, bool hasDynamicCasters);
+
+	// Record Binding the Atlas and Setting the Sampling Uniforms Read by keyLightSource
+	// ---------------------------------------------------------------------------------
+	void bind(CommandList& commands) const;
+
+	// Cascades Re-Rendered by the Last update(); Zero in Steady State
+	// ---------------------------------------------------------------
+	int renderedCascadeCount() const { return mRenderedCascades; }
+
+	// World to Light Clip Space of a Cascade, as Last Rendered
+	// --------------------------------------------------------
+	const glm::mat4& cascadeViewProjection(int cascade) const { return mCascades[cascade].viewProjection; }
+
+private:
+	struct Cascade
+	{
+		float radius;                 // Camera Distance this Cascade Covers
+		glm::vec3 snappedCenter;      // Light-Space Grid Cell the Cache was Rendered For
+		glm::mat4 viewProjection;     // World to Light Clip Space
+		glm::mat4 shadowMatrix;       // World to Atlas Texture Coordinates and Depth
+		bool valid;
+	};
+
+	bool createAtlas(TextureId& texture, RenderTargetId& target);
+	void renderTile(int cascade, RenderTargetId target, const DrawCasters& drawCasters, bool staticCasters);
+
+	Cascade mCascades[CASCADE_COUNT];
+	glm::vec3 mLightDirection = glm::vec3(0.0f);
+	glm::vec3 mCameraPosition = glm::vec3(0.0f);
+
+	TextureId mStaticAtlas = 0;
+	RenderTargetId mStaticTarget = 0;
+	TextureId mCompositeAtlas = 0;
+	RenderTargetId mCompositeTarget = 0;
+	bool mUsingComposite = false;
+	int mRenderedCascades = 0;
+
+	RenderBackend* mBackend = nullptr;
+	GLuint mDepthProgram = 0;
+	PipelineId mDepthPipeline = 0;   // Created for the First Depth Program update() is Given
+	CommandList mCommands;
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <cstdint>        // uint32_t
+#include <utility>        // move
+#include <vector>         // vector
+
+// Generational Slot Map: Contiguous Resource Pool Addressed by 32-Bit Handles
+// ---------------------------------------------------------------------------
+// Values live packed in one array, so iterating every live resource walks contiguous
+// memory no matter how many have been created and destroyed. A handle never points at
+// the value directly: its low INDEX_BITS select a slot that records where the value
+// currently sits, and its high bits must match the slot's generation. Destroying a value
+// moves the last value into its place, bumps the slot's generation and puts the slot on
+// a free list, so create, destroy and lookup are all O(1) and a handle kept after its
+// value was destroyed is detected instead of silently aliasing the slot's next occupant.
+// Handle types are distinct per value type, so a texture handle cannot index the meshes.
+template <typename T>
+class SlotMap
+{
+public:
+	static const uint32_t INDEX_BITS = 20;                            // Up to ~1M Live Values
+	static const uint32_t MAX_SLOTS = 1u << INDEX_BITS;
+	static const uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+
+	// Null Handle is Zero: Generations Start at 1 so No Live Handle is Ever Zero
+	// --------------------------------------------------------------------------
+	struct Handle
+	{
+		uint32_t value = 0;
+
+		explicit operator bool() const { return value != 0; }
+		bool operator==(Handle other) const { return value == other.value; }
+		bool operator!=(Handle other) const { return value != other.value; }
+	};
+
+	// Stores a Value; Returns a Null Handle Once Every Slot is in Use
+	// ---------------------------------------------------------------
+	Handle insert(T value)
+	{
+		uint32_t slot;
+		if (mFreeHead != NO_SLOT)
+		{
+			slot = mFreeHead;
+			mFreeHead = mSlots[slot].dense & ~FREE_BIT;
+		}
+		else
+		{
+			if (mSlots.size() == MAX_SLOTS)
+				return Handle();
+
+			slot = static_cast<uint32_t>(mSlots.size());
+			mSlots.push_back(Slot{ 0, 1 });
+		}
+
+		mSlots[slot].dense = static_cast<uint32_t>(mValues.size());
+		mValues.push_back(std::move(value));
+		mValueSlots.push_back(slot);
+
+		Handle handle;
+		handle.value = (mSlots[slot].generation << INDEX_BITS) | slot;
+		return handle;
+	}
+
+	// Removes a Value; False if the Handle is Null or Stale
+	// -----------------------------------------------------
+	bool erase(Handle handle)
+	{
+		if (!contains(handle))
+			return false;
+
+		const uint32_t slot = handle.value & (MAX_SLOTS - 1);
+		const uint32_t dense = mSlots[slot].dense;
+		const uint32_t last = static_cast<uint32_t>(mValues.size() - 1);
+
+		// Keep Values Packed: the Last Value Fills the Hole
+		// -------------------------------------------------
+		if (dense != last)
+		{
+			mValues[dense] = std::move(mValues[last]);
+			mValueSlots[dense] = mValueSlots[last];
+			mSlots[mValueSlots[dense]].dense = dense;
+		}
+		mValues.pop_back();
+		mValueSlots.pop_back();
+
+		// Retire the Slot: Outstanding Handles Now Carry an Old Generation
+		// ----------------------------------------------------------------
+		uint32_t generation = (mSlots[slot].generation + 1) & GENERATION_MASK;
+		mSlots[slot].generation = generation ? generation : 1;
+		mSlots[slot].dense = mFreeHead | FREE_BIT;
+		mFreeHead = slot;
+
+		return true;
+	}
+
+	bool contains(Handle handle) const
+	{
+		const uint32_t slot = handle.value & (MAX_SLOTS - 1);
+		return slot < mSlots.size()
+			&& (mSlots[slot].dense & FREE_BIT) == 0
+			&& mSlots[slot].generation == handle.value >> INDEX_BITS;
+	}
+
+	// Lookup: Two Array Reads, nullptr for a Null or Stale Handle
+	// -----------------------------------------------------------
+	T* get(Handle handle)
+	{
+		return contains(handle) ? &mValues[mSlots[handle.value & (MAX_SLOTS - 1)].dense] : nullptr;
+	}
+
+	const T* get(Handle handle) const
+	{
+		return contains(handle) ? &mValues[mSlots[handle.value & (MAX_SLOTS - 1)].dense] : nullptr;
+	}
+
+	// Dense Iteration Over Live Values, in No Particular Order
+	// --------------------------------------------------------
+	T* begin() { return mValues.data(); }
+	T* end() { return mValues.data() + mValues.size(); }
+	const T* begin() const { return mValues.data(); }
+	const T* end() const { return mValues.data() + mValues.size(); }
+	size_t size() const { return mValues.size(); }
+
+	void reserve(size_t count)
+	{
+		mValues.reserve(count);
+		mValueSlots.reserve(count);
+		mSlots.reserve(count);
+	}
+
+	// Drops Every Value; Handles Issued Before Become Stale
+	// -----------------------------------------------------
+	void clear()
+	{
+		while (!mValues.empty())
+		{
+			Handle handle;
+			handle.value = (mSlots[mValueSlots.back()].generation << INDEX_BITS) | mValueSlots.back();
+			erase(handle);
+		}
+	}
+
+private:
+	static const uint32_t NO_SLOT = ~0u & ~(1u << 31);
+	static const uint32_t FREE_BIT = 1u << 31;   // Set in Slot::dense While the Slot is Free
+
+	struct Slot
+	{
+		uint32_t dense;        // Index into mValues, or the Next Free Slot | FREE_BIT
+		uint32_t generation;
+	};
+
+	std::vector<T> mValues;             // Packed Live Values
+	std::vector<uint32_t> mValueSlots;  // Slot Owning Each Packed Value
+	std::vector<Slot> mSlots;
+	uint32_t mFreeHead = NO_SLOT;
+};
@@ -0,0 +1,378 @@
+#include "SpirvModule.h"
+
+#include <algorithm>       // max
+#include <iostream>        // cerr
+#include <unordered_map>   // unordered_map
+
+using namespace std;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	const uint32_t MAGIC = 0x07230203;
+	const size_t HEADER_WORDS = 5;
+
+	// Opcodes, Decorations and Storage Classes Read Here (SPIR-V Specification, Section 3)
+	// ------------------------------------------------------------------------------------
+	enum Opcode : uint32_t
+	{
+		OP_NAME = 5, OP_MEMBER_NAME = 6, OP_TYPE_INT = 21, OP_TYPE_FLOAT = 22, OP_TYPE_VECTOR = 23,
+		OP_TYPE_MATRIX = 24, OP_TYPE_IMAGE = 25, OP_TYPE_SAMPLED_IMAGE = 27, OP_TYPE_ARRAY = 28,
+		OP_TYPE_RUNTIME_ARRAY = 29, OP_TYPE_STRUCT = 30, OP_TYPE_POINTER = 32, OP_CONSTANT = 43,
+		OP_VARIABLE = 59, OP_DECORATE = 71, OP_MEMBER_DECORATE = 72
+	};
+
+	enum Decoration : uint32_t
+	{
+		DECORATION_BLOCK = 2, DECORATION_BUFFER_BLOCK = 3, DECORATION_ROW_MAJOR = 4, DECORATION_ARRAY_STRIDE = 6,
+		DECORATION_MATRIX_STRIDE = 7, DECORATION_BUILT_IN = 11, DECORATION_LOCATION = 30, DECORATION_BINDING = 33,
+		DECORATION_DESCRIPTOR_SET = 34, DECORATION_OFFSET = 35
+	};
+
+	enum StorageClass : uint32_t
+	{
+		STORAGE_UNIFORM_CONSTANT = 0, STORAGE_INPUT = 1, STORAGE_UNIFORM = 2, STORAGE_OUTPUT = 3, STORAGE_STORAGE_BUFFER = 12
+	};
+
+	const size_t NO_WORD = 0;   // Word Zero is the Magic Number, so No Decoration Literal Lives There
+
+	// Decorations of a Type, a Variable or a Struct Member
+	// ----------------------------------------------------
+	struct Decorations
+	{
+		bool block = false;
+		bool bufferBlock = false;
+		bool builtIn = false;
+		bool rowMajor = false;
+		uint32_t arrayStride = 0;
+		uint32_t matrixStride = 0;
+		uint32_t offset = 0;
+		bool hasOffset = false;
+		size_t locationWord = NO_WORD;
+		size_t bindingWord = NO_WORD;
+		size_t setWord = NO_WORD;
+	};
+
+	struct Type
+	{
+		uint32_t opcode = 0;
+		uint32_t component = 0;   // Vector Component, Matrix Column, Array Element, Image or Pointee Type
+		uint32_t count = 0;       // Vector Size, Matrix Columns or the Array Length's Constant
+		uint32_t storageClass = 0;
+		vector<uint32_t> members;
+	};
+
+	struct Variable
+	{
+		uint32_t id;
+		uint32_t pointerType;
+		uint32_t storageClass;
+	};
+
+	// Literal Strings are Packed Four Bytes to a Word, Lowest Byte First, and Null-Terminated
+	// ---------------------------------------------------------------------------------------
+	string literalString(const uint32_t* words, size_t count)
+	{
+		string text;
+		for (size_t i = 0; i < count; ++i)
+		{
+			for (int byte = 0; byte < 4; ++byte)
+			{
+				const char character = static_cast<char>((words[i] >> (8 * byte)) & 0xFF);
+				if (character == '\0')
+					return text;
+				text += character;
+			}
+		}
+
+		return text;
+	}
+
+	uint64_t memberKey(uint32_t structType, uint32_t member)
+	{
+		return (static_cast<uint64_t>(structType) << 32) | member;
+	}
+}
+
+bool SpirvModule::parse(const vector<uint32_t>& words)
+{
+	*this = SpirvModule();
+	mWords = words;
+
+	// Error Check: SPIR-V Header
+	// --------------------------
+	if (mWords.size() < HEADER_WORDS || mWords[0] != MAGIC)
+	{
+		cerr << "ERROR::SPIRV::NOT_A_MODULE " << mWords.size() << " Words" << endl;
+		return false;
+	}
+
+	unordered_map<uint32_t, string> names;
+	unordered_map<uint64_t, string> memberNames;
+	unordered_map<uint32_t, Decorations> decorations;
+	unordered_map<uint64_t, Decorations> memberDecorations;
+	unordered_map<uint32_t, Type> types;
+	unordered_map<uint32_t, uint32_t> constants;
+	vector<Variable> variables;
+
+	// One Pass Over the Instructions; Only Declarations Matter, Function Bodies are Skipped
+	// -------------------------------------------------------------------------------------
+	size_t i = HEADER_WORDS;
+	while (i < mWords.size())
+	{
+		const uint32_t* instruction = &mWords[i];
+		const size_t wordCount = instruction[0] >> 16;
+		const uint32_t opcode = instruction[0] & 0xFFFF;
+
+		// Error Check: Instruction Length
+		// -------------------------------
+		if (wordCount == 0 || i + wordCount > mWords.size())
+		{
+			cerr << "ERROR::SPIRV::TRUNCATED_INSTRUCTION at Word " << i << endl;
+			return false;
+		}
+
+		switch (opcode)
+		{
+			case OP_NAME:
+				if (wordCount > 2)
+					names[instruction[1]] = literalString(instruction + 2, wordCount - 2);
+				break;
+
+			case OP_MEMBER_NAME:
+				if (wordCount > 3)
+					memberNames[memberKey(instruction[1], instruction[2])] = literalString(instruction + 3, wordCount - 3);
+				break;
+
+			case OP_DECORATE:
+			{
+				if (wordCount < 3)
+					break;
+
+				Decorations& decorated = decorations[instruction[1]];
+				switch (instruction[2])
+				{
+					case DECORATION_BLOCK:          decorated.block = true; break;
+					case DECORATION_BUFFER_BLOCK:   decorated.bufferBlock = true; break;
+					case DECORATION_BUILT_IN:       decorated.builtIn = true; break;
+					case DECORATION_ARRAY_STRIDE:   decorated.arrayStride = wordCount > 3 ? instruction[3] : 0; break;
+					case DECORATION_LOCATION:       decorated.locationWord = wordCount > 3 ? i + 3 : NO_WORD; break;
+					case DECORATION_BINDING:        decorated.bindingWord = wordCount > 3 ? i + 3 : NO_WORD; break;
+					case DECORATION_DESCRIPTOR_SET: decorated.setWord = wordCount > 3 ? i + 3 : NO_WORD; break;
+				}
+				break;
+			}
+
+			case OP_MEMBER_DECORATE:
+			{
+				if (wordCount < 4)
+					break;
+
+				Decorations& decorated = memberDecorations[memberKey(instruction[1], instruction[2])];
+				switch (instruction[3])
+				{
+					case DECORATION_ROW_MAJOR:     decorated.rowMajor = true; break;
+					case DECORATION_BUILT_IN:      decorated.builtIn = true; break;
+					case DECORATION_MATRIX_STRIDE: decorated.matrixStride = wordCount > 4 ? instruction[4] : 0; break;
+					case DECORATION_OFFSET:
+						decorated.offset = wordCount > 4 ? instruction[4] : 0;
+						decorated.hasOffset = wordCount > 4;
+						break;
+				}
+				break;
+			}
+
+			case OP_TYPE_INT:
+			case OP_TYPE_FLOAT:
+			case OP_TYPE_IMAGE:
+				types[instruction[1]].opcode = opcode;
+				break;
+
+			case OP_TYPE_VECTOR:
+			case OP_TYPE_MATRIX:
+			case OP_TYPE_ARRAY:
+				if (wordCount > 3)
+				{
+					Type& type = types[instruction[1]];
+					type.opcode = opcode;
+					type.component = instruction[2];
+					type.count = instruction[3];
+				}
+				break;
+
+			case OP_TYPE_SAMPLED_IMAGE:
+			case OP_TYPE_RUNTIME_ARRAY:
+				if (wordCount > 2)
+				{
+					Type& type = types[instruction[1]];
+					type.opcode = opcode;
+					type.component = instruction[2];
+				}
+				break;
+
+			case OP_TYPE_STRUCT:
+			{
+				Type& type = types[instruction[1]];
+				type.opcode = opcode;
+				type.members.assign(instruction + 2, instruction + wordCount);
+				break;
+			}
+
+			case OP_TYPE_POINTER:
+				if (wordCount > 3)
+				{
+					Type& type = types[instruction[1]];
+					type.opcode = opcode;
+					type.component = instruction[3];
+					type.storageClass = instruction[2];
+				}
+				break;
+
+			case OP_CONSTANT:
+				if (wordCount > 3)
+					constants[instruction[2]] = instruction[3];
+				break;
+
+			case OP_VARIABLE:
+				if (wordCount > 3)
+					variables.push_back(Variable{ instruction[2], instruction[1], instruction[3] });
+				break;
+		}
+
+		i += wordCount;
+	}
+
+	// Variables by What they Point At
+	// -------------------------------
+	for (const Variable& variable : variables)
+	{
+		const uint32_t pointee = types[variable.pointerType].component;
+		const Type& type = types[pointee];
+		const Decorations& decorated = decorations[variable.id];
+		const Decorations& typeDecorated = decorations[pointee];
+		string name = names[variable.id];
+
+		const bool sampler = variable.storageClass == STORAGE_UNIFORM_CONSTANT && type.opcode == OP_TYPE_SAMPLED_IMAGE;
+		const bool uniformBlock = variable.storageClass == STORAGE_UNIFORM && typeDecorated.block;
+		const bool storageBuffer = (variable.storageClass == STORAGE_UNIFORM && typeDecorated.bufferBlock) ||
+			(variable.storageClass == STORAGE_STORAGE_BUFFER && typeDecorated.block);
+
+		if (sampler || uniformBlock || storageBuffer)
+		{
+			if (name.empty())
+				name = names[pointee];
+
+			// Error Check: Bindings were Mapped when the Module was Built
+			// -----------------------------------------------------------
+			if (decorated.setWord == NO_WORD || decorated.bindingWord == NO_WORD)
+			{
+				cerr << "ERROR::SPIRV::UNBOUND_RESOURCE " << name << " (Build with --auto-map-bindings)" << endl;
+				return false;
+			}
+
+			Resource resource;
+			resource.name = name;
+			resource.binding = mWords[decorated.bindingWord];
+			resource.setWord = decorated.setWord;
+			resource.bindingWord = decorated.bindingWord;
+
+			if (sampler)
+				mSamplers.push_back(resource);
+			else if (storageBuffer)
+				mStorageBuffers.push_back(resource);
+			else
+			{
+				// Error Check: Only the Default Block; the GLSL() Sources Declare No Others
+				// --------------------------------------------------------------------------
+				if (mHasUniformBlock)
+				{
+					cerr << "ERROR::SPIRV::SECOND_UNIFORM_BLOCK " << name << " after " << mUniformBlock.name << endl;
+					return false;
+				}
+
+				mHasUniformBlock = true;
+				mUniformBlock = resource;
+
+				for (uint32_t member = 0; member < type.members.size(); ++member)
+				{
+					const Decorations& memberDecorated = memberDecorations[memberKey(pointee, member)];
+					Member reflected;
+					reflected.name = memberNames[memberKey(pointee, member)];
+					reflected.offset = memberDecorated.offset;
+					reflected.matrixStride = memberDecorated.matrixStride;
+					reflected.rowMajor = memberDecorated.rowMajor;
+
+					uint32_t memberType = type.members[member];
+					if (types[memberType].opcode == OP_TYPE_ARRAY)
+					{
+						reflected.arrayLength = constants[types[memberType].count];
+						reflected.arrayStride = decorations[memberType].arrayStride;
+						memberType = types[memberType].component;
+					}
+					if (types[memberType].opcode == OP_TYPE_MATRIX)
+					{
+						reflected.columns = types[memberType].count;
+						memberType = types[memberType].component;
+					}
+					if (types[memberType].opcode == OP_TYPE_VECTOR)
+						reflected.rows = types[memberType].count;
+
+					// Error Check: Laid Out, and Built from 32-Bit Scalars
+					// ----------------------------------------------------
+					const uint32_t scalar = types[memberType].opcode == OP_TYPE_VECTOR ? types[types[memberType].component].opcode : types[memberType].opcode;
+					if (!memberDecorated.hasOffset || (scalar != OP_TYPE_FLOAT && scalar != OP_TYPE_INT) || reflected.arrayLength == 0)
+					{
+						cerr << "ERROR::SPIRV::UNSUPPORTED_UNIFORM " << reflected.name << " in " << name << endl;
+						return false;
+					}
+
+					const uint32_t elementBytes = (reflected.columns > 1)
+						? (reflected.rowMajor ? (reflected.rows - 1) * reflected.matrixStride + reflected.columns * 4 : (reflected.columns - 1) * reflected.matrixStride + reflected.rows * 4)
+						: reflected.rows * 4;
+					mUniformBlockSize = max(mUniformBlockSize, reflected.offset + (reflected.arrayLength - 1) * reflected.arrayStride + elementBytes);
+					mMembers.push_back(reflected);
+				}
+			}
+			continue;
+		}
+
+		// Stage Interface; Built-Ins are Decorated on the Variable or, in gl_PerVertex, its Members
+		// -----------------------------------------------------------------------------------------
+		if (variable.storageClass != STORAGE_INPUT && variable.storageClass != STORAGE_OUTPUT)
+			continue;
+
+		bool builtIn = decorated.builtIn;
+		for (uint32_t member = 0; member < type.members.size(); ++member)
+			builtIn = builtIn || memberDecorations[memberKey(pointee, member)].builtIn;
+		if (builtIn)
+			continue;
+
+		// Error Check: Locations were Mapped when the Module was Built
+		// ------------------------------------------------------------
+		if (decorated.locationWord == NO_WORD)
+		{
+			cerr << "ERROR::SPIRV::UNLOCATED_VARIABLE " << name << " (Build with --auto-map-locations)" << endl;
+			return false;
+		}
+
+		Interface reflected;
+		reflected.name = name;
+		reflected.location = mWords[decorated.locationWord];
+		reflected.locationWord = decorated.locationWord;
+		(variable.storageClass == STORAGE_INPUT ? mInputs : mOutputs).push_back(reflected);
+	}
+
+	return true;
+}
+
+void SpirvModule::setBinding(const Resource& resource, uint32_t set, uint32_t binding)
+{
+	mWords[resource.setWord] = set;
+	mWords[resource.bindingWord] = binding;
+}
+
+void SpirvModule::setLocation(const Interface& variable, uint32_t location)
+{
+	mWords[variable.locationWord] = location;
+}
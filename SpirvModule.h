@@ -0,0 +1,89 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <cstdint>        // uint32_t
+#include <string>         // string
+#include <vector>         // vector
+
+// Reflection and Binding Patches of One SPIR-V Shader Stage
+// ---------------------------------------------------------
+// Reads what a Vulkan backend needs from a module glslangValidator built out of a GLSL()
+// source with -R, which gathers the loose uniforms into one default uniform block, and
+// with locations and bindings mapped automatically: the default block's members with
+// their offsets and strides, the samplers and storage buffers, and the stage's inputs and
+// outputs. Each of those keeps the index of the word holding its set, binding or location,
+// so the backend can rewrite them in the module it keeps and the stages of a program agree
+// on one descriptor layout and one interface without any change to the GLSL.
+class SpirvModule
+{
+public:
+	// Default Uniform Block Member; Arrays of Vectors and Matrices Step by arrayStride
+	// --------------------------------------------------------------------------------
+	struct Member
+	{
+		std::string name;
+		uint32_t offset = 0;
+		uint32_t arrayLength = 1;     // 1 for Non-Arrays
+		uint32_t arrayStride = 0;
+		uint32_t columns = 1;         // Matrix Columns; 1 for Scalars and Vectors
+		uint32_t rows = 1;            // Vector or Column Components
+		uint32_t matrixStride = 0;
+		bool rowMajor = false;
+	};
+
+	// Sampler, Storage Buffer or the Default Uniform Block; Word Indices are into words()
+	// ------------------------------------------------------------------------------------
+	struct Resource
+	{
+		std::string name;
+		uint32_t binding = 0;
+		size_t setWord = 0;
+		size_t bindingWord = 0;
+	};
+
+	// Stage Input or Output Other than a Built-In
+	// -------------------------------------------
+	struct Interface
+	{
+		std::string name;
+		uint32_t location = 0;
+		size_t locationWord = 0;
+	};
+
+	// Error Check: False, with the Reason Printed, for Anything but a Well-Formed Module whose
+	// Resources and Interface Variables all Carry their Decorations
+	// ----------------------------------------------------------------------------------------
+	bool parse(const std::vector<uint32_t>& words);
+
+	bool hasUniformBlock() const { return mHasUniformBlock; }
+	const Resource& uniformBlock() const { return mUniformBlock; }
+	const std::vector<Member>& members() const { return mMembers; }
+	uint32_t uniformBlockSize() const { return mUniformBlockSize; }   // Bytes Up to the End of the Last Member
+
+	const std::vector<Resource>& samplers() const { return mSamplers; }
+	const std::vector<Resource>& storageBuffers() const { return mStorageBuffers; }
+	const std::vector<Interface>& inputs() const { return mInputs; }
+	const std::vector<Interface>& outputs() const { return mOutputs; }
+
+	// Patches Rewrite the Module's Words; Reflected Values Stay as Parsed
+	// -------------------------------------------------------------------
+	void setBinding(const Resource& resource, uint32_t set, uint32_t binding);
+	void setLocation(const Interface& variable, uint32_t location);
+
+	const std::vector<uint32_t>& words() const { return mWords; }
+
+private:
+	std::vector<uint32_t> mWords;
+
+	bool mHasUniformBlock = false;
+	Resource mUniformBlock;
+	std::vector<Member> mMembers;
+	uint32_t mUniformBlockSize = 0;
+
+	std::vector<Resource> mSamplers;
+	std::vector<Resource> mStorageBuffers;
+	std::vector<Interface> mInputs;
+	std::vector<Interface> mOutputs;
+};
@@ -0,0 +1,129 @@
+#include "StreamBuffer.h"
+
+#include <algorithm>   // max
+#include <iostream>    // cerr
+
+using namespace std;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	const size_t REGION_ALIGNMENT = 256;
+	const uint64_t STALL_WAIT_NANOSECONDS = 1000000;
+}
+
+bool StreamBuffer::create(RenderBackend& backend, size_t regionSize)
+{
+	mBackend = &backend;
+	mStalls = 0;
+	return createStorage(regionSize);
+}
+
+void StreamBuffer::destroy()
+{
+	if (!mBackend)
+		return;
+
+	destroyFences();
+
+	for (BufferId retired : mRetired)
+		mBackend->destroyBuffer(retired);
+	mRetired.clear();
+
+	mBackend->destroyBuffer(mBuffer);
+	mBuffer = 0;
+	mMapped = nullptr;
+}
+
+void StreamBuffer::destroyFences()
+{
+	for (FenceId& fence : mFences)
+	{
+		if (fence)
+			mBackend->destroyFence(fence);
+		fence = 0;
+	}
+}
+
+// One Stream Buffer Holding Every Region
+// --------------------------------------
+bool StreamBuffer::createStorage(size_t regionSize)
+{
+	// Regions Start on a Multiple of the Largest Offset Alignment Drivers Report
+	// --------------------------------------------------------------------------
+	mRegionSize = (regionSize + REGION_ALIGNMENT - 1) / REGION_ALIGNMENT * REGION_ALIGNMENT;
+	mRegion = 0;
+	mHead = 0;
+
+	mBuffer = mBackend->createBuffer(BufferType::Stream, mRegionSize * REGION_COUNT, nullptr);
+	mMapped = static_cast<char*>(mBackend->mappedData(mBuffer));
+
+	// Error Check: Persistent Mapping
+	// -------------------------------
+	if (!mMapped)
+	{
+		cerr << "ERROR::STREAM_BUFFER::MAP_FAILED " << (mRegionSize * REGION_COUNT) << " Bytes" << endl;
+		return false;
+	}
+
+	return true;
+}
+
+void StreamBuffer::beginFrame()
+{
+	// Outgrown Buffers were Only Referenced by the Previous Frame's Commands
+	// ----------------------------------------------------------------------
+	for (BufferId retired : mRetired)
+		mBackend->destroyBuffer(retired);
+	mRetired.clear();
+
+	if (mHead > 0)
+		mFences[mRegion] = mBackend->insertFence();
+
+	mRegion = (mRegion + 1) % REGION_COUNT;
+	mHead = 0;
+
+	// Error Check: the GPU may Still be Reading this Region
+	// -----------------------------------------------------
+	if (FenceId fence = mFences[mRegion])
+	{
+		if (!mBackend->waitFence(fence, 0))
+		{
+			++mStalls;
+			while (!mBackend->waitFence(fence, STALL_WAIT_NANOSECONDS))
+				;
+		}
+
+		mBackend->destroyFence(fence);
+		mFences[mRegion] = 0;
+	}
+}
+
+StreamBuffer::Allocation StreamBuffer::allocate(size_t size, size_t alignment)
+{
+	size_t offset = (mHead + alignment - 1) / alignment * alignment;
+
+	// Grow: Fresh Storage, and the Old Buffer Lives Until the Next Frame
+	// ------------------------------------------------------------------
+	if (offset + size > mRegionSize)
+	{
+		destroyFences();
+
+		mRetired.push_back(mBuffer);
+		if (!createStorage(max(mRegionSize * 2, size * 2)))
+			return Allocation();
+
+		offset = 0;
+	}
+
+	mHead = offset + size;
+
+	Allocation allocation;
+	allocation.buffer = mBuffer;
+	allocation.offset = mRegion * mRegionSize + offset;
+	allocation.size = size;
+	allocation.pointer = mMapped + allocation.offset;
+
+	return allocation;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <vector>         // vector
+
+#include "RenderBackend.h"
+
+// Persistently Mapped Streaming Buffer for Per-Frame Dynamic Data
+// ---------------------------------------------------------------
+// One backend stream buffer stays mapped for its whole lifetime and is split into
+// REGION_COUNT regions. Each frame bump-allocates out of one region and the CPU writes
+// straight through the returned pointer; the GPU reads the same memory by buffer and
+// offset, so there is no upload copy and no implicit sync. A fence is placed when a
+// region's frame is done, and beginFrame() only waits when the GPU is still REGION_COUNT
+// frames behind. An allocation that does not fit grows the buffer; the old one stays
+// valid for the rest of the frame and is deleted at the next frame.
+class StreamBuffer
+{
+public:
+	static const int REGION_COUNT = 3;
+
+	// Suballocation: Write Through pointer, Bind with buffer, offset and size
+	// -----------------------------------------------------------------------
+	struct Allocation
+	{
+		void* pointer = nullptr;
+		BufferId buffer = 0;
+		size_t offset = 0;
+		size_t size = 0;
+
+		template <typename T>
+		T* data() const { return static_cast<T*>(pointer); }
+	};
+
+	bool create(RenderBackend& backend, size_t regionSize);
+	void destroy();
+
+	// Fence the Region Just Used, Move to the Next and Wait Until the GPU is Done with it
+	// -----------------------------------------------------------------------------------
+	void beginFrame();
+
+	// Bump-Allocate from the Current Region; Offsets are Multiples of alignment
+	// -------------------------------------------------------------------------
+	Allocation allocate(size_t size, size_t alignment = 16);
+
+	size_t regionSize() const { return mRegionSize; }
+
+	// Frames where beginFrame() had to Block on the GPU
+	// -------------------------------------------------
+	int stallCount() const { return mStalls; }
+
+private:
+	bool createStorage(size_t regionSize);
+	void destroyFences();
+
+	RenderBackend* mBackend = nullptr;
+	BufferId mBuffer = 0;
+	char* mMapped = nullptr;
+	size_t mRegionSize = 0;
+	FenceId mFences[REGION_COUNT] = {};
+	int mRegion = 0;
+	size_t mHead = 0;                   // Bytes Used in the Current Region
+	std::vector<BufferId> mRetired;     // Outgrown Buffers Still Referenced by this Frame
+	int mStalls = 0;
+};
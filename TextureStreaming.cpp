@@ -0,0 +1,381 @@
+#include "TextureStreaming.h"
+
+#include <algorithm>   // min, max, copy
+#include <iostream>    // cerr
+#include <utility>     // move
+
+#include "MemoryTracker.h"
+
+using namespace std;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	const int MAX_TEXTURES = 0xFFFF;   // Slot + 1 Has to Fit the Feedback Target's 16 Bits
+
+	int levelSize(int size, int level)
+	{
+		return max(1, size >> level);
+	}
+}
+
+bool TextureStreamer::create(RenderBackend& backend, size_t budgetBytes)
+{
+	mBackend = &backend;
+	mBudgetBytes = budgetBytes;
+	mFrame = 0;
+	return true;
+}
+
+void TextureStreamer::destroy()
+{
+	if (!mBackend)
+		return;
+
+	for (StreamedTexture& texture : mTextures)
+	{
+		mBackend->destroyTexture(texture.texture);
+		MemoryTracker::releaseCpu(MemoryTracker::Category::CpuTextures, storageBytes(texture, 0));
+	}
+	mTextures.clear();
+	mResidentBytes = 0;
+
+	if (mFeedbackFence)
+		mBackend->destroyFence(mFeedbackFence);
+	mFeedbackFence = 0;
+	destroyFeedbackTarget();
+}
+
+int TextureStreamer::addTexture(const unsigned char* pixels, int width, int height, int channels)
+{
+	// Error Check: 8-Bit RGB or RGBA, and a Free Feedback Slot
+	// --------------------------------------------------------
+	if ((channels != 3 && channels != 4) || width <= 0 || height <= 0 || mTextures.size() >= MAX_TEXTURES)
+	{
+		cerr << "ERROR::TEXTURE_STREAMING::UNSUPPORTED_IMAGE " << width << "x" << height << "x" << channels << endl;
+		return -1;
+	}
+
+	StreamedTexture texture;
+	texture.width = width;
+	texture.height = height;
+
+	// Expand to RGBA so Every Level Uploads with 4-Byte Rows
+	// ------------------------------------------------------
+	const size_t texelCount = static_cast<size_t>(width) * height;
+	vector<unsigned char> base(texelCount * 4, 255);
+	for (size_t i = 0; i < texelCount; ++i)
+		copy(pixels + i * channels, pixels + (i + 1) * channels, base.begin() + i * 4);
+	texture.levels.push_back(move(base));
+
+	// 2x2 Box Filter Down to 1x1; an Odd Edge Repeats its Last Texel
+	// --------------------------------------------------------------
+	for (int level = 1; levelSize(width, level - 1) > 1 || levelSize(height, level - 1) > 1; ++level)
+	{
+		const vector<unsigned char>& source = texture.levels.back();
+		const int sourceWidth = levelSize(width, level - 1);
+		const int sourceHeight = levelSize(height, level - 1);
+		const int levelWidth = levelSize(width, level);
+		const int levelHeight = levelSize(height, level);
+
+		vector<unsigned char> filtered(static_cast<size_t>(levelWidth) * levelHeight * 4);
+		for (int y = 0; y < levelHeight; ++y)
+		{
+			const int y0 = min(y * 2, sourceHeight - 1);
+			const int y1 = min(y * 2 + 1, sourceHeight - 1);
+			for (int x = 0; x < levelWidth; ++x)
+			{
+				const int x0 = min(x * 2, sourceWidth - 1);
+				const int x1 = min(x * 2 + 1, sourceWidth - 1);
+				for (int c = 0; c < 4; ++c)
+				{
+					const int sum = source[(y0 * sourceWidth + x0) * 4 + c] + source[(y0 * sourceWidth + x1) * 4 + c]
+						+ source[(y1 * sourceWidth + x0) * 4 + c] + source[(y1 * sourceWidth + x1) * 4 + c];
+					filtered[(y * levelWidth + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+				}
+			}
+		}
+		texture.levels.push_back(move(filtered));
+	}
+
+	// Only the Coarsest Levels are Resident at Startup
+	// ------------------------------------------------
+	while (max(levelSize(width, texture.minimumLevel), levelSize(height, texture.minimumLevel)) > STARTUP_MIP_SIZE)
+		++texture.minimumLevel;
+
+	texture.requestedLevel = texture.minimumLevel;
+	texture.loadedLevel = levelCount(texture);
+	reallocate(texture, texture.minimumLevel);
+	for (int level = levelCount(texture) - 1; level >= texture.minimumLevel; --level)
+		uploadLevel(texture, level);
+
+	MemoryTracker::allocateCpu(MemoryTracker::Category::CpuTextures, storageBytes(texture, 0));
+	mTextures.push_back(move(texture));
+	mResidencyChanged = true;
+	return static_cast<int>(mTextures.size()) - 1;
+}
+
+size_t TextureStreamer::storageBytes(const StreamedTexture& texture, int firstLevel)
+{
+	size_t bytes = 0;
+	for (int level = firstLevel; level < levelCount(texture); ++level)
+		bytes += static_cast<size_t>(levelSize(texture.width, level)) * levelSize(texture.height, level) * 4;
+	return bytes;
+}
+
+// RG16UI Slot and Mip Target with its Own Depth, and the Readback Buffer it is Read Into
+// --------------------------------------------------------------------------------------
+bool TextureStreamer::createFeedbackTarget(int width, int height)
+{
+	mFeedbackWidth = width;
+	mFeedbackHeight = height;
+
+	TextureDesc desc;
+	desc.width = width;
+	desc.height = height;
+	desc.format = TextureFormat::RG16UI;
+	desc.filter = TextureFilter::Nearest;
+	desc.wrap = TextureWrap::ClampToEdge;
+	desc.levels = 1;
+	desc.renderTarget = true;
+	mFeedbackColor = mBackend->createTexture(desc, nullptr);
+
+	desc.format = TextureFormat::Depth24;
+	mFeedbackDepth = mBackend->createTexture(desc, nullptr);
+
+	// Error Check: Feedback Target Completeness
+	// -----------------------------------------
+	if (mFeedbackColor && mFeedbackDepth)
+		mFeedbackTarget = mBackend->createRenderTarget(&mFeedbackColor, 1, mFeedbackDepth);
+	if (!mFeedbackTarget)
+	{
+		cerr << "ERROR::TEXTURE_STREAMING::FEEDBACK_INCOMPLETE " << width << "x" << height << endl;
+		destroyFeedbackTarget();
+		return false;
+	}
+
+	mFeedbackBuffer = mBackend->createBuffer(BufferType::Readback, static_cast<size_t>(width) * height * 2 * sizeof(uint16_t), nullptr);
+	return mFeedbackBuffer != 0;
+}
+
+void TextureStreamer::destroyFeedbackTarget()
+{
+	mBackend->destroyRenderTarget(mFeedbackTarget);
+	mBackend->destroyTexture(mFeedbackColor);
+	mBackend->destroyTexture(mFeedbackDepth);
+	mBackend->destroyBuffer(mFeedbackBuffer);
+	mFeedbackTarget = mFeedbackColor = mFeedbackDepth = mFeedbackBuffer = 0;
+	mFeedbackWidth = mFeedbackHeight = 0;
+}
+
+bool TextureStreamer::beginFeedback(int windowWidth, int windowHeight)
+{
+	// One Readback in Flight at a Time
+	// --------------------------------
+	if (mFeedbackFence || ++mFrame % FEEDBACK_INTERVAL != 0)
+		return false;
+
+	const int width = max(1, windowWidth / FEEDBACK_DIVISOR);
+	const int height = max(1, windowHeight / FEEDBACK_DIVISOR);
+	if (width != mFeedbackWidth || height != mFeedbackHeight || !mFeedbackTarget)
+	{
+		destroyFeedbackTarget();
+		if (!createFeedbackTarget(width, height))
+			return false;
+	}
+
+	return true;
+}
+
+void TextureStreamer::endFeedback()
+{
+	mBackend->readRenderTarget(mFeedbackTarget, mFeedbackWidth, mFeedbackHeight, mFeedbackBuffer);
+	mFeedbackFence = mBackend->insertFence();
+}
+
+// Finest Level any Feedback Pixel Asked For; Never Waits on the GPU
+// -----------------------------------------------------------------
+bool TextureStreamer::readFeedback()
+{
+	if (!mFeedbackFence)
+		return false;
+
+	if (!mBackend->waitFence(mFeedbackFence, 0))
+		return false;
+
+	mBackend->destroyFence(mFeedbackFence);
+	mFeedbackFence = 0;
+
+	for (StreamedTexture& texture : mTextures)
+		texture.requested = false;
+
+	const size_t pixelCount = static_cast<size_t>(mFeedbackWidth) * mFeedbackHeight;
+	const uint16_t* pixels = static_cast<const uint16_t*>(mBackend->mappedData(mFeedbackBuffer));
+	if (pixels)
+	{
+		for (size_t i = 0; i < pixelCount; ++i)
+		{
+			const size_t slot = pixels[i * 2];
+			if (slot == 0 || slot > mTextures.size())
+				continue;
+
+			StreamedTexture& texture = mTextures[slot - 1];
+			const int level = min(static_cast<int>(pixels[i * 2 + 1]), levelCount(texture) - 1);
+			if (!texture.requested || level < texture.requestedLevel)
+			{
+				texture.requestedLevel = level;
+				texture.requested = true;
+			}
+		}
+	}
+
+	return pixels != nullptr;
+}
+
+// Requested Levels Under the Budget: Cached Levels Nobody Asked for Go First, then the
+// Largest Requests are Coarsened; Nothing Drops Below its Startup Levels
+// ------------------------------------------------------------------------------------
+void TextureStreamer::planResidency(vector<int>& targetLevels) const
+{
+	targetLevels.resize(mTextures.size());
+	size_t totalBytes = 0;
+	for (size_t i = 0; i < mTextures.size(); ++i)
+	{
+		const StreamedTexture& texture = mTextures[i];
+		targetLevels[i] = texture.requested ? min(texture.requestedLevel, texture.allocatedLevel) : texture.allocatedLevel;
+		totalBytes += storageBytes(texture, targetLevels[i]);
+	}
+
+	while (totalBytes > mBudgetBytes)
+	{
+		int best = -1;
+		bool bestIsCache = false;
+		size_t bestBytes = 0;
+		for (size_t i = 0; i < mTextures.size(); ++i)
+		{
+			const StreamedTexture& texture = mTextures[i];
+			if (targetLevels[i] >= texture.minimumLevel)
+				continue;
+
+			const int neededLevel = texture.requested ? min(texture.requestedLevel, texture.minimumLevel) : texture.minimumLevel;
+			const bool isCache = targetLevels[i] < neededLevel;
+			const size_t bytes = storageBytes(texture, targetLevels[i]);
+			if (best < 0 || (isCache && !bestIsCache) || (isCache == bestIsCache && bytes > bestBytes))
+			{
+				best = static_cast<int>(i);
+				bestIsCache = isCache;
+				bestBytes = bytes;
+			}
+		}
+
+		// Error Check: the Startup Levels Alone Exceed the Budget
+		// -------------------------------------------------------
+		if (best < 0)
+			break;
+
+		totalBytes -= bestBytes - storageBytes(mTextures[best], targetLevels[best] + 1);
+		++targetLevels[best];
+	}
+}
+
+void TextureStreamer::update()
+{
+	// Shrink First so Growing Never Overshoots the Budget
+	// ---------------------------------------------------
+	if (readFeedback())
+	{
+		vector<int> targetLevels;
+		planResidency(targetLevels);
+		mResidencyChanged = false;
+
+		for (size_t i = 0; i < mTextures.size(); ++i)
+		{
+			if (targetLevels[i] > mTextures[i].allocatedLevel)
+			{
+				reallocate(mTextures[i], targetLevels[i]);
+				mResidencyChanged = true;
+			}
+		}
+
+		for (size_t i = 0; i < mTextures.size(); ++i)
+		{
+			if (targetLevels[i] < mTextures[i].allocatedLevel)
+			{
+				reallocate(mTextures[i], targetLevels[i]);
+				mResidencyChanged = true;
+			}
+		}
+	}
+
+	// Fill Allocated Levels a Few per Frame, Coarse to Fine, Round-Robin Across Textures
+	// ---------------------------------------------------------------------------------
+	int uploads = 0;
+	for (size_t visited = 0; visited < mTextures.size() && uploads < UPLOADS_PER_FRAME; ++visited)
+	{
+		StreamedTexture& texture = mTextures[mUploadCursor];
+		mUploadCursor = (mUploadCursor + 1) % mTextures.size();
+
+		if (texture.loadedLevel > texture.allocatedLevel)
+		{
+			uploadLevel(texture, texture.loadedLevel - 1);
+			++uploads;
+		}
+	}
+}
+
+bool TextureStreamer::isStreaming() const
+{
+	if (mFeedbackFence || mResidencyChanged)
+		return true;
+
+	for (const StreamedTexture& texture : mTextures)
+	{
+		if (texture.loadedLevel > texture.allocatedLevel)
+			return true;
+	}
+
+	return false;
+}
+
+// New Storage Holding firstLevel and Coarser; Filled Levels Both Storages Share are Copied
+// ----------------------------------------------------------------------------------------
+void TextureStreamer::reallocate(StreamedTexture& texture, int firstLevel)
+{
+	TextureDesc desc;
+	desc.width = levelSize(texture.width, firstLevel);
+	desc.height = levelSize(texture.height, firstLevel);
+	desc.filter = TextureFilter::Trilinear;
+	desc.levels = levelCount(texture) - firstLevel;
+	const TextureId replacement = mBackend->createTexture(desc, nullptr);
+
+	int keptLevel = levelCount(texture);
+	if (texture.texture)
+	{
+		keptLevel = max(firstLevel, texture.loadedLevel);
+		for (int level = keptLevel; level < levelCount(texture); ++level)
+			mBackend->copyTextureLevel(texture.texture, level - texture.allocatedLevel, replacement, level - firstLevel);
+
+		mEvictedLevels += max(0, firstLevel - texture.loadedLevel);
+		mResidentBytes -= storageBytes(texture, texture.allocatedLevel);
+		mBackend->destroyTexture(texture.texture);
+	}
+
+	// Sampling Starts at the Finest Filled Level
+	// ------------------------------------------
+	mBackend->setTextureBaseLevel(replacement, min(keptLevel, levelCount(texture) - 1) - firstLevel);
+
+	texture.texture = replacement;
+	texture.allocatedLevel = firstLevel;
+	texture.loadedLevel = keptLevel;
+	mResidentBytes += storageBytes(texture, firstLevel);
+}
+
+void TextureStreamer::uploadLevel(StreamedTexture& texture, int level)
+{
+	mBackend->updateTexture(texture.texture, level - texture.allocatedLevel, texture.levels[level].data());
+	mBackend->setTextureBaseLevel(texture.texture, level - texture.allocatedLevel);
+
+	texture.loadedLevel = level;
+	++mUploadedLevels;
+}
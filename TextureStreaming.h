@@ -0,0 +1,111 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <vector>         // vector
+
+#include "RenderBackend.h"
+
+// Mip-Level Texture Streaming Driven by a Residency Feedback Pass
+// ---------------------------------------------------------------
+// Each texture's full RGBA8 mip chain stays in system memory (standing in for the file on
+// disk); only the levels no larger than STARTUP_MIP_SIZE are uploaded when it is added.
+// Every FEEDBACK_INTERVAL frames the caller draws the scene into a small feedback target,
+// writing each pixel's texture slot and the mip it would sample at full resolution, and the
+// target is read back through a readback buffer with a fence, so the CPU never waits for it.
+// A finished readback gives each texture the finest level any pixel asked for. Textures no
+// pixel touched keep their levels as a cache but are coarsened first when the requests do
+// not fit the memory budget, then the finest requests are coarsened one level at a time.
+// A texture's backend storage only holds its resident levels, so growing or shrinking it
+// creates a new texture and copies the levels already there on the GPU. New finer levels
+// are then uploaded a few per frame, with the base level hiding the ones not yet filled.
+// The texture handle changes on reallocation: look it up by slot each time it is bound.
+class TextureStreamer
+{
+public:
+	static const int STARTUP_MIP_SIZE = 32;         // Largest Edge of the Levels Uploaded at Startup
+	static const int FEEDBACK_DIVISOR = 8;          // Feedback Target is 1/8 of the Window on Each Axis
+	static const int FEEDBACK_INTERVAL = 4;         // Frames Between Feedback Passes
+	static const int UPLOADS_PER_FRAME = 4;         // Mip Levels Uploaded per update()
+
+	bool create(RenderBackend& backend, size_t budgetBytes);
+	void destroy();
+
+	// Register an 8-Bit RGB or RGBA Image; Returns its Slot, or -1 if it Could Not be Added
+	// ------------------------------------------------------------------------------------
+	int addTexture(const unsigned char* pixels, int width, int height, int channels);
+
+	TextureId textureId(int slot) const { return mTextures[slot].texture; }
+	int width(int slot) const { return mTextures[slot].width; }      // Full-Resolution Size
+	int height(int slot) const { return mTextures[slot].height; }
+
+	// Size the Feedback Target for the Caller's Pass, which Clears its Color to Zero and its
+	// Depth; False on Frames Without One
+	// ---------------------------------------------------------------------------------------
+	bool beginFeedback(int windowWidth, int windowHeight);
+
+	// Queue the Feedback Readback Once the Pass has Ended
+	// ---------------------------------------------------
+	void endFeedback();
+
+	RenderTargetId feedbackTarget() const { return mFeedbackTarget; }
+	int feedbackWidth() const { return mFeedbackWidth; }
+	int feedbackHeight() const { return mFeedbackHeight; }
+
+	// Consume a Finished Readback, then Reallocate and Upload Towards the Requested Levels
+	// -----------------------------------------------------------------------------------
+	void update();
+
+	size_t textureCount() const { return mTextures.size(); }
+	size_t residentBytes() const { return mResidentBytes; }
+	size_t budgetBytes() const { return mBudgetBytes; }
+	size_t uploadedLevelCount() const { return mUploadedLevels; }   // Since Startup
+	size_t evictedLevelCount() const { return mEvictedLevels; }
+
+	// True Until a Feedback Pass Finds Nothing to Change and Every Level is Uploaded
+	// ------------------------------------------------------------------------------
+	bool isStreaming() const;
+
+private:
+	struct StreamedTexture
+	{
+		std::vector<std::vector<unsigned char>> levels;   // RGBA8, Level 0 First
+		int width = 0;
+		int height = 0;
+		TextureId texture = 0;
+		int allocatedLevel = 0;    // Finest Level the Storage Holds
+		int loadedLevel = 0;       // Finest Level Filled; BASE_LEVEL Hides the Ones Between
+		int minimumLevel = 0;      // Always Resident
+		int requestedLevel = 0;    // From the Latest Feedback
+		bool requested = false;    // Any Pixel Sampled it in the Latest Feedback
+	};
+
+	static int levelCount(const StreamedTexture& texture) { return static_cast<int>(texture.levels.size()); }
+	static size_t storageBytes(const StreamedTexture& texture, int firstLevel);
+
+	bool createFeedbackTarget(int width, int height);
+	void destroyFeedbackTarget();
+	bool readFeedback();
+	void planResidency(std::vector<int>& targetLevels) const;
+	void reallocate(StreamedTexture& texture, int firstLevel);
+	void uploadLevel(StreamedTexture& texture, int level);
+
+	RenderBackend* mBackend = nullptr;
+	std::vector<StreamedTexture> mTextures;
+	size_t mBudgetBytes = 0;
+	size_t mResidentBytes = 0;
+	size_t mUploadedLevels = 0;
+	size_t mEvictedLevels = 0;
+	size_t mUploadCursor = 0;      // Round-Robin Start of the Next update()'s Uploads
+	bool mResidencyChanged = true; // The Latest Feedback Reallocated Something; True Until the First
+
+	RenderTargetId mFeedbackTarget = 0;
+	TextureId mFeedbackColor = 0;  // RG16UI: Texture Slot + 1 (0 = None) and Mip Level
+	TextureId mFeedbackDepth = 0;
+	BufferId mFeedbackBuffer = 0;  // Readback Buffer the Pixels Land In
+	FenceId mFeedbackFence = 0;    // Set While a Readback is in Flight
+	int mFeedbackWidth = 0;
+	int mFeedbackHeight = 0;
+	int mFrame = 0;
+};
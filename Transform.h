@@ -0,0 +1,28 @@
+#pragma once
+
+// Includes
+// -------
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+
+// Object Transform: Scale, Euler Rotation and Translation
+// -------------------------------------------------------
+struct Transform
+{
+	glm::vec3 scale = glm::vec3(1.0f);
+	glm::vec3 rotation = glm::vec3(0.0f);      // Radians About the X, Y and Z Axes
+	glm::vec3 translation = glm::vec3(0.0f);
+};
+
+// Builds the Model Matrix: Transformations are Applied Right-To-Left
+// ------------------------------------------------------------------
+inline glm::mat4 composeModelMatrix(const Transform& transform)
+{
+	glm::mat4 scale = glm::scale(transform.scale);
+	glm::mat4 xRotation = glm::rotate(transform.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
+	glm::mat4 yRotation = glm::rotate(transform.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
+	glm::mat4 zRotation = glm::rotate(transform.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
+	glm::mat4 translation = glm::translate(transform.translation);
+
+	return translation * (yRotation * xRotation * zRotation) * scale;
+}
@@ -0,0 +1,265 @@
+#include "TransformBatch.h"
+
+#include <algorithm>   // min
+#include <cmath>       // floor
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRANSFORM_BATCH_SSE2
+#endif
+
+using namespace std;
+using namespace glm;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+#if defined(__AVX__)
+
+	// AVX: 8 Lanes
+	// ------------
+	struct Lanes
+	{
+		static const size_t COUNT = 8;
+		__m256 v;
+
+		static Lanes load(const float* source) { return { _mm256_loadu_ps(source) }; }
+		static Lanes splat(float value) { return { _mm256_set1_ps(value) }; }
+		void store(float* destination) const { _mm256_storeu_ps(destination, v); }
+	};
+
+	inline Lanes operator+(Lanes a, Lanes b) { return { _mm256_add_ps(a.v, b.v) }; }
+	inline Lanes operator-(Lanes a, Lanes b) { return { _mm256_sub_ps(a.v, b.v) }; }
+	inline Lanes operator*(Lanes a, Lanes b) { return { _mm256_mul_ps(a.v, b.v) }; }
+	inline Lanes operator/(Lanes a, Lanes b) { return { _mm256_div_ps(a.v, b.v) }; }
+	inline Lanes operator|(Lanes a, Lanes b) { return { _mm256_or_ps(a.v, b.v) }; }
+	inline Lanes operator^(Lanes a, Lanes b) { return { _mm256_xor_ps(a.v, b.v) }; }
+	inline Lanes operator&(Lanes a, Lanes b) { return { _mm256_and_ps(a.v, b.v) }; }
+	inline Lanes equal(Lanes a, Lanes b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ) }; }
+	inline Lanes greaterEqual(Lanes a, Lanes b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+	inline Lanes select(Lanes mask, Lanes a, Lanes b) { return { _mm256_blendv_ps(b.v, a.v, mask.v) }; }
+	inline Lanes roundNearest(Lanes a) { return { _mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) }; }
+	inline Lanes floorLanes(Lanes a) { return { _mm256_floor_ps(a.v) }; }
+
+#elif defined(TRANSFORM_BATCH_SSE2)
+
+	// SSE2: 4 Lanes, the Baseline for Every x64 CPU
+	// ---------------------------------------------
+	struct Lanes
+	{
+		static const size_t COUNT = 4;
+		__m128 v;
+
+		static Lanes load(const float* source) { return { _mm_loadu_ps(source) }; }
+		static Lanes splat(float value) { return { _mm_set1_ps(value) }; }
+		void store(float* destination) const { _mm_storeu_ps(destination, v); }
+	};
+
+	inline Lanes operator+(Lanes a, Lanes b) { return { _mm_add_ps(a.v, b.v) }; }
+	inline Lanes operator-(Lanes a, Lanes b) { return { _mm_sub_ps(a.v, b.v) }; }
+	inline Lanes operator*(Lanes a, Lanes b) { return { _mm_mul_ps(a.v, b.v) }; }
+	inline Lanes operator/(Lanes a, Lanes b) { return { _mm_div_ps(a.v, b.v) }; }
+	inline Lanes operator|(Lanes a, Lanes b) { return { _mm_or_ps(a.v, b.v) }; }
+	inline Lanes operator^(Lanes a, Lanes b) { return { _mm_xor_ps(a.v, b.v) }; }
+	inline Lanes operator&(Lanes a, Lanes b) { return { _mm_and_ps(a.v, b.v) }; }
+	inline Lanes equal(Lanes a, Lanes b) { return { _mm_cmpeq_ps(a.v, b.v) }; }
+	inline Lanes greaterEqual(Lanes a, Lanes b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+	inline Lanes select(Lanes mask, Lanes a, Lanes b) { return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) }; }
+	inline Lanes roundNearest(Lanes a) { return { _mm_cvtepi32_ps(_mm_cvtps_epi32(a.v)) }; }
+
+	inline Lanes floorLanes(Lanes a)
+	{
+		__m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+		return { _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, a.v), _mm_set1_ps(1.0f))) };
+	}
+
+#else
+
+	// Scalar Fallback: 1 Lane
+	// -----------------------
+	struct Lanes
+	{
+		static const size_t COUNT = 1;
+		float v;
+
+		static Lanes load(const float* source) { return { *source }; }
+		static Lanes splat(float value) { return { value }; }
+		void store(float* destination) const { *destination = v; }
+	};
+
+	inline Lanes operator+(Lanes a, Lanes b) { return { a.v + b.v }; }
+	inline Lanes operator-(Lanes a, Lanes b) { return { a.v - b.v }; }
+	inline Lanes operator*(Lanes a, Lanes b) { return { a.v * b.v }; }
+	inline Lanes operator/(Lanes a, Lanes b) { return { a.v / b.v }; }
+	inline Lanes equal(Lanes a, Lanes b) { return { a.v == b.v ? 1.0f : 0.0f }; }
+	inline Lanes greaterEqual(Lanes a, Lanes b) { return { a.v >= b.v ? 1.0f : 0.0f }; }
+	inline Lanes operator|(Lanes a, Lanes b) { return { (a.v != 0.0f || b.v != 0.0f) ? 1.0f : 0.0f }; }
+	inline Lanes select(Lanes mask, Lanes a, Lanes b) { return mask.v != 0.0f ? a : b; }
+	inline Lanes roundNearest(Lanes a) { return { std::floor(a.v + 0.5f) }; }
+	inline Lanes floorLanes(Lanes a) { return { std::floor(a.v) }; }
+
+	// Sign Flips are Plain Negation Without Bit Masks
+	// -----------------------------------------------
+	inline Lanes negateWhere(Lanes mask, Lanes a) { return { mask.v != 0.0f ? -a.v : a.v }; }
+
+#endif
+
+#if defined(__AVX__) || defined(TRANSFORM_BATCH_SSE2)
+
+	// Flip the Sign Bit of Every Lane where mask is Set
+	// -------------------------------------------------
+	inline Lanes negateWhere(Lanes mask, Lanes a) { return a ^ (mask & Lanes::splat(-0.0f)); }
+
+#endif
+
+	// Sine and Cosine Together: Reduce to [-Pi/4, Pi/4] by Quadrant, then Minimax Polynomials
+	// ---------------------------------------------------------------------------------------
+	inline void sinCos(Lanes angle, Lanes& sine, Lanes& cosine)
+	{
+		// Quadrant = round(angle / (Pi/2)), Subtracted in Three Parts to Keep Precision
+		// -----------------------------------------------------------------------------
+		Lanes quadrant = roundNearest(angle * Lanes::splat(0.636619772f));
+		Lanes x = angle - quadrant * Lanes::splat(1.5703125f);
+		x = x - quadrant * Lanes::splat(4.837512969970703125e-4f);
+		x = x - quadrant * Lanes::splat(7.54978995489188216e-8f);
+
+		Lanes x2 = x * x;
+		Lanes s = x + x * x2 * (Lanes::splat(-1.6666654611e-1f) + x2 * (Lanes::splat(8.3321608736e-3f) + x2 * Lanes::splat(-1.9515295891e-4f)));
+		Lanes c = Lanes::splat(1.0f) - Lanes::splat(0.5f) * x2
+			+ x2 * x2 * (Lanes::splat(4.166664568298827e-2f) + x2 * (Lanes::splat(-1.388731625493765e-3f) + x2 * Lanes::splat(2.443315711809948e-5f)));
+
+		// Quadrant Modulo 4 Decides the Swap and Signs
+		// --------------------------------------------
+		Lanes q = quadrant - Lanes::splat(4.0f) * floorLanes(quadrant * Lanes::splat(0.25f));
+		Lanes one = equal(q, Lanes::splat(1.0f));
+		Lanes two = equal(q, Lanes::splat(2.0f));
+		Lanes three = equal(q, Lanes::splat(3.0f));
+		Lanes swap = one | three;
+
+		sine = negateWhere(greaterEqual(q, Lanes::splat(2.0f)), select(swap, c, s));
+		cosine = negateWhere(one | two, select(swap, s, c));
+	}
+}
+
+const size_t TransformBatch::LANE_COUNT = Lanes::COUNT;
+
+const char* TransformBatch::instructionSet()
+{
+#if defined(__AVX__)
+	return "AVX";
+#elif defined(TRANSFORM_BATCH_SSE2)
+	return "SSE2";
+#else
+	return "Scalar";
+#endif
+}
+
+void TransformBatch::resize(size_t count)
+{
+	mCount = count;
+	++mVersion;
+
+	// Padding Lanes Hold the Identity so the Kernel Never Divides by Zero
+	// -------------------------------------------------------------------
+	for (int component = 0; component < COMPONENT_COUNT; ++component)
+	{
+		float padding = (component <= SCALE_Z) ? 1.0f : 0.0f;
+		mComponents[component].resize(count + LANE_COUNT, padding);
+		fill(mComponents[component].begin() + count, mComponents[component].end(), padding);
+	}
+}
+
+void TransformBatch::add(const Transform& transform)
+{
+	resize(mCount + 1);
+	set(mCount - 1, transform);
+}
+
+void TransformBatch::set(size_t index, const Transform& transform)
+{
+	const float values[COMPONENT_COUNT] =
+	{
+		transform.scale.x, transform.scale.y, transform.scale.z,
+		transform.rotation.x, transform.rotation.y, transform.rotation.z,
+		transform.translation.x, transform.translation.y, transform.translation.z
+	};
+
+	for (int component = 0; component < COMPONENT_COUNT; ++component)
+		mComponents[component][index] = values[component];
+	++mVersion;
+}
+
+Transform TransformBatch::get(size_t index) const
+{
+	Transform transform;
+	transform.scale = vec3(mComponents[SCALE_X][index], mComponents[SCALE_Y][index], mComponents[SCALE_Z][index]);
+	transform.rotation = vec3(mComponents[ROTATION_X][index], mComponents[ROTATION_Y][index], mComponents[ROTATION_Z][index]);
+	transform.translation = vec3(mComponents[TRANSLATION_X][index], mComponents[TRANSLATION_Y][index], mComponents[TRANSLATION_Z][index]);
+
+	return transform;
+}
+
+void TransformBatch::compose(size_t begin, size_t end, mat4* models, mat3* normals) const
+{
+	for (size_t first = begin; first < end; first += Lanes::COUNT)
+	{
+		Lanes scaleX = Lanes::load(&mComponents[SCALE_X][first]);
+		Lanes scaleY = Lanes::load(&mComponents[SCALE_Y][first]);
+		Lanes scaleZ = Lanes::load(&mComponents[SCALE_Z][first]);
+
+		Lanes sinX, cosX, sinY, cosY, sinZ, cosZ;
+		sinCos(Lanes::load(&mComponents[ROTATION_X][first]), sinX, cosX);
+		sinCos(Lanes::load(&mComponents[ROTATION_Y][first]), sinY, cosY);
+		sinCos(Lanes::load(&mComponents[ROTATION_Z][first]), sinZ, cosZ);
+
+		// Rotation = Y * X * Z, Matching composeModelMatrix(); r[column][row]
+		// -------------------------------------------------------------------
+		Lanes sinYsinX = sinY * sinX;
+		Lanes cosYsinX = cosY * sinX;
+		Lanes r[3][3] =
+		{
+			{ cosY * cosZ + sinYsinX * sinZ, cosX * sinZ, cosYsinX * sinZ - sinY * cosZ },
+			{ sinYsinX * cosZ - cosY * sinZ, cosX * cosZ, sinY * sinZ + cosYsinX * cosZ },
+			{ sinY * cosX, Lanes::splat(0.0f) - sinX, cosY * cosX }
+		};
+
+		// Model Columns are Rotation * Scale; Normal Columns are Rotation / Scale
+		// -----------------------------------------------------------------------
+		const Lanes scales[3] = { scaleX, scaleY, scaleZ };
+		float model[12][Lanes::COUNT];
+		float normal[9][Lanes::COUNT];
+
+		for (int column = 0; column < 3; ++column)
+		{
+			for (int row = 0; row < 3; ++row)
+			{
+				(r[column][row] * scales[column]).store(model[column * 3 + row]);
+				(r[column][row] / scales[column]).store(normal[column * 3 + row]);
+			}
+		}
+
+		Lanes::load(&mComponents[TRANSLATION_X][first]).store(model[9]);
+		Lanes::load(&mComponents[TRANSLATION_Y][first]).store(model[10]);
+		Lanes::load(&mComponents[TRANSLATION_Z][first]).store(model[11]);
+
+		// Back to One Matrix per Object
+		// -----------------------------
+		size_t count = min(Lanes::COUNT, end - first);
+		for (size_t lane = 0; lane < count; ++lane)
+		{
+			mat4& m = models[first + lane];
+			m[0] = vec4(model[0][lane], model[1][lane], model[2][lane], 0.0f);
+			m[1] = vec4(model[3][lane], model[4][lane], model[5][lane], 0.0f);
+			m[2] = vec4(model[6][lane], model[7][lane], model[8][lane], 0.0f);
+			m[3] = vec4(model[9][lane], model[10][lane], model[11][lane], 1.0f);
+
+			mat3& n = normals[first + lane];
+			n[0] = vec3(normal[0][lane], normal[1][lane], normal[2][lane]);
+			n[1] = vec3(normal[3][lane], normal[4][lane], normal[5][lane]);
+			n[2] = vec3(normal[6][lane], normal[7][lane], normal[8][lane]);
+		}
+	}
+}
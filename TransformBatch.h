@@ -0,0 +1,56 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+#include <vector>         // vector
+#include <glm/glm.hpp>
+
+#include "Transform.h"
+
+// Structure-of-Arrays Transforms Composed with SIMD
+// -------------------------------------------------
+// Every transform component is stored in its own array, so the kernel loads the same
+// component of 4 (SSE) or 8 (AVX, when the compiler targets it) objects per instruction
+// and composes that many model matrices at once. Alongside each model matrix it writes
+// the normal matrix, the inverse-transpose of the upper 3x3. For translate * rotate * scale
+// that is rotate * inverse(scale), so the per-vertex inverse in the shader is replaced by
+// three divides per object on the CPU.
+class TransformBatch
+{
+public:
+	static const size_t LANE_COUNT;   // Objects per SIMD Register
+
+	// Name of the Instruction Set the Kernel was Compiled For
+	// -------------------------------------------------------
+	static const char* instructionSet();
+
+	size_t size() const { return mCount; }
+	void resize(size_t count);
+	void add(const Transform& transform);
+	void set(size_t index, const Transform& transform);
+	Transform get(size_t index) const;
+
+	// Bumped by Every resize() and set(), so Callers can Tell the Transforms Changed
+	// -----------------------------------------------------------------------------
+	size_t version() const { return mVersion; }
+
+	// Compose Objects [begin, end) into models[begin...] and normals[begin...]
+	// ------------------------------------------------------------------------
+	void compose(size_t begin, size_t end, glm::mat4* models, glm::mat3* normals) const;
+
+private:
+	enum Component
+	{
+		SCALE_X, SCALE_Y, SCALE_Z,
+		ROTATION_X, ROTATION_Y, ROTATION_Z,
+		TRANSLATION_X, TRANSLATION_Y, TRANSLATION_Z,
+		COMPONENT_COUNT
+	};
+
+	// Arrays are Padded by a Full Register so the Last Group can Load Past the End
+	// ----------------------------------------------------------------------------
+	std::vector<float> mComponents[COMPONENT_COUNT];
+	size_t mCount = 0;
+	size_t mVersion = 0;
+};
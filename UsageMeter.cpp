@@ -0,0 +1,130 @@
+#include "UsageMeter.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>        // GetProcessTimes
+#else
+#include <sys/resource.h>   // getrusage
+#endif
+
+bool UsageMeter::create(RenderBackend& backend)
+{
+	mBackend = &backend;
+	for (TimestampId* timestamps : mTimestamps)
+	{
+		timestamps[0] = backend.createTimestamp();
+		timestamps[1] = backend.createTimestamp();
+	}
+	for (bool& issued : mQueryIssued)
+		issued = false;
+	mNextQuery = 0;
+
+	return true;
+}
+
+void UsageMeter::destroy()
+{
+	if (!mBackend)
+		return;
+
+	for (TimestampId* timestamps : mTimestamps)
+	{
+		mBackend->destroyTimestamp(timestamps[0]);
+		mBackend->destroyTimestamp(timestamps[1]);
+		timestamps[0] = timestamps[1] = 0;
+	}
+	mBackend = nullptr;
+}
+
+void UsageMeter::beginFrame()
+{
+	mTiming = ++mFrameIndex > WARMUP_FRAMES;
+	if (!mTiming)
+		return;
+
+	// Reuse the Oldest Query; its Frame Finished Long Ago, so this Rarely Waits
+	// -------------------------------------------------------------------------
+	if (mQueryIssued[mNextQuery])
+		collectQueries(true);
+
+	mBackend->writeTimestamp(mTimestamps[mNextQuery][0]);
+}
+
+void UsageMeter::endFrame()
+{
+	if (!mTiming)
+		return;
+
+	mBackend->writeTimestamp(mTimestamps[mNextQuery][1]);
+
+	// Submit the End Now: Left Queued it would Only Execute with the Next Frame's
+	// Commands, and an On-Demand Loop's Idle Time would be Timed as GPU Work
+	// ---------------------------------------------------------------------------
+	mBackend->flush();
+	mQueryIssued[mNextQuery] = true;
+	mNextQuery = (mNextQuery + 1) % QUERY_COUNT;
+	++mFrames;
+}
+
+void UsageMeter::reset(double now)
+{
+	mStartTime = now;
+	mStartCpuSeconds = processCpuSeconds();
+	mGpuSeconds = 0.0;
+	mFrames = 0;
+}
+
+float UsageMeter::cpuPercent(double now) const
+{
+	const double elapsed = now - mStartTime;
+	return elapsed > 0.0 ? static_cast<float>(100.0 * (processCpuSeconds() - mStartCpuSeconds) / elapsed) : 0.0f;
+}
+
+float UsageMeter::gpuPercent(double now)
+{
+	collectQueries(false);
+
+	const double elapsed = now - mStartTime;
+	return elapsed > 0.0 ? static_cast<float>(100.0 * mGpuSeconds / elapsed) : 0.0f;
+}
+
+// Add Finished Queries to the Interval, Oldest First; with wait, the Oldest is Always Read
+// ---------------------------------------------------------------------------------------
+void UsageMeter::collectQueries(bool wait)
+{
+	for (int i = 0; i < QUERY_COUNT; ++i)
+	{
+		const int slot = (mNextQuery + i) % QUERY_COUNT;
+		if (!mQueryIssued[slot])
+			continue;
+
+		uint64_t begin = 0, end = 0;
+		if (!mBackend->timestampResult(mTimestamps[slot][1], wait && slot == mNextQuery, end))
+			break;
+
+		mBackend->timestampResult(mTimestamps[slot][0], true, begin);
+		mGpuSeconds += (end - begin) * 1e-9;
+		mQueryIssued[slot] = false;
+	}
+}
+
+double UsageMeter::processCpuSeconds()
+{
+#ifdef _WIN32
+	FILETIME creation, exit, kernel, user;
+	if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+		return 0.0;
+
+	// FILETIMEs Count 100-Nanosecond Ticks
+	// ------------------------------------
+	const ULONGLONG kernelTicks = (static_cast<ULONGLONG>(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime;
+	const ULONGLONG userTicks = (static_cast<ULONGLONG>(user.dwHighDateTime) << 32) | user.dwLowDateTime;
+	return (kernelTicks + userTicks) * 1e-7;
+#else
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0.0;
+
+	return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+#endif
+}
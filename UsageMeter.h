@@ -0,0 +1,59 @@
+#pragma once
+
+// Includes
+// -------
+#include <cstddef>        // size_t
+
+#include "RenderBackend.h"
+
+// CPU and GPU Utilization Over a Wall-Clock Interval
+// --------------------------------------------------
+// CPU use is the process's user and kernel time across every thread, so worker pools and
+// driver threads count too; 100% is one core kept busy. GPU use is the time between the
+// backend timestamps bracketing each timed frame, read back QUERY_COUNT frames later or as
+// soon as they are available, so the CPU never waits on them. A frame still in flight at
+// the end of an interval counts towards the next one.
+class UsageMeter
+{
+public:
+	static const int QUERY_COUNT = 4;
+	static const int WARMUP_FRAMES = 1;   // The First Frame Carries One-Off Driver Work and is Not Timed
+
+	bool create(RenderBackend& backend);
+	void destroy();
+
+	// Bracket a Frame's Commands, Outside Passes
+	// ------------------------------------------
+	void beginFrame();
+	void endFrame();
+
+	// Start a New Interval at now (glfwGetTime() Seconds)
+	// ---------------------------------------------------
+	void reset(double now);
+
+	// Use Since the Last reset(), as a Percentage of the Elapsed Wall Time
+	// --------------------------------------------------------------------
+	float cpuPercent(double now) const;
+	float gpuPercent(double now);
+
+	size_t frameCount() const { return mFrames; }   // Timed Frames Since reset()
+
+	// User and Kernel Time of the Whole Process
+	// -----------------------------------------
+	static double processCpuSeconds();
+
+private:
+	void collectQueries(bool wait);
+
+	RenderBackend* mBackend = nullptr;
+	TimestampId mTimestamps[QUERY_COUNT][2] = {};   // Begin and End per Frame in Flight
+	bool mQueryIssued[QUERY_COUNT] = {};
+	int mNextQuery = 0;
+	int mFrameIndex = 0;
+	bool mTiming = false;
+
+	double mStartTime = 0.0;
+	double mStartCpuSeconds = 0.0;
+	double mGpuSeconds = 0.0;
+	size_t mFrames = 0;
+};
@@ -0,0 +1,2478 @@
+#include "VulkanBackend.h"
+
+#ifdef RENDER_BACKEND_VULKAN
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>   // glfwCreateWindowSurface
+#include <algorithm>      // max, min
+#include <cstring>        // memcpy, strcmp
+#include <iostream>       // cerr
+#include <glm/gtc/packing.hpp>   // packHalf4x16
+
+#include "JobSystem.h"
+#include "MemoryTracker.h"
+
+using namespace std;
+
+// Unnamed Namespace
+// -----------------
+namespace
+{
+	const VkMemoryPropertyFlags HOST_MEMORY = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+	VkFormat textureFormat(TextureFormat format, VkFormat depth24)
+	{
+		switch (format)
+		{
+			case TextureFormat::R8:       return VK_FORMAT_R8_UNORM;
+			case TextureFormat::RGBA16F:  return VK_FORMAT_R16G16B16A16_SFLOAT;
+			case TextureFormat::RG16UI:   return VK_FORMAT_R16G16_UINT;
+			case TextureFormat::Depth24:  return depth24;
+			case TextureFormat::Depth32F: return VK_FORMAT_D32_SFLOAT;
+			default:                      return VK_FORMAT_R8G8B8A8_UNORM;   // RGB8 Gains an Opaque Alpha
+		}
+	}
+
+	VkImageAspectFlags aspect(VkFormat format)
+	{
+		return (format == VK_FORMAT_D32_SFLOAT || format == VK_FORMAT_X8_D24_UNORM_PACK32) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+	}
+
+	bool integerFormat(VkFormat format)
+	{
+		return format == VK_FORMAT_R16G16_UINT;
+	}
+
+	VkFormat attributeFormat(const VertexAttribute& attribute)
+	{
+		static const VkFormat FLOATS[] = { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+		static const VkFormat BYTES[] = { VK_FORMAT_R8_UNORM, VK_FORMAT_R8G8_UNORM, VK_FORMAT_R8G8B8_UNORM, VK_FORMAT_R8G8B8A8_UNORM };
+		const int index = min(max(attribute.components, 1), 4) - 1;
+		return attribute.normalizedBytes ? BYTES[index] : FLOATS[index];
+	}
+
+	// Levels glGenerateMipmap would Give a Texture of this Size
+	// ---------------------------------------------------------
+	uint32_t mipLevels(int width, int height)
+	{
+		uint32_t levels = 1;
+		while ((max(width, height) >> levels) > 0)
+			++levels;
+		return levels;
+	}
+
+	// Rows Padded to alignment as GL Unpacks them, Repacked Tightly in the Image's Format;
+	// RGBA16F Pixels Arrive as Floats and are Halved, as GL Converts them
+	// ------------------------------------------------------------------------------------
+	vector<uint8_t> packPixels(TextureFormat format, int width, int height, const void* pixels, size_t alignment)
+	{
+		const bool halves = format == TextureFormat::RGBA16F;
+		const size_t sourceTexel = (format == TextureFormat::R8) ? 1 : (format == TextureFormat::RGB8) ? 3 : halves ? 16 : 4;
+		const size_t targetTexel = (format == TextureFormat::R8) ? 1 : halves ? 8 : 4;
+		const size_t sourceRow = (width * sourceTexel + alignment - 1) / alignment * alignment;
+
+		vector<uint8_t> packed(static_cast<size_t>(width) * height * targetTexel);
+		const uint8_t* source = static_cast<const uint8_t*>(pixels);
+		for (int y = 0; y < height; ++y)
+		{
+			const uint8_t* row = source + y * sourceRow;
+			uint8_t* target = packed.data() + static_cast<size_t>(y) * width * targetTexel;
+			if (sourceTexel == targetTexel)
+			{
+				memcpy(target, row, width * targetTexel);
+				continue;
+			}
+
+			if (halves)
+			{
+				for (int x = 0; x < width; ++x)
+				{
+					glm::vec4 texel;
+					memcpy(&texel, row + 16 * x, sizeof(texel));
+					const uint64_t half = glm::packHalf4x16(texel);
+					memcpy(target + 8 * x, &half, sizeof(half));
+				}
+				continue;
+			}
+
+			for (int x = 0; x < width; ++x)
+			{
+				target[4 * x + 0] = row[3 * x + 0];
+				target[4 * x + 1] = row[3 * x + 1];
+				target[4 * x + 2] = row[3 * x + 2];
+				target[4 * x + 3] = 255;
+			}
+		}
+
+		return packed;
+	}
+
+	// Copies count Values of a Uniform into a Default Block Member; GL Takes Matrices Column
+	// by Column, which Row-Major Members Store Transposed
+	// ---------------------------------------------------------------------------------------
+	void writeMember(vector<char>& block, const SpirvModule::Member& member, const uint32_t* values, uint32_t count, uint32_t components)
+	{
+		count = min(count, member.arrayLength);
+		for (uint32_t element = 0; element < count; ++element)
+		{
+			const size_t base = member.offset + element * member.arrayStride;
+			const uint32_t* value = values + element * components;
+
+			if (member.columns == 1)
+			{
+				const size_t size = min(components, member.rows) * sizeof(uint32_t);
+				if (base + size <= block.size())
+					memcpy(block.data() + base, value, size);
+				continue;
+			}
+
+			for (uint32_t column = 0; column < member.columns; ++column)
+			{
+				for (uint32_t row = 0; row < member.rows && column * member.rows + row < components; ++row)
+				{
+					const size_t offset = base + (member.rowMajor ? row * member.matrixStride + column * sizeof(uint32_t)
+						: column * member.matrixStride + row * sizeof(uint32_t));
+					if (offset + sizeof(uint32_t) <= block.size())
+						memcpy(block.data() + offset, &value[column * member.rows + row], sizeof(uint32_t));
+				}
+			}
+		}
+	}
+
+	void imageBarrier(VkCommandBuffer commands, VkImage image, VkImageAspectFlags aspectMask, uint32_t level, uint32_t levelCount,
+		VkImageLayout from, VkImageLayout to)
+	{
+		VkImageMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+		barrier.oldLayout = from;
+		barrier.newLayout = to;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = image;
+		barrier.subresourceRange = { aspectMask, level, levelCount, 0, 1 };
+		vkCmdPipelineBarrier(commands, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+	}
+
+	// Attachments Start and End Sampled, as Every Texture Rests Between Passes; the Depth
+	// Follows the Colors
+	// -----------------------------------------------------------------------------------
+	VkRenderPass createRenderPass(VkDevice device, const VkFormat* colors, uint32_t colorCount, VkFormat depth, bool clearColor, bool clearDepth)
+	{
+		VkAttachmentDescription attachments[RenderBackend::MAX_COLOR_TARGETS + 1] = {};
+		VkAttachmentReference colorReferences[RenderBackend::MAX_COLOR_TARGETS] = {};
+		const VkAttachmentReference depthReference = { colorCount, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+		const uint32_t attachmentCount = colorCount + (depth != VK_FORMAT_UNDEFINED ? 1 : 0);
+
+		for (uint32_t i = 0; i < attachmentCount; ++i)
+		{
+			const bool isDepth = i == colorCount;
+			VkAttachmentDescription& attachment = attachments[i];
+			attachment.format = isDepth ? depth : colors[i];
+			attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+			attachment.loadOp = (isDepth ? clearDepth : clearColor) ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
+			attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+			attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			attachment.initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			attachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			if (!isDepth)
+				colorReferences[i] = { i, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+		}
+
+		VkSubpassDescription subpass = {};
+		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.colorAttachmentCount = colorCount;
+		subpass.pColorAttachments = colorCount > 0 ? colorReferences : nullptr;
+		subpass.pDepthStencilAttachment = depth != VK_FORMAT_UNDEFINED ? &depthReference : nullptr;
+
+		VkSubpassDependency dependencies[2] = {};
+		dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+		dependencies[0].dstSubpass = 0;
+		dependencies[0].srcStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		dependencies[0].dstStageMask = VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT;
+		dependencies[0].srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+		dependencies[0].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+		dependencies[1].srcSubpass = 0;
+		dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+		dependencies[1].srcStageMask = VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT;
+		dependencies[1].dstStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+		dependencies[1].srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+		dependencies[1].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+		VkRenderPassCreateInfo info = {};
+		info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		info.attachmentCount = attachmentCount;
+		info.pAttachments = attachments;
+		info.subpassCount = 1;
+		info.pSubpasses = &subpass;
+		info.dependencyCount = 2;
+		info.pDependencies = dependencies;
+
+		VkRenderPass renderPass = VK_NULL_HANDLE;
+		if (vkCreateRenderPass(device, &info, nullptr, &renderPass) != VK_SUCCESS)
+			cerr << "ERROR::BACKEND::RENDER_PASS " << colorCount << " Colors, Depth " << depth << endl;
+		return renderPass;
+	}
+
+	bool hasExtension(const vector<VkExtensionProperties>& extensions, const char* name)
+	{
+		for (const VkExtensionProperties& extension : extensions)
+		{
+			if (strcmp(extension.extensionName, name) == 0)
+				return true;
+		}
+		return false;
+	}
+}
+
+#pragma region Setup
+
+bool VulkanBackend::create(GLFWwindow* window, JobSystem& jobSystem)
+{
+	mWindow = window;
+	mJobSystem = &jobSystem;
+
+	if (!createDevice(window))
+		return false;
+
+	VkPipelineCacheCreateInfo cacheInfo = {};
+	cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	vkCreatePipelineCache(mDevice, &cacheInfo, nullptr, &mPipelineCache);
+
+	// Set 0: Each Stage's Default Uniform Block, at a Dynamic Offset into a Uniform Chunk
+	// ------------------------------------------------------------------------------------
+	VkDescriptorSetLayoutBinding blocks[2] = {};
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		blocks[i].binding = i;
+		blocks[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		blocks[i].descriptorCount = 1;
+		blocks[i].stageFlags = i == 0 ? VK_SHADER_STAGE_VERTEX_BIT : VK_SHADER_STAGE_FRAGMENT_BIT;
+	}
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.bindingCount = 2;
+	layoutInfo.pBindings = blocks;
+
+	VkDescriptorPoolSize chunkSize = { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 2 * DESCRIPTOR_SETS_PER_POOL };
+	VkDescriptorPoolCreateInfo poolInfo = {};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.maxSets = DESCRIPTOR_SETS_PER_POOL;
+	poolInfo.poolSizeCount = 1;
+	poolInfo.pPoolSizes = &chunkSize;
+
+	if (vkCreateDescriptorSetLayout(mDevice, &layoutInfo, nullptr, &mUniformSetLayout) != VK_SUCCESS ||
+		vkCreateDescriptorPool(mDevice, &poolInfo, nullptr, &mChunkDescriptorPool) != VK_SUCCESS)
+	{
+		cerr << "ERROR::BACKEND::UNIFORM_SET_LAYOUT" << endl;
+		return false;
+	}
+
+	// Frames: Uploads and Commands Submitted Together, Fenced per Slot
+	// -----------------------------------------------------------------
+	for (Frame& frame : mFrames)
+	{
+		VkCommandPoolCreateInfo commandPoolInfo = {};
+		commandPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		commandPoolInfo.queueFamilyIndex = mQueueFamily;
+
+		VkFenceCreateInfo fenceInfo = {};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		VkSemaphoreCreateInfo semaphoreInfo = {};
+		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+		if (vkCreateCommandPool(mDevice, &commandPoolInfo, nullptr, &frame.pool) != VK_SUCCESS ||
+			vkCreateFence(mDevice, &fenceInfo, nullptr, &frame.fence) != VK_SUCCESS ||
+			vkCreateSemaphore(mDevice, &semaphoreInfo, nullptr, &frame.imageAvailable) != VK_SUCCESS)
+		{
+			cerr << "ERROR::BACKEND::FRAME_OBJECTS" << endl;
+			return false;
+		}
+
+		VkCommandBuffer commandBuffers[2] = {};
+		VkCommandBufferAllocateInfo allocateInfo = {};
+		allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocateInfo.commandPool = frame.pool;
+		allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocateInfo.commandBufferCount = 2;
+		vkAllocateCommandBuffers(mDevice, &allocateInfo, commandBuffers);
+		frame.uploads = commandBuffers[0];
+		frame.commands = commandBuffers[1];
+	}
+
+	mVertexLayouts.push_back(VertexLayout());
+	beginFrame();
+
+	// Window Target at the Framebuffer Size, and the Fallbacks Unbound Slots Read
+	// ---------------------------------------------------------------------------
+	int width = 0;
+	int height = 0;
+	glfwGetFramebufferSize(window, &width, &height);
+	if (!createWindowTarget(static_cast<uint32_t>(max(width, 1)), static_cast<uint32_t>(max(height, 1))) || !createSwapchain())
+		return false;
+
+	const uint8_t black[4] = { 0, 0, 0, 255 };
+	TextureDesc empty;
+	empty.width = empty.height = 1;
+	empty.filter = TextureFilter::Nearest;
+	empty.mipmaps = false;
+	mEmptyTexture = createTexture(empty, black);
+	mEmptyBuffer = createBuffer(BufferType::Vertex, 256, nullptr);
+
+	return mEmptyTexture && mEmptyBuffer;
+}
+
+// The First Device that can Present to the Window with GL Clip Depth and Line Fill;
+// Discrete GPUs Before Any Other
+// ---------------------------------------------------------------------------------
+bool VulkanBackend::createDevice(GLFWwindow* window)
+{
+	uint32_t extensionCount = 0;
+	const char** extensions = glfwGetRequiredInstanceExtensions(&extensionCount);
+
+	// Error Check: Loader and Window System Support
+	// ---------------------------------------------
+	if (!extensions)
+	{
+		cerr << "ERROR::BACKEND::VULKAN_UNAVAILABLE No Loader or Surface Extensions" << endl;
+		return false;
+	}
+
+	VkApplicationInfo application = {};
+	application.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+	application.pApplicationName = "Hello-Triangle";
+	application.apiVersion = VK_API_VERSION_1_1;
+
+	VkInstanceCreateInfo instanceInfo = {};
+	instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+	instanceInfo.pApplicationInfo = &application;
+	instanceInfo.enabledExtensionCount = extensionCount;
+	instanceInfo.ppEnabledExtensionNames = extensions;
+
+	if (vkCreateInstance(&instanceInfo, nullptr, &mInstance) != VK_SUCCESS ||
+		glfwCreateWindowSurface(mInstance, window, nullptr, &mSurface) != VK_SUCCESS)
+	{
+		cerr << "ERROR::BACKEND::VULKAN_UNAVAILABLE No Vulkan 1.1 Instance or Window Surface" << endl;
+		return false;
+	}
+
+	uint32_t deviceCount = 0;
+	vkEnumeratePhysicalDevices(mInstance, &deviceCount, nullptr);
+	vector<VkPhysicalDevice> devices(deviceCount);
+	vkEnumeratePhysicalDevices(mInstance, &deviceCount, devices.data());
+
+	for (VkPhysicalDevice device : devices)
+	{
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(device, &properties);
+		if (properties.apiVersion < VK_API_VERSION_1_1)
+			continue;
+
+		uint32_t count = 0;
+		vkEnumerateDeviceExtensionProperties(device, nullptr, &count, nullptr);
+		vector<VkExtensionProperties> deviceExtensions(count);
+		vkEnumerateDeviceExtensionProperties(device, nullptr, &count, deviceExtensions.data());
+		if (!hasExtension(deviceExtensions, VK_KHR_SWAPCHAIN_EXTENSION_NAME) || !hasExtension(deviceExtensions, VK_EXT_DEPTH_CLIP_CONTROL_EXTENSION_NAME))
+			continue;
+
+		VkPhysicalDeviceDepthClipControlFeaturesEXT clipControl = {};
+		clipControl.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DEPTH_CLIP_CONTROL_FEATURES_EXT;
+		VkPhysicalDeviceFeatures2 features = {};
+		features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		features.pNext = &clipControl;
+		vkGetPhysicalDeviceFeatures2(device, &features);
+		if (!clipControl.depthClipControl || !features.features.fillModeNonSolid)
+			continue;
+
+		vkGetPhysicalDeviceQueueFamilyProperties(device, &count, nullptr);
+		vector<VkQueueFamilyProperties> families(count);
+		vkGetPhysicalDeviceQueueFamilyProperties(device, &count, families.data());
+		for (uint32_t family = 0; family < count; ++family)
+		{
+			VkBool32 presents = VK_FALSE;
+			vkGetPhysicalDeviceSurfaceSupportKHR(device, family, mSurface, &presents);
+			if (!(families[family].queueFlags & VK_QUEUE_GRAPHICS_BIT) || !presents)
+				continue;
+
+			if (!mPhysicalDevice || (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU && mProperties.deviceType != VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU))
+			{
+				mPhysicalDevice = device;
+				mProperties = properties;
+				mQueueFamily = family;
+			}
+			break;
+		}
+	}
+
+	// Error Check: a Device with Everything Drawing as GL Does Needs
+	// ---------------------------------------------------------------
+	if (!mPhysicalDevice)
+	{
+		cerr << "ERROR::BACKEND::NO_VULKAN_DEVICE Presenting with " << VK_EXT_DEPTH_CLIP_CONTROL_EXTENSION_NAME << " and fillModeNonSolid" << endl;
+		return false;
+	}
+
+	// Multi-View: the Vertex Shader Picks the Viewport Only through the Extension
+	// ---------------------------------------------------------------------------
+	uint32_t count = 0;
+	vkEnumerateDeviceExtensionProperties(mPhysicalDevice, nullptr, &count, nullptr);
+	vector<VkExtensionProperties> available(count);
+	vkEnumerateDeviceExtensionProperties(mPhysicalDevice, nullptr, &count, available.data());
+	VkPhysicalDeviceFeatures supported;
+	vkGetPhysicalDeviceFeatures(mPhysicalDevice, &supported);
+	const bool viewportLayer = supported.multiViewport && hasExtension(available, VK_EXT_SHADER_VIEWPORT_INDEX_LAYER_EXTENSION_NAME);
+
+	// 24-Bit Depth where it can be Drawn Into and Sampled, as GL Always Can; 32-Bit Otherwise
+	// ---------------------------------------------------------------------------------------
+	const VkFormatFeatureFlags depthFeatures = VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+	VkFormatProperties depth24;
+	vkGetPhysicalDeviceFormatProperties(mPhysicalDevice, VK_FORMAT_X8_D24_UNORM_PACK32, &depth24);
+	mDepth24Format = (depth24.optimalTilingFeatures & depthFeatures) == depthFeatures ? VK_FORMAT_X8_D24_UNORM_PACK32 : VK_FORMAT_D32_SFLOAT;
+
+	const float priority = 1.0f;
+	VkDeviceQueueCreateInfo queueInfo = {};
+	queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+	queueInfo.queueFamilyIndex = mQueueFamily;
+	queueInfo.queueCount = 1;
+	queueInfo.pQueuePriorities = &priority;
+
+	VkPhysicalDeviceDepthClipControlFeaturesEXT clipControl = {};
+	clipControl.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DEPTH_CLIP_CONTROL_FEATURES_EXT;
+	clipControl.depthClipControl = VK_TRUE;
+	VkPhysicalDeviceFeatures2 features = {};
+	features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+	features.pNext = &clipControl;
+	features.features.fillModeNonSolid = VK_TRUE;
+	features.features.multiViewport = viewportLayer ? VK_TRUE : VK_FALSE;
+
+	const char* deviceExtensions[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_EXT_DEPTH_CLIP_CONTROL_EXTENSION_NAME, VK_EXT_SHADER_VIEWPORT_INDEX_LAYER_EXTENSION_NAME };
+	VkDeviceCreateInfo deviceInfo = {};
+	deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+	deviceInfo.pNext = &features;
+	deviceInfo.queueCreateInfoCount = 1;
+	deviceInfo.pQueueCreateInfos = &queueInfo;
+	deviceInfo.enabledExtensionCount = viewportLayer ? 3 : 2;
+	deviceInfo.ppEnabledExtensionNames = deviceExtensions;
+
+	if (vkCreateDevice(mPhysicalDevice, &deviceInfo, nullptr, &mDevice) != VK_SUCCESS)
+	{
+		cerr << "ERROR::BACKEND::DEVICE_CREATION " << mProperties.deviceName << endl;
+		return false;
+	}
+
+	vkGetDeviceQueue(mDevice, mQueueFamily, 0, &mQueue);
+	vkGetPhysicalDeviceMemoryProperties(mPhysicalDevice, &mMemoryProperties);
+	mMaxViewports = viewportLayer ? mProperties.limits.maxViewports : 1;
+	cerr << "INFO: Vulkan Device: " << mProperties.deviceName << endl;
+	return true;
+}
+
+// Swapchain Images are Only Blitted Into, so Any Size and Color Format Will Do
+// ----------------------------------------------------------------------------
+bool VulkanBackend::createSwapchain()
+{
+	VkSurfaceCapabilitiesKHR capabilities;
+	vkGetPhysicalDeviceSurfaceCapabilitiesKHR(mPhysicalDevice, mSurface, &capabilities);
+
+	// Error Check: Blits into the Swapchain
+	// -------------------------------------
+	if (!(capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT))
+	{
+		cerr << "ERROR::BACKEND::SWAPCHAIN_USAGE Surface Images Cannot be Blitted Into" << endl;
+		return false;
+	}
+
+	const RenderTarget& window = mRenderTargets.at(0);
+	mSwapchainExtent = capabilities.currentExtent;
+	if (mSwapchainExtent.width == 0xFFFFFFFF)
+		mSwapchainExtent = { window.width, window.height };
+
+	// Minimized: Nothing to Present Until the Window Comes Back
+	// ---------------------------------------------------------
+	if (mSwapchainExtent.width == 0 || mSwapchainExtent.height == 0)
+		return true;
+
+	uint32_t count = 0;
+	vkGetPhysicalDeviceSurfaceFormatsKHR(mPhysicalDevice, mSurface, &count, nullptr);
+	vector<VkSurfaceFormatKHR> formats(count);
+	vkGetPhysicalDeviceSurfaceFormatsKHR(mPhysicalDevice, mSurface, &count, formats.data());
+
+	VkSurfaceFormatKHR format = formats.empty() ? VkSurfaceFormatKHR{ VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR } : formats[0];
+	for (const VkSurfaceFormatKHR& candidate : formats)
+	{
+		if (candidate.format == VK_FORMAT_B8G8R8A8_UNORM || candidate.format == VK_FORMAT_R8G8B8A8_UNORM)
+		{
+			format = candidate;
+			break;
+		}
+	}
+
+	// FIFO is Always Supported, and Synchronized as glfwSwapInterval(1) is; Without Vsync,
+	// Immediate as glfwSwapInterval(0) is, or Else Mailbox, which Never Waits Either
+	// ------------------------------------------------------------------------------------
+	VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR;
+	if (!mVsync)
+	{
+		vkGetPhysicalDeviceSurfacePresentModesKHR(mPhysicalDevice, mSurface, &count, nullptr);
+		vector<VkPresentModeKHR> modes(count);
+		vkGetPhysicalDeviceSurfacePresentModesKHR(mPhysicalDevice, mSurface, &count, modes.data());
+		for (VkPresentModeKHR candidate : { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR })
+		{
+			if (find(modes.begin(), modes.end(), candidate) != modes.end())
+				presentMode = candidate;
+		}
+	}
+
+	uint32_t imageCount = capabilities.minImageCount + 1;
+	if (capabilities.maxImageCount > 0)
+		imageCount = min(imageCount, capabilities.maxImageCount);
+
+	VkSwapchainCreateInfoKHR info = {};
+	info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+	info.surface = mSurface;
+	info.minImageCount = imageCount;
+	info.imageFormat = format.format;
+	info.imageColorSpace = format.colorSpace;
+	info.imageExtent = mSwapchainExtent;
+	info.imageArrayLayers = 1;
+	info.imageUsage = VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+	info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	info.preTransform = capabilities.currentTransform;
+	info.compositeAlpha = (capabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR) ? VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR
+		: static_cast<VkCompositeAlphaFlagBitsKHR>(capabilities.supportedCompositeAlpha & -static_cast<int32_t>(capabilities.supportedCompositeAlpha));
+	info.presentMode = presentMode;
+	info.clipped = VK_TRUE;
+
+	if (vkCreateSwapchainKHR(mDevice, &info, nullptr, &mSwapchain) != VK_SUCCESS)
+	{
+		cerr << "ERROR::BACKEND::SWAPCHAIN_CREATION " << mSwapchainExtent.width << "x" << mSwapchainExtent.height << endl;
+		return false;
+	}
+
+	vkGetSwapchainImagesKHR(mDevice, mSwapchain, &count, nullptr);
+	mSwapchainImages.resize(count);
+	vkGetSwapchainImagesKHR(mDevice, mSwapchain, &count, mSwapchainImages.data());
+
+	mRenderFinished.resize(count);
+	for (VkSemaphore& semaphore : mRenderFinished)
+	{
+		VkSemaphoreCreateInfo semaphoreInfo = {};
+		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		vkCreateSemaphore(mDevice, &semaphoreInfo, nullptr, &semaphore);
+	}
+
+	return true;
+}
+
+void VulkanBackend::destroySwapchain()
+{
+	for (VkSemaphore semaphore : mRenderFinished)
+		vkDestroySemaphore(mDevice, semaphore, nullptr);
+	mRenderFinished.clear();
+	mSwapchainImages.clear();
+
+	if (mSwapchain)
+		vkDestroySwapchainKHR(mDevice, mSwapchain, nullptr);
+	mSwapchain = VK_NULL_HANDLE;
+}
+
+// Attachment Views of Level Zero and a Framebuffer for the Target's Format Class
+// ------------------------------------------------------------------------------
+bool VulkanBackend::buildRenderTarget(const TextureId* colors, size_t colorCount, TextureId depth, RenderTarget& target)
+{
+	// Error Check: Target Completeness
+	// --------------------------------
+	const Texture* textures[MAX_COLOR_TARGETS + 1] = {};
+	const size_t textureCount = colorCount + (depth ? 1 : 0);
+	bool complete = colorCount <= MAX_COLOR_TARGETS && textureCount > 0;
+	for (size_t i = 0; complete && i < textureCount; ++i)
+	{
+		const auto texture = mTextures.find(i < colorCount ? colors[i] : depth);
+		const VkImageAspectFlags expected = i < colorCount ? VK_IMAGE_ASPECT_COLOR_BIT : VK_IMAGE_ASPECT_DEPTH_BIT;
+		complete = texture != mTextures.end() && texture->second.desc.renderTarget && aspect(texture->second.format) == expected &&
+			(!textures[0] || (texture->second.desc.width == textures[0]->desc.width && texture->second.desc.height == textures[0]->desc.height));
+		textures[i] = complete ? &texture->second : nullptr;
+	}
+	if (!complete)
+	{
+		cerr << "ERROR::BACKEND::RENDER_TARGET_INCOMPLETE " << colorCount << " Colors, Depth " << depth << endl;
+		return false;
+	}
+
+	const TextureDesc& desc = textures[0]->desc;
+	FormatClass formats = {};
+	target = RenderTarget();
+	target.colorCount = static_cast<uint32_t>(colorCount);
+	target.depth = depth;
+	target.width = static_cast<uint32_t>(desc.width);
+	target.height = static_cast<uint32_t>(desc.height);
+	formats.colorCount = target.colorCount;
+	formats.depth = depth ? textures[colorCount]->format : VK_FORMAT_UNDEFINED;
+
+	const uint32_t viewCount = static_cast<uint32_t>(textureCount);
+	for (uint32_t i = 0; i < viewCount; ++i)
+	{
+		if (i < colorCount)
+		{
+			target.colors[i] = colors[i];
+			formats.colors[i] = textures[i]->format;
+		}
+
+		VkImageViewCreateInfo viewInfo = {};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.image = textures[i]->image;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.format = textures[i]->format;
+		viewInfo.subresourceRange = { aspect(textures[i]->format), 0, 1, 0, 1 };
+		vkCreateImageView(mDevice, &viewInfo, nullptr, &target.views[i]);
+	}
+	target.formatClass = formatClass(formats);
+
+	VkFramebufferCreateInfo framebufferInfo = {};
+	framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+	framebufferInfo.renderPass = renderPass(target.formatClass, false, false);
+	framebufferInfo.attachmentCount = viewCount;
+	framebufferInfo.pAttachments = target.views;
+	framebufferInfo.width = target.width;
+	framebufferInfo.height = target.height;
+	framebufferInfo.layers = 1;
+
+	if (vkCreateFramebuffer(mDevice, &framebufferInfo, nullptr, &target.framebuffer) != VK_SUCCESS)
+	{
+		cerr << "ERROR::BACKEND::FRAMEBUFFER_CREATION " << target.width << "x" << target.height << endl;
+		releaseRenderTarget(target);
+		return false;
+	}
+
+	return true;
+}
+
+void VulkanBackend::releaseRenderTarget(const RenderTarget& target)
+{
+	const VkDevice device = mDevice;
+	const RenderTarget released = target;
+	release([device, released]()
+	{
+		vkDestroyFramebuffer(device, released.framebuffer, nullptr);
+		for (VkImageView view : released.views)
+			vkDestroyImageView(device, view, nullptr);
+	});
+}
+
+// Target Zero: What GL's Default Framebuffer is, with its 24-Bit Depth, Presented by a Blit
+// -----------------------------------------------------------------------------------------
+bool VulkanBackend::createWindowTarget(uint32_t width, uint32_t height)
+{
+	TextureDesc desc;
+	desc.width = static_cast<int>(width);
+	desc.height = static_cast<int>(height);
+	desc.filter = TextureFilter::Nearest;
+	desc.wrap = TextureWrap::ClampToEdge;
+	desc.mipmaps = false;
+	desc.renderTarget = true;
+
+	const TextureId color = createTexture(desc, nullptr);
+	desc.format = TextureFormat::Depth24;
+	const TextureId depth = createTexture(desc, nullptr);
+
+	RenderTarget target;
+	if (!color || !depth || !buildRenderTarget(&color, 1, depth, target))
+	{
+		destroyTexture(color);
+		destroyTexture(depth);
+		return false;
+	}
+
+	mRenderTargets[0] = target;
+	return true;
+}
+
+void VulkanBackend::destroyWindowTarget()
+{
+	const auto window = mRenderTargets.find(0);
+	if (window == mRenderTargets.end())
+		return;
+
+	releaseRenderTarget(window->second);
+	destroyTexture(window->second.colors[0]);
+	destroyTexture(window->second.depth);
+	mRenderTargets.erase(window);
+}
+
+// Reuse the Slot Once the Batch Last Submitted from it has Finished
+// -----------------------------------------------------------------
+void VulkanBackend::beginFrame()
+{
+	Frame& frame = mFrames[mSerial % FRAMES_IN_FLIGHT];
+	if (frame.serial)
+	{
+		vkWaitForFences(mDevice, 1, &frame.fence, VK_TRUE, UINT64_MAX);
+		mCompletedSerial = max(mCompletedSerial, frame.serial);
+	}
+	vkResetFences(mDevice, 1, &frame.fence);
+
+	for (function<void()>& destroy : frame.garbage)
+		destroy();
+	frame.garbage.clear();
+
+	for (size_t i = 0; i < frame.recordersUsed; ++i)
+	{
+		Recorder& recorder = *frame.recorders[i];
+		vkResetCommandPool(mDevice, recorder.pool, 0);
+		for (VkDescriptorPool pool : recorder.descriptorPools)
+			vkResetDescriptorPool(mDevice, pool, 0);
+		recorder.descriptorPool = 0;
+
+		lock_guard<mutex> lock(mChunkMutex);
+		mFreeChunks.insert(mFreeChunks.end(), recorder.chunks.begin(), recorder.chunks.end());
+		recorder.chunks.clear();
+		recorder.chunkHead = UNIFORM_CHUNK_SIZE;
+	}
+	frame.recordersUsed = 0;
+
+	vkResetCommandPool(mDevice, frame.pool, 0);
+	VkCommandBufferBeginInfo beginInfo = {};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	vkBeginCommandBuffer(frame.uploads, &beginInfo);
+	vkBeginCommandBuffer(frame.commands, &beginInfo);
+}
+
+// Submit the Batch: Uploads, then the Passes; the Semaphores are the Swapchain's
+// ------------------------------------------------------------------------------
+void VulkanBackend::flush(VkSemaphore wait, VkSemaphore signal)
+{
+	Frame& frame = mFrames[mSerial % FRAMES_IN_FLIGHT];
+
+	VkMemoryBarrier barrier = {};
+	barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+	vkCmdPipelineBarrier(frame.uploads, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+	vkEndCommandBuffer(frame.uploads);
+	vkEndCommandBuffer(frame.commands);
+
+	const VkCommandBuffer commandBuffers[] = { frame.uploads, frame.commands };
+	const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+	VkSubmitInfo submitInfo = {};
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.waitSemaphoreCount = wait ? 1 : 0;
+	submitInfo.pWaitSemaphores = &wait;
+	submitInfo.pWaitDstStageMask = &waitStage;
+	submitInfo.commandBufferCount = 2;
+	submitInfo.pCommandBuffers = commandBuffers;
+	submitInfo.signalSemaphoreCount = signal ? 1 : 0;
+	submitInfo.pSignalSemaphores = &signal;
+
+	if (vkQueueSubmit(mQueue, 1, &submitInfo, frame.fence) != VK_SUCCESS)
+		cerr << "ERROR::BACKEND::QUEUE_SUBMIT Batch " << mSerial << endl;
+
+	frame.serial = mSerial++;
+	mBatchHasWork = false;
+	beginFrame();
+}
+
+// A Pass Being Recorded Keeps the Batch Open Until it Ends
+// --------------------------------------------------------
+void VulkanBackend::flush()
+{
+	if (!mInPass && mBatchHasWork)
+		flush(VK_NULL_HANDLE, VK_NULL_HANDLE);
+}
+
+VulkanBackend::~VulkanBackend()
+{
+	if (mDevice)
+	{
+		vkDeviceWaitIdle(mDevice);
+
+		// Objects the Backend Made Itself Leave the Tracker; the Caller's Leaks Stay Reported
+		// -----------------------------------------------------------------------------------
+		destroyWindowTarget();
+		destroyTexture(mEmptyTexture);
+		destroyBuffer(mEmptyBuffer);
+
+		for (Frame& frame : mFrames)
+		{
+			for (function<void()>& destroy : frame.garbage)
+				destroy();
+			frame.garbage.clear();
+		}
+
+		for (const unique_ptr<UniformChunk>& chunk : mChunks)
+		{
+			MemoryTracker::deviceFreed(MemoryTracker::DeviceObject::Buffer, chunk->id);
+			vkDestroyBuffer(mDevice, chunk->buffer, nullptr);
+			vkFreeMemory(mDevice, chunk->memory, nullptr);
+		}
+
+		for (const auto& variant : mPipelineVariants)
+			vkDestroyPipeline(mDevice, variant.second, nullptr);
+		for (const auto& program : mPrograms)
+		{
+			vkDestroyShaderModule(mDevice, program.second.vertex, nullptr);
+			vkDestroyShaderModule(mDevice, program.second.fragment, nullptr);
+			vkDestroyPipelineLayout(mDevice, program.second.pipelineLayout, nullptr);
+			vkDestroyDescriptorSetLayout(mDevice, program.second.setLayout, nullptr);
+		}
+		for (const auto& target : mRenderTargets)
+		{
+			vkDestroyFramebuffer(mDevice, target.second.framebuffer, nullptr);
+			for (VkImageView view : target.second.views)
+				vkDestroyImageView(mDevice, view, nullptr);
+		}
+		for (const auto& timestamp : mTimestamps)
+			vkDestroyQueryPool(mDevice, timestamp.second.pool, nullptr);
+		for (const auto& texture : mTextures)
+		{
+			vkDestroySampler(mDevice, texture.second.sampler, nullptr);
+			vkDestroyImageView(mDevice, texture.second.view, nullptr);
+			vkDestroyImage(mDevice, texture.second.image, nullptr);
+			vkFreeMemory(mDevice, texture.second.memory, nullptr);
+		}
+		for (const auto& buffer : mBuffers)
+		{
+			vkDestroyBuffer(mDevice, buffer.second.buffer, nullptr);
+			vkFreeMemory(mDevice, buffer.second.memory, nullptr);
+		}
+
+		for (VkRenderPass renderPass : mRenderPasses)
+			vkDestroyRenderPass(mDevice, renderPass, nullptr);
+		for (Frame& frame : mFrames)
+		{
+			for (const unique_ptr<Recorder>& recorder : frame.recorders)
+			{
+				vkDestroyCommandPool(mDevice, recorder->pool, nullptr);
+				for (VkDescriptorPool pool : recorder->descriptorPools)
+					vkDestroyDescriptorPool(mDevice, pool, nullptr);
+			}
+			vkDestroyCommandPool(mDevice, frame.pool, nullptr);
+			vkDestroyFence(mDevice, frame.fence, nullptr);
+			vkDestroySemaphore(mDevice, frame.imageAvailable, nullptr);
+		}
+
+		vkDestroyDescriptorPool(mDevice, mChunkDescriptorPool, nullptr);
+		vkDestroyDescriptorSetLayout(mDevice, mUniformSetLayout, nullptr);
+		vkDestroyPipelineCache(mDevice, mPipelineCache, nullptr);
+		destroySwapchain();
+		vkDestroyDevice(mDevice, nullptr);
+	}
+
+	if (mSurface)
+		vkDestroySurfaceKHR(mInstance, mSurface, nullptr);
+	if (mInstance)
+		vkDestroyInstance(mInstance, nullptr);
+}
+
+#pragma endregion
+
+#pragma region Resources
+
+bool VulkanBackend::allocate(VkMemoryRequirements requirements, VkMemoryPropertyFlags properties, VkDeviceMemory& memory)
+{
+	for (uint32_t type = 0; type < mMemoryProperties.memoryTypeCount; ++type)
+	{
+		if (!(requirements.memoryTypeBits & (1u << type)) || (mMemoryProperties.memoryTypes[type].propertyFlags & properties) != properties)
+			continue;
+
+		VkMemoryAllocateInfo info = {};
+		info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		info.allocationSize = requirements.size;
+		info.memoryTypeIndex = type;
+		if (vkAllocateMemory(mDevice, &info, nullptr, &memory) == VK_SUCCESS)
+			return true;
+	}
+
+	cerr << "ERROR::BACKEND::ALLOCATION_FAILED " << requirements.size << " Bytes" << endl;
+	return false;
+}
+
+bool VulkanBackend::createRawBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& memory)
+{
+	VkBufferCreateInfo info = {};
+	info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	info.size = max<VkDeviceSize>(size, 4);
+	info.usage = usage;
+	info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	if (vkCreateBuffer(mDevice, &info, nullptr, &buffer) != VK_SUCCESS)
+		return false;
+
+	VkMemoryRequirements requirements;
+	vkGetBufferMemoryRequirements(mDevice, buffer, &requirements);
+	if (!allocate(requirements, properties, memory))
+	{
+		vkDestroyBuffer(mDevice, buffer, nullptr);
+		buffer = VK_NULL_HANDLE;
+		return false;
+	}
+
+	vkBindBufferMemory(mDevice, buffer, memory, 0);
+	return true;
+}
+
+// Host Copy of Upload Data, Released with the Batch that Reads it
+// ---------------------------------------------------------------
+void VulkanBackend::stage(const void* data, VkDeviceSize size, VkBuffer& buffer)
+{
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+	if (!createRawBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, HOST_MEMORY, buffer, memory))
+		return;
+
+	void* mapped = nullptr;
+	vkMapMemory(mDevice, memory, 0, size, 0, &mapped);
+	memcpy(mapped, data, static_cast<size_t>(size));
+	vkUnmapMemory(mDevice, memory);
+
+	const VkDevice device = mDevice;
+	const VkBuffer staging = buffer;
+	release([device, staging, memory]()
+	{
+		vkDestroyBuffer(device, staging, nullptr);
+		vkFreeMemory(device, memory, nullptr);
+	});
+}
+
+bool VulkanBackend::linearFilter(VkFormat format) const
+{
+	VkFormatProperties properties;
+	vkGetPhysicalDeviceFormatProperties(mPhysicalDevice, format, &properties);
+	return (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) != 0;
+}
+
+void VulkanBackend::createView(Texture& texture)
+{
+	VkImageViewCreateInfo info = {};
+	info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	info.image = texture.image;
+	info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	info.format = texture.format;
+	info.subresourceRange = { aspect(texture.format), texture.baseLevel, texture.levels - texture.baseLevel, 0, 1 };
+	vkCreateImageView(mDevice, &info, nullptr, &texture.view);
+}
+
+void VulkanBackend::transition(VkCommandBuffer commands, const Texture& texture, uint32_t level, uint32_t levelCount, VkImageLayout from, VkImageLayout to)
+{
+	imageBarrier(commands, texture.image, aspect(texture.format), level, levelCount, from, to);
+}
+
+void VulkanBackend::release(function<void()> destroy)
+{
+	mFrames[mSerial % FRAMES_IN_FLIGHT].garbage.push_back(move(destroy));
+}
+
+// Targets of the Same Attachment Formats Share Render Passes and Pipelines
+// ------------------------------------------------------------------------
+uint32_t VulkanBackend::formatClass(const FormatClass& formats)
+{
+	const auto existing = find_if(mFormatClasses.begin(), mFormatClasses.end(), [&formats](const FormatClass& candidate)
+	{
+		return candidate.colorCount == formats.colorCount && candidate.depth == formats.depth &&
+			equal(candidate.colors, candidate.colors + candidate.colorCount, formats.colors);
+	});
+	if (existing != mFormatClasses.end())
+		return static_cast<uint32_t>(existing - mFormatClasses.begin());
+
+	mFormatClasses.push_back(formats);
+	for (int clears = 0; clears < 4; ++clears)
+		mRenderPasses.push_back(createRenderPass(mDevice, formats.colors, formats.colorCount, formats.depth, (clears & 2) != 0, (clears & 1) != 0));
+	return static_cast<uint32_t>(mFormatClasses.size() - 1);
+}
+
+VkRenderPass VulkanBackend::renderPass(uint32_t formatClass, bool clearColor, bool clearDepth)
+{
+	return mRenderPasses[4 * formatClass + (clearColor ? 2 : 0) + (clearDepth ? 1 : 0)];
+}
+
+BufferId VulkanBackend::createBuffer(BufferType type, size_t size, const void* data)
+{
+	Buffer buffer = {};
+	buffer.type = type;
+	buffer.size = size;
+
+	// Stream and Readback Buffers: Host Memory, Mapped for the Buffer's Whole Lifetime
+	// --------------------------------------------------------------------------------
+	if (type == BufferType::Stream || type == BufferType::Readback)
+	{
+		const VkBufferUsageFlags usage = (type == BufferType::Readback) ? VK_BUFFER_USAGE_TRANSFER_DST_BIT
+			: VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+		if (!createRawBuffer(size, usage, HOST_MEMORY, buffer.buffer, buffer.memory) ||
+			vkMapMemory(mDevice, buffer.memory, 0, VK_WHOLE_SIZE, 0, &buffer.mapped) != VK_SUCCESS)
+		{
+			cerr << "ERROR::BACKEND::MAP_FAILED " << size << " Bytes" << endl;
+			if (buffer.buffer)
+			{
+				vkDestroyBuffer(mDevice, buffer.buffer, nullptr);
+				vkFreeMemory(mDevice, buffer.memory, nullptr);
+			}
+			return 0;
+		}
+
+		if (data)
+			memcpy(buffer.mapped, data, size);
+		else if (type == BufferType::Readback)
+			memset(buffer.mapped, 0, size);
+	}
+	else
+	{
+		const VkBufferUsageFlags usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+		if (!createRawBuffer(size, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, buffer.buffer, buffer.memory))
+			return 0;
+
+		// Device Memory is Filled by the Batch's Uploads; Empty Buffers Read as Zero
+		// --------------------------------------------------------------------------
+		const VkCommandBuffer uploads = mFrames[mSerial % FRAMES_IN_FLIGHT].uploads;
+		VkBuffer staging = VK_NULL_HANDLE;
+		if (data && size)
+			stage(data, size, staging);
+
+		if (staging)
+		{
+			const VkBufferCopy region = { 0, 0, size };
+			vkCmdCopyBuffer(uploads, staging, buffer.buffer, 1, &region);
+		}
+		else
+			vkCmdFillBuffer(uploads, buffer.buffer, 0, VK_WHOLE_SIZE, 0);
+		mBatchHasWork = true;
+	}
+
+	const BufferId id = mNextHandle++;
+	mBuffers[id] = buffer;
+	MemoryTracker::deviceAllocated(MemoryTracker::DeviceObject::Buffer, id,
+		(type == BufferType::Stream || type == BufferType::Readback) ? MemoryTracker::Category::StreamBuffers : MemoryTracker::Category::MeshBuffers, size);
+	return id;
+}
+
+void VulkanBackend::destroyBuffer(BufferId id)
+{
+	const auto buffer = mBuffers.find(id);
+	if (buffer == mBuffers.end())
+		return;
+
+	MemoryTracker::deviceFreed(MemoryTracker::DeviceObject::Buffer, id);
+	const VkDevice device = mDevice;
+	const VkBuffer handle = buffer->second.buffer;
+	const VkDeviceMemory memory = buffer->second.memory;
+	release([device, handle, memory]()
+	{
+		vkDestroyBuffer(device, handle, nullptr);
+		vkFreeMemory(device, memory, nullptr);
+	});
+	mBuffers.erase(buffer);
+}
+
+void* VulkanBackend::mappedData(BufferId id)
+{
+	const auto buffer = mBuffers.find(id);
+	return buffer != mBuffers.end() ? buffer->second.mapped : nullptr;
+}
+
+size_t VulkanBackend::storageBufferAlignment() const
+{
+	return static_cast<size_t>(mProperties.limits.minStorageBufferOffsetAlignment);
+}
+
+// A Fence is the Batch it was Inserted Into; an Empty Batch Adds Nothing to Wait For
+// ----------------------------------------------------------------------------------
+FenceId VulkanBackend::insertFence()
+{
+	return static_cast<FenceId>(mBatchHasWork ? mSerial : mSerial - 1);
+}
+
+// Waiting on the Batch Being Recorded Submits it First, or it would Never Finish
+// ------------------------------------------------------------------------------
+bool VulkanBackend::waitFence(FenceId fence, uint64_t timeout)
+{
+	if (fence <= mCompletedSerial)
+		return true;
+
+	if (fence >= mSerial)
+	{
+		if (!timeout || mInPass)
+			return false;
+		flush(VK_NULL_HANDLE, VK_NULL_HANDLE);
+	}
+
+	Frame& frame = mFrames[fence % FRAMES_IN_FLIGHT];
+	if (frame.serial == fence)
+	{
+		if (vkWaitForFences(mDevice, 1, &frame.fence, VK_TRUE, timeout) == VK_TIMEOUT)
+			return false;
+	}
+
+	mCompletedSerial = max<uint64_t>(mCompletedSerial, fence);
+	return true;
+}
+
+TimestampId VulkanBackend::createTimestamp()
+{
+	VkQueryPoolCreateInfo info = {};
+	info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+	info.queryCount = 1;
+
+	Timestamp timestamp = {};
+	if (vkCreateQueryPool(mDevice, &info, nullptr, &timestamp.pool) != VK_SUCCESS)
+	{
+		cerr << "ERROR::BACKEND::QUERY_POOL_CREATION Timestamp" << endl;
+		return 0;
+	}
+
+	const TimestampId id = mNextHandle++;
+	mTimestamps[id] = timestamp;
+	return id;
+}
+
+void VulkanBackend::destroyTimestamp(TimestampId id)
+{
+	const auto timestamp = mTimestamps.find(id);
+	if (timestamp == mTimestamps.end())
+		return;
+
+	const VkDevice device = mDevice;
+	const VkQueryPool pool = timestamp->second.pool;
+	release([device, pool]() { vkDestroyQueryPool(device, pool, nullptr); });
+	mTimestamps.erase(timestamp);
+}
+
+// Reset and Written Once the Work Recorded Before it has Finished
+// ---------------------------------------------------------------
+void VulkanBackend::writeTimestamp(TimestampId id)
+{
+	const auto timestamp = mTimestamps.find(id);
+	if (timestamp == mTimestamps.end() || mInPass)
+		return;
+
+	const VkCommandBuffer commands = mFrames[mSerial % FRAMES_IN_FLIGHT].commands;
+	vkCmdResetQueryPool(commands, timestamp->second.pool, 0, 1);
+	vkCmdWriteTimestamp(commands, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestamp->second.pool, 0);
+	timestamp->second.serial = mSerial;
+	mBatchHasWork = true;
+}
+
+// Ticks Scaled by the Device's Period into Nanoseconds; the Batch's Fence Says when it is In
+// ------------------------------------------------------------------------------------------
+bool VulkanBackend::timestampResult(TimestampId id, bool wait, uint64_t& nanoseconds)
+{
+	const auto timestamp = mTimestamps.find(id);
+	if (timestamp == mTimestamps.end() || !timestamp->second.serial || !waitFence(timestamp->second.serial, wait ? UINT64_MAX : 0))
+		return false;
+
+	uint64_t ticks = 0;
+	if (vkGetQueryPoolResults(mDevice, timestamp->second.pool, 0, 1, sizeof(ticks), &ticks, sizeof(ticks), VK_QUERY_RESULT_64_BIT) != VK_SUCCESS)
+		return false;
+
+	nanoseconds = static_cast<uint64_t>(static_cast<double>(ticks) * mProperties.limits.timestampPeriod);
+	return true;
+}
+
+TextureId VulkanBackend::createTexture(const TextureDesc& desc, const void* pixels)
+{
+	// Error Check: Empty Textures Cannot be Sampled
+	// ---------------------------------------------
+	if (desc.width <= 0 || desc.height <= 0)
+	{
+		cerr << "ERROR::BACKEND::TEXTURE_SIZE " << desc.width << "x" << desc.height << endl;
+		return 0;
+	}
+
+	Texture texture = {};
+	texture.desc = desc;
+	texture.format = textureFormat(desc.format, mDepth24Format);
+	texture.levels = desc.levels > 0 ? static_cast<uint32_t>(desc.levels) : desc.mipmaps ? mipLevels(desc.width, desc.height) : 1;
+	const VkImageAspectFlags aspectMask = aspect(texture.format);
+
+	VkImageCreateInfo imageInfo = {};
+	imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageInfo.format = texture.format;
+	imageInfo.extent = { static_cast<uint32_t>(desc.width), static_cast<uint32_t>(desc.height), 1 };
+	imageInfo.mipLevels = texture.levels;
+	imageInfo.arrayLayers = 1;
+	imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+	if (desc.renderTarget)
+		imageInfo.usage |= aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT ? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+	imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	VkMemoryRequirements requirements = {};
+	if (vkCreateImage(mDevice, &imageInfo, nullptr, &texture.image) != VK_SUCCESS)
+	{
+		cerr << "ERROR::BACKEND::TEXTURE_SIZE " << desc.width << "x" << desc.height << endl;
+		return 0;
+	}
+
+	vkGetImageMemoryRequirements(mDevice, texture.image, &requirements);
+	if (!allocate(requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, texture.memory))
+	{
+		vkDestroyImage(mDevice, texture.image, nullptr);
+		return 0;
+	}
+	vkBindImageMemory(mDevice, texture.image, texture.memory, 0);
+	createView(texture);
+
+	// Sampling as the GL Texture Parameters Would
+	// -------------------------------------------
+	const bool linear = desc.filter != TextureFilter::Nearest && linearFilter(texture.format);
+	const VkSamplerAddressMode wrap = desc.wrap == TextureWrap::ClampToEdge ? VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE : VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	VkSamplerCreateInfo samplerInfo = {};
+	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerInfo.magFilter = samplerInfo.minFilter = linear ? VK_FILTER_LINEAR : VK_FILTER_NEAREST;
+	samplerInfo.mipmapMode = desc.filter == TextureFilter::Trilinear ? VK_SAMPLER_MIPMAP_MODE_LINEAR : VK_SAMPLER_MIPMAP_MODE_NEAREST;
+	samplerInfo.addressModeU = samplerInfo.addressModeV = samplerInfo.addressModeW = wrap;
+	samplerInfo.compareEnable = desc.shadowCompare ? VK_TRUE : VK_FALSE;
+	samplerInfo.compareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+	samplerInfo.maxLod = desc.filter == TextureFilter::Trilinear ? VK_LOD_CLAMP_NONE : 0.0f;
+	vkCreateSampler(mDevice, &samplerInfo, nullptr, &texture.sampler);
+
+	// Contents: the Pixels and the Mip Chain Blitted Down from them, or Cleared
+	// --------------------------------------------------------------------------
+	const VkCommandBuffer uploads = mFrames[mSerial % FRAMES_IN_FLIGHT].uploads;
+	imageBarrier(uploads, texture.image, aspectMask, 0, texture.levels, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+	VkBuffer staging = VK_NULL_HANDLE;
+	if (pixels && desc.levels == 0)
+	{
+		const vector<uint8_t> packed = packPixels(desc.format, desc.width, desc.height, pixels, 4);
+		stage(packed.data(), packed.size(), staging);
+	}
+
+	if (staging)
+	{
+		VkBufferImageCopy region = {};
+		region.imageSubresource = { aspectMask, 0, 0, 1 };
+		region.imageExtent = imageInfo.extent;
+		vkCmdCopyBufferToImage(uploads, staging, texture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+		for (uint32_t level = 1; level < texture.levels; ++level)
+		{
+			imageBarrier(uploads, texture.image, aspectMask, level - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+			VkImageBlit blit = {};
+			blit.srcSubresource = { aspectMask, level - 1, 0, 1 };
+			blit.srcOffsets[1] = { max(1, desc.width >> (level - 1)), max(1, desc.height >> (level - 1)), 1 };
+			blit.dstSubresource = { aspectMask, level, 0, 1 };
+			blit.dstOffsets[1] = { max(1, desc.width >> level), max(1, desc.height >> level), 1 };
+			vkCmdBlitImage(uploads, texture.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, texture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				1, &blit, linear ? VK_FILTER_LINEAR : VK_FILTER_NEAREST);
+
+			imageBarrier(uploads, texture.image, aspectMask, level - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+		}
+	}
+	else
+	{
+		const VkImageSubresourceRange range = { aspectMask, 0, texture.levels, 0, 1 };
+		if (aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT)
+		{
+			const VkClearDepthStencilValue clear = { 1.0f, 0 };
+			vkCmdClearDepthStencilImage(uploads, texture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clear, 1, &range);
+		}
+		else
+		{
+			const VkClearColorValue clear = {};
+			vkCmdClearColorImage(uploads, texture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clear, 1, &range);
+		}
+	}
+
+	imageBarrier(uploads, texture.image, aspectMask, 0, texture.levels, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	mBatchHasWork = true;
+
+	const TextureId id = mNextHandle++;
+	mTextures[id] = texture;
+	MemoryTracker::deviceAllocated(MemoryTracker::DeviceObject::Image, id,
+		desc.renderTarget ? MemoryTracker::Category::RenderTargets : MemoryTracker::Category::Textures, static_cast<size_t>(requirements.size));
+	return id;
+}
+
+void VulkanBackend::destroyTexture(TextureId id)
+{
+	const auto texture = mTextures.find(id);
+	if (texture == mTextures.end())
+		return;
+
+	MemoryTracker::deviceFreed(MemoryTracker::DeviceObject::Image, id);
+	const VkDevice device = mDevice;
+	const Texture released = texture->second;
+	release([device, released]()
+	{
+		vkDestroySampler(device, released.sampler, nullptr);
+		vkDestroyImageView(device, released.view, nullptr);
+		vkDestroyImage(device, released.image, nullptr);
+		vkFreeMemory(device, released.memory, nullptr);
+	});
+	mTextures.erase(texture);
+}
+
+// Single-Byte Rows are Tightly Packed, not Padded to Four Bytes, as in the GL Backend
+// ----------------------------------------------------------------------------------
+void VulkanBackend::updateTexture(TextureId id, int level, const void* pixels)
+{
+	const auto found = mTextures.find(id);
+	if (found == mTextures.end() || level < 0 || static_cast<uint32_t>(level) >= found->second.levels)
+		return;
+
+	const Texture& texture = found->second;
+	const int width = max(1, texture.desc.width >> level);
+	const int height = max(1, texture.desc.height >> level);
+	const vector<uint8_t> packed = packPixels(texture.desc.format, width, height, pixels, texture.desc.format == TextureFormat::R8 ? 1 : 4);
+
+	VkBuffer staging = VK_NULL_HANDLE;
+	stage(packed.data(), packed.size(), staging);
+	if (!staging)
+		return;
+
+	const VkCommandBuffer commands = mFrames[mSerial % FRAMES_IN_FLIGHT].commands;
+	VkBufferImageCopy region = {};
+	region.imageSubresource = { aspect(texture.format), static_cast<uint32_t>(level), 0, 1 };
+	region.imageExtent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1 };
+	transition(commands, texture, level, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+	vkCmdCopyBufferToImage(commands, staging, texture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+	transition(commands, texture, level, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	mBatchHasWork = true;
+}
+
+void VulkanBackend::copyTextureLevel(TextureId sourceId, int sourceLevel, TextureId targetId, int targetLevel)
+{
+	const auto source = mTextures.find(sourceId);
+	const auto target = mTextures.find(targetId);
+	if (source == mTextures.end() || target == mTextures.end())
+		return;
+
+	const TextureDesc& desc = source->second.desc;
+	const VkImageAspectFlags aspectMask = aspect(source->second.format);
+	VkImageCopy region = {};
+	region.srcSubresource = { aspectMask, static_cast<uint32_t>(sourceLevel), 0, 1 };
+	region.dstSubresource = { aspectMask, static_cast<uint32_t>(targetLevel), 0, 1 };
+	region.extent = { static_cast<uint32_t>(max(1, desc.width >> sourceLevel)), static_cast<uint32_t>(max(1, desc.height >> sourceLevel)), 1 };
+
+	const VkCommandBuffer commands = mFrames[mSerial % FRAMES_IN_FLIGHT].commands;
+	transition(commands, source->second, sourceLevel, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+	transition(commands, target->second, targetLevel, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+	vkCmdCopyImage(commands, source->second.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, target->second.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+	transition(commands, source->second, sourceLevel, 1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	transition(commands, target->second, targetLevel, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	mBatchHasWork = true;
+}
+
+// A New View Starting at the Level; Lists Already Recorded Keep the Old One
+// -------------------------------------------------------------------------
+void VulkanBackend::setTextureBaseLevel(TextureId id, int level)
+{
+	const auto found = mTextures.find(id);
+	if (found == mTextures.end())
+		return;
+
+	Texture& texture = found->second;
+	const uint32_t baseLevel = min(static_cast<uint32_t>(max(level, 0)), texture.levels - 1);
+	if (baseLevel == texture.baseLevel)
+		return;
+
+	const VkDevice device = mDevice;
+	const VkImageView view = texture.view;
+	release([device, view]() { vkDestroyImageView(device, view, nullptr); });
+
+	texture.baseLevel = baseLevel;
+	createView(texture);
+}
+
+RenderTargetId VulkanBackend::createRenderTarget(const TextureId* colors, size_t colorCount, TextureId depth)
+{
+	RenderTarget target;
+	if (!buildRenderTarget(colors, colorCount, depth, target))
+		return 0;
+
+	const RenderTargetId id = mNextHandle++;
+	mRenderTargets[id] = target;
+	return id;
+}
+
+void VulkanBackend::destroyRenderTarget(RenderTargetId id)
+{
+	const auto target = mRenderTargets.find(id);
+	if (!id || target == mRenderTargets.end())
+		return;
+
+	releaseRenderTarget(target->second);
+	mRenderTargets.erase(target);
+}
+
+// Equal Sizes Copy Texels Exactly; Both Colors Rest Sampled Again Afterwards
+// --------------------------------------------------------------------------
+void VulkanBackend::blitRenderTarget(RenderTargetId sourceId, int sourceWidth, int sourceHeight, RenderTargetId targetId, int targetWidth, int targetHeight)
+{
+	const auto source = mRenderTargets.find(sourceId);
+	const auto target = mRenderTargets.find(targetId);
+	if (mInPass || source == mRenderTargets.end() || target == mRenderTargets.end() || !source->second.colorCount || !target->second.colorCount)
+		return;
+
+	const Texture& from = mTextures.at(source->second.colors[0]);
+	const Texture& to = mTextures.at(target->second.colors[0]);
+	const bool scaled = sourceWidth != targetWidth || sourceHeight != targetHeight;
+
+	VkImageBlit blit = {};
+	blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+	blit.srcOffsets[1] = { sourceWidth, sourceHeight, 1 };
+	blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+	blit.dstOffsets[1] = { targetWidth, targetHeight, 1 };
+
+	const VkCommandBuffer commands = mFrames[mSerial % FRAMES_IN_FLIGHT].commands;
+	transition(commands, from, 0, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+	transition(commands, to, 0, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+	vkCmdBlitImage(commands, from.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, to.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit,
+		scaled && linearFilter(from.format) ? VK_FILTER_LINEAR : VK_FILTER_NEAREST);
+	transition(commands, from, 0, 1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	transition(commands, to, 0, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	mBatchHasWork = true;
+}
+
+// Rows are Copied Bottom First, as Images are Laid Out; the Copy is Made Visible to the Host
+// ------------------------------------------------------------------------------------------
+void VulkanBackend::readRenderTarget(RenderTargetId targetId, int width, int height, BufferId bufferId)
+{
+	const auto target = mRenderTargets.find(targetId);
+	const auto buffer = mBuffers.find(bufferId);
+	if (mInPass || target == mRenderTargets.end() || buffer == mBuffers.end() || !target->second.colorCount)
+		return;
+
+	const Texture& color = mTextures.at(target->second.colors[0]);
+	VkBufferImageCopy region = {};
+	region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+	region.imageExtent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1 };
+
+	VkMemoryBarrier barrier = {};
+	barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+
+	const VkCommandBuffer commands = mFrames[mSerial % FRAMES_IN_FLIGHT].commands;
+	transition(commands, color, 0, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+	vkCmdCopyImageToBuffer(commands, color.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer->second.buffer, 1, &region);
+	transition(commands, color, 0, 1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	vkCmdPipelineBarrier(commands, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+	mBatchHasWork = true;
+}
+
+VertexInputId VulkanBackend::createVertexInput(const VertexLayout& layout, BufferId vertices, BufferId indices)
+{
+	// Error Check: the Vertex Input Needs a Vertex Buffer and an Index Buffer of this Backend
+	// ---------------------------------------------------------------------------------------
+	if (vertices || indices)
+	{
+		const auto vertexBuffer = mBuffers.find(vertices);
+		const auto indexBuffer = mBuffers.find(indices);
+		if (vertexBuffer == mBuffers.end() || vertexBuffer->second.type != BufferType::Vertex ||
+			indexBuffer == mBuffers.end() || indexBuffer->second.type != BufferType::Index)
+		{
+			cerr << "ERROR::BACKEND::VERTEX_INPUT_BUFFERS " << vertices << " " << indices << endl;
+			return 0;
+		}
+	}
+
+	// Identical Layouts Share an Index, and with it their Pipelines
+	// -------------------------------------------------------------
+	uint32_t layoutIndex = 0;
+	for (; layoutIndex < mVertexLayouts.size(); ++layoutIndex)
+	{
+		const VertexLayout& existing = mVertexLayouts[layoutIndex];
+		bool same = existing.stride == layout.stride && existing.attributeCount == layout.attributeCount;
+		for (size_t i = 0; same && i < layout.attributeCount; ++i)
+		{
+			const VertexAttribute& a = existing.attributes[i];
+			const VertexAttribute& b = layout.attributes[i];
+			same = a.location == b.location && a.components == b.components && a.offset == b.offset && a.normalizedBytes == b.normalizedBytes;
+		}
+		if (same)
+			break;
+	}
+	if (layoutIndex == mVertexLayouts.size())
+		mVertexLayouts.push_back(layout);
+
+	const VertexInputId id = mNextHandle++;
+	mVertexInputs[id] = { layoutIndex, vertices, indices };
+	return id;
+}
+
+void VulkanBackend::destroyVertexInput(VertexInputId vertexInput)
+{
+	mVertexInputs.erase(vertexInput);
+}
+
+// Patches Both Stages onto One Descriptor Layout and One Interface, as GL's Link Would
+// Match them by Name
+// ------------------------------------------------------------------------------------
+ProgramId VulkanBackend::createProgram(const vector<uint32_t>& vertexSpirv, const vector<uint32_t>& fragmentSpirv)
+{
+	SpirvModule stages[2];
+	if (!stages[0].parse(vertexSpirv) || !stages[1].parse(fragmentSpirv))
+		return 0;
+
+	Program program = {};
+	vector<VkDescriptorSetLayoutBinding> bindings;
+	for (uint32_t stage = 0; stage < 2; ++stage)
+	{
+		SpirvModule& module = stages[stage];
+
+		// Error Check: the Default Block Fits the Range Every Draw Binds
+		// --------------------------------------------------------------
+		if (module.uniformBlockSize() > UNIFORM_RANGE)
+		{
+			cerr << "ERROR::BACKEND::UNIFORM_BLOCK_SIZE " << module.uniformBlockSize() << " Bytes Over " << UNIFORM_RANGE << endl;
+			return 0;
+		}
+		if (module.hasUniformBlock())
+			module.setBinding(module.uniformBlock(), 0, stage);
+
+		// Storage Buffers Keep their GL Binding; Samplers Share a Binding per Name
+		// ------------------------------------------------------------------------
+		for (const SpirvModule::Resource& storage : module.storageBuffers())
+		{
+			if (storage.binding >= SAMPLER_BINDING_BASE)
+			{
+				cerr << "ERROR::BACKEND::STORAGE_BINDING " << storage.name << " at " << storage.binding << " (Below " << SAMPLER_BINDING_BASE << ")" << endl;
+				return 0;
+			}
+
+			module.setBinding(storage, 1, storage.binding);
+			if (find(program.storageBindings.begin(), program.storageBindings.end(), storage.binding) == program.storageBindings.end())
+				program.storageBindings.push_back(storage.binding);
+		}
+
+		for (const SpirvModule::Resource& sampler : module.samplers())
+		{
+			const size_t index = find(program.samplers.begin(), program.samplers.end(), sampler.name) - program.samplers.begin();
+			if (index == program.samplers.size())
+				program.samplers.push_back(sampler.name);
+
+			if (program.samplers.size() > MAX_TEXTURE_UNITS)
+			{
+				cerr << "ERROR::BACKEND::TOO_MANY_SAMPLERS " << program.samplers.size() << " (At Most " << MAX_TEXTURE_UNITS << ")" << endl;
+				return 0;
+			}
+			module.setBinding(sampler, 1, SAMPLER_BINDING_BASE + static_cast<uint32_t>(index));
+		}
+
+		(stage == 0 ? program.vertexMembers : program.fragmentMembers) = module.members();
+		(stage == 0 ? program.vertexBlockSize : program.fragmentBlockSize) = module.uniformBlockSize();
+	}
+
+	// Error Check: Every Fragment Input Comes from a Vertex Output of the Same Name
+	// ------------------------------------------------------------------------------
+	for (const SpirvModule::Interface& input : stages[1].inputs())
+	{
+		const auto output = find_if(stages[0].outputs().begin(), stages[0].outputs().end(),
+			[&input](const SpirvModule::Interface& candidate) { return candidate.name == input.name; });
+		if (output == stages[0].outputs().end())
+		{
+			cerr << "ERROR::BACKEND::UNMATCHED_VARYING " << input.name << endl;
+			return 0;
+		}
+		stages[1].setLocation(input, output->location);
+	}
+
+	for (uint32_t binding : program.storageBindings)
+		bindings.push_back({ binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, nullptr });
+	for (size_t i = 0; i < program.samplers.size(); ++i)
+		bindings.push_back({ SAMPLER_BINDING_BASE + static_cast<uint32_t>(i), VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1,
+			VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, nullptr });
+
+	VkShaderModule* modules[2] = { &program.vertex, &program.fragment };
+	for (int stage = 0; stage < 2; ++stage)
+	{
+		VkShaderModuleCreateInfo moduleInfo = {};
+		moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		moduleInfo.codeSize = stages[stage].words().size() * sizeof(uint32_t);
+		moduleInfo.pCode = stages[stage].words().data();
+		vkCreateShaderModule(mDevice, &moduleInfo, nullptr, modules[stage]);
+	}
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+	layoutInfo.pBindings = bindings.data();
+	vkCreateDescriptorSetLayout(mDevice, &layoutInfo, nullptr, &program.setLayout);
+
+	const VkDescriptorSetLayout setLayouts[] = { mUniformSetLayout, program.setLayout };
+	VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
+	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutInfo.setLayoutCount = 2;
+	pipelineLayoutInfo.pSetLayouts = setLayouts;
+	vkCreatePipelineLayout(mDevice, &pipelineLayoutInfo, nullptr, &program.pipelineLayout);
+
+	// Error Check: the Driver Accepted Both Modules
+	// ---------------------------------------------
+	if (!program.vertex || !program.fragment || !program.setLayout || !program.pipelineLayout)
+	{
+		cerr << "ERROR::BACKEND::SHADER_MODULE " << vertexSpirv.size() << " and " << fragmentSpirv.size() << " Words" << endl;
+		vkDestroyShaderModule(mDevice, program.vertex, nullptr);
+		vkDestroyShaderModule(mDevice, program.fragment, nullptr);
+		vkDestroyPipelineLayout(mDevice, program.pipelineLayout, nullptr);
+		vkDestroyDescriptorSetLayout(mDevice, program.setLayout, nullptr);
+		return 0;
+	}
+
+	const ProgramId id = mNextHandle++;
+	mPrograms[id] = program;
+	MemoryTracker::deviceAllocated(MemoryTracker::DeviceObject::Program, id, MemoryTracker::Category::Programs,
+		(vertexSpirv.size() + fragmentSpirv.size()) * sizeof(uint32_t));
+	return id;
+}
+
+void VulkanBackend::destroyProgram(ProgramId id)
+{
+	const auto program = mPrograms.find(id);
+	if (program == mPrograms.end())
+		return;
+
+	MemoryTracker::deviceFreed(MemoryTracker::DeviceObject::Program, id);
+	const VkDevice device = mDevice;
+	const Program released = program->second;
+	release([device, released]()
+	{
+		vkDestroyShaderModule(device, released.vertex, nullptr);
+		vkDestroyShaderModule(device, released.fragment, nullptr);
+		vkDestroyPipelineLayout(device, released.pipelineLayout, nullptr);
+		vkDestroyDescriptorSetLayout(device, released.setLayout, nullptr);
+	});
+	mPrograms.erase(program);
+}
+
+// Slots Resolve to Samplers and Default Block Members by Name, as glGetUniformLocation Does
+// -----------------------------------------------------------------------------------------
+PipelineId VulkanBackend::createPipeline(const PipelineDesc& desc)
+{
+	const auto program = mPrograms.find(desc.program);
+
+	// Error Check: a Program this Backend Created
+	// -------------------------------------------
+	if (program == mPrograms.end())
+	{
+		cerr << "ERROR::BACKEND::PIPELINE_PROGRAM " << desc.program << endl;
+		return 0;
+	}
+
+	Pipeline pipeline;
+	pipeline.desc = desc;
+	pipeline.desc.uniforms = nullptr;
+	pipeline.slots.resize(desc.uniformCount);
+	for (size_t i = 0; i < desc.uniformCount; ++i)
+	{
+		if (!desc.uniforms[i])
+			continue;
+
+		const string name = desc.uniforms[i];
+		SlotTarget& slot = pipeline.slots[i];
+		const vector<string>& samplers = program->second.samplers;
+		const auto sampler = find(samplers.begin(), samplers.end(), name);
+		if (sampler != samplers.end())
+			slot.sampler = static_cast<int>(sampler - samplers.begin());
+
+		for (int stage = 0; stage < 2; ++stage)
+		{
+			const vector<SpirvModule::Member>& members = stage == 0 ? program->second.vertexMembers : program->second.fragmentMembers;
+			for (size_t member = 0; member < members.size(); ++member)
+			{
+				if (members[member].name == name)
+					(stage == 0 ? slot.vertexMember : slot.fragmentMember) = static_cast<int>(member);
+			}
+		}
+	}
+
+	const PipelineId id = mNextHandle++;
+	mPipelines[id] = pipeline;
+	return id;
+}
+
+void VulkanBackend::destroyPipeline(PipelineId id)
+{
+	if (!mPipelines.erase(id))
+		return;
+
+	for (auto variant = mPipelineVariants.begin(); variant != mPipelineVariants.end();)
+	{
+		if ((variant->first >> 32) != id)
+		{
+			++variant;
+			continue;
+		}
+
+		const VkDevice device = mDevice;
+		const VkPipeline handle = variant->second;
+		release([device, handle]() { vkDestroyPipeline(device, handle, nullptr); });
+		variant = mPipelineVariants.erase(variant);
+	}
+}
+
+#pragma endregion
+
+#pragma region Passes
+
+// Clears Only Touch the Render Area, which is the Viewport Inside the Target
+// --------------------------------------------------------------------------
+void VulkanBackend::beginPass(const PassDesc& pass)
+{
+	// The Window Target Follows the Framebuffer Size, Checked Once a Frame
+	// ---------------------------------------------------------------------
+	if (pass.target == 0 && !mWindowChecked)
+	{
+		int width = 0;
+		int height = 0;
+		glfwGetFramebufferSize(mWindow, &width, &height);
+		const RenderTarget& window = mRenderTargets.at(0);
+		if (width > 0 && height > 0 && (static_cast<uint32_t>(width) != window.width || static_cast<uint32_t>(height) != window.height))
+		{
+			destroyWindowTarget();
+			createWindowTarget(static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+			mSwapchainStale = true;
+		}
+		mWindowChecked = true;
+	}
+
+	mInPass = true;
+	mPassRenderPass = VK_NULL_HANDLE;
+	const auto found = mRenderTargets.find(pass.target);
+	if (found == mRenderTargets.end())
+	{
+		cerr << "ERROR::BACKEND::PASS_TARGET " << pass.target << endl;
+		return;
+	}
+
+	const RenderTarget& target = found->second;
+	const int32_t x0 = min(max(pass.x, 0), static_cast<int32_t>(target.width));
+	const int32_t y0 = min(max(pass.y, 0), static_cast<int32_t>(target.height));
+	const int32_t x1 = min(max(pass.x + pass.width, x0), static_cast<int32_t>(target.width));
+	const int32_t y1 = min(max(pass.y + pass.height, y0), static_cast<int32_t>(target.height));
+	if (x1 == x0 || y1 == y0)
+		return;
+
+	const bool hasColor = target.colorCount > 0;
+	const bool hasDepth = target.depth != 0;
+	mPassRenderPass = renderPass(target.formatClass, pass.clearColor && hasColor, pass.clearDepth && hasDepth);
+	mPassFramebuffer = target.framebuffer;
+	mPassFormatClass = target.formatClass;
+	mPassViewport = { static_cast<float>(pass.x), static_cast<float>(pass.y), static_cast<float>(pass.width), static_cast<float>(pass.height), 0.0f, 1.0f };
+	mPassRect = { { x0, y0 }, { static_cast<uint32_t>(x1 - x0), static_cast<uint32_t>(y1 - y0) } };
+
+	// Integer Colors Clear to the Color Converted to Integers, as glClearBufferuiv Would
+	// ----------------------------------------------------------------------------------
+	const FormatClass& formats = mFormatClasses[target.formatClass];
+	VkClearValue clears[MAX_COLOR_TARGETS + 1] = {};
+	uint32_t clearCount = 0;
+	for (; clearCount < target.colorCount; ++clearCount)
+	{
+		VkClearColorValue& clear = clears[clearCount].color;
+		if (integerFormat(formats.colors[clearCount]))
+		{
+			for (int i = 0; i < 4; ++i)
+				clear.uint32[i] = static_cast<uint32_t>(pass.color[i]);
+		}
+		else
+			memcpy(clear.float32, &pass.color[0], 4 * sizeof(float));
+	}
+	if (hasDepth)
+		clears[clearCount++].depthStencil = { 1.0f, 0 };
+
+	VkRenderPassBeginInfo beginInfo = {};
+	beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+	beginInfo.renderPass = mPassRenderPass;
+	beginInfo.framebuffer = mPassFramebuffer;
+	beginInfo.renderArea = mPassRect;
+	beginInfo.clearValueCount = clearCount;
+	beginInfo.pClearValues = clears;
+	vkCmdBeginRenderPass(mFrames[mSerial % FRAMES_IN_FLIGHT].commands, &beginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+	mBatchHasWork = true;
+}
+
+void VulkanBackend::endPass()
+{
+	if (mInPass && mPassRenderPass)
+		vkCmdEndRenderPass(mFrames[mSerial % FRAMES_IN_FLIGHT].commands);
+	mInPass = false;
+	mPassRenderPass = VK_NULL_HANDLE;
+}
+
+// One Secondary Command Buffer per List, Recorded Across the Job System and Executed in
+// the Order Given
+// -------------------------------------------------------------------------------------
+void VulkanBackend::submit(const CommandList* lists, size_t count)
+{
+	if (!mInPass || !mPassRenderPass)
+		return;
+
+	mRecording.clear();
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (!lists[i].words().empty())
+			mRecording.emplace_back(&nextRecorder(), &lists[i]);
+	}
+	if (mRecording.empty())
+		return;
+
+	mJobSystem->parallelFor(mRecording.size(), 1, [this](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+			record(*mRecording[i].first, *mRecording[i].second);
+	});
+
+	mSecondaries.clear();
+	for (const auto& recording : mRecording)
+		mSecondaries.push_back(recording.first->commands);
+	vkCmdExecuteCommands(mFrames[mSerial % FRAMES_IN_FLIGHT].commands, static_cast<uint32_t>(mSecondaries.size()), mSecondaries.data());
+}
+
+// The Present Mode is the Swapchain's, so a Change Rebuilds it at the Next present()
+// ----------------------------------------------------------------------------------
+void VulkanBackend::setVsync(bool enabled)
+{
+	mSwapchainStale = mSwapchainStale || enabled != mVsync;
+	mVsync = enabled;
+}
+
+// Flip the Window Target into the Swapchain Image, then Submit the Batch and Present
+// ----------------------------------------------------------------------------------
+void VulkanBackend::present()
+{
+	mWindowChecked = false;
+	if (mSwapchainStale)
+	{
+		vkDeviceWaitIdle(mDevice);
+		destroySwapchain();
+		createSwapchain();
+		mSwapchainStale = false;
+	}
+
+	Frame& frame = mFrames[mSerial % FRAMES_IN_FLIGHT];
+	uint32_t image = 0;
+	const VkResult acquired = mSwapchain ? vkAcquireNextImageKHR(mDevice, mSwapchain, UINT64_MAX, frame.imageAvailable, VK_NULL_HANDLE, &image)
+		: VK_ERROR_OUT_OF_DATE_KHR;
+
+	// Error Check: the Surface Changed or is Minimized; the Frame is Dropped
+	// ----------------------------------------------------------------------
+	if (acquired != VK_SUCCESS && acquired != VK_SUBOPTIMAL_KHR)
+	{
+		mSwapchainStale = true;
+		flush(VK_NULL_HANDLE, VK_NULL_HANDLE);
+		return;
+	}
+
+	const RenderTarget& window = mRenderTargets.at(0);
+	const Texture& color = mTextures.at(window.colors[0]);
+	const VkImage swapchainImage = mSwapchainImages[image];
+
+	VkImageBlit blit = {};
+	blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+	blit.srcOffsets[1] = { static_cast<int32_t>(window.width), static_cast<int32_t>(window.height), 1 };
+	blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+	blit.dstOffsets[0] = { 0, static_cast<int32_t>(mSwapchainExtent.height), 0 };
+	blit.dstOffsets[1] = { static_cast<int32_t>(mSwapchainExtent.width), 0, 1 };
+
+	transition(frame.commands, color, 0, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+	imageBarrier(frame.commands, swapchainImage, VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+	vkCmdBlitImage(frame.commands, color.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, swapchainImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_NEAREST);
+	transition(frame.commands, color, 0, 1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	imageBarrier(frame.commands, swapchainImage, VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+
+	const VkSemaphore renderFinished = mRenderFinished[image];
+	flush(frame.imageAvailable, renderFinished);
+
+	VkPresentInfoKHR presentInfo = {};
+	presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+	presentInfo.waitSemaphoreCount = 1;
+	presentInfo.pWaitSemaphores = &renderFinished;
+	presentInfo.swapchainCount = 1;
+	presentInfo.pSwapchains = &mSwapchain;
+	presentInfo.pImageIndices = &image;
+
+	const VkResult presented = vkQueuePresentKHR(mQueue, &presentInfo);
+	if (presented == VK_ERROR_OUT_OF_DATE_KHR || presented == VK_SUBOPTIMAL_KHR)
+		mSwapchainStale = true;
+}
+
+#pragma endregion
+
+#pragma region Recording
+
+// Recorders are Kept by Frame Slot, so their Pools are Only Reset Once the GPU is Done
+// ------------------------------------------------------------------------------------
+VulkanBackend::Recorder& VulkanBackend::nextRecorder()
+{
+	Frame& frame = mFrames[mSerial % FRAMES_IN_FLIGHT];
+	if (frame.recordersUsed == frame.recorders.size())
+	{
+		unique_ptr<Recorder> recorder(new Recorder());
+
+		VkCommandPoolCreateInfo poolInfo = {};
+		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.queueFamilyIndex = mQueueFamily;
+		vkCreateCommandPool(mDevice, &poolInfo, nullptr, &recorder->pool);
+
+		VkCommandBufferAllocateInfo allocateInfo = {};
+		allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocateInfo.commandPool = recorder->pool;
+		allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+		allocateInfo.commandBufferCount = 1;
+		vkAllocateCommandBuffers(mDevice, &allocateInfo, &recorder->commands);
+
+		frame.recorders.push_back(move(recorder));
+	}
+
+	return *frame.recorders[frame.recordersUsed++];
+}
+
+// Mapped Uniform Memory with a Set 0 Reading Both Stages' Blocks from it
+// ----------------------------------------------------------------------
+VulkanBackend::UniformChunk* VulkanBackend::takeChunk()
+{
+	lock_guard<mutex> lock(mChunkMutex);
+	if (!mFreeChunks.empty())
+	{
+		UniformChunk* chunk = mFreeChunks.back();
+		mFreeChunks.pop_back();
+		return chunk;
+	}
+
+	unique_ptr<UniformChunk> chunk(new UniformChunk());
+	if (!createRawBuffer(UNIFORM_CHUNK_SIZE, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, HOST_MEMORY, chunk->buffer, chunk->memory))
+		return nullptr;
+
+	void* mapped = nullptr;
+	vkMapMemory(mDevice, chunk->memory, 0, VK_WHOLE_SIZE, 0, &mapped);
+	chunk->mapped = static_cast<char*>(mapped);
+
+	VkDescriptorSetAllocateInfo allocateInfo = {};
+	allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocateInfo.descriptorPool = mChunkDescriptorPool;
+	allocateInfo.descriptorSetCount = 1;
+	allocateInfo.pSetLayouts = &mUniformSetLayout;
+
+	// Error Check: Every Chunk Holds One Set from a Fixed Pool
+	// --------------------------------------------------------
+	if (vkAllocateDescriptorSets(mDevice, &allocateInfo, &chunk->set) != VK_SUCCESS)
+	{
+		cerr << "ERROR::BACKEND::UNIFORM_CHUNKS Over " << DESCRIPTOR_SETS_PER_POOL << " Chunks in Flight" << endl;
+		vkDestroyBuffer(mDevice, chunk->buffer, nullptr);
+		vkFreeMemory(mDevice, chunk->memory, nullptr);
+		return nullptr;
+	}
+
+	VkDescriptorBufferInfo bufferInfo = { chunk->buffer, 0, UNIFORM_RANGE };
+	VkWriteDescriptorSet writes[2] = {};
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writes[i].dstSet = chunk->set;
+		writes[i].dstBinding = i;
+		writes[i].descriptorCount = 1;
+		writes[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		writes[i].pBufferInfo = &bufferInfo;
+	}
+	vkUpdateDescriptorSets(mDevice, 2, writes, 0, nullptr);
+
+	chunk->id = mNextHandle++;
+	MemoryTracker::deviceAllocated(MemoryTracker::DeviceObject::Buffer, chunk->id, MemoryTracker::Category::StreamBuffers, UNIFORM_CHUNK_SIZE);
+	mChunks.push_back(move(chunk));
+	return mChunks.back().get();
+}
+
+// Sets Come from the Recorder's Own Pools, Another Pool Added Whenever One Runs Out
+// ---------------------------------------------------------------------------------
+VkDescriptorSet VulkanBackend::allocateSet(Recorder& recorder, VkDescriptorSetLayout layout)
+{
+	VkDescriptorSetAllocateInfo allocateInfo = {};
+	allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocateInfo.descriptorSetCount = 1;
+	allocateInfo.pSetLayouts = &layout;
+
+	for (;; ++recorder.descriptorPool)
+	{
+		if (recorder.descriptorPool == recorder.descriptorPools.size())
+		{
+			const VkDescriptorPoolSize sizes[] = {
+				{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_TEXTURE_UNITS * DESCRIPTOR_SETS_PER_POOL },
+				{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, SAMPLER_BINDING_BASE * DESCRIPTOR_SETS_PER_POOL } };
+			VkDescriptorPoolCreateInfo poolInfo = {};
+			poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+			poolInfo.maxSets = DESCRIPTOR_SETS_PER_POOL;
+			poolInfo.poolSizeCount = 2;
+			poolInfo.pPoolSizes = sizes;
+
+			VkDescriptorPool pool = VK_NULL_HANDLE;
+			if (vkCreateDescriptorPool(mDevice, &poolInfo, nullptr, &pool) != VK_SUCCESS)
+				return VK_NULL_HANDLE;
+			recorder.descriptorPools.push_back(pool);
+		}
+
+		VkDescriptorSet set = VK_NULL_HANDLE;
+		allocateInfo.descriptorPool = recorder.descriptorPools[recorder.descriptorPool];
+		if (vkAllocateDescriptorSets(mDevice, &allocateInfo, &set) == VK_SUCCESS)
+			return set;
+	}
+}
+
+// Replays One List as GLBackend::execute Does; Uniforms and Bindings Reach the Command
+// Buffer at the Next Draw
+// ------------------------------------------------------------------------------------
+void VulkanBackend::record(Recorder& recorder, const CommandList& list)
+{
+	typedef CommandList::Op Op;
+
+	recorder.pipeline = nullptr;
+	recorder.pipelineId = 0;
+	recorder.program = nullptr;
+	recorder.variantPipeline = 0;
+	recorder.variant = VK_NULL_HANDLE;
+	recorder.boundPipeline = VK_NULL_HANDLE;
+	recorder.boundProgram = nullptr;
+	recorder.vertexInput = nullptr;
+	recorder.programUniforms = nullptr;
+	recorder.descriptorsDirty = true;
+	fill(begin(recorder.textures), end(recorder.textures), 0);
+	fill(begin(recorder.storage), end(recorder.storage), StorageBinding());
+
+	// Each List Sets the Uniforms it Reads; Samplers Read Unit Zero Until Set
+	// -----------------------------------------------------------------------
+	for (auto& uniforms : recorder.uniforms)
+	{
+		fill(uniforms.second.vertex.begin(), uniforms.second.vertex.end(), 0);
+		fill(uniforms.second.fragment.begin(), uniforms.second.fragment.end(), 0);
+		fill(uniforms.second.units.begin(), uniforms.second.units.end(), 0);
+		uniforms.second.dirty = true;
+	}
+
+	VkCommandBufferInheritanceInfo inheritance = {};
+	inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+	inheritance.renderPass = mPassRenderPass;
+	inheritance.framebuffer = mPassFramebuffer;
+
+	VkCommandBufferBeginInfo beginInfo = {};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	beginInfo.pInheritanceInfo = &inheritance;
+
+	const VkCommandBuffer commands = recorder.commands;
+	// Every Viewport a Pipeline Declares Starts as the Pass's
+	// -------------------------------------------------------
+	vkBeginCommandBuffer(commands, &beginInfo);
+	for (uint32_t i = 0; i < mMaxViewports; ++i)
+	{
+		vkCmdSetViewport(commands, i, 1, &mPassViewport);
+		vkCmdSetScissor(commands, i, 1, &mPassRect);
+	}
+
+	const uint32_t* word = list.words().data();
+	const uint32_t* end = word + list.words().size();
+	while (word < end)
+	{
+		const Op op = static_cast<Op>(*word++);
+		switch (op)
+		{
+			case Op::BindPipeline:
+			{
+				const auto pipeline = mPipelines.find(word[0]);
+				const auto program = pipeline != mPipelines.end() ? mPrograms.find(pipeline->second.desc.program) : mPrograms.end();
+				recorder.pipelineId = word[0];
+				recorder.pipeline = pipeline != mPipelines.end() ? &pipeline->second : nullptr;
+				recorder.program = program != mPrograms.end() ? &program->second : nullptr;
+				recorder.programUniforms = nullptr;
+				if (recorder.program)
+				{
+					ProgramUniforms& uniforms = recorder.uniforms[program->first];
+					uniforms.vertex.resize(recorder.program->vertexBlockSize);
+					uniforms.fragment.resize(recorder.program->fragmentBlockSize);
+					uniforms.units.resize(recorder.program->samplers.size());
+					recorder.programUniforms = &uniforms;
+				}
+				word += 1;
+				break;
+			}
+
+			case Op::BindVertexInput:
+			{
+				const auto vertexInput = mVertexInputs.find(word[0]);
+				recorder.vertexInput = vertexInput != mVertexInputs.end() ? &vertexInput->second : nullptr;
+				recorder.indexType = static_cast<IndexType>(word[1]) == IndexType::UInt32 ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16;
+				if (recorder.vertexInput && recorder.vertexInput->vertices)
+				{
+					const VkDeviceSize offset = 0;
+					vkCmdBindVertexBuffers(commands, 0, 1, &mBuffers.at(recorder.vertexInput->vertices).buffer, &offset);
+					vkCmdBindIndexBuffer(commands, mBuffers.at(recorder.vertexInput->indices).buffer, 0, recorder.indexType);
+				}
+				word += 2;
+				break;
+			}
+
+			case Op::BindVertexBuffer:
+			{
+				const auto buffer = mBuffers.find(word[0]);
+				if (recorder.vertexInput && mVertexLayouts[recorder.vertexInput->layout].attributeCount > 0 && buffer != mBuffers.end())
+				{
+					const VkDeviceSize offset = word[1];
+					vkCmdBindVertexBuffers(commands, 0, 1, &buffer->second.buffer, &offset);
+				}
+				word += 2;
+				break;
+			}
+
+			case Op::BindTexture:
+				if (word[0] < MAX_TEXTURE_UNITS)
+					recorder.textures[word[0]] = word[1];
+				recorder.descriptorsDirty = true;
+				word += 2;
+				break;
+
+			case Op::BindStorageBuffer:
+				if (word[0] < SAMPLER_BINDING_BASE)
+					recorder.storage[word[0]] = { word[1], word[2], word[3] };
+				recorder.descriptorsDirty = true;
+				word += 4;
+				break;
+
+			// Views Past maxViewports() Cannot be Picked, so they are Left Out
+			// ----------------------------------------------------------------
+			case Op::SetViewports:
+			{
+				for (uint32_t i = 0; i < min(word[0], mMaxViewports); ++i)
+				{
+					VkViewport viewport = mPassViewport;
+					memcpy(&viewport, word + 1 + 4 * i, 4 * sizeof(float));
+					vkCmdSetViewport(commands, i, 1, &viewport);
+				}
+				word += 1 + 4 * word[0];
+				break;
+			}
+
+			case Op::SetInt:
+			case Op::SetUInt:
+				setUniform(recorder, word[0], word + 1, 1, 1);
+				word += 2;
+				break;
+
+			case Op::SetUVec3:
+				setUniform(recorder, word[0], word + 1, 1, 3);
+				word += 4;
+				break;
+
+			case Op::SetFloat:
+			case Op::SetVec2:
+			case Op::SetVec3:
+			case Op::SetVec4:
+			case Op::SetMat3:
+			case Op::SetMat4:
+			{
+				static const uint32_t COMPONENTS[] = { 1, 2, 3, 4, 9, 16 };
+				const uint32_t components = COMPONENTS[static_cast<uint32_t>(op) - static_cast<uint32_t>(Op::SetFloat)];
+				setUniform(recorder, word[0], word + 2, word[1], components);
+				word += 2 + components * word[1];
+				break;
+			}
+
+			case Op::Draw:
+				if (prepareDraw(recorder))
+					vkCmdDraw(commands, word[0], word[2], word[1], 0);
+				word += 3;
+				break;
+
+			case Op::DrawIndexed:
+				if (prepareDraw(recorder))
+					vkCmdDrawIndexed(commands, word[0], word[2], word[1], 0, 0);
+				word += 3;
+				break;
+
+			case Op::DrawIndexedRanges:
+			{
+				const uint32_t rangeCount = word[0];
+				if (prepareDraw(recorder))
+				{
+					for (uint32_t i = 0; i < rangeCount; ++i)
+						vkCmdDrawIndexed(commands, word[1 + 2 * i], 1, word[2 + 2 * i], 0, 0);
+				}
+				word += 1 + 2 * rangeCount;
+				break;
+			}
+		}
+	}
+
+	vkEndCommandBuffer(commands);
+}
+
+// Pipeline Variant, then the Uniform Blocks and Bindings Changed Since the Last Draw
+// ----------------------------------------------------------------------------------
+bool VulkanBackend::prepareDraw(Recorder& recorder)
+{
+	if (!recorder.pipeline || !recorder.program)
+		return false;
+
+	const uint32_t layout = recorder.vertexInput ? recorder.vertexInput->layout : 0;
+	if (recorder.variantPipeline != recorder.pipelineId || recorder.variantLayout != layout || !recorder.variant)
+	{
+		recorder.variant = pipelineVariant(recorder.pipelineId, layout);
+		recorder.variantPipeline = recorder.pipelineId;
+		recorder.variantLayout = layout;
+	}
+	if (!recorder.variant)
+		return false;
+
+	const VkCommandBuffer commands = recorder.commands;
+	const Program& program = *recorder.program;
+	if (recorder.variant != recorder.boundPipeline)
+	{
+		vkCmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_GRAPHICS, recorder.variant);
+		recorder.boundPipeline = recorder.variant;
+	}
+	if (&program != recorder.boundProgram)
+	{
+		recorder.descriptorsDirty = true;
+		recorder.programUniforms->dirty = true;
+		recorder.boundProgram = &program;
+	}
+
+	// Set 0: Both Blocks Copied into the Recorder's Chunk at Aligned Offsets
+	// -----------------------------------------------------------------------
+	ProgramUniforms& uniforms = *recorder.programUniforms;
+	if (uniforms.dirty)
+	{
+		const VkDeviceSize alignment = max<VkDeviceSize>(mProperties.limits.minUniformBufferOffsetAlignment, 1);
+		const auto aligned = [alignment](VkDeviceSize offset) { return (offset + alignment - 1) / alignment * alignment; };
+
+		VkDeviceSize vertexOffset = aligned(recorder.chunkHead);
+		VkDeviceSize fragmentOffset = aligned(vertexOffset + program.vertexBlockSize);
+		if (recorder.chunks.empty() || fragmentOffset + UNIFORM_RANGE > UNIFORM_CHUNK_SIZE)
+		{
+			UniformChunk* chunk = takeChunk();
+			if (!chunk)
+				return false;
+
+			recorder.chunks.push_back(chunk);
+			vertexOffset = 0;
+			fragmentOffset = aligned(program.vertexBlockSize);
+		}
+
+		UniformChunk& chunk = *recorder.chunks.back();
+		if (!uniforms.vertex.empty())
+			memcpy(chunk.mapped + vertexOffset, uniforms.vertex.data(), uniforms.vertex.size());
+		if (!uniforms.fragment.empty())
+			memcpy(chunk.mapped + fragmentOffset, uniforms.fragment.data(), uniforms.fragment.size());
+		recorder.chunkHead = fragmentOffset + program.fragmentBlockSize;
+
+		const uint32_t offsets[] = { static_cast<uint32_t>(vertexOffset), static_cast<uint32_t>(fragmentOffset) };
+		vkCmdBindDescriptorSets(commands, VK_PIPELINE_BIND_POINT_GRAPHICS, program.pipelineLayout, 0, 1, &chunk.set, 2, offsets);
+		uniforms.dirty = false;
+	}
+
+	// Set 1: Storage Buffers and the Textures on the Units the Samplers Read
+	// -----------------------------------------------------------------------
+	if (recorder.descriptorsDirty && (!program.storageBindings.empty() || !program.samplers.empty()))
+	{
+		const VkDescriptorSet set = allocateSet(recorder, program.setLayout);
+		if (!set)
+			return false;
+
+		recorder.bufferInfos.clear();
+		recorder.imageInfos.clear();
+		recorder.writes.clear();
+		for (uint32_t binding : program.storageBindings)
+		{
+			const StorageBinding& storage = recorder.storage[binding];
+			const auto buffer = mBuffers.find(storage.buffer);
+			if (buffer != mBuffers.end())
+				recorder.bufferInfos.push_back({ buffer->second.buffer, storage.offset, storage.size ? storage.size : VK_WHOLE_SIZE });
+			else
+				recorder.bufferInfos.push_back({ mBuffers.at(mEmptyBuffer).buffer, 0, VK_WHOLE_SIZE });
+		}
+		for (int32_t unit : uniforms.units)
+		{
+			const TextureId id = (unit >= 0 && unit < static_cast<int32_t>(MAX_TEXTURE_UNITS)) ? recorder.textures[unit] : 0;
+			const auto texture = mTextures.find(id);
+			const Texture& bound = texture != mTextures.end() ? texture->second : mTextures.at(mEmptyTexture);
+			recorder.imageInfos.push_back({ bound.sampler, bound.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+		}
+
+		for (size_t i = 0; i < recorder.bufferInfos.size() + recorder.imageInfos.size(); ++i)
+		{
+			const bool storage = i < recorder.bufferInfos.size();
+			VkWriteDescriptorSet write = {};
+			write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			write.dstSet = set;
+			write.dstBinding = storage ? program.storageBindings[i] : SAMPLER_BINDING_BASE + static_cast<uint32_t>(i - recorder.bufferInfos.size());
+			write.descriptorCount = 1;
+			write.descriptorType = storage ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			write.pBufferInfo = storage ? &recorder.bufferInfos[i] : nullptr;
+			write.pImageInfo = storage ? nullptr : &recorder.imageInfos[i - recorder.bufferInfos.size()];
+			recorder.writes.push_back(write);
+		}
+		vkUpdateDescriptorSets(mDevice, static_cast<uint32_t>(recorder.writes.size()), recorder.writes.data(), 0, nullptr);
+		vkCmdBindDescriptorSets(commands, VK_PIPELINE_BIND_POINT_GRAPHICS, program.pipelineLayout, 1, 1, &set, 0, nullptr);
+		recorder.descriptorsDirty = false;
+	}
+
+	return true;
+}
+
+// Built on First Use for a Vertex Layout, the Pass's Format Class and the Fill Mode, with
+// the State GLBackend::applyState Sets
+// ---------------------------------------------------------------------------------------
+VkPipeline VulkanBackend::pipelineVariant(PipelineId id, uint32_t layout)
+{
+	const bool wireframe = mWireframe && !mPipelines.at(id).desc.alwaysFilled;
+	const uint64_t key = (static_cast<uint64_t>(id) << 32) | (static_cast<uint64_t>(layout) << 16) | (mPassFormatClass << 1) | (wireframe ? 1 : 0);
+
+	lock_guard<mutex> lock(mPipelineMutex);
+	const auto existing = mPipelineVariants.find(key);
+	if (existing != mPipelineVariants.end())
+		return existing->second;
+
+	const PipelineDesc& desc = mPipelines.at(id).desc;
+	const Program& program = mPrograms.at(desc.program);
+	const VertexLayout& vertexLayout = mVertexLayouts[layout];
+	const FormatClass& formats = mFormatClasses[mPassFormatClass];
+
+	VkPipelineShaderStageCreateInfo stages[2] = {};
+	for (int i = 0; i < 2; ++i)
+	{
+		stages[i].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		stages[i].stage = i == 0 ? VK_SHADER_STAGE_VERTEX_BIT : VK_SHADER_STAGE_FRAGMENT_BIT;
+		stages[i].module = i == 0 ? program.vertex : program.fragment;
+		stages[i].pName = "main";
+	}
+
+	VkVertexInputBindingDescription binding = { 0, vertexLayout.stride, VK_VERTEX_INPUT_RATE_VERTEX };
+	VkVertexInputAttributeDescription attributes[VertexLayout::MAX_ATTRIBUTES] = {};
+	for (size_t i = 0; i < vertexLayout.attributeCount; ++i)
+	{
+		const VertexAttribute& attribute = vertexLayout.attributes[i];
+		attributes[i] = { attribute.location, 0, attributeFormat(attribute), static_cast<uint32_t>(attribute.offset) };
+	}
+
+	VkPipelineVertexInputStateCreateInfo vertexInput = {};
+	vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+	vertexInput.vertexBindingDescriptionCount = vertexLayout.attributeCount > 0 ? 1 : 0;
+	vertexInput.pVertexBindingDescriptions = &binding;
+	vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexLayout.attributeCount);
+	vertexInput.pVertexAttributeDescriptions = attributes;
+
+	VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
+	inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	inputAssembly.topology = desc.topology == Topology::Lines ? VK_PRIMITIVE_TOPOLOGY_LINE_LIST : VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+	// Clip Depth from -1, as in GL
+	// ----------------------------
+	VkPipelineViewportDepthClipControlCreateInfoEXT clipControl = {};
+	clipControl.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_DEPTH_CLIP_CONTROL_CREATE_INFO_EXT;
+	clipControl.negativeOneToOne = VK_TRUE;
+
+	VkPipelineViewportStateCreateInfo viewport = {};
+	viewport.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+	viewport.pNext = &clipControl;
+	viewport.viewportCount = mMaxViewports;
+	viewport.scissorCount = mMaxViewports;
+
+	// Polygon Offset Only Applies to Filled Polygons in GL
+	// -----------------------------------------------------
+	VkPipelineRasterizationStateCreateInfo rasterization = {};
+	rasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+	rasterization.polygonMode = wireframe ? VK_POLYGON_MODE_LINE : VK_POLYGON_MODE_FILL;
+	rasterization.cullMode = VK_CULL_MODE_NONE;
+	rasterization.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+	rasterization.depthBiasEnable = !wireframe && (desc.depthBiasSlope != 0.0f || desc.depthBiasConstant != 0.0f) ? VK_TRUE : VK_FALSE;
+	rasterization.depthBiasConstantFactor = desc.depthBiasConstant;
+	rasterization.depthBiasSlopeFactor = desc.depthBiasSlope;
+	rasterization.lineWidth = 1.0f;
+
+	VkPipelineMultisampleStateCreateInfo multisample = {};
+	multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+	multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+	// A Disabled GL Depth Test Writes No Depth Either
+	// -----------------------------------------------
+	const bool depthTest = desc.depthTest && formats.depth != VK_FORMAT_UNDEFINED;
+	VkPipelineDepthStencilStateCreateInfo depthStencil = {};
+	depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	depthStencil.depthTestEnable = depthTest ? VK_TRUE : VK_FALSE;
+	depthStencil.depthWriteEnable = depthTest ? VK_TRUE : VK_FALSE;
+	depthStencil.depthCompareOp = desc.depthCompare == DepthCompare::Always ? VK_COMPARE_OP_ALWAYS : VK_COMPARE_OP_LESS;
+
+	// GL Skips Blending for Integer Colors, which Vulkan Cannot Blend
+	// ---------------------------------------------------------------
+	VkPipelineColorBlendAttachmentState blendAttachments[MAX_COLOR_TARGETS] = {};
+	for (uint32_t i = 0; i < formats.colorCount; ++i)
+	{
+		VkPipelineColorBlendAttachmentState& blendAttachment = blendAttachments[i];
+		blendAttachment.blendEnable = desc.alphaBlend && !integerFormat(formats.colors[i]) ? VK_TRUE : VK_FALSE;
+		blendAttachment.srcColorBlendFactor = blendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+		blendAttachment.dstColorBlendFactor = blendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+		blendAttachment.colorBlendOp = blendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+		blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+	}
+
+	VkPipelineColorBlendStateCreateInfo blend = {};
+	blend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	blend.attachmentCount = formats.colorCount;
+	blend.pAttachments = blendAttachments;
+
+	const VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+	VkPipelineDynamicStateCreateInfo dynamic = {};
+	dynamic.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	dynamic.dynamicStateCount = 2;
+	dynamic.pDynamicStates = dynamicStates;
+
+	VkGraphicsPipelineCreateInfo info = {};
+	info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+	info.stageCount = 2;
+	info.pStages = stages;
+	info.pVertexInputState = &vertexInput;
+	info.pInputAssemblyState = &inputAssembly;
+	info.pViewportState = &viewport;
+	info.pRasterizationState = &rasterization;
+	info.pMultisampleState = &multisample;
+	info.pDepthStencilState = &depthStencil;
+	info.pColorBlendState = &blend;
+	info.pDynamicState = &dynamic;
+	info.layout = program.pipelineLayout;
+	info.renderPass = renderPass(mPassFormatClass, false, false);
+
+	// Error Check: a Failed Variant is Kept as Null, so it is Reported Once
+	// ---------------------------------------------------------------------
+	VkPipeline pipeline = VK_NULL_HANDLE;
+	if (vkCreateGraphicsPipelines(mDevice, mPipelineCache, 1, &info, nullptr, &pipeline) != VK_SUCCESS)
+	{
+		cerr << "ERROR::BACKEND::PIPELINE_CREATION Pipeline " << id << ", Vertex Layout " << layout << endl;
+		pipeline = VK_NULL_HANDLE;
+	}
+
+	mPipelineVariants[key] = pipeline;
+	return pipeline;
+}
+
+// A Slot Lands on a Sampler's Unit, or on the Default Block Members of its Name
+// ----------------------------------------------------------------------------
+void VulkanBackend::setUniform(Recorder& recorder, uint32_t slot, const uint32_t* values, uint32_t count, uint32_t componentsPerValue)
+{
+	if (!recorder.pipeline || !recorder.programUniforms || slot >= recorder.pipeline->slots.size())
+		return;
+
+	const SlotTarget& target = recorder.pipeline->slots[slot];
+	ProgramUniforms& uniforms = *recorder.programUniforms;
+	if (target.sampler >= 0)
+	{
+		uniforms.units[target.sampler] = static_cast<int32_t>(values[0]);
+		recorder.descriptorsDirty = true;
+	}
+	if (target.vertexMember >= 0)
+	{
+		writeMember(uniforms.vertex, recorder.program->vertexMembers[target.vertexMember], values, count, componentsPerValue);
+		uniforms.dirty = true;
+	}
+	if (target.fragmentMember >= 0)
+	{
+		writeMember(uniforms.fragment, recorder.program->fragmentMembers[target.fragmentMember], values, count, componentsPerValue);
+		uniforms.dirty = true;
+	}
+}
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,374 @@
+#pragma once
+
+#ifdef RENDER_BACKEND_VULKAN
+
+// Includes
+// -------
+#include <vulkan/vulkan.h>   // Vulkan SDK
+#include <functional>        // std::function
+#include <memory>            // unique_ptr
+#include <mutex>             // mutex
+#include <string>            // string
+#include <unordered_map>     // unordered_map
+#include <vector>            // vector
+
+#include "RenderBackend.h"
+#include "SpirvModule.h"     // Member
+
+class JobSystem;
+struct GLFWwindow;
+
+// Vulkan 1.1 Render Backend
+// -------------------------
+// Draws the same frames as the GL backend from the same command lists. Every pass renders
+// into images laid out the way GL lays them out (row zero at the bottom, unflipped
+// viewports, clip depth from -1 through VK_EXT_depth_clip_control), so gl_FragCoord,
+// viewports and texture coordinates mean what they do in GL, and present() flips the
+// window target into the swapchain with one blit. Programs are SPIR-V that
+// glslangValidator -R built from the GLSL() sources: each stage's default uniform block is
+// patched to set 0 (a dynamic uniform buffer per stage), samplers and storage buffers to
+// set 1, and fragment inputs to the locations of the vertex outputs of the same name.
+// submit() records each command list into its own secondary command buffer on the job
+// system and executes them in order inside the pass's render pass; uniforms are packed
+// into per-recorder chunks of mapped memory, and pipelines are built on first use for
+// each vertex layout, set of target formats and fill mode. Blits, readbacks and timestamps
+// are recorded between the passes, and a timestamp is a query pool of one. Multi-view
+// needs VK_EXT_shader_viewport_index_layer, without which maxViewports() is 1, and
+// setVsync() picks the swapchain's present mode. FRAMES_IN_FLIGHT frames are recorded
+// ahead of the GPU; a fence is the serial of the batch it was inserted into, and destroyed
+// objects are released once the last batch that could use them has finished.
+class VulkanBackend : public RenderBackend
+{
+public:
+	static const uint32_t FRAMES_IN_FLIGHT = 2;
+	static const uint32_t UNIFORM_RANGE = 2048;                 // Bytes a Stage's Default Uniform Block may Use
+	static const VkDeviceSize UNIFORM_CHUNK_SIZE = 256 * 1024;
+	static const uint32_t SAMPLER_BINDING_BASE = 8;             // Set 1: Storage Buffers Keep their GL Binding Below this
+	static const uint32_t MAX_TEXTURE_UNITS = 16;
+	static const uint32_t DESCRIPTOR_SETS_PER_POOL = 256;
+
+	~VulkanBackend() override;
+
+	// Error Check: False, with the Reason Printed, when No Device can Present to the Window
+	// with GL Clip Depth and Line Fill
+	// -------------------------------------------------------------------------------------
+	bool create(GLFWwindow* window, JobSystem& jobSystem);
+
+	const char* name() const override { return "Vulkan 1.1"; }
+	uint32_t maxViewports() const override { return mMaxViewports; }
+
+	BufferId createBuffer(BufferType type, size_t size, const void* data) override;
+	void destroyBuffer(BufferId buffer) override;
+	void* mappedData(BufferId buffer) override;
+	size_t storageBufferAlignment() const override;
+
+	FenceId insertFence() override;
+	bool waitFence(FenceId fence, uint64_t timeout) override;
+	void destroyFence(FenceId) override {}   // Fences are Batch Serials
+	void flush() override;
+	void setVsync(bool enabled) override;
+
+	TimestampId createTimestamp() override;
+	void destroyTimestamp(TimestampId timestamp) override;
+	void writeTimestamp(TimestampId timestamp) override;
+	bool timestampResult(TimestampId timestamp, bool wait, uint64_t& nanoseconds) override;
+
+	TextureId createTexture(const TextureDesc& desc, const void* pixels) override;
+	void destroyTexture(TextureId texture) override;
+	void updateTexture(TextureId texture, int level, const void* pixels) override;
+	void copyTextureLevel(TextureId source, int sourceLevel, TextureId target, int targetLevel) override;
+	void setTextureBaseLevel(TextureId texture, int level) override;
+
+	RenderTargetId createRenderTarget(const TextureId* colors, size_t colorCount, TextureId depth) override;
+	void destroyRenderTarget(RenderTargetId target) override;
+	void blitRenderTarget(RenderTargetId source, int sourceWidth, int sourceHeight, RenderTargetId target, int targetWidth, int targetHeight) override;
+	void readRenderTarget(RenderTargetId target, int width, int height, BufferId buffer) override;
+
+	VertexInputId createVertexInput(const VertexLayout& layout, BufferId vertices, BufferId indices) override;
+	void destroyVertexInput(VertexInputId vertexInput) override;
+
+	ProgramId createProgram(const std::vector<uint32_t>& vertexSpirv, const std::vector<uint32_t>& fragmentSpirv) override;
+	void destroyProgram(ProgramId program) override;
+
+	PipelineId createPipeline(const PipelineDesc& desc) override;
+	void destroyPipeline(PipelineId pipeline) override;
+
+	void beginPass(const PassDesc& pass) override;
+	void endPass() override;
+	void submit(const CommandList* lists, size_t count) override;
+
+	void setWireframe(bool wireframe) override { mWireframe = wireframe; }
+	void present() override;
+
+private:
+	struct Buffer
+	{
+		BufferType type;
+		VkDeviceSize size;
+		VkBuffer buffer;
+		VkDeviceMemory memory;
+		void* mapped;   // Stream and Readback Buffers Only
+	};
+
+	struct Texture
+	{
+		TextureDesc desc;
+		VkFormat format;
+		uint32_t levels;
+		uint32_t baseLevel;
+		VkImage image;
+		VkDeviceMemory memory;
+		VkImageView view;   // Levels from baseLevel On
+		VkSampler sampler;
+	};
+
+	struct RenderTarget
+	{
+		TextureId colors[MAX_COLOR_TARGETS];
+		uint32_t colorCount;
+		TextureId depth;
+		uint32_t width;
+		uint32_t height;
+		uint32_t formatClass;                          // Index into mFormatClasses
+		VkImageView views[MAX_COLOR_TARGETS + 1];      // Level Zero Only, as Attachments Need: the Colors, then the Depth
+		VkFramebuffer framebuffer;
+	};
+
+	// Attachment Formats Render Passes and Pipelines are Built For
+	// ------------------------------------------------------------
+	struct FormatClass
+	{
+		VkFormat colors[MAX_COLOR_TARGETS];
+		uint32_t colorCount;
+		VkFormat depth;   // VK_FORMAT_UNDEFINED Without One
+	};
+
+	// A Query Pool of One, Rewritten in Whichever Batch Writes it Next
+	// ----------------------------------------------------------------
+	struct Timestamp
+	{
+		VkQueryPool pool;
+		uint64_t serial;   // Batch Last Written In; Zero Before the First Write
+	};
+
+	struct VertexInput
+	{
+		uint32_t layout;   // Index into mVertexLayouts
+		BufferId vertices;
+		BufferId indices;
+	};
+
+	struct Program
+	{
+		VkShaderModule vertex;
+		VkShaderModule fragment;
+		VkDescriptorSetLayout setLayout;   // Set 1
+		VkPipelineLayout pipelineLayout;
+		std::vector<SpirvModule::Member> vertexMembers;
+		std::vector<SpirvModule::Member> fragmentMembers;
+		uint32_t vertexBlockSize;
+		uint32_t fragmentBlockSize;
+		std::vector<std::string> samplers;       // Bound at SAMPLER_BINDING_BASE Plus the Index
+		std::vector<uint32_t> storageBindings;
+	};
+
+	// Where a Uniform Slot Lands in a Program; -1 Where it Does Not
+	// ------------------------------------------------------------
+	struct SlotTarget
+	{
+		int sampler = -1;
+		int vertexMember = -1;
+		int fragmentMember = -1;
+	};
+
+	struct Pipeline
+	{
+		PipelineDesc desc;
+		std::vector<SlotTarget> slots;
+	};
+
+	// Mapped Memory Uniform Blocks are Copied Into, with a Set 0 Pointing at it
+	// -------------------------------------------------------------------------
+	struct UniformChunk
+	{
+		BufferId id;   // Counted Under the Buffer Handles
+		VkBuffer buffer;
+		VkDeviceMemory memory;
+		char* mapped;
+		VkDescriptorSet set;
+	};
+
+	struct StorageBinding
+	{
+		BufferId buffer;
+		uint32_t offset;
+		uint32_t size;
+	};
+
+	// Default Block Contents and Sampler Units a List has Set for One Program, as GL Keeps them
+	// ----------------------------------------------------------------------------------------
+	struct ProgramUniforms
+	{
+		std::vector<char> vertex;
+		std::vector<char> fragment;
+		std::vector<int32_t> units;
+		bool dirty = true;
+	};
+
+	// Records One Command List into a Secondary Command Buffer on a Worker Thread
+	// ---------------------------------------------------------------------------
+	struct Recorder
+	{
+		VkCommandPool pool = VK_NULL_HANDLE;
+		VkCommandBuffer commands = VK_NULL_HANDLE;
+		std::vector<VkDescriptorPool> descriptorPools;
+		size_t descriptorPool = 0;                 // Pool Sets are Allocated From
+		std::vector<UniformChunk*> chunks;         // Returned when the Frame's Slot is Reused
+		VkDeviceSize chunkHead = UNIFORM_CHUNK_SIZE;
+
+		// Replay State, Reset for Each List
+		// ---------------------------------
+		const Pipeline* pipeline = nullptr;
+		PipelineId pipelineId = 0;
+		const Program* program = nullptr;
+		PipelineId variantPipeline = 0;            // Pipeline and Layout the Variant was Looked Up For
+		uint32_t variantLayout = 0;
+		VkPipeline variant = VK_NULL_HANDLE;
+		VkPipeline boundPipeline = VK_NULL_HANDLE;
+		const Program* boundProgram = nullptr;
+		const VertexInput* vertexInput = nullptr;
+		VkIndexType indexType = VK_INDEX_TYPE_UINT16;
+		TextureId textures[MAX_TEXTURE_UNITS] = {};
+		StorageBinding storage[SAMPLER_BINDING_BASE] = {};
+		std::unordered_map<ProgramId, ProgramUniforms> uniforms;
+		ProgramUniforms* programUniforms = nullptr;
+		bool descriptorsDirty = true;
+
+		std::vector<VkDescriptorImageInfo> imageInfos;     // Scratch for Writing Set 1
+		std::vector<VkDescriptorBufferInfo> bufferInfos;
+		std::vector<VkWriteDescriptorSet> writes;
+	};
+
+	struct Frame
+	{
+		VkCommandPool pool;
+		VkCommandBuffer uploads;    // Buffer and Texture Contents, Submitted Before commands
+		VkCommandBuffer commands;
+		VkFence fence;
+		VkSemaphore imageAvailable;
+		uint64_t serial;            // Batch Last Submitted from this Slot
+		std::vector<std::unique_ptr<Recorder>> recorders;
+		size_t recordersUsed;
+		std::vector<std::function<void()>> garbage;   // Releases Objects the Batch may Use
+	};
+
+	// Setup
+	// -----
+	bool createDevice(GLFWwindow* window);
+	bool createSwapchain();
+	void destroySwapchain();
+	bool buildRenderTarget(const TextureId* colors, size_t colorCount, TextureId depth, RenderTarget& target);
+	void releaseRenderTarget(const RenderTarget& target);
+	bool createWindowTarget(uint32_t width, uint32_t height);
+	void destroyWindowTarget();
+	void beginFrame();
+	void flush(VkSemaphore wait, VkSemaphore signal);
+
+	// Resources
+	// ---------
+	bool allocate(VkMemoryRequirements requirements, VkMemoryPropertyFlags properties, VkDeviceMemory& memory);
+	bool createRawBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& memory);
+	void stage(const void* data, VkDeviceSize size, VkBuffer& buffer);
+	bool linearFilter(VkFormat format) const;
+	void createView(Texture& texture);
+	void transition(VkCommandBuffer commands, const Texture& texture, uint32_t level, uint32_t levelCount, VkImageLayout from, VkImageLayout to);
+	void release(std::function<void()> destroy);
+	uint32_t formatClass(const FormatClass& formats);
+	VkRenderPass renderPass(uint32_t formatClass, bool clearColor, bool clearDepth);
+	UniformChunk* takeChunk();
+	VkDescriptorSet allocateSet(Recorder& recorder, VkDescriptorSetLayout layout);
+
+	// Recording
+	// ---------
+	Recorder& nextRecorder();
+	void record(Recorder& recorder, const CommandList& list);
+	bool prepareDraw(Recorder& recorder);
+	VkPipeline pipelineVariant(PipelineId pipeline, uint32_t layout);
+	void setUniform(Recorder& recorder, uint32_t slot, const uint32_t* values, uint32_t count, uint32_t componentsPerValue);
+
+	// Device
+	// ------
+	VkInstance mInstance = VK_NULL_HANDLE;
+	VkSurfaceKHR mSurface = VK_NULL_HANDLE;
+	VkPhysicalDevice mPhysicalDevice = VK_NULL_HANDLE;
+	VkPhysicalDeviceProperties mProperties = {};
+	VkPhysicalDeviceMemoryProperties mMemoryProperties = {};
+	VkDevice mDevice = VK_NULL_HANDLE;
+	uint32_t mQueueFamily = 0;
+	VkQueue mQueue = VK_NULL_HANDLE;
+	uint32_t mMaxViewports = 1;                     // Above 1 Only with VK_EXT_shader_viewport_index_layer
+	VkFormat mDepth24Format = VK_FORMAT_UNDEFINED;  // X8_D24 where it can be Drawn Into and Sampled, D32F Otherwise
+	VkPipelineCache mPipelineCache = VK_NULL_HANDLE;
+	GLFWwindow* mWindow = nullptr;
+	JobSystem* mJobSystem = nullptr;
+
+	// Swapchain and the Window Target it Presents
+	// -------------------------------------------
+	VkSwapchainKHR mSwapchain = VK_NULL_HANDLE;
+	VkExtent2D mSwapchainExtent = {};
+	std::vector<VkImage> mSwapchainImages;
+	std::vector<VkSemaphore> mRenderFinished;   // One per Swapchain Image
+	bool mSwapchainStale = false;
+	bool mVsync = true;
+	bool mWindowChecked = false;                // Window Size Compared Once per Frame
+
+	// Objects by Handle; Handles are Never Reused
+	// -------------------------------------------
+	std::unordered_map<BufferId, Buffer> mBuffers;
+	std::unordered_map<TextureId, Texture> mTextures;
+	std::unordered_map<RenderTargetId, RenderTarget> mRenderTargets;   // Zero is the Window
+	std::unordered_map<VertexInputId, VertexInput> mVertexInputs;
+	std::unordered_map<ProgramId, Program> mPrograms;
+	std::unordered_map<PipelineId, Pipeline> mPipelines;
+	std::unordered_map<TimestampId, Timestamp> mTimestamps;
+	uint32_t mNextHandle = 1;
+	std::vector<VertexLayout> mVertexLayouts;
+	std::vector<FormatClass> mFormatClasses;
+	std::vector<VkRenderPass> mRenderPasses;    // Four per Format Class, One per Pair of Clears
+
+	// Descriptors Shared by Every Program
+	// -----------------------------------
+	VkDescriptorSetLayout mUniformSetLayout = VK_NULL_HANDLE;   // Set 0
+	VkDescriptorPool mChunkDescriptorPool = VK_NULL_HANDLE;
+	std::vector<std::unique_ptr<UniformChunk>> mChunks;
+	std::vector<UniformChunk*> mFreeChunks;
+	std::mutex mChunkMutex;
+	TextureId mEmptyTexture = 0;    // Bound to Samplers Given No Texture
+	BufferId mEmptyBuffer = 0;      // Bound to Storage Buffers Given No Buffer
+
+	// Pipelines per Vertex Layout, Format Class and Fill Mode, Built while Recording
+	// -------------------------------------------------------------------------------
+	std::unordered_map<uint64_t, VkPipeline> mPipelineVariants;
+	std::mutex mPipelineMutex;
+
+	// Frames and Fences
+	// -----------------
+	Frame mFrames[FRAMES_IN_FLIGHT] = {};
+	uint64_t mSerial = 1;              // Batch Being Recorded
+	uint64_t mCompletedSerial = 0;
+	bool mBatchHasWork = false;
+	bool mWireframe = false;
+
+	// Current Pass
+	// ------------
+	bool mInPass = false;
+	VkRenderPass mPassRenderPass = VK_NULL_HANDLE;
+	VkFramebuffer mPassFramebuffer = VK_NULL_HANDLE;
+	uint32_t mPassFormatClass = 0;
+	VkViewport mPassViewport = {};
+	VkRect2D mPassRect = {};                                      // Render Area: the Viewport Inside the Target
+	std::vector<std::pair<Recorder*, const CommandList*>> mRecording;
+	std::vector<VkCommandBuffer> mSecondaries;
+};
+
+#endif